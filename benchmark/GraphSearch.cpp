@@ -0,0 +1,169 @@
+#include <dwl/solver/AStar.h>
+#include <dwl/solver/BidirectionalAStar.h>
+#include <dwl/solver/Dijkstrap.h>
+#include <dwl/model/GridBasedBodyAdjacency.h>
+#include <dwl/environment/TerrainMap.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+
+/**
+ * This benchmark computes a diagonal shortest-path over flat terrain maps of increasing
+ * size (at 4 cm of resolution) with each graph-search solver, and reports the expansion
+ * rate vs. the map size in a csv format. The usage is:
+ *   search_benchmark [repetitions] [csv file]
+ */
+
+struct BenchmarkResult
+{
+	BenchmarkResult() : size(0.), cells(0), repetitions(0), solved(0),
+			min_time(0.), mean_time(0.), cost(0.), expansions(0), expansion_rate(0.) {}
+
+	std::string solver;
+	double size;
+	unsigned int cells;
+	unsigned int repetitions;
+	unsigned int solved;
+	double min_time;
+	double mean_time;
+	double cost;
+	unsigned int expansions;
+	double expansion_rate;
+};
+
+
+void buildTerrain(dwl::environment::TerrainMap& terrain,
+				  double size,
+				  double resolution)
+{
+	dwl::environment::SpaceDiscretization space_model(resolution);
+
+	// Building a squared terrain with a smooth cost pattern. Note that the keys are
+	// computed from the origin key for avoiding rounding errors
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	unsigned int num_cells = round(size / resolution);
+	terrain_data.data.reserve(num_cells * num_cells);
+	dwl::Key origin;
+	space_model.coordToKey(origin.x, 0., true);
+	space_model.coordToKey(origin.z, 0., false);
+	for (unsigned int i = 0; i < num_cells; ++i) {
+		for (unsigned int j = 0; j < num_cells; ++j) {
+			double x = i * resolution;
+			double y = j * resolution;
+
+			dwl::TerrainCell cell;
+			cell.key.x = origin.x + i;
+			cell.key.y = origin.x + j;
+			cell.key.z = origin.z;
+			cell.cost = 1. + 0.5 * sin(x) * cos(y);
+			cell.height = 0.;
+			cell.normal = Eigen::Vector3d::UnitZ();
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+}
+
+
+BenchmarkResult run(dwl::solver::SearchTreeSolver* solver,
+					dwl::model::HeuristicField* heuristic_field,
+					double size,
+					double resolution,
+					unsigned int repetitions)
+{
+	BenchmarkResult result;
+	result.solver = solver->getName();
+	if (heuristic_field != NULL)
+		result.solver += " (heuristic field)";
+	result.size = size;
+	result.repetitions = repetitions;
+
+	dwl::environment::TerrainMap terrain;
+	buildTerrain(terrain, size, resolution);
+	result.cells = terrain.getTerrainDataMap().size();
+
+	// Using the terrain adjacency, i.e. the cost of the terrain cells
+	dwl::model::GridBasedBodyAdjacency* adjacency = new dwl::model::GridBasedBodyAdjacency();
+	adjacency->setStanceAdjacency(false);
+	if (heuristic_field != NULL)
+		adjacency->setHeuristicField(heuristic_field);
+	solver->setAdjacencyModel(adjacency);
+	solver->reset(NULL, &terrain);
+	solver->init();
+
+	// Searching from a corner to the opposite one
+	dwl::Vertex source, target;
+	double margin = size - resolution;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., 0., 0.));
+	terrain.getTerrainSpaceModel().stateToVertex(target, Eigen::Vector3d(margin, margin, 0.));
+
+	double total_expansions = 0.;
+	for (unsigned int i = 0; i < repetitions; ++i) {
+		std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+		if (solver->compute(source, target, std::numeric_limits<double>::max()))
+			result.solved++;
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+		if (i == 0 || time < result.min_time)
+			result.min_time = time;
+		result.mean_time += time / repetitions;
+		result.cost = solver->getMinimumCost();
+		result.expansions = solver->getNumberOfExpansions();
+		total_expansions += result.expansions;
+	}
+	if (result.mean_time > 0.)
+		result.expansion_rate = total_expansions / (result.mean_time * repetitions);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned int repetitions = argc > 1 ? atoi(argv[1]) : 5;
+
+	// Benchmarking maps up to 10 m x 10 m at 4 cm of resolution
+	double resolution = 0.04;
+	double sizes[] = {1., 2.5, 5., 7.5, 10.};
+
+	std::vector<BenchmarkResult> results;
+	for (unsigned int i = 0; i < sizeof(sizes) / sizeof(double); ++i) {
+		dwl::solver::AStar astar;
+		results.push_back(run(&astar, NULL, sizes[i], resolution, repetitions));
+
+		dwl::solver::AStar field_astar;
+		dwl::model::HeuristicField heuristic_field;
+		results.push_back(run(&field_astar, &heuristic_field, sizes[i], resolution, repetitions));
+
+		dwl::solver::BidirectionalAStar bidirectional_astar;
+		results.push_back(run(&bidirectional_astar, NULL, sizes[i], resolution, repetitions));
+
+		dwl::solver::Dijkstrap dijkstrap;
+		results.push_back(run(&dijkstrap, NULL, sizes[i], resolution, repetitions));
+	}
+
+	// Reporting the results in a csv format
+	std::ostringstream csv;
+	csv << "solver,size,cells,repetitions,solved,min_time,mean_time,cost,expansions,"
+			"expansions_per_second" << std::endl;
+	for (unsigned int i = 0; i < results.size(); ++i) {
+		const BenchmarkResult& r = results[i];
+		csv << r.solver << "," << r.size << "," << r.cells << "," << r.repetitions << ","
+			<< r.solved << "," << r.min_time << "," << r.mean_time << ","
+			<< r.cost << "," << r.expansions << "," << r.expansion_rate << std::endl;
+	}
+	std::cout << csv.str();
+
+	if (argc > 2) {
+		std::ofstream file(argv[2]);
+		file << csv.str();
+	}
+
+	return 0;
+}
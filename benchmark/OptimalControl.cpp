@@ -0,0 +1,287 @@
+#include <dwl/ocp/OptimalControl.h>
+#include <dwl/ocp/FullDynamicalSystem.h>
+#include <dwl/ocp/CentroidalDynamicalSystem.h>
+#include <dwl/ocp/IntegralControlEnergyCost.h>
+#include <dwl/ocp/TerminalStateTrackingEnergyCost.h>
+#include <dwl/solver/OptimizationSolver.h>
+#ifdef DWL_WITH_IPOPT
+#include <dwl/solver/IpoptNLP.h>
+#endif
+#ifdef DWL_WITH_CMAES
+#include <dwl/solver/cmaesSOFamily.h>
+#endif
+#include <model/HS071DynamicalSystem.cpp>
+#include <model/HS071Cost.cpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+/**
+ * This benchmark solves a set of canonical optimal control problems with each
+ * available solver, and reports the wall time, number of evaluations and
+ * iterations in a csv format. The usage is:
+ *   ocp_benchmark [repetitions] [warm-up runs] [csv file]
+ */
+
+typedef dwl::ocp::OptimalControl* (*ProblemBuilder)(bool soft);
+
+/** Trotting gait of the HyQ problems, i.e. two strides of 0.5 s with 0.05 s steps */
+const double TROT_STEP_TIME = 0.05;
+const unsigned int TROT_PHASE_KNOTS = 5;
+const unsigned int TROT_STRIDES = 2;
+const double TROT_STRIDE_LENGTH = 0.2;
+
+
+/**
+ * Imposes the contact schedule of a trot, i.e. the diagonal legs swing in alternate phases
+ * and the contact forces of the swing legs are zero. The phase is defined by the time of the
+ * knot
+ */
+class TrottingScheduleConstraint : public dwl::ocp::Constraint<dwl::WholeBodyState>
+{
+	public:
+		TrottingScheduleConstraint(double phase_duration,
+								   double step_time) : phase_duration_(phase_duration),
+										   step_time_(step_time)
+		{
+			name_ = "trotting schedule";
+
+			// The first diagonal pair (LF and RH feet) swings first
+			first_pair_.push_back("lf_foot");
+			first_pair_.push_back("rh_foot");
+			second_pair_.push_back("rf_foot");
+			second_pair_.push_back("lh_foot");
+		}
+
+		void compute(Eigen::VectorXd& constraint,
+					 const dwl::WholeBodyState& state)
+		{
+			unsigned int phase = floor((state.time - 0.5 * step_time_) / phase_duration_);
+			const std::vector<std::string>& swing_feet = phase % 2 == 0 ?
+					first_pair_ : second_pair_;
+
+			constraint.setZero(3 * swing_feet.size());
+			for (unsigned int i = 0; i < swing_feet.size(); ++i) {
+				dwl::rbd::BodyVector6d::const_iterator eff_it =
+						state.contact_eff.find(swing_feet[i]);
+				if (eff_it != state.contact_eff.end())
+					constraint.segment<3>(3 * i) = eff_it->second.segment<3>(dwl::rbd::LX);
+			}
+		}
+
+		void getBounds(Eigen::VectorXd& lower_bound,
+					   Eigen::VectorXd& upper_bound)
+		{
+			lower_bound = Eigen::VectorXd::Zero(3 * first_pair_.size());
+			upper_bound = Eigen::VectorXd::Zero(3 * first_pair_.size());
+		}
+
+
+	private:
+		double phase_duration_;
+		double step_time_;
+		std::vector<std::string> first_pair_;
+		std::vector<std::string> second_pair_;
+};
+
+struct BenchmarkResult
+{
+	BenchmarkResult() : repetitions(0), solved(0), min_time(0.), mean_time(0.),
+			max_time(0.), evaluations(0), iterations(0) {}
+
+	std::string problem;
+	std::string solver;
+	unsigned int repetitions;
+	unsigned int solved;
+	double min_time;
+	double mean_time;
+	double max_time;
+	unsigned int evaluations;
+	unsigned int iterations;
+};
+
+
+dwl::ocp::OptimalControl* buildHS071(bool soft)
+{
+	dwl::ocp::OptimalControl* ocp = new dwl::ocp::OptimalControl();
+
+	dwl::ocp::DynamicalSystem* system = new dwl::model::HS071DynamicalSystem();
+	if (soft) {
+		system->defineAsSoftConstraint();
+		system->setSoftProperties(dwl::ocp::SoftConstraintProperties(10000, 0.1, 0.));
+	}
+	ocp->addDynamicalSystem(system);
+	ocp->addCost(new dwl::model::HS071Cost());
+
+	return ocp;
+}
+
+
+dwl::ocp::OptimalControl* buildHyQ(dwl::ocp::DynamicalSystem* system,
+								   bool soft)
+{
+	// Resetting the system from the hyq urdf file
+	std::string urdf_file = DWL_SOURCE_DIR"/sample/hyq.urdf";
+	std::string yarf_file = DWL_SOURCE_DIR"/config/hyq.yarf";
+	system->modelFromURDFFile(urdf_file, yarf_file);
+	system->setStepIntegrationTime(TROT_STEP_TIME);
+	if (soft)
+		system->defineAsSoftConstraint();
+
+	// Defining the forward displacement of the trotting strides
+	dwl::model::FloatingBaseSystem& fbs = system->getFloatingBaseSystem();
+	unsigned int num_joints = fbs.getJointDoF();
+	dwl::WholeBodyState initial_state(num_joints);
+	initial_state.joint_pos = fbs.getDefaultPosture();
+	initial_state.setBasePosition(Eigen::Vector3d(0., 0., 0.));
+	dwl::WholeBodyState terminal_state = initial_state;
+	terminal_state.setBasePosition(Eigen::Vector3d(TROT_STRIDES * TROT_STRIDE_LENGTH, 0., 0.));
+
+	// Defining the contact schedule of the trot
+	dwl::ocp::Constraint<dwl::WholeBodyState>* schedule =
+			new TrottingScheduleConstraint(TROT_PHASE_KNOTS * TROT_STEP_TIME, TROT_STEP_TIME);
+	if (soft)
+		schedule->defineAsSoftConstraint();
+	system->setInitialState(initial_state);
+	system->setTerminalState(terminal_state);
+
+	// Defining the control-energy and terminal-tracking costs
+	dwl::WholeBodyState control_weights(num_joints);
+	control_weights.joint_eff = 0.0001 * Eigen::VectorXd::Ones(num_joints);
+	dwl::ocp::Cost* control_cost = new dwl::ocp::IntegralControlEnergyCost();
+	control_cost->setWeights(control_weights);
+
+	dwl::WholeBodyState tracking_weights(num_joints);
+	tracking_weights.setBasePosition(Eigen::Vector3d(100., 100., 100.));
+	tracking_weights.joint_pos = Eigen::VectorXd::Ones(num_joints);
+	dwl::ocp::Cost* tracking_cost = new dwl::ocp::TerminalStateTrackingEnergyCost();
+	tracking_cost->setWeights(tracking_weights);
+	tracking_cost->setDesiredState(terminal_state);
+
+	dwl::ocp::OptimalControl* ocp = new dwl::ocp::OptimalControl();
+	ocp->addDynamicalSystem(system);
+	ocp->addConstraint(schedule);
+	ocp->addCost(control_cost);
+	ocp->addCost(tracking_cost);
+	ocp->setHorizon(2 * TROT_PHASE_KNOTS * TROT_STRIDES);
+
+	return ocp;
+}
+
+
+dwl::ocp::OptimalControl* buildHyQFullDynamics(bool soft)
+{
+	return buildHyQ(new dwl::ocp::FullDynamicalSystem(), soft);
+}
+
+
+dwl::ocp::OptimalControl* buildHyQCentroidal(bool soft)
+{
+	return buildHyQ(new dwl::ocp::CentroidalDynamicalSystem(), soft);
+}
+
+
+BenchmarkResult run(const std::string& problem_name,
+					ProblemBuilder builder,
+					dwl::solver::OptimizationSolver* solver,
+					const std::string& config_file,
+					bool soft,
+					unsigned int repetitions,
+					unsigned int warmup)
+{
+	BenchmarkResult result;
+	result.problem = problem_name;
+	result.solver = solver->getName();
+	result.repetitions = repetitions;
+
+	// Building the optimal control problem and setting it to the solver
+	dwl::ocp::OptimalControl* ocp = builder(soft);
+	solver->setOptimizationModel(ocp);
+	solver->setFromConfigFile(config_file);
+	solver->init();
+	solver->enableProfiling();
+
+	// Warming up the solver, i.e. caches, allocations and lazy initializations
+	for (unsigned int i = 0; i < warmup; ++i)
+		solver->compute();
+
+	// Timing the solves
+	std::vector<double> times(repetitions);
+	for (unsigned int i = 0; i < repetitions; ++i) {
+		std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+		if (solver->compute())
+			result.solved++;
+		times[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+		// Getting the evaluations and iterations of the last solve
+		const dwl::utils::ProfileReport& report = solver->getProfileReport();
+		result.evaluations = 0;
+		for (dwl::utils::ProfileReport::EvaluationMap::const_iterator it = report.evaluations.begin();
+				it != report.evaluations.end(); ++it)
+			result.evaluations += it->second.count;
+		result.iterations = report.iterations.size();
+	}
+
+	if (repetitions > 0) {
+		result.min_time = *std::min_element(times.begin(), times.end());
+		result.max_time = *std::max_element(times.begin(), times.end());
+		for (unsigned int i = 0; i < repetitions; ++i)
+			result.mean_time += times[i] / repetitions;
+	}
+
+	delete ocp;
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned int repetitions = argc > 1 ? atoi(argv[1]) : 5;
+	unsigned int warmup = argc > 2 ? atoi(argv[2]) : 1;
+
+	// Defining the benchmark problems
+	std::vector<std::pair<std::string, ProblemBuilder> > problems;
+	problems.push_back(std::make_pair("hs071", &buildHS071));
+	problems.push_back(std::make_pair("hyq_full_dynamics", &buildHyQFullDynamics));
+	problems.push_back(std::make_pair("hyq_centroidal", &buildHyQCentroidal));
+
+	// Solving every problem with each available solver
+	std::vector<BenchmarkResult> results;
+	for (unsigned int p = 0; p < problems.size(); ++p) {
+#ifdef DWL_WITH_IPOPT
+		dwl::solver::IpoptNLP ipopt;
+		results.push_back(run(problems[p].first, problems[p].second, &ipopt,
+							  DWL_SOURCE_DIR"/config/ipopt_config.yaml", false,
+							  repetitions, warmup));
+#endif
+#ifdef DWL_WITH_CMAES
+		dwl::solver::cmaesSOFamily<> cmaes;
+		results.push_back(run(problems[p].first, problems[p].second, &cmaes,
+							  DWL_SOURCE_DIR"/config/cmaes_config.yaml", true,
+							  repetitions, warmup));
+#endif
+	}
+
+	// Reporting the results in a csv format
+	std::ostringstream csv;
+	csv << "problem,solver,repetitions,solved,min_time,mean_time,max_time,"
+			"evaluations,iterations" << std::endl;
+	for (unsigned int i = 0; i < results.size(); ++i) {
+		const BenchmarkResult& r = results[i];
+		csv << r.problem << "," << r.solver << "," << r.repetitions << ","
+			<< r.solved << "," << r.min_time << "," << r.mean_time << ","
+			<< r.max_time << "," << r.evaluations << "," << r.iterations << std::endl;
+	}
+	std::cout << csv.str();
+
+	if (argc > 3) {
+		std::ofstream file(argv[3]);
+		file << csv.str();
+	}
+
+	return 0;
+}
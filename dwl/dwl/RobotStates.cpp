@@ -182,8 +182,8 @@ const WholeBodyTrajectory& RobotStates::getWholeBodyTrajectory(const ReducedBody
 	// Getting the number of points defined in the reduced-body trajectory
 	unsigned int num_points = trajectory.size();
 
-	// Resizing the full trajectory vector
-	wt_.clear();
+	// Resizing the full trajectory vector. Note that the existing states are
+	// reused, so there isn't memory allocation across calls
 	wt_.resize(num_points);
 
 	// Getting the full trajectory
@@ -1,4 +1,5 @@
 #include <dwl/WholeBodyState.h>
+#include <utility>
 
 
 namespace dwl
@@ -24,12 +25,55 @@ WholeBodyState::WholeBodyState(unsigned int num_joints) :
 }
 
 
+WholeBodyState::WholeBodyState(WholeBodyState&& other) noexcept :
+		time(0.), duration(0.), base_pos(rbd::Vector6d::Zero()), base_vel(rbd::Vector6d::Zero()),
+		base_acc(rbd::Vector6d::Zero()), base_eff(rbd::Vector6d::Zero()), num_joints_(0),
+		default_joint_value_(0.), null_3dvector_(Eigen::Vector3d::Zero()),
+		null_6dvector_(NO_WRENCH)
+{
+	// The moved-from state is left as a zero state without joints
+	swap(other);
+}
+
+
 WholeBodyState::~WholeBodyState()
 {
 
 }
 
 
+WholeBodyState& WholeBodyState::operator=(WholeBodyState&& other) noexcept
+{
+	if (this != &other)
+		swap(other);
+
+	return *this;
+}
+
+
+void WholeBodyState::swap(WholeBodyState& other) noexcept
+{
+	// The dynamic-size vectors and the contact maps swap their buffers. The null vectors
+	// aren't swapped, since they are the same in every state
+	std::swap(time, other.time);
+	std::swap(duration, other.duration);
+	base_pos.swap(other.base_pos);
+	base_vel.swap(other.base_vel);
+	base_acc.swap(other.base_acc);
+	base_eff.swap(other.base_eff);
+	joint_pos.swap(other.joint_pos);
+	joint_vel.swap(other.joint_vel);
+	joint_acc.swap(other.joint_acc);
+	joint_eff.swap(other.joint_eff);
+	contact_pos.swap(other.contact_pos);
+	contact_vel.swap(other.contact_vel);
+	contact_acc.swap(other.contact_acc);
+	contact_eff.swap(other.contact_eff);
+	std::swap(num_joints_, other.num_joints_);
+	std::swap(default_joint_value_, other.default_joint_value_);
+}
+
+
 const double& WholeBodyState::getTime() const
 {
 	return time;
@@ -77,6 +77,28 @@ class WholeBodyState
 		/** @brief Constructor function */
 		WholeBodyState(unsigned int num_joints = 0);
 
+		/** @brief Copy constructor function */
+		WholeBodyState(const WholeBodyState& other) = default;
+
+		/**
+		 * @brief Move constructor function. The joint and contact states are
+		 * swapped, so there isn't memory allocation
+		 */
+		WholeBodyState(WholeBodyState&& other) noexcept;
+
+		/** @brief Copy assignment operator. Note that the Eigen assignments reuse the memory when
+		 * the dimensions are the same */
+		WholeBodyState& operator=(const WholeBodyState& other) = default;
+
+		/** @brief Move assignment operator */
+		WholeBodyState& operator=(WholeBodyState&& other) noexcept;
+
+		/**
+		 * @brief Swaps the states without copying the dynamic-size ones
+		 * @param WholeBodyState& The other whole-body state
+		 */
+		void swap(WholeBodyState& other) noexcept;
+
 		/** @brief Destructor function */
 		~WholeBodyState();
 
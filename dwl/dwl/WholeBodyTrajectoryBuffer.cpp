@@ -0,0 +1,558 @@
+#include <dwl/WholeBodyTrajectoryBuffer.h>
+#include <algorithm>
+#include <utility>
+
+
+namespace dwl
+{
+
+WholeBodyTrajectoryBuffer::WholeBodyTrajectoryBuffer(unsigned int num_joints,
+													 const std::vector<std::string>& contact_names) :
+		size_(0), num_joints_(num_joints), contact_names_(contact_names)
+{
+	setDimensions(num_joints, contact_names);
+}
+
+
+WholeBodyTrajectoryBuffer::WholeBodyTrajectoryBuffer(WholeBodyTrajectoryBuffer&& other) noexcept :
+		size_(0), num_joints_(0)
+{
+	swap(other);
+}
+
+
+WholeBodyTrajectoryBuffer::~WholeBodyTrajectoryBuffer()
+{
+
+}
+
+
+WholeBodyTrajectoryBuffer&
+WholeBodyTrajectoryBuffer::operator=(WholeBodyTrajectoryBuffer&& other) noexcept
+{
+	if (this != &other)
+		swap(other);
+
+	return *this;
+}
+
+
+void WholeBodyTrajectoryBuffer::swap(WholeBodyTrajectoryBuffer& other) noexcept
+{
+	std::swap(size_, other.size_);
+	std::swap(num_joints_, other.num_joints_);
+	contact_names_.swap(other.contact_names_);
+	time_.swap(other.time_);
+	duration_.swap(other.duration_);
+	base_pos_.swap(other.base_pos_);
+	base_vel_.swap(other.base_vel_);
+	base_acc_.swap(other.base_acc_);
+	base_eff_.swap(other.base_eff_);
+	joint_pos_.swap(other.joint_pos_);
+	joint_vel_.swap(other.joint_vel_);
+	joint_acc_.swap(other.joint_acc_);
+	joint_eff_.swap(other.joint_eff_);
+	contact_pos_.swap(other.contact_pos_);
+	contact_vel_.swap(other.contact_vel_);
+	contact_acc_.swap(other.contact_acc_);
+	contact_eff_.swap(other.contact_eff_);
+	contact_pos_dim_.swap(other.contact_pos_dim_);
+	contact_vel_dim_.swap(other.contact_vel_dim_);
+	contact_acc_dim_.swap(other.contact_acc_dim_);
+	contact_eff_dim_.swap(other.contact_eff_dim_);
+}
+
+
+void WholeBodyTrajectoryBuffer::setDimensions(unsigned int num_joints,
+											  const std::vector<std::string>& contact_names)
+{
+	size_ = 0;
+	num_joints_ = num_joints;
+	contact_names_ = contact_names;
+
+	// Keeping the current capacity
+	unsigned int capacity = time_.size();
+	unsigned int num_contacts = contact_names_.size();
+	base_pos_.resize(6, capacity);
+	base_vel_.resize(6, capacity);
+	base_acc_.resize(6, capacity);
+	base_eff_.resize(6, capacity);
+	joint_pos_.resize(num_joints_, capacity);
+	joint_vel_.resize(num_joints_, capacity);
+	joint_acc_.resize(num_joints_, capacity);
+	joint_eff_.resize(num_joints_, capacity);
+	contact_pos_.resize(MAX_CONTACT_DIM * num_contacts, capacity);
+	contact_vel_.resize(MAX_CONTACT_DIM * num_contacts, capacity);
+	contact_acc_.resize(MAX_CONTACT_DIM * num_contacts, capacity);
+	contact_eff_.resize(6 * num_contacts, capacity);
+	contact_pos_dim_.resize(num_contacts, capacity);
+	contact_vel_dim_.resize(num_contacts, capacity);
+	contact_acc_dim_.resize(num_contacts, capacity);
+	contact_eff_dim_.resize(num_contacts, capacity);
+}
+
+
+void WholeBodyTrajectoryBuffer::reserve(unsigned int capacity)
+{
+	if (capacity <= this->capacity())
+		return;
+
+	time_.conservativeResize(capacity);
+	duration_.conservativeResize(capacity);
+	base_pos_.conservativeResize(Eigen::NoChange, capacity);
+	base_vel_.conservativeResize(Eigen::NoChange, capacity);
+	base_acc_.conservativeResize(Eigen::NoChange, capacity);
+	base_eff_.conservativeResize(Eigen::NoChange, capacity);
+	joint_pos_.conservativeResize(Eigen::NoChange, capacity);
+	joint_vel_.conservativeResize(Eigen::NoChange, capacity);
+	joint_acc_.conservativeResize(Eigen::NoChange, capacity);
+	joint_eff_.conservativeResize(Eigen::NoChange, capacity);
+	contact_pos_.conservativeResize(Eigen::NoChange, capacity);
+	contact_vel_.conservativeResize(Eigen::NoChange, capacity);
+	contact_acc_.conservativeResize(Eigen::NoChange, capacity);
+	contact_eff_.conservativeResize(Eigen::NoChange, capacity);
+	contact_pos_dim_.conservativeResize(Eigen::NoChange, capacity);
+	contact_vel_dim_.conservativeResize(Eigen::NoChange, capacity);
+	contact_acc_dim_.conservativeResize(Eigen::NoChange, capacity);
+	contact_eff_dim_.conservativeResize(Eigen::NoChange, capacity);
+}
+
+
+void WholeBodyTrajectoryBuffer::resize(unsigned int size)
+{
+	reserve(size);
+
+	// Setting zero the new samples, their contacts aren't defined
+	if (size > size_) {
+		unsigned int num_new = size - size_;
+		time_.segment(size_, num_new).setZero();
+		duration_.segment(size_, num_new).setZero();
+		base_pos_.middleCols(size_, num_new).setZero();
+		base_vel_.middleCols(size_, num_new).setZero();
+		base_acc_.middleCols(size_, num_new).setZero();
+		base_eff_.middleCols(size_, num_new).setZero();
+		joint_pos_.middleCols(size_, num_new).setZero();
+		joint_vel_.middleCols(size_, num_new).setZero();
+		joint_acc_.middleCols(size_, num_new).setZero();
+		joint_eff_.middleCols(size_, num_new).setZero();
+		contact_pos_.middleCols(size_, num_new).setZero();
+		contact_vel_.middleCols(size_, num_new).setZero();
+		contact_acc_.middleCols(size_, num_new).setZero();
+		contact_eff_.middleCols(size_, num_new).setZero();
+		contact_pos_dim_.middleCols(size_, num_new).setZero();
+		contact_vel_dim_.middleCols(size_, num_new).setZero();
+		contact_acc_dim_.middleCols(size_, num_new).setZero();
+		contact_eff_dim_.middleCols(size_, num_new).setZero();
+	}
+	size_ = size;
+}
+
+
+void WholeBodyTrajectoryBuffer::clear()
+{
+	size_ = 0;
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::size() const
+{
+	return size_;
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::capacity() const
+{
+	return time_.size();
+}
+
+
+bool WholeBodyTrajectoryBuffer::empty() const
+{
+	return size_ == 0;
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::getJointDoF() const
+{
+	return num_joints_;
+}
+
+
+const std::vector<std::string>& WholeBodyTrajectoryBuffer::getContactNames() const
+{
+	return contact_names_;
+}
+
+
+void WholeBodyTrajectoryBuffer::push_back(const WholeBodyState& state)
+{
+	if (size_ == capacity())
+		grow();
+
+	++size_;
+	setState(size_ - 1, state);
+}
+
+
+void WholeBodyTrajectoryBuffer::setState(unsigned int index,
+										 const WholeBodyState& state)
+{
+	time_(index) = state.time;
+	duration_(index) = state.duration;
+	base_pos_.col(index) = state.base_pos;
+	base_vel_.col(index) = state.base_vel;
+	base_acc_.col(index) = state.base_acc;
+	base_eff_.col(index) = state.base_eff;
+
+	// Setting zero the joint states that aren't defined
+	if ((unsigned) state.joint_pos.size() == num_joints_)
+		joint_pos_.col(index) = state.joint_pos;
+	else
+		joint_pos_.col(index).setZero();
+	if ((unsigned) state.joint_vel.size() == num_joints_)
+		joint_vel_.col(index) = state.joint_vel;
+	else
+		joint_vel_.col(index).setZero();
+	if ((unsigned) state.joint_acc.size() == num_joints_)
+		joint_acc_.col(index) = state.joint_acc;
+	else
+		joint_acc_.col(index).setZero();
+	if ((unsigned) state.joint_eff.size() == num_joints_)
+		joint_eff_.col(index) = state.joint_eff;
+	else
+		joint_eff_.col(index).setZero();
+
+	// Setting the contact states, the missed contacts have zero dimension
+	unsigned int num_contacts = contact_names_.size();
+	for (unsigned int c = 0; c < num_contacts; ++c) {
+		setContactState(contact_pos_, contact_pos_dim_, index, c, state.contact_pos);
+		setContactState(contact_vel_, contact_vel_dim_, index, c, state.contact_vel);
+		setContactState(contact_acc_, contact_acc_dim_, index, c, state.contact_acc);
+		setContactState(contact_eff_, contact_eff_dim_, index, c, state.contact_eff);
+	}
+}
+
+
+void WholeBodyTrajectoryBuffer::getState(WholeBodyState& state,
+										 unsigned int index) const
+{
+	state.time = time_(index);
+	state.duration = duration_(index);
+	state.base_pos = base_pos_.col(index);
+	state.base_vel = base_vel_.col(index);
+	state.base_acc = base_acc_.col(index);
+	state.base_eff = base_eff_.col(index);
+	state.joint_pos = joint_pos_.col(index);
+	state.joint_vel = joint_vel_.col(index);
+	state.joint_acc = joint_acc_.col(index);
+	state.joint_eff = joint_eff_.col(index);
+
+
+	// Getting only the contacts defined in the sample
+	getContactStates(state.contact_pos, contact_pos_, contact_pos_dim_, index);
+	getContactStates(state.contact_vel, contact_vel_, contact_vel_dim_, index);
+	getContactStates(state.contact_acc, contact_acc_, contact_acc_dim_, index);
+	getContactStates(state.contact_eff, contact_eff_, contact_eff_dim_, index);
+}
+
+
+void WholeBodyTrajectoryBuffer::fromWholeBodyTrajectory(const WholeBodyTrajectory& trajectory)
+{
+	clear();
+	reserve(trajectory.size());
+	for (unsigned int k = 0; k < trajectory.size(); ++k)
+		push_back(trajectory[k]);
+}
+
+
+void WholeBodyTrajectoryBuffer::toWholeBodyTrajectory(WholeBodyTrajectory& trajectory) const
+{
+	trajectory.resize(size_, WholeBodyState(num_joints_));
+	for (unsigned int k = 0; k < size_; ++k)
+		getState(trajectory[k], k);
+}
+
+
+double& WholeBodyTrajectoryBuffer::time(unsigned int index)
+{
+	return time_(index);
+}
+
+
+const double& WholeBodyTrajectoryBuffer::time(unsigned int index) const
+{
+	return time_(index);
+}
+
+
+double& WholeBodyTrajectoryBuffer::duration(unsigned int index)
+{
+	return duration_(index);
+}
+
+
+const double& WholeBodyTrajectoryBuffer::duration(unsigned int index) const
+{
+	return duration_(index);
+}
+
+
+WholeBodyTrajectoryBuffer::BaseState WholeBodyTrajectoryBuffer::base_pos(unsigned int index)
+{
+	return base_pos_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstBaseState WholeBodyTrajectoryBuffer::base_pos(unsigned int index) const
+{
+	return base_pos_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::BaseState WholeBodyTrajectoryBuffer::base_vel(unsigned int index)
+{
+	return base_vel_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstBaseState WholeBodyTrajectoryBuffer::base_vel(unsigned int index) const
+{
+	return base_vel_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::BaseState WholeBodyTrajectoryBuffer::base_acc(unsigned int index)
+{
+	return base_acc_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstBaseState WholeBodyTrajectoryBuffer::base_acc(unsigned int index) const
+{
+	return base_acc_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::BaseState WholeBodyTrajectoryBuffer::base_eff(unsigned int index)
+{
+	return base_eff_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstBaseState WholeBodyTrajectoryBuffer::base_eff(unsigned int index) const
+{
+	return base_eff_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::JointState WholeBodyTrajectoryBuffer::joint_pos(unsigned int index)
+{
+	return joint_pos_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstJointState WholeBodyTrajectoryBuffer::joint_pos(unsigned int index) const
+{
+	return joint_pos_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::JointState WholeBodyTrajectoryBuffer::joint_vel(unsigned int index)
+{
+	return joint_vel_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstJointState WholeBodyTrajectoryBuffer::joint_vel(unsigned int index) const
+{
+	return joint_vel_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::JointState WholeBodyTrajectoryBuffer::joint_acc(unsigned int index)
+{
+	return joint_acc_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstJointState WholeBodyTrajectoryBuffer::joint_acc(unsigned int index) const
+{
+	return joint_acc_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::JointState WholeBodyTrajectoryBuffer::joint_eff(unsigned int index)
+{
+	return joint_eff_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstJointState WholeBodyTrajectoryBuffer::joint_eff(unsigned int index) const
+{
+	return joint_eff_.col(index);
+}
+
+
+WholeBodyTrajectoryBuffer::ContactState
+WholeBodyTrajectoryBuffer::contact_pos(unsigned int index, unsigned int contact)
+{
+	return contact_pos_.block<3,1>(MAX_CONTACT_DIM * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstContactState
+WholeBodyTrajectoryBuffer::contact_pos(unsigned int index, unsigned int contact) const
+{
+	return contact_pos_.block<3,1>(MAX_CONTACT_DIM * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ContactState
+WholeBodyTrajectoryBuffer::contact_vel(unsigned int index, unsigned int contact)
+{
+	return contact_vel_.block<3,1>(MAX_CONTACT_DIM * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstContactState
+WholeBodyTrajectoryBuffer::contact_vel(unsigned int index, unsigned int contact) const
+{
+	return contact_vel_.block<3,1>(MAX_CONTACT_DIM * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ContactState
+WholeBodyTrajectoryBuffer::contact_acc(unsigned int index, unsigned int contact)
+{
+	return contact_acc_.block<3,1>(MAX_CONTACT_DIM * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstContactState
+WholeBodyTrajectoryBuffer::contact_acc(unsigned int index, unsigned int contact) const
+{
+	return contact_acc_.block<3,1>(MAX_CONTACT_DIM * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ContactWrench
+WholeBodyTrajectoryBuffer::contact_eff(unsigned int index, unsigned int contact)
+{
+	return contact_eff_.block<6,1>(6 * contact, index);
+}
+
+
+WholeBodyTrajectoryBuffer::ConstContactWrench
+WholeBodyTrajectoryBuffer::contact_eff(unsigned int index, unsigned int contact) const
+{
+	return contact_eff_.block<6,1>(6 * contact, index);
+}
+
+
+unsigned int& WholeBodyTrajectoryBuffer::contact_pos_dim(unsigned int index, unsigned int contact)
+{
+	return contact_pos_dim_(contact, index);
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::contact_pos_dim(unsigned int index, unsigned int contact) const
+{
+	return contact_pos_dim_(contact, index);
+}
+
+
+unsigned int& WholeBodyTrajectoryBuffer::contact_vel_dim(unsigned int index, unsigned int contact)
+{
+	return contact_vel_dim_(contact, index);
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::contact_vel_dim(unsigned int index, unsigned int contact) const
+{
+	return contact_vel_dim_(contact, index);
+}
+
+
+unsigned int& WholeBodyTrajectoryBuffer::contact_acc_dim(unsigned int index, unsigned int contact)
+{
+	return contact_acc_dim_(contact, index);
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::contact_acc_dim(unsigned int index, unsigned int contact) const
+{
+	return contact_acc_dim_(contact, index);
+}
+
+
+unsigned int& WholeBodyTrajectoryBuffer::contact_eff_dim(unsigned int index, unsigned int contact)
+{
+	return contact_eff_dim_(contact, index);
+}
+
+
+unsigned int WholeBodyTrajectoryBuffer::contact_eff_dim(unsigned int index, unsigned int contact) const
+{
+	return contact_eff_dim_(contact, index);
+}
+
+
+void WholeBodyTrajectoryBuffer::grow()
+{
+	unsigned int capacity = this->capacity();
+	reserve(capacity == 0 ? 8 : 2 * capacity);
+}
+
+
+template<typename BodyVector>
+void WholeBodyTrajectoryBuffer::setContactState(Eigen::MatrixXd& states,
+												MatrixXu& dims,
+												unsigned int index,
+												unsigned int contact,
+												const BodyVector& body_states)
+{
+	unsigned int slot = states.rows() / contact_names_.size();
+	typename BodyVector::const_iterator it = body_states.find(contact_names_[contact]);
+	if (it == body_states.end()) {
+		dims(contact, index) = 0;
+		return;
+	}
+
+	// The contact states longer than the slot are truncated
+	unsigned int dim = std::min((unsigned int) it->second.size(), slot);
+	states.block(slot * contact, index, dim, 1) = it->second.head(dim);
+	states.block(slot * contact + dim, index, slot - dim, 1).setZero();
+	dims(contact, index) = dim;
+}
+
+
+template<typename BodyVector>
+void WholeBodyTrajectoryBuffer::getContactStates(BodyVector& body_states,
+												 const Eigen::MatrixXd& states,
+												 const MatrixXu& dims,
+												 unsigned int index) const
+{
+	// Removing the contacts that aren't defined in the sample
+	typename BodyVector::iterator it = body_states.begin();
+	while (it != body_states.end()) {
+		std::vector<std::string>::const_iterator name_it =
+				std::find(contact_names_.begin(), contact_names_.end(), it->first);
+		if (name_it == contact_names_.end() ||
+				dims(name_it - contact_names_.begin(), index) == 0)
+			body_states.erase(it++);
+		else
+			++it;
+	}
+
+	unsigned int num_contacts = contact_names_.size();
+	for (unsigned int c = 0; c < num_contacts; ++c) {
+		unsigned int dim = dims(c, index);
+		if (dim == 0)
+			continue;
+
+		unsigned int slot = states.rows() / num_contacts;
+		body_states[contact_names_[c]] = states.block(slot * c, index, dim, 1);
+	}
+}
+
+} //@namespace dwl
@@ -0,0 +1,271 @@
+#ifndef DWL__WHOLE_BODY_TRAJECTORY_BUFFER__H
+#define DWL__WHOLE_BODY_TRAJECTORY_BUFFER__H
+
+#include <dwl/WholeBodyState.h>
+
+
+namespace dwl
+{
+
+/**
+ * @brief The WholeBodyTrajectoryBuffer class
+ * This class stores a whole-body trajectory in a contiguous structure-of-arrays
+ * layout, i.e. each state (time, base, joint and contact states) is stored in a
+ * matrix where each column is a sample of the trajectory. The contact states are
+ * stored in the order of the contact names, e.g. contact_pos [x_0, ..., x_P], where
+ * each contact has a slot of up to six components. The buffer also stores the
+ * dimension of each contact per sample, which is zero for the contacts that aren't
+ * defined in the sample, so the contact states are rebuilt as they were set.
+ * The buffer keeps its capacity between clear() calls, so it could be reused
+ * across solves without memory allocation. Per-sample states are accessible as
+ * Eigen views of the columns, or they could be copied into a WholeBodyState.
+ * @author Carlos Mastalli
+ * @copyright BSD 3-Clause License
+ */
+class WholeBodyTrajectoryBuffer
+{
+	public:
+		typedef Eigen::Matrix<double,6,Eigen::Dynamic> Matrix6Xd;
+		typedef Matrix6Xd::ColXpr BaseState;
+		typedef Matrix6Xd::ConstColXpr ConstBaseState;
+		typedef Eigen::MatrixXd::ColXpr JointState;
+		typedef Eigen::MatrixXd::ConstColXpr ConstJointState;
+		typedef Eigen::Block<Eigen::MatrixXd,3,1> ContactState;
+		typedef Eigen::Block<const Eigen::MatrixXd,3,1> ConstContactState;
+		typedef Eigen::Block<Eigen::MatrixXd,6,1> ContactWrench;
+		typedef Eigen::Block<const Eigen::MatrixXd,6,1> ConstContactWrench;
+
+		/**
+		 * @brief Constructor function
+		 * @param unsigned int Number of joints
+		 * @param const std::vector<std::string>& Contact names
+		 */
+		WholeBodyTrajectoryBuffer(unsigned int num_joints = 0,
+								  const std::vector<std::string>& contact_names =
+										  std::vector<std::string>());
+
+		/** @brief Copy constructor function */
+		WholeBodyTrajectoryBuffer(const WholeBodyTrajectoryBuffer& other) = default;
+
+		/** @brief Move constructor function, it swaps the storage */
+		WholeBodyTrajectoryBuffer(WholeBodyTrajectoryBuffer&& other) noexcept;
+
+		/** @brief Destructor function */
+		~WholeBodyTrajectoryBuffer();
+
+		/** @brief Copy assignment operator */
+		WholeBodyTrajectoryBuffer& operator=(const WholeBodyTrajectoryBuffer& other) = default;
+
+		/** @brief Move assignment operator, it swaps the storage */
+		WholeBodyTrajectoryBuffer& operator=(WholeBodyTrajectoryBuffer&& other) noexcept;
+
+		/**
+		 * @brief Swaps the trajectories without copying them
+		 * @param WholeBodyTrajectoryBuffer& The other trajectory buffer
+		 */
+		void swap(WholeBodyTrajectoryBuffer& other) noexcept;
+
+		/**
+		 * @brief Sets the dimensions of the samples, which clears the buffer
+		 * @param unsigned int Number of joints
+		 * @param const std::vector<std::string>& Contact names
+		 */
+		void setDimensions(unsigned int num_joints,
+						   const std::vector<std::string>& contact_names);
+
+		/**
+		 * @brief Reserves the memory for a certain number of samples
+		 * @param unsigned int Number of samples
+		 */
+		void reserve(unsigned int capacity);
+
+		/**
+		 * @brief Resizes the trajectory, the new samples are zero
+		 * @param unsigned int Number of samples
+		 */
+		void resize(unsigned int size);
+
+		/** @brief Clears the trajectory but it keeps the reserved memory */
+		void clear();
+
+		/** @brief Gets the number of samples */
+		unsigned int size() const;
+
+		/** @brief Gets the number of samples that fit in the reserved memory */
+		unsigned int capacity() const;
+
+		/** @brief Returns true if the trajectory doesn't have samples */
+		bool empty() const;
+
+		/** @brief Gets the number of joints */
+		unsigned int getJointDoF() const;
+
+		/** @brief Gets the contact names */
+		const std::vector<std::string>& getContactNames() const;
+
+		/**
+		 * @brief Adds a sample at the end of the trajectory
+		 * @param const WholeBodyState& Whole-body state
+		 */
+		void push_back(const WholeBodyState& state);
+
+		/**
+		 * @brief Sets a sample of the trajectory
+		 * @param unsigned int Sample index
+		 * @param const WholeBodyState& Whole-body state
+		 */
+		void setState(unsigned int index,
+					  const WholeBodyState& state);
+
+		/**
+		 * @brief Gets a sample of the trajectory. There isn't memory allocation
+		 * if the whole-body state has already the right dimensions
+		 * @param WholeBodyState& Whole-body state
+		 * @param unsigned int Sample index
+		 */
+		void getState(WholeBodyState& state,
+					  unsigned int index) const;
+
+		/**
+		 * @brief Copies a whole-body trajectory into the buffer
+		 * @param const WholeBodyTrajectory& Whole-body trajectory
+		 */
+		void fromWholeBodyTrajectory(const WholeBodyTrajectory& trajectory);
+
+		/**
+		 * @brief Copies the buffer into a whole-body trajectory, it reuses the
+		 * existing states of the trajectory
+		 * @param WholeBodyTrajectory& Whole-body trajectory
+		 */
+		void toWholeBodyTrajectory(WholeBodyTrajectory& trajectory) const;
+
+		/** @brief Per-sample views of the time and duration */
+		double& time(unsigned int index);
+		const double& time(unsigned int index) const;
+		double& duration(unsigned int index);
+		const double& duration(unsigned int index) const;
+
+		/** @brief Per-sample views of the base states */
+		BaseState base_pos(unsigned int index);
+		ConstBaseState base_pos(unsigned int index) const;
+		BaseState base_vel(unsigned int index);
+		ConstBaseState base_vel(unsigned int index) const;
+		BaseState base_acc(unsigned int index);
+		ConstBaseState base_acc(unsigned int index) const;
+		BaseState base_eff(unsigned int index);
+		ConstBaseState base_eff(unsigned int index) const;
+
+		/** @brief Per-sample views of the joint states */
+		JointState joint_pos(unsigned int index);
+		ConstJointState joint_pos(unsigned int index) const;
+		JointState joint_vel(unsigned int index);
+		ConstJointState joint_vel(unsigned int index) const;
+		JointState joint_acc(unsigned int index);
+		ConstJointState joint_acc(unsigned int index) const;
+		JointState joint_eff(unsigned int index);
+		ConstJointState joint_eff(unsigned int index) const;
+
+		/**
+		 * @brief Per-sample views of the contact states given the contact index,
+		 * i.e. the position of its name in the contact names. The views of the
+		 * position, velocity and acceleration are the first three components of
+		 * the contact slot
+		 */
+		ContactState contact_pos(unsigned int index, unsigned int contact);
+		ConstContactState contact_pos(unsigned int index, unsigned int contact) const;
+		ContactState contact_vel(unsigned int index, unsigned int contact);
+		ConstContactState contact_vel(unsigned int index, unsigned int contact) const;
+		ContactState contact_acc(unsigned int index, unsigned int contact);
+		ConstContactState contact_acc(unsigned int index, unsigned int contact) const;
+		ContactWrench contact_eff(unsigned int index, unsigned int contact);
+		ConstContactWrench contact_eff(unsigned int index, unsigned int contact) const;
+
+		/**
+		 * @brief Per-sample dimensions of the contact states given the contact index.
+		 * The dimension is zero if the contact isn't defined in the sample, and
+		 * getState() doesn't add it to the whole-body state
+		 */
+		unsigned int& contact_pos_dim(unsigned int index, unsigned int contact);
+		unsigned int contact_pos_dim(unsigned int index, unsigned int contact) const;
+		unsigned int& contact_vel_dim(unsigned int index, unsigned int contact);
+		unsigned int contact_vel_dim(unsigned int index, unsigned int contact) const;
+		unsigned int& contact_acc_dim(unsigned int index, unsigned int contact);
+		unsigned int contact_acc_dim(unsigned int index, unsigned int contact) const;
+		unsigned int& contact_eff_dim(unsigned int index, unsigned int contact);
+		unsigned int contact_eff_dim(unsigned int index, unsigned int contact) const;
+
+		/** @brief Maximum dimension of the contact states */
+		static const unsigned int MAX_CONTACT_DIM = 6;
+
+
+	private:
+		typedef Eigen::Matrix<unsigned int,Eigen::Dynamic,Eigen::Dynamic> MatrixXu;
+
+		/** @brief Grows the reserved memory for adding a new sample */
+		void grow();
+
+		/**
+		 * @brief Sets a contact state of a sample, it stores a zero dimension if the
+		 * contact isn't defined in the whole-body state
+		 * @param Eigen::MatrixXd& Contact states
+		 * @param MatrixXu& Contact dimensions
+		 * @param unsigned int Sample index
+		 * @param unsigned int Contact index
+		 * @param const BodyVector& Contact states of the whole-body state
+		 */
+		template<typename BodyVector>
+		void setContactState(Eigen::MatrixXd& states,
+							 MatrixXu& dims,
+							 unsigned int index,
+							 unsigned int contact,
+							 const BodyVector& body_states);
+
+		/**
+		 * @brief Gets the contact states of a sample, it adds only the defined
+		 * contacts and it removes the rest
+		 * @param BodyVector& Contact states of the whole-body state
+		 * @param const Eigen::MatrixXd& Contact states
+		 * @param const MatrixXu& Contact dimensions
+		 * @param unsigned int Sample index
+		 */
+		template<typename BodyVector>
+		void getContactStates(BodyVector& body_states,
+							  const Eigen::MatrixXd& states,
+							  const MatrixXu& dims,
+							  unsigned int index) const;
+
+		/** @brief Number of samples */
+		unsigned int size_;
+
+		/** @brief Number of joints */
+		unsigned int num_joints_;
+
+		/** @brief Contact names */
+		std::vector<std::string> contact_names_;
+
+		/** @brief Structure-of-arrays storage, one column per sample */
+		Eigen::VectorXd time_;
+		Eigen::VectorXd duration_;
+		Matrix6Xd base_pos_;
+		Matrix6Xd base_vel_;
+		Matrix6Xd base_acc_;
+		Matrix6Xd base_eff_;
+		Eigen::MatrixXd joint_pos_;
+		Eigen::MatrixXd joint_vel_;
+		Eigen::MatrixXd joint_acc_;
+		Eigen::MatrixXd joint_eff_;
+		Eigen::MatrixXd contact_pos_;
+		Eigen::MatrixXd contact_vel_;
+		Eigen::MatrixXd contact_acc_;
+		Eigen::MatrixXd contact_eff_;
+
+		/** @brief Per-sample contact dimensions, one row per contact */
+		MatrixXu contact_pos_dim_;
+		MatrixXu contact_vel_dim_;
+		MatrixXu contact_acc_dim_;
+		MatrixXu contact_eff_dim_;
+};
+
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,51 @@
+#include <dwl/environment/CurvatureFeature.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+CurvatureFeature::CurvatureFeature() : max_curvature_(0.1)
+{
+	name_ = "Curvature";
+	max_cost_ = 10.;
+}
+
+
+CurvatureFeature::~CurvatureFeature()
+{
+
+}
+
+
+void CurvatureFeature::setMaximumCurvature(double max_curvature)
+{
+	max_curvature_ = max_curvature;
+}
+
+
+void CurvatureFeature::computeCost(double& cost_value,
+								   const Terrain& terrain_info)
+{
+	cost_value = max_cost_ * std::min(fabs(terrain_info.curvature) / max_curvature_, 1.);
+}
+
+
+void CurvatureFeature::computeCost(std::vector<double>& cost_values,
+								   const TerrainGrid& grid,
+								   unsigned int min_row,
+								   unsigned int max_row)
+{
+	unsigned int min_index = min_row * grid.width;
+	unsigned int max_index = max_row * grid.width;
+	const double* curvature = grid.curvatures.data();
+	double* cost = cost_values.data();
+	double scale = max_cost_ / max_curvature_;
+	for (unsigned int i = min_index; i < max_index; ++i)
+		cost[i] = std::min(scale * fabs(curvature[i]), max_cost_);
+}
+
+} //@namespace environment
+} //@namespace dwl
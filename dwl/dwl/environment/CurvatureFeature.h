@@ -0,0 +1,65 @@
+#ifndef DWL__ENVIRONMENT__CURVATURE_FEATURE__H
+#define DWL__ENVIRONMENT__CURVATURE_FEATURE__H
+
+#include <dwl/environment/Feature.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class CurvatureFeature
+ * @brief Class for computing the cost of the curvature of the terrain. The cost increases
+ * linearly with the absolute curvature until the maximum curvature. The curvatures are the
+ * ones of the terrain cells (see TerrainCell::curvature)
+ */
+class CurvatureFeature : public Feature
+{
+	public:
+		/** @brief Constructor function */
+		CurvatureFeature();
+
+		/** @brief Destructor function */
+		~CurvatureFeature();
+
+		/**
+		 * @brief Sets the curvature of the maximum cost
+		 * @param double Maximum curvature
+		 */
+		void setMaximumCurvature(double max_curvature);
+
+		/**
+		 * @brief Computes the curvature cost of a terrain cell
+		 * @param double& Cost value
+		 * @param const Terrain& Information about the terrain
+		 */
+		void computeCost(double& cost_value,
+						 const Terrain& terrain_info);
+
+		/**
+		 * @brief Computes the curvature cost of the rows of a terrain grid
+		 * @param std::vector<double>& Cost values of the grid cells (row-major)
+		 * @param const TerrainGrid& Terrain grid
+		 * @param unsigned int First row
+		 * @param unsigned int Last row (excluded)
+		 */
+		void computeCost(std::vector<double>& cost_values,
+						 const TerrainGrid& grid,
+						 unsigned int min_row,
+						 unsigned int max_row);
+
+		using Feature::computeCost;
+
+
+	private:
+		/** @brief Curvature of the maximum cost */
+		double max_curvature_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
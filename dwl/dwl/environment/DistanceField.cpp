@@ -0,0 +1,217 @@
+#include <dwl/environment/DistanceField.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+const int DistanceField::NO_SEED;
+
+
+DistanceField::DistanceField() : origin_x_(0), origin_y_(0), width_(0), height_(0),
+		max_distance_(0), max_squared_distance_(0)
+{
+	free_layer_.obstacle_seeds = true;
+	obstacle_layer_.obstacle_seeds = false;
+	setMaximumDistance(20);
+}
+
+
+DistanceField::~DistanceField()
+{
+
+}
+
+
+void DistanceField::setMaximumDistance(unsigned int max_distance)
+{
+	max_distance_ = max_distance;
+	max_squared_distance_ = max_distance * max_distance;
+}
+
+
+void DistanceField::resize(int origin_x,
+						   int origin_y,
+						   unsigned int width,
+						   unsigned int height)
+{
+	origin_x_ = origin_x;
+	origin_y_ = origin_y;
+	width_ = width;
+	height_ = height;
+
+	// Without obstacles, the free cells don't have closest obstacle and they are the seeds
+	// of the obstacle side
+	unsigned int num_cells = width * height;
+	obstacles_.assign(num_cells, 0);
+	free_layer_.squared_distance.assign(num_cells, std::numeric_limits<int>::max());
+	free_layer_.closest_seed.assign(num_cells, NO_SEED);
+	free_layer_.to_raise.assign(num_cells, 0);
+	free_layer_.open = decltype(free_layer_.open)();
+	obstacle_layer_.squared_distance.assign(num_cells, 0);
+	obstacle_layer_.closest_seed.resize(num_cells);
+	for (unsigned int i = 0; i < num_cells; ++i)
+		obstacle_layer_.closest_seed[i] = i;
+	obstacle_layer_.to_raise.assign(num_cells, 0);
+	obstacle_layer_.open = decltype(obstacle_layer_.open)();
+}
+
+
+bool DistanceField::setObstacle(int key_x,
+								int key_y)
+{
+	if (!isInside(key_x, key_y))
+		return false;
+
+	unsigned int index = (key_y - origin_y_) * width_ + (key_x - origin_x_);
+	if (obstacles_[index] == 0) {
+		obstacles_[index] = 1;
+		setSeed(free_layer_, index);
+		removeSeed(obstacle_layer_, index);
+	}
+
+	return true;
+}
+
+
+void DistanceField::removeObstacle(int key_x,
+								   int key_y)
+{
+	if (!isInside(key_x, key_y))
+		return;
+
+	unsigned int index = (key_y - origin_y_) * width_ + (key_x - origin_x_);
+	if (obstacles_[index] != 0) {
+		obstacles_[index] = 0;
+		removeSeed(free_layer_, index);
+		setSeed(obstacle_layer_, index);
+	}
+}
+
+
+void DistanceField::update()
+{
+	updateLayer(free_layer_);
+	updateLayer(obstacle_layer_);
+}
+
+
+double DistanceField::getDistance(int key_x,
+								  int key_y) const
+{
+	if (!isInside(key_x, key_y))
+		return max_distance_;
+
+	unsigned int index = (key_y - origin_y_) * width_ + (key_x - origin_x_);
+	if (obstacles_[index] == 0) {
+		int squared_distance = free_layer_.squared_distance[index];
+		if (squared_distance == std::numeric_limits<int>::max())
+			return max_distance_;
+		return sqrt(squared_distance);
+	} else {
+		int squared_distance = obstacle_layer_.squared_distance[index];
+		if (squared_distance == std::numeric_limits<int>::max())
+			return -(double) max_distance_;
+		return -sqrt(squared_distance);
+	}
+}
+
+
+bool DistanceField::isEnabled() const
+{
+	return width_ != 0 && height_ != 0;
+}
+
+
+unsigned int DistanceField::getMaximumDistance() const
+{
+	return max_distance_;
+}
+
+
+void DistanceField::setSeed(DistanceLayer& layer,
+							unsigned int index)
+{
+	layer.squared_distance[index] = 0;
+	layer.closest_seed[index] = index;
+	layer.to_raise[index] = 0;
+	layer.open.push(std::make_pair(0, index));
+}
+
+
+void DistanceField::removeSeed(DistanceLayer& layer,
+							   unsigned int index)
+{
+	layer.squared_distance[index] = std::numeric_limits<int>::max();
+	layer.closest_seed[index] = NO_SEED;
+	layer.to_raise[index] = 1;
+	layer.open.push(std::make_pair(0, index));
+}
+
+
+void DistanceField::updateLayer(DistanceLayer& layer)
+{
+	while (!layer.open.empty()) {
+		int distance = layer.open.top().first;
+		unsigned int index = layer.open.top().second;
+		layer.open.pop();
+
+		int x = index % width_;
+		int y = index / width_;
+		int min_x = std::max(x - 1, 0), max_x = std::min(x + 1, (int) width_ - 1);
+		int min_y = std::max(y - 1, 0), max_y = std::min(y + 1, (int) height_ - 1);
+		if (layer.to_raise[index]) {
+			// Raising the neighbors that referenced a removed seed, and queueing the other ones
+			// for lowering the raised cells
+			for (int ny = min_y; ny <= max_y; ++ny) {
+				for (int nx = min_x; nx <= max_x; ++nx) {
+					unsigned int neighbor = ny * width_ + nx;
+					int closest = layer.closest_seed[neighbor];
+					if (closest == NO_SEED || layer.to_raise[neighbor])
+						continue;
+
+					int old_distance = layer.squared_distance[neighbor];
+					if (!isSeed(layer, closest)) {
+						layer.squared_distance[neighbor] = std::numeric_limits<int>::max();
+						layer.closest_seed[neighbor] = NO_SEED;
+						layer.to_raise[neighbor] = 1;
+					}
+					layer.open.push(std::make_pair(old_distance, neighbor));
+				}
+			}
+			layer.to_raise[index] = 0;
+		} else {
+			// Skipping the cells that were lowered after queueing them, and the ones whose
+			// seed was removed
+			int closest = layer.closest_seed[index];
+			if (distance > layer.squared_distance[index] ||
+					closest == NO_SEED || !isSeed(layer, closest))
+				continue;
+
+			// Lowering the neighbors with the closest seed of the cell
+			int seed_x = closest % width_;
+			int seed_y = closest / width_;
+			for (int ny = min_y; ny <= max_y; ++ny) {
+				for (int nx = min_x; nx <= max_x; ++nx) {
+					unsigned int neighbor = ny * width_ + nx;
+					if (layer.to_raise[neighbor])
+						continue;
+
+					int squared_distance = (nx - seed_x) * (nx - seed_x) +
+							(ny - seed_y) * (ny - seed_y);
+					if (squared_distance < layer.squared_distance[neighbor] &&
+							squared_distance <= max_squared_distance_) {
+						layer.squared_distance[neighbor] = squared_distance;
+						layer.closest_seed[neighbor] = closest;
+						layer.open.push(std::make_pair(squared_distance, neighbor));
+					}
+				}
+			}
+		}
+	}
+}
+
+} //@namespace environment
+} //@namespace dwl
@@ -0,0 +1,177 @@
+#ifndef DWL__ENVIRONMENT__DISTANCE_FIELD__H
+#define DWL__ENVIRONMENT__DISTANCE_FIELD__H
+
+#include <dwl/utils/utils.h>
+#include <queue>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class DistanceField
+ * @brief 2d Euclidean signed distance field of a grid of obstacle cells. The free cells store the
+ * distance to the closest obstacle cell, and the obstacle cells store the negative distance to the
+ * closest free cell (both between cell centers and in cells). Each side is a truncated field that
+ * is updated incrementally by a dynamic brushfire, i.e. each cell keeps a reference to its closest
+ * seed, a new seed lowers the distances of its surroundings and a removed seed raises (clears) the
+ * cells that referenced it before they are lowered again by the remaining seeds. So, only the
+ * cells whose distance changes are visited
+ */
+class DistanceField
+{
+	public:
+		/** @brief Constructor function */
+		DistanceField();
+
+		/** @brief Destructor function */
+		~DistanceField();
+
+		/**
+		 * @brief Sets the maximum distance, i.e. the distances are truncated to this value
+		 * @param unsigned int Maximum distance (in cells)
+		 */
+		void setMaximumDistance(unsigned int max_distance);
+
+		/**
+		 * @brief Resizes the grid, which removes all the obstacles
+		 * @param int Minimum key along the x-axis
+		 * @param int Minimum key along the y-axis
+		 * @param unsigned int Number of cells along the x-axis
+		 * @param unsigned int Number of cells along the y-axis
+		 */
+		void resize(int origin_x,
+					int origin_y,
+					unsigned int width,
+					unsigned int height);
+
+		/**
+		 * @brief Sets an obstacle cell. The distances are updated in the next update()
+		 * @param int Key along the x-axis
+		 * @param int Key along the y-axis
+		 * @return False if the cell is outside the grid
+		 */
+		bool setObstacle(int key_x,
+						 int key_y);
+
+		/**
+		 * @brief Removes an obstacle cell. The distances are updated in the next update()
+		 * @param int Key along the x-axis
+		 * @param int Key along the y-axis
+		 */
+		void removeObstacle(int key_x,
+							int key_y);
+
+		/** @brief Propagates the pending changes of obstacles */
+		void update();
+
+		/**
+		 * @brief Gets the signed distance of a cell, which is the maximum distance outside the
+		 * grid
+		 * @param int Key along the x-axis
+		 * @param int Key along the y-axis
+		 * @return Signed distance (in cells)
+		 */
+		double getDistance(int key_x,
+						   int key_y) const;
+
+		/**
+		 * @brief Indicates if a cell is inside the grid
+		 * @param int Key along the x-axis
+		 * @param int Key along the y-axis
+		 * @return True if the cell is inside the grid
+		 */
+		inline bool isInside(int key_x,
+							 int key_y) const
+		{
+			return key_x >= origin_x_ && key_y >= origin_y_ &&
+					key_x < origin_x_ + (int) width_ && key_y < origin_y_ + (int) height_;
+		}
+
+		/** @brief Indicates if the grid has cells */
+		bool isEnabled() const;
+
+		/** @brief Gets the maximum distance (in cells) */
+		unsigned int getMaximumDistance() const;
+
+
+	private:
+		/** @brief Value of the cells without closest seed */
+		static const int NO_SEED = -1;
+
+		/**
+		 * @struct DistanceLayer
+		 * @brief Truncated distance field of one side, i.e. the seeds are the obstacle cells
+		 * for the free side, and the free cells for the obstacle side
+		 */
+		struct DistanceLayer
+		{
+			std::vector<int> squared_distance;
+			std::vector<int> closest_seed;
+			std::vector<char> to_raise;
+			std::priority_queue<std::pair<int,unsigned int>,
+								std::vector<std::pair<int,unsigned int> >,
+								std::greater<std::pair<int,unsigned int> > > open;
+			bool obstacle_seeds;
+		};
+
+		/**
+		 * @brief Sets a seed of a layer
+		 * @param DistanceLayer& Distance layer
+		 * @param unsigned int Cell index
+		 */
+		void setSeed(DistanceLayer& layer,
+					 unsigned int index);
+
+		/**
+		 * @brief Removes a seed of a layer
+		 * @param DistanceLayer& Distance layer
+		 * @param unsigned int Cell index
+		 */
+		void removeSeed(DistanceLayer& layer,
+						unsigned int index);
+
+		/**
+		 * @brief Propagates the pending changes of a layer
+		 * @param DistanceLayer& Distance layer
+		 */
+		void updateLayer(DistanceLayer& layer);
+
+		/**
+		 * @brief Indicates if a cell is a seed of a layer
+		 * @param const DistanceLayer& Distance layer
+		 * @param unsigned int Cell index
+		 */
+		inline bool isSeed(const DistanceLayer& layer,
+						   unsigned int index) const
+		{
+			return (obstacles_[index] != 0) == layer.obstacle_seeds;
+		}
+
+		/** @brief Distance layers of the free and obstacle cells */
+		DistanceLayer free_layer_;
+		DistanceLayer obstacle_layer_;
+
+		/** @brief Indicates if each cell is an obstacle */
+		std::vector<char> obstacles_;
+
+		/** @brief Minimum key of the grid */
+		int origin_x_;
+		int origin_y_;
+
+		/** @brief Size of the grid */
+		unsigned int width_;
+		unsigned int height_;
+
+		/** @brief Maximum distance (in cells) and its squared value */
+		unsigned int max_distance_;
+		int max_squared_distance_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
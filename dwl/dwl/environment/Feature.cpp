@@ -52,6 +52,38 @@ void Feature::computeCost(double& cost_value,
 }
 
 
+void Feature::computeCost(std::vector<double>& cost_values,
+						  const TerrainGrid& grid,
+						  unsigned int min_row,
+						  unsigned int max_row)
+{
+	SpaceDiscretization grid_model(grid.resolution);
+	Terrain terrain_info;
+	terrain_info.resolution = grid.resolution;
+	terrain_info.min_height = 0.;
+	for (unsigned int row = min_row; row < max_row; ++row) {
+		for (unsigned int col = 0; col < grid.width; ++col) {
+			unsigned int index = row * grid.width + col;
+			if (!grid.valid[index]) {
+				cost_values[index] = 0.;
+				continue;
+			}
+
+			// Getting the terrain information of the cell
+			Key key(grid.origin.x + col, grid.origin.y + row, 0);
+			grid_model.keyToCoord(terrain_info.position(rbd::X), key.x, true);
+			grid_model.keyToCoord(terrain_info.position(rbd::Y), key.y, true);
+			terrain_info.position(rbd::Z) = grid.heights[index];
+			terrain_info.surface_normal << grid.normal_x[index], grid.normal_y[index],
+					grid.normal_z[index];
+			terrain_info.curvature = grid.curvatures[index];
+
+			computeCost(cost_values[index], terrain_info);
+		}
+	}
+}
+
+
 void Feature::setWeight(double weight)
 {
 	weight_ = weight;
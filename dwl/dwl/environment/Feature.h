@@ -43,13 +43,31 @@ class Feature
 
 		/**
 		 * @brief Abstract method to compute the cost value according some robot
-		 * and terrain information
+		 * and terrain information. The lattice-based body adjacency could call it concurrently
+		 * for the actions of an expansion (see LatticeBasedBodyAdjacency::setNumberOfThreads),
+		 * so it has to be reentrant, i.e. it can't modify the feature or other shared state
 		 * @param double& Reference of the reward variable
 		 * @param const RobotAndTerrain& Information of the robot and terrain
 		 */
 		virtual void computeCost(double& cost_value,
 								 const RobotAndTerrain& info);
 
+		/**
+		 * @brief Computes the cost values of the rows of a terrain grid. The default
+		 * implementation evaluates each valid cell by computeCost(double&, const Terrain&),
+		 * and the terrain features override it for evaluating the contiguous layers of the
+		 * grid. The rows could be evaluated concurrently, so it has to write only the costs
+		 * of its rows
+		 * @param std::vector<double>& Cost values of the grid cells (row-major)
+		 * @param const TerrainGrid& Terrain grid
+		 * @param unsigned int First row
+		 * @param unsigned int Last row (excluded)
+		 */
+		virtual void computeCost(std::vector<double>& cost_values,
+								 const TerrainGrid& grid,
+								 unsigned int min_row,
+								 unsigned int max_row);
+
 		/**
 		 * @brief Sets the weight of the feature
 		 * @param double Weight of the feature
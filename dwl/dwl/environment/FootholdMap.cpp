@@ -0,0 +1,462 @@
+#include <dwl/environment/FootholdMap.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+FootholdMap::FootholdMap() : robot_(NULL), table_robot_(NULL), table_plane_resolution_(0.),
+		table_angular_resolution_(0.), space_discretization_(std::numeric_limits<double>::max()),
+		width_(0), height_(0), revision_(0), is_updated_(false), cost_weight_(1.),
+		slope_weight_(1.), roughness_weight_(1.), edge_weight_(1.), max_slope_(0.5),
+		max_roughness_(0.05), edge_distance_(0.1), step_height_(0.05), half_size_(1)
+{
+
+}
+
+
+FootholdMap::~FootholdMap()
+{
+
+}
+
+
+void FootholdMap::setRobot(robot::Robot* robot)
+{
+	robot_ = robot;
+
+	// Building again the reachable cells in the next update, because the search areas of the
+	// robot could change without changing its pointer
+	reachable_cells_.clear();
+	table_robot_ = NULL;
+}
+
+
+void FootholdMap::setWeights(double cost_weight,
+							 double slope_weight,
+							 double roughness_weight,
+							 double edge_weight)
+{
+	cost_weight_ = cost_weight;
+	slope_weight_ = slope_weight;
+	roughness_weight_ = roughness_weight;
+	edge_weight_ = edge_weight;
+	is_updated_ = false;
+}
+
+
+void FootholdMap::setMaximumSlope(double max_slope)
+{
+	max_slope_ = max_slope;
+	is_updated_ = false;
+}
+
+
+void FootholdMap::setMaximumRoughness(double max_roughness)
+{
+	max_roughness_ = max_roughness;
+	is_updated_ = false;
+}
+
+
+void FootholdMap::setEdgeDistance(double edge_distance)
+{
+	edge_distance_ = edge_distance;
+	is_updated_ = false;
+}
+
+
+void FootholdMap::setStepHeight(double step_height)
+{
+	step_height_ = step_height;
+	is_updated_ = false;
+}
+
+
+void FootholdMap::setWindowSize(unsigned int half_size)
+{
+	half_size_ = half_size;
+	is_updated_ = false;
+}
+
+
+void FootholdMap::setNumberOfThreads(unsigned int num_threads)
+{
+	workers_.setNumberOfThreads(num_threads);
+}
+
+
+bool FootholdMap::update(const TerrainMap& terrain)
+{
+	buildReachabilityTables(terrain);
+	if (is_updated_ && revision_ == terrain.getRevision())
+		return width_ != 0 && height_ != 0;
+
+	// Updating only the dirty region if it's known and inside the grid. Otherwise all the
+	// layers are built again
+	DirtyRegion region;
+	double resolution = terrain.getTerrainSpaceModel().getEnvironmentResolution(true);
+	if (is_updated_ && width_ != 0 && height_ != 0 &&
+			resolution == space_discretization_.getEnvironmentResolution(true) &&
+			terrain.getDirtyRegion(region, revision_) &&
+			(region.cells.empty() ||
+					(region.min_key.x >= origin_.x && region.min_key.y >= origin_.y &&
+					region.max_key.x < origin_.x + width_ &&
+					region.max_key.y < origin_.y + height_)))
+		updateRegion(terrain, region);
+	else
+		build(terrain);
+
+	revision_ = terrain.getRevision();
+	is_updated_ = true;
+
+	return width_ != 0 && height_ != 0;
+}
+
+
+Weight FootholdMap::getScore(const Vertex& vertex) const
+{
+	Key key;
+	unsigned int index;
+	space_discretization_.vertexToKey(key, vertex, true);
+	if (!getIndex(index, key.x, key.y))
+		return std::numeric_limits<Weight>::max();
+
+	return scores_[index];
+}
+
+
+bool FootholdMap::getReachableFootholds(std::vector<Vertex>& footholds,
+										unsigned int leg_id,
+										const Eigen::Vector3d& body_state) const
+{
+	footholds.clear();
+	std::map<unsigned int, std::vector<std::vector<CellOffset> > >::const_iterator leg_it =
+			reachable_cells_.find(leg_id);
+	if (leg_it == reachable_cells_.end())
+		return false;
+
+	Key body_key, key;
+	Vertex key_vertex;
+	space_discretization_.coordToKey(body_key.x, body_state(0), true);
+	space_discretization_.coordToKey(body_key.y, body_state(1), true);
+	const std::vector<CellOffset>& cells = leg_it->second[getHeadingIndex(body_state(2))];
+	for (unsigned int i = 0; i < cells.size(); i++) {
+		int key_x = body_key.x + cells[i].first;
+		int key_y = body_key.y + cells[i].second;
+		unsigned int index;
+		if (getIndex(index, key_x, key_y) &&
+				scores_[index] != std::numeric_limits<Weight>::max()) {
+			key.x = key_x;
+			key.y = key_y;
+			space_discretization_.keyToVertex(key_vertex, key, true);
+			footholds.push_back(key_vertex);
+		}
+	}
+
+	return true;
+}
+
+
+bool FootholdMap::getBestFoothold(Vertex& foothold,
+								  Weight& score,
+								  unsigned int leg_id,
+								  const Eigen::Vector3d& body_state) const
+{
+	score = std::numeric_limits<Weight>::max();
+	std::map<unsigned int, std::vector<std::vector<CellOffset> > >::const_iterator leg_it =
+			reachable_cells_.find(leg_id);
+	if (leg_it == reachable_cells_.end())
+		return false;
+
+	Key body_key, key;
+	space_discretization_.coordToKey(body_key.x, body_state(0), true);
+	space_discretization_.coordToKey(body_key.y, body_state(1), true);
+	const std::vector<CellOffset>& cells = leg_it->second[getHeadingIndex(body_state(2))];
+	for (unsigned int i = 0; i < cells.size(); i++) {
+		int key_x = body_key.x + cells[i].first;
+		int key_y = body_key.y + cells[i].second;
+		unsigned int index;
+		if (getIndex(index, key_x, key_y) && scores_[index] < score) {
+			score = scores_[index];
+			key.x = key_x;
+			key.y = key_y;
+			space_discretization_.keyToVertex(foothold, key, true);
+		}
+	}
+
+	return score != std::numeric_limits<Weight>::max();
+}
+
+
+unsigned long FootholdMap::getRevision() const
+{
+	return revision_;
+}
+
+
+void FootholdMap::build(const TerrainMap& terrain)
+{
+	const SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	space_discretization_.setEnvironmentResolution(space_model.getEnvironmentResolution(true),
+												   true);
+	space_discretization_.setEnvironmentResolution(space_model.getEnvironmentResolution(false),
+												   false);
+
+	// Getting the bounding box of the terrain cells
+	const TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	Key key, min_key(std::numeric_limits<unsigned short int>::max(),
+					 std::numeric_limits<unsigned short int>::max(), 0), max_key;
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		space_model.vertexToKey(key, cell_it->first, true);
+		min_key.x = std::min(min_key.x, key.x);
+		min_key.y = std::min(min_key.y, key.y);
+		max_key.x = std::max(max_key.x, key.x);
+		max_key.y = std::max(max_key.y, key.y);
+	}
+
+	origin_ = min_key;
+	width_ = terrain_map.empty() ? 0 : max_key.x - min_key.x + 1;
+	height_ = terrain_map.empty() ? 0 : max_key.y - min_key.y + 1;
+	unsigned int num_cells = width_ * height_;
+	heights_.assign(num_cells, 0.);
+	costs_.assign(num_cells, 0.);
+	normal_z_.assign(num_cells, 1.);
+	valid_.assign(num_cells, 0);
+	scores_.assign(num_cells, std::numeric_limits<Weight>::max());
+
+	// Copying the terrain cells into the layers
+	unsigned int index;
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		const TerrainCell& cell = cell_it->second;
+		space_model.vertexToKey(key, cell_it->first, true);
+		getIndex(index, key.x, key.y);
+		space_model.keyToCoord(heights_[index], cell.key.z, false);
+		costs_[index] = cell.cost;
+		normal_z_[index] = cell.normal(rbd::Z);
+		valid_[index] = 1;
+	}
+
+	// Computing the distances to the edges
+	double resolution = space_model.getEnvironmentResolution(true);
+	edge_field_.setMaximumDistance(std::max((int) ceil(edge_distance_ / resolution), 1));
+	edge_field_.resize(origin_.x, origin_.y, width_, height_);
+	for (unsigned int row = 0; row < height_; row++) {
+		for (unsigned int col = 0; col < width_; col++)
+			updateEdge(col, row);
+	}
+	edge_field_.update();
+
+	if (num_cells != 0)
+		computeScores(0, width_ - 1, 0, height_ - 1);
+}
+
+
+void FootholdMap::updateRegion(const TerrainMap& terrain,
+							   const DirtyRegion& region)
+{
+	if (region.cells.empty())
+		return;
+
+	// Updating the layers of the dirty cells
+	const SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	Key key;
+	unsigned int index;
+	for (std::unordered_set<Vertex>::const_iterator cell_it = region.cells.begin();
+			cell_it != region.cells.end(); ++cell_it) {
+		space_model.vertexToKey(key, *cell_it, true);
+		getIndex(index, key.x, key.y);
+		const TerrainCell* cell = terrain.findTerrainCell(*cell_it);
+		if (cell == NULL)
+			valid_[index] = 0;
+		else {
+			space_model.keyToCoord(heights_[index], cell->key.z, false);
+			costs_[index] = cell->cost;
+			normal_z_[index] = cell->normal(rbd::Z);
+			valid_[index] = 1;
+		}
+	}
+
+	// Updating the edges of the dirty cells and their 4-neighbors, since a step depends on both
+	// cells
+	for (std::unordered_set<Vertex>::const_iterator cell_it = region.cells.begin();
+			cell_it != region.cells.end(); ++cell_it) {
+		space_model.vertexToKey(key, *cell_it, true);
+		unsigned int col = key.x - origin_.x;
+		unsigned int row = key.y - origin_.y;
+		updateEdge(col, row);
+		if (col > 0)
+			updateEdge(col - 1, row);
+		if (col + 1 < width_)
+			updateEdge(col + 1, row);
+		if (row > 0)
+			updateEdge(col, row - 1);
+		if (row + 1 < height_)
+			updateEdge(col, row + 1);
+	}
+	edge_field_.update();
+
+	// The scores change inside the window and the truncated edge distance of the changed cells
+	unsigned int margin = std::max(half_size_, edge_field_.getMaximumDistance()) + 1;
+	unsigned int min_col = region.min_key.x - origin_.x;
+	unsigned int min_row = region.min_key.y - origin_.y;
+	unsigned int max_col = region.max_key.x - origin_.x;
+	unsigned int max_row = region.max_key.y - origin_.y;
+	computeScores(min_col > margin ? min_col - margin : 0,
+				  std::min(max_col + margin, width_ - 1),
+				  min_row > margin ? min_row - margin : 0,
+				  std::min(max_row + margin, height_ - 1));
+}
+
+
+void FootholdMap::updateEdge(unsigned int col,
+							 unsigned int row)
+{
+	unsigned int index = row * width_ + col;
+	bool is_edge = !valid_[index] || col == 0 || row == 0 ||
+			col + 1 == width_ || row + 1 == height_;
+	if (!is_edge) {
+		unsigned int neighbors[4] = {index - 1, index + 1, index - width_, index + width_};
+		for (unsigned int i = 0; i < 4 && !is_edge; i++) {
+			unsigned int neighbor = neighbors[i];
+			is_edge = valid_[neighbor] && fabs(heights_[neighbor] - heights_[index]) > step_height_;
+		}
+	}
+
+	int key_x = origin_.x + col;
+	int key_y = origin_.y + row;
+	if (is_edge)
+		edge_field_.setObstacle(key_x, key_y);
+	else
+		edge_field_.removeObstacle(key_x, key_y);
+}
+
+
+void FootholdMap::computeScores(unsigned int min_col, unsigned int max_col,
+								unsigned int min_row, unsigned int max_row)
+{
+	double max_edge_distance = edge_field_.getMaximumDistance();
+	unsigned int num_rows = max_row - min_row + 1;
+	unsigned int num_tiles = (num_rows + FOOTHOLD_TILE_ROWS - 1) / FOOTHOLD_TILE_ROWS;
+	workers_.run(num_tiles, [&](unsigned int tile, unsigned int thread_id) {
+		unsigned int first_row = min_row + tile * FOOTHOLD_TILE_ROWS;
+		unsigned int last_row = std::min(first_row + FOOTHOLD_TILE_ROWS - 1, max_row);
+		for (unsigned int row = first_row; row <= last_row; ++row) {
+			for (unsigned int col = min_col; col <= max_col; ++col) {
+				// Discarding the missing cells, the steep cells and the edges
+				unsigned int index = row * width_ + col;
+				scores_[index] = std::numeric_limits<Weight>::max();
+				if (!valid_[index])
+					continue;
+
+				double slope = acos(std::min(normal_z_[index], 1.));
+				if (slope > max_slope_)
+					continue;
+
+				double edge_distance = edge_field_.getDistance(origin_.x + col, origin_.y + row);
+				if (edge_distance <= 0.)
+					continue;
+
+				// Computing the height deviation of the window. The heights are expressed
+				// w.r.t. the cell height, which reduces the round-off errors
+				unsigned int min_y = row > half_size_ ? row - half_size_ : 0;
+				unsigned int max_y = std::min(row + half_size_, height_ - 1);
+				unsigned int min_x = col > half_size_ ? col - half_size_ : 0;
+				unsigned int max_x = std::min(col + half_size_, width_ - 1);
+				double num_points = 0., sum = 0., squared_sum = 0.;
+				for (unsigned int y = min_y; y <= max_y; ++y) {
+					for (unsigned int x = min_x; x <= max_x; ++x) {
+						unsigned int neighbor = y * width_ + x;
+						if (!valid_[neighbor])
+							continue;
+
+						double height = heights_[neighbor] - heights_[index];
+						num_points += 1.;
+						sum += height;
+						squared_sum += height * height;
+					}
+				}
+				double mean = sum / num_points;
+				double roughness = sqrt(std::max(squared_sum / num_points - mean * mean, 0.));
+
+				scores_[index] = cost_weight_ * costs_[index] +
+						slope_weight_ * slope / max_slope_ +
+						roughness_weight_ * std::min(roughness / max_roughness_, 1.) +
+						edge_weight_ * (1. - std::min(edge_distance / max_edge_distance, 1.));
+			}
+		}
+	});
+}
+
+
+void FootholdMap::buildReachabilityTables(const TerrainMap& terrain)
+{
+	const SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	double plane_resolution = space_model.getEnvironmentResolution(true);
+	double angular_resolution = space_model.getStateResolution(false);
+	if (robot_ == NULL || (!reachable_cells_.empty() && table_robot_ == robot_ &&
+			table_plane_resolution_ == plane_resolution &&
+			table_angular_resolution_ == angular_resolution))
+		return;
+
+	reachable_cells_.clear();
+	if (angular_resolution <= 0) {
+		printf(RED_ "Could not build the reachable cells because it was not defined the"
+				" angular resolution\n" COLOR_RESET);
+		return;
+	}
+
+	// Selecting the cells whose center is inside the footstep search area rotated by the yaw
+	// of each heading
+	SearchAreaMap footstep_areas = robot_->getFootstepSearchAreas();
+	unsigned int num_headings = ceil(2 * M_PI / angular_resolution);
+	for (SearchAreaMap::const_iterator area_it = footstep_areas.begin();
+			area_it != footstep_areas.end(); ++area_it) {
+		const SearchArea& area = area_it->second;
+		std::vector<std::vector<CellOffset> >& leg_cells = reachable_cells_[area_it->first];
+		leg_cells.resize(num_headings);
+
+		double radius = std::max(Eigen::Vector2d(area.min_x, area.min_y).norm(),
+								 Eigen::Vector2d(area.max_x, area.max_y).norm());
+		radius = std::max(radius, Eigen::Vector2d(area.min_x, area.max_y).norm());
+		radius = std::max(radius, Eigen::Vector2d(area.max_x, area.min_y).norm());
+		int max_offset = ceil(radius / plane_resolution);
+		for (unsigned int k = 0; k < num_headings; k++) {
+			double yaw;
+			space_model.keyToState(yaw, k, false);
+			double cos_yaw = cos(yaw);
+			double sin_yaw = sin(yaw);
+			for (int dy = -max_offset; dy <= max_offset; dy++) {
+				for (int dx = -max_offset; dx <= max_offset; dx++) {
+					double x = dx * plane_resolution * cos_yaw + dy * plane_resolution * sin_yaw;
+					double y = -dx * plane_resolution * sin_yaw + dy * plane_resolution * cos_yaw;
+					if (x >= area.min_x && x <= area.max_x && y >= area.min_y && y <= area.max_y)
+						leg_cells[k].push_back(CellOffset(dx, dy));
+				}
+			}
+		}
+	}
+
+	table_robot_ = robot_;
+	table_plane_resolution_ = plane_resolution;
+	table_angular_resolution_ = angular_resolution;
+}
+
+
+unsigned int FootholdMap::getHeadingIndex(double yaw) const
+{
+	// The reachable cells are precomputed for multiples of the angular resolution
+	int num_headings = reachable_cells_.begin()->second.size();
+	int index = (int) round(yaw / table_angular_resolution_) % num_headings;
+	if (index < 0)
+		index += num_headings;
+
+	return index;
+}
+
+} //@namespace environment
+} //@namespace dwl
@@ -0,0 +1,266 @@
+#ifndef DWL__ENVIRONMENT__FOOTHOLD_MAP__H
+#define DWL__ENVIRONMENT__FOOTHOLD_MAP__H
+
+#include <dwl/environment/TerrainMap.h>
+#include <dwl/environment/DistanceField.h>
+#include <dwl/robot/Robot.h>
+#include <dwl/utils/WorkerPool.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class FootholdMap
+ * @brief Precomputes the foothold information of a terrain map once per terrain update, so the
+ * contact planners select the footholds by table lookups. Each terrain cell gets a score (lower
+ * is better) from its terrain cost, slope, roughness (height deviation of a squared window) and
+ * distance to the closest edge, i.e. a missing cell or a step. The edge distances are kept in a
+ * distance field, so a terrain update only propagates the changed edges. Furthermore, the cells
+ * of the footstep search area of each leg are precomputed relative to the body per discretized
+ * heading. The heights are the ones of the height keys. The contact planners own a foothold map
+ * (see ContactPlanning::updateFootholdMap), but there isn't a contact planner implementation that
+ * uses it yet
+ */
+class FootholdMap
+{
+	public:
+		/** @brief Constructor function */
+		FootholdMap();
+
+		/** @brief Destructor function */
+		~FootholdMap();
+
+		/**
+		 * @brief Sets the robot whose footstep search areas define the reachable cells. The
+		 * reachable cells are built again in the next update
+		 * @param robot::Robot* Robot
+		 */
+		void setRobot(robot::Robot* robot);
+
+		/**
+		 * @brief Sets the weights of the score terms. The cost is used as it is, and the other
+		 * terms are normalized between 0 and 1
+		 * @param double Weight of the terrain cost
+		 * @param double Weight of the slope
+		 * @param double Weight of the roughness
+		 * @param double Weight of the edge proximity
+		 */
+		void setWeights(double cost_weight,
+						double slope_weight,
+						double roughness_weight,
+						double edge_weight);
+
+		/**
+		 * @brief Sets the maximum slope of a foothold
+		 * @param double Maximum slope (in radians)
+		 */
+		void setMaximumSlope(double max_slope);
+
+		/**
+		 * @brief Sets the roughness that gets the maximum roughness penalty
+		 * @param double Maximum roughness (in meters)
+		 */
+		void setMaximumRoughness(double max_roughness);
+
+		/**
+		 * @brief Sets the distance to the edges in which the footholds are penalized
+		 * @param double Edge distance (in meters)
+		 */
+		void setEdgeDistance(double edge_distance);
+
+		/**
+		 * @brief Sets the height difference between neighboring cells that defines a step
+		 * @param double Step height (in meters)
+		 */
+		void setStepHeight(double step_height);
+
+		/**
+		 * @brief Sets the half size of the roughness window, i.e. the window has
+		 * (2 * half_size + 1)^2 cells
+		 * @param unsigned int Half size of the window (in cells)
+		 */
+		void setWindowSize(unsigned int half_size);
+
+		/**
+		 * @brief Sets the number of threads that evaluate the tiles of rows. Zero uses the
+		 * number of hardware threads
+		 * @param unsigned int Number of threads
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
+		/**
+		 * @brief Updates the foothold information if the terrain changed since the last update.
+		 * Only the dirty region is recomputed if the changes are known and inside the grid
+		 * @param const TerrainMap& Terrain map
+		 * @return True if there is foothold information
+		 */
+		bool update(const TerrainMap& terrain);
+
+		/**
+		 * @brief Gets the score of a terrain cell
+		 * @param const Vertex& Terrain vertex
+		 * @return Score of the cell, which is the maximum value if it isn't a foothold
+		 */
+		Weight getScore(const Vertex& vertex) const;
+
+		/**
+		 * @brief Gets the footholds of a leg that are reachable from a body state
+		 * @param std::vector<Vertex>& Reachable footholds
+		 * @param unsigned int Leg id
+		 * @param const Eigen::Vector3d& Body state (x,y,yaw)
+		 * @return False if there isn't reachability information of the leg
+		 */
+		bool getReachableFootholds(std::vector<Vertex>& footholds,
+								   unsigned int leg_id,
+								   const Eigen::Vector3d& body_state) const;
+
+		/**
+		 * @brief Gets the reachable foothold of a leg with the lowest score
+		 * @param Vertex& Best foothold
+		 * @param Weight& Score of the best foothold
+		 * @param unsigned int Leg id
+		 * @param const Eigen::Vector3d& Body state (x,y,yaw)
+		 * @return True if there is a reachable foothold
+		 */
+		bool getBestFoothold(Vertex& foothold,
+							 Weight& score,
+							 unsigned int leg_id,
+							 const Eigen::Vector3d& body_state) const;
+
+		/** @brief Gets the terrain revision of the last update */
+		unsigned long getRevision() const;
+
+
+	private:
+		/** @brief Number of rows of a tile */
+		static const unsigned int FOOTHOLD_TILE_ROWS = 16;
+
+		/**
+		 * @brief Builds all the layers from the terrain cells
+		 * @param const TerrainMap& Terrain map
+		 */
+		void build(const TerrainMap& terrain);
+
+		/**
+		 * @brief Updates the layers of the dirty cells, and recomputes the scores around them
+		 * @param const TerrainMap& Terrain map
+		 * @param const DirtyRegion& Dirty region
+		 */
+		void updateRegion(const TerrainMap& terrain,
+						  const DirtyRegion& region);
+
+		/**
+		 * @brief Updates the edge of a cell in the distance field. A cell is an edge if it
+		 * isn't a terrain cell or the height difference with a 4-neighbor is bigger than the step
+		 * height. The cells of the border of the grid are edges too
+		 * @param unsigned int Column of the cell
+		 * @param unsigned int Row of the cell
+		 */
+		void updateEdge(unsigned int col,
+						unsigned int row);
+
+		/**
+		 * @brief Computes the scores of the cells of a rectangular region of the grid
+		 * @param unsigned int Minimum column
+		 * @param unsigned int Maximum column
+		 * @param unsigned int Minimum row
+		 * @param unsigned int Maximum row
+		 */
+		void computeScores(unsigned int min_col, unsigned int max_col,
+						   unsigned int min_row, unsigned int max_row);
+
+		/**
+		 * @brief Builds the reachable cells per leg and heading, if they weren't built since the
+		 * robot was set or the resolutions changed
+		 * @param const TerrainMap& Terrain map
+		 */
+		void buildReachabilityTables(const TerrainMap& terrain);
+
+		/**
+		 * @brief Gets the heading index of a yaw angle
+		 * @param double Yaw angle
+		 * @return The heading index
+		 */
+		unsigned int getHeadingIndex(double yaw) const;
+
+		/**
+		 * @brief Gets the grid index of a key
+		 * @param unsigned int& Grid index
+		 * @param int Key along the x-axis
+		 * @param int Key along the y-axis
+		 * @return False if the key is outside the grid
+		 */
+		inline bool getIndex(unsigned int& index,
+							 int key_x,
+							 int key_y) const
+		{
+			int col = key_x - (int) origin_.x;
+			int row = key_y - (int) origin_.y;
+			if (col < 0 || row < 0 || col >= (int) width_ || row >= (int) height_)
+				return false;
+
+			index = row * width_ + col;
+			return true;
+		}
+
+		/** @brief Key offsets of a reachable cell w.r.t. the body cell */
+		typedef std::pair<int,int> CellOffset;
+
+		/** @brief Robot that defines the footstep search areas */
+		robot::Robot* robot_;
+
+		/** @brief Reachable cells per leg id and heading index */
+		std::map<unsigned int, std::vector<std::vector<CellOffset> > > reachable_cells_;
+
+		/** @brief Robot and resolutions used for building the reachable cells */
+		robot::Robot* table_robot_;
+		double table_plane_resolution_;
+		double table_angular_resolution_;
+
+		/** @brief Space discretization of the terrain */
+		SpaceDiscretization space_discretization_;
+
+		/** @brief Minimum key and size of the grid */
+		Key origin_;
+		unsigned int width_;
+		unsigned int height_;
+
+		/** @brief Layers of the grid in row-major order */
+		std::vector<double> heights_;
+		std::vector<Weight> costs_;
+		std::vector<double> normal_z_;
+		std::vector<char> valid_;
+		std::vector<Weight> scores_;
+
+		/** @brief Distances to the closest edge (in cells) */
+		DistanceField edge_field_;
+
+		/** @brief Worker pool for evaluating the tiles */
+		utils::WorkerPool workers_;
+
+		/** @brief Terrain revision of the last update */
+		unsigned long revision_;
+		bool is_updated_;
+
+		/** @brief Weights of the score terms */
+		double cost_weight_;
+		double slope_weight_;
+		double roughness_weight_;
+		double edge_weight_;
+
+		/** @brief Parameters of the score terms */
+		double max_slope_;
+		double max_roughness_;
+		double edge_distance_;
+		double step_height_;
+		unsigned int half_size_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,136 @@
+#include <dwl/environment/HeightDeviationFeature.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+HeightDeviationFeature::HeightDeviationFeature() : max_deviation_(0.1)
+{
+	name_ = "Height Deviation";
+	max_cost_ = 10.;
+	setNeighboringArea(-0.08, 0.08, -0.08, 0.08, 0.04);
+}
+
+
+HeightDeviationFeature::~HeightDeviationFeature()
+{
+
+}
+
+
+void HeightDeviationFeature::setMaximumDeviation(double max_deviation)
+{
+	max_deviation_ = max_deviation;
+}
+
+
+void HeightDeviationFeature::computeCost(double& cost_value,
+										 const Terrain& terrain_info)
+{
+	cost_value = 0.;
+	if (!terrain_info.height_map)
+		return;
+
+	// Computing the average height of the neighboring area
+	SpaceDiscretization space_model(terrain_info.resolution);
+	double height_sum = 0.;
+	unsigned int num_cells = 0;
+	for (double y = neightboring_area_.min_y; y < neightboring_area_.max_y + 0.5 *
+			terrain_info.resolution; y += terrain_info.resolution) {
+		for (double x = neightboring_area_.min_x; x < neightboring_area_.max_x + 0.5 *
+				terrain_info.resolution; x += terrain_info.resolution) {
+			Vertex vertex;
+			space_model.coordToVertex(vertex, Eigen::Vector2d(terrain_info.position(rbd::X) + x,
+															  terrain_info.position(rbd::Y) + y));
+			HeightMap::const_iterator height_it =
+					terrain_info.height_map->find(vertex);
+			if (height_it != terrain_info.height_map->end()) {
+				height_sum += height_it->second;
+				num_cells++;
+			}
+		}
+	}
+
+	if (num_cells != 0) {
+		double deviation = fabs(terrain_info.position(rbd::Z) - height_sum / num_cells);
+		cost_value = max_cost_ * std::min(deviation / max_deviation_, 1.);
+	}
+}
+
+
+void HeightDeviationFeature::computeCost(std::vector<double>& cost_values,
+										 const TerrainGrid& grid,
+										 unsigned int min_row,
+										 unsigned int max_row)
+{
+	// Getting the neighboring area in cells
+	int min_dx = round(neightboring_area_.min_x / grid.resolution);
+	int max_dx = round(neightboring_area_.max_x / grid.resolution);
+	int min_dy = round(neightboring_area_.min_y / grid.resolution);
+	int max_dy = round(neightboring_area_.max_y / grid.resolution);
+	int width = grid.width;
+	if (min_row >= max_row || width == 0)
+		return;
+
+	// Building the integral images of the heights and valid cells of the rows that are
+	// covered by the neighboring areas. They have a row and column of zeros at the beginning
+	int first_row = std::max((int) min_row + min_dy, 0);
+	int last_row = std::min((int) max_row - 1 + max_dy, (int) grid.height - 1);
+	int num_rows = std::max(last_row - first_row + 1, 0);
+	int stride = width + 1;
+	std::vector<double> height_sum((num_rows + 1) * stride, 0.);
+	std::vector<double> count_sum((num_rows + 1) * stride, 0.);
+	for (int r = 0; r < num_rows; ++r) {
+		const double* heights = &grid.heights[(first_row + r) * width];
+		const char* valid = &grid.valid[(first_row + r) * width];
+		const double* upper_height = &height_sum[r * stride];
+		const double* upper_count = &count_sum[r * stride];
+		double* current_height = &height_sum[(r + 1) * stride];
+		double* current_count = &count_sum[(r + 1) * stride];
+		double row_height = 0., row_count = 0.;
+		for (int col = 0; col < width; ++col) {
+			if (valid[col]) {
+				row_height += heights[col];
+				row_count += 1.;
+			}
+			current_height[col + 1] = upper_height[col + 1] + row_height;
+			current_count[col + 1] = upper_count[col + 1] + row_count;
+		}
+	}
+
+	// Computing the cost of each cell from the four corners of its neighboring area
+	double scale = max_cost_ / max_deviation_;
+	for (unsigned int row = min_row; row < max_row; ++row) {
+		int low_row = std::max((int) row + min_dy, first_row) - first_row;
+		int high_row = std::min((int) row + max_dy, last_row) + 1 - first_row;
+		const double* heights = &grid.heights[row * width];
+		double* cost = &cost_values[row * width];
+		for (int col = 0; col < width; ++col) {
+			int low = std::max(col + min_dx, 0);
+			int high = std::min(col + max_dx + 1, width);
+			if (low >= high || low_row >= high_row) {
+				cost[col] = 0.;
+				continue;
+			}
+
+			double area_count = count_sum[high_row * stride + high] -
+					count_sum[high_row * stride + low] - count_sum[low_row * stride + high] +
+					count_sum[low_row * stride + low];
+			if (area_count == 0.)
+				cost[col] = 0.;
+			else {
+				double area_height = height_sum[high_row * stride + high] -
+						height_sum[high_row * stride + low] -
+						height_sum[low_row * stride + high] + height_sum[low_row * stride + low];
+				double deviation = fabs(heights[col] - area_height / area_count);
+				cost[col] = std::min(scale * deviation, max_cost_);
+			}
+		}
+	}
+}
+
+} //@namespace environment
+} //@namespace dwl
@@ -0,0 +1,68 @@
+#ifndef DWL__ENVIRONMENT__HEIGHT_DEVIATION_FEATURE__H
+#define DWL__ENVIRONMENT__HEIGHT_DEVIATION_FEATURE__H
+
+#include <dwl/environment/Feature.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class HeightDeviationFeature
+ * @brief Class for computing the cost of the height deviation of the terrain, i.e. the difference
+ * between the height of a cell and the average height of its neighboring area (see
+ * setNeighboringArea()). The cost increases linearly with the deviation until the maximum
+ * deviation
+ */
+class HeightDeviationFeature : public Feature
+{
+	public:
+		/** @brief Constructor function */
+		HeightDeviationFeature();
+
+		/** @brief Destructor function */
+		~HeightDeviationFeature();
+
+		/**
+		 * @brief Sets the height deviation of the maximum cost
+		 * @param double Maximum height deviation (in meters)
+		 */
+		void setMaximumDeviation(double max_deviation);
+
+		/**
+		 * @brief Computes the height deviation cost of a terrain cell from the height map
+		 * @param double& Cost value
+		 * @param const Terrain& Information about the terrain
+		 */
+		void computeCost(double& cost_value,
+						 const Terrain& terrain_info);
+
+		/**
+		 * @brief Computes the height deviation cost of the rows of a terrain grid. The
+		 * neighboring areas are summed from integral images of the heights and valid cells,
+		 * so the cost of a cell doesn't depend on the size of its area
+		 * @param std::vector<double>& Cost values of the grid cells (row-major)
+		 * @param const TerrainGrid& Terrain grid
+		 * @param unsigned int First row
+		 * @param unsigned int Last row (excluded)
+		 */
+		void computeCost(std::vector<double>& cost_values,
+						 const TerrainGrid& grid,
+						 unsigned int min_row,
+						 unsigned int max_row);
+
+		using Feature::computeCost;
+
+
+	private:
+		/** @brief Height deviation of the maximum cost */
+		double max_deviation_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,187 @@
+#include <dwl/environment/NormalEstimator.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+NormalEstimator::NormalEstimator() : half_size_(2), min_points_(3)
+{
+
+}
+
+
+NormalEstimator::~NormalEstimator()
+{
+
+}
+
+
+void NormalEstimator::setWindowSize(unsigned int half_size)
+{
+	half_size_ = half_size;
+}
+
+
+void NormalEstimator::setMinimumPoints(unsigned int num_points)
+{
+	min_points_ = std::max(num_points, (unsigned int) 3);
+}
+
+
+void NormalEstimator::setNumberOfThreads(unsigned int num_threads)
+{
+	workers_.setNumberOfThreads(num_threads);
+}
+
+
+void NormalEstimator::compute(TerrainGrid& grid)
+{
+	if (grid.width == 0 || grid.height == 0)
+		return;
+
+	computeIntegralImages(grid);
+
+	// Fitting the plane of the window of each cell in tiles of rows. The moments of a window
+	// are the sum of its four corners in the integral images
+	unsigned int stride = (grid.width + 1) * NUM_MOMENTS;
+	unsigned int num_tiles = (grid.height + NORMAL_TILE_ROWS - 1) / NORMAL_TILE_ROWS;
+	workers_.run(num_tiles, [&](unsigned int tile, unsigned int thread_id) {
+		unsigned int max_row = std::min((tile + 1) * NORMAL_TILE_ROWS, grid.height);
+		for (unsigned int row = tile * NORMAL_TILE_ROWS; row < max_row; ++row) {
+			unsigned int min_y = row > half_size_ ? row - half_size_ : 0;
+			unsigned int max_y = std::min(row + half_size_ + 1, grid.height);
+			for (unsigned int col = 0; col < grid.width; ++col) {
+				unsigned int index = row * grid.width + col;
+				if (!grid.valid[index])
+					continue;
+
+				unsigned int min_x = col > half_size_ ? col - half_size_ : 0;
+				unsigned int max_x = std::min(col + half_size_ + 1, grid.width);
+				const double* m11 = &moments_[max_y * stride + max_x * NUM_MOMENTS];
+				const double* m10 = &moments_[max_y * stride + min_x * NUM_MOMENTS];
+				const double* m01 = &moments_[min_y * stride + max_x * NUM_MOMENTS];
+				const double* m00 = &moments_[min_y * stride + min_x * NUM_MOMENTS];
+				double window[NUM_MOMENTS];
+				for (unsigned int i = 0; i < NUM_MOMENTS; ++i)
+					window[i] = m11[i] - m10[i] - m01[i] + m00[i];
+
+				double num_points = window[0];
+				if (num_points < min_points_)
+					continue;
+
+				// Computing the mean and covariance of the window
+				Eigen::Vector3d mean(window[1], window[2], window[3]);
+				mean /= num_points;
+				Eigen::Matrix3d covariance;
+				covariance(0,0) = window[4] / num_points - mean(0) * mean(0);
+				covariance(0,1) = window[5] / num_points - mean(0) * mean(1);
+				covariance(0,2) = window[6] / num_points - mean(0) * mean(2);
+				covariance(1,1) = window[7] / num_points - mean(1) * mean(1);
+				covariance(1,2) = window[8] / num_points - mean(1) * mean(2);
+				covariance(2,2) = window[9] / num_points - mean(2) * mean(2);
+				covariance(1,0) = covariance(0,1);
+				covariance(2,0) = covariance(0,2);
+				covariance(2,1) = covariance(1,2);
+
+				Eigen::Vector3d normal;
+				double curvature;
+				math::solvePlaneParameters(normal, curvature, covariance);
+
+				// The eigenvector has an arbitrary sign, so the normal is oriented upwards
+				if (normal(rbd::Z) < 0.)
+					normal = -normal;
+				grid.normal_x[index] = normal(rbd::X);
+				grid.normal_y[index] = normal(rbd::Y);
+				grid.normal_z[index] = normal(rbd::Z);
+				grid.curvatures[index] = curvature;
+			}
+		}
+	});
+}
+
+
+bool NormalEstimator::compute(TerrainMap& terrain,
+							  const Eigen::Vector2d& min_corner,
+							  const Eigen::Vector2d& max_corner)
+{
+	TerrainGrid grid;
+	terrain.getTerrainGrid(grid, min_corner, max_corner);
+	compute(grid);
+
+	// Writing the changed normals and curvatures into the terrain map
+	const SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	TerrainData terrain_delta;
+	terrain_delta.plane_size = space_model.getEnvironmentResolution(true);
+	terrain_delta.height_size = space_model.getEnvironmentResolution(false);
+	bool is_terrain_cell = false;
+	Key key;
+	Vertex vertex;
+	for (unsigned int row = 0; row < grid.height; ++row) {
+		key.y = grid.origin.y + row;
+		for (unsigned int col = 0; col < grid.width; ++col) {
+			unsigned int index = row * grid.width + col;
+			if (!grid.valid[index])
+				continue;
+
+			is_terrain_cell = true;
+			key.x = grid.origin.x + col;
+			space_model.keyToVertex(vertex, key, true);
+			const TerrainCell* cell = terrain.findTerrainCell(vertex);
+			Eigen::Vector3d normal(grid.normal_x[index],
+								   grid.normal_y[index],
+								   grid.normal_z[index]);
+			if (cell->normal != normal || cell->curvature != grid.curvatures[index]) {
+				terrain_delta.data.push_back(*cell);
+				terrain_delta.data.back().normal = normal;
+				terrain_delta.data.back().curvature = grid.curvatures[index];
+			}
+		}
+	}
+	terrain.updateTerrainMap(terrain_delta);
+
+	return is_terrain_cell;
+}
+
+
+void NormalEstimator::computeIntegralImages(const TerrainGrid& grid)
+{
+	// The first row and column of the integral images are zeros
+	unsigned int stride = (grid.width + 1) * NUM_MOMENTS;
+	moments_.assign((grid.height + 1) * stride, 0.);
+
+	// The points are expressed w.r.t. the origin of the grid, which reduces the round-off
+	// errors of the sums
+	for (unsigned int row = 0; row < grid.height; ++row) {
+		double y = row * grid.resolution;
+		double row_moments[NUM_MOMENTS] = {0.};
+		const double* upper = &moments_[row * stride];
+		double* current = &moments_[(row + 1) * stride];
+		for (unsigned int col = 0; col < grid.width; ++col) {
+			unsigned int index = row * grid.width + col;
+			if (grid.valid[index]) {
+				double x = col * grid.resolution;
+				double z = grid.heights[index];
+				row_moments[0] += 1.;
+				row_moments[1] += x;
+				row_moments[2] += y;
+				row_moments[3] += z;
+				row_moments[4] += x * x;
+				row_moments[5] += x * y;
+				row_moments[6] += x * z;
+				row_moments[7] += y * y;
+				row_moments[8] += y * z;
+				row_moments[9] += z * z;
+			}
+
+			unsigned int offset = (col + 1) * NUM_MOMENTS;
+			for (unsigned int i = 0; i < NUM_MOMENTS; ++i)
+				current[offset + i] = upper[offset + i] + row_moments[i];
+		}
+	}
+}
+
+} //@namespace environment
+} //@namespace dwl
@@ -0,0 +1,104 @@
+#ifndef DWL__ENVIRONMENT__NORMAL_ESTIMATOR__H
+#define DWL__ENVIRONMENT__NORMAL_ESTIMATOR__H
+
+#include <dwl/environment/TerrainMap.h>
+#include <dwl/utils/WorkerPool.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class NormalEstimator
+ * @brief Estimates the surface normal and curvature of every cell of a heightmap by fitting a
+ * plane to the cells of a squared window around it. Instead of collecting the points of each
+ * window, it builds integral images of the point moments (number of points, x, y, z and their
+ * products), so the mean and covariance of any window are obtained from its four corners, i.e.
+ * O(1) per cell regardless of the window size. The plane is solved in closed form (see
+ * math::solvePlaneParameters), and its normal is oriented upwards. The heights are the ones of
+ * the height keys, so a fine height resolution reduces the discretization error of the planes
+ */
+class NormalEstimator
+{
+	public:
+		/** @brief Constructor function */
+		NormalEstimator();
+
+		/** @brief Destructor function */
+		~NormalEstimator();
+
+		/**
+		 * @brief Sets the half size of the window, i.e. the window has (2 * half_size + 1)^2 cells
+		 * @param unsigned int Half size of the window (in cells)
+		 */
+		void setWindowSize(unsigned int half_size);
+
+		/**
+		 * @brief Sets the minimum number of terrain cells of a window for fitting a plane.
+		 * Otherwise the normal and curvature of the cell are kept
+		 * @param unsigned int Minimum number of cells
+		 */
+		void setMinimumPoints(unsigned int num_points);
+
+		/**
+		 * @brief Sets the number of threads that evaluate the tiles of rows. Zero uses the
+		 * number of hardware threads
+		 * @param unsigned int Number of threads
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
+		/**
+		 * @brief Computes the normals and curvatures of all the cells of a terrain grid. Note
+		 * that the windows are clipped to the grid
+		 * @param TerrainGrid& Terrain grid
+		 */
+		void compute(TerrainGrid& grid);
+
+		/**
+		 * @brief Computes the normals and curvatures of the terrain cells of a rectangular
+		 * region, and writes them into the terrain map
+		 * @param TerrainMap& Terrain map
+		 * @param const Eigen::Vector2d& Minimum corner of the region
+		 * @param const Eigen::Vector2d& Maximum corner of the region
+		 * @return True if there were terrain cells in the region
+		 */
+		bool compute(TerrainMap& terrain,
+					 const Eigen::Vector2d& min_corner,
+					 const Eigen::Vector2d& max_corner);
+
+
+	private:
+		/** @brief Number of moments of the integral images, i.e. n, x, y, z, xx, xy, xz, yy, yz
+		 * and zz */
+		static const unsigned int NUM_MOMENTS = 10;
+
+		/** @brief Number of rows of a tile */
+		static const unsigned int NORMAL_TILE_ROWS = 16;
+
+		/**
+		 * @brief Builds the integral images of the point moments of a terrain grid
+		 * @param const TerrainGrid& Terrain grid
+		 */
+		void computeIntegralImages(const TerrainGrid& grid);
+
+		/** @brief Integral images of the moments, interleaved per cell with a row and column of
+		 * zeros at the beginning, i.e. (height + 1) x (width + 1) cells */
+		std::vector<double> moments_;
+
+		/** @brief Worker pool for evaluating the tiles */
+		utils::WorkerPool workers_;
+
+		/** @brief Half size of the window */
+		unsigned int half_size_;
+
+		/** @brief Minimum number of cells for fitting a plane */
+		unsigned int min_points_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
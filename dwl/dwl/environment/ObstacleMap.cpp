@@ -7,6 +7,10 @@ namespace dwl
 namespace environment
 {
 
+const int ObstacleMap::NO_SURFACE;
+const int ObstacleMap::OUT_OF_BOUNDS;
+
+
 ObstacleMap::ObstacleMap() : space_discretization_(0,0), depth_(16), is_added_search_area_(false),
 		interest_radius_x_(std::numeric_limits<double>::max()),
 		interest_radius_y_(std::numeric_limits<double>::max()),
@@ -40,6 +44,8 @@ void ObstacleMap::compute(octomap::OcTree* octomap,
 	}
 
 	double yaw = robot_state(3);
+	double cos_yaw = cos(yaw);
+	double sin_yaw = sin(yaw);
 
 	// Setting the depth of the octomap message according to the resolution
 	double octomap_resolution = octomap->getResolution();
@@ -56,61 +62,101 @@ void ObstacleMap::compute(octomap::OcTree* octomap,
 		boundary_max(0) = search_areas_[n].max_x + robot_state(0);
 		boundary_max(1) = search_areas_[n].max_y + robot_state(1);
 
+		// Getting the coordinates of the columns of the search area
 		double resolution = search_areas_[n].resolution;
-		for (double y = boundary_min(1); y < boundary_max(1); y += resolution) {
-			for (double x = boundary_min(0); x < boundary_max(0); x += resolution) {
-				// Computing the rotated coordinate of the point inside the search area
-				double xr = (x - robot_state(0)) * cos(yaw) - (y - robot_state(1)) * sin(yaw) +
-						robot_state(0);
-				double yr = (x - robot_state(0)) * sin(yaw) + (y - robot_state(1)) * cos(yaw) +
-						robot_state(1);
-
-				// Checking if the cell belongs to dimensions of the map, and also getting the key
-				// of this cell
-				double z = search_areas_[n].max_z + robot_state(2);
-				octomap::OcTreeKey init_key;
-				if (!octomap->coordToKeyChecked(xr, yr, z, depth_, init_key)) {
-					printf(RED_ "Cell out of bounds \n" COLOR_RESET);
-
-					return;
-				}
+		std::vector<double> x_coords, y_coords;
+		for (double y = boundary_min(1); y < boundary_max(1); y += resolution)
+			y_coords.push_back(y);
+		for (double x = boundary_min(0); x < boundary_max(0); x += resolution)
+			x_coords.push_back(x);
+
+		// Computing the range of height keys of the columns, which is the same for all of
+		// them, i.e. from the key of the maximum height to the first key below the minimum
+		// height. Note that the nodes of the depth are visited once
+		double max_z = search_areas_[n].max_z + robot_state(2);
+		double min_z = search_areas_[n].min_z + robot_state(2);
+		octomap::key_type top_key;
+		if (!octomap->coordToKeyChecked(max_z, depth_, top_key)) {
+			printf(RED_ "Cell out of bounds \n" COLOR_RESET);
+			return;
+		}
+		std::vector<octomap::key_type> column_keys;
+		int key_step = 1 << (16 - depth_);
+		for (int key_z = top_key; key_z >= 0; key_z -= key_step) {
+			column_keys.push_back(key_z);
+			if (octomap->keyToCoord((octomap::key_type) key_z, depth_) < min_z)
+				break;
+		}
 
-				// Finding the cell of the surface
-				int r = 0;
-				while (z >= search_areas_[n].min_z + robot_state(2)) {
-					octomap::OcTreeKey heightmap_key;
-					octomap::OcTreeNode* heightmap_node = octomap->search(init_key, depth_);
-					heightmap_key[0] = init_key[0];
-					heightmap_key[1] = init_key[1];
-					heightmap_key[2] = init_key[2] - r;
-
-					heightmap_node = octomap->search(heightmap_key, depth_);
-					octomap::point3d height_point = octomap->keyToCoord(heightmap_key, depth_);
-					z = height_point(2);
-					if (heightmap_node) {
-						// Computation of the heightmap
-						if (octomap->isNodeOccupied(heightmap_node)) {
-							// Setting the obstacle cell sizes
-							Cell obstacle_cell;
-							obstacle_cell.plane_size = space_discretization_.getEnvironmentResolution(true);
-							obstacle_cell.height_size = space_discretization_.getEnvironmentResolution(false);
-
-							// Getting position of the occupied cell
-							Eigen::Vector3d cell_position;
-							cell_position(0) = height_point(0);
-							cell_position(1) = height_point(1);
-							cell_position(2) = height_point(2);
-							space_discretization_.coordToKeyChecked(obstacle_cell.key, cell_position);
-
-							// Adding the obstacle to map
-							addCellToObstacleMap(obstacle_cell);
+		// Finding the surface cell of each column in a flat grid, i.e. the index of its height
+		// key. The rows of the grid are evaluated in tiles
+		unsigned int width = x_coords.size();
+		unsigned int num_rows = y_coords.size();
+		std::vector<int> surface_grid(width * num_rows, NO_SURFACE);
+		unsigned int num_tiles = (num_rows + OBSTACLE_TILE_ROWS - 1) / OBSTACLE_TILE_ROWS;
+		workers_.run(num_tiles, [&](unsigned int tile, unsigned int thread_id) {
+			unsigned int max_row = std::min((tile + 1) * OBSTACLE_TILE_ROWS, num_rows);
+			for (unsigned int row = tile * OBSTACLE_TILE_ROWS; row < max_row; ++row) {
+				double yc = y_coords[row] - robot_state(1);
+				for (unsigned int col = 0; col < width; ++col) {
+					// Computing the rotated coordinate of the point inside the search area
+					double xc = x_coords[col] - robot_state(0);
+					double xr = xc * cos_yaw - yc * sin_yaw + robot_state(0);
+					double yr = xc * sin_yaw + yc * cos_yaw + robot_state(1);
+
+					// Checking if the cell belongs to dimensions of the map, and also getting
+					// the key of this cell
+					octomap::OcTreeKey key;
+					int& surface = surface_grid[row * width + col];
+					if (!octomap->coordToKeyChecked(xr, yr, max_z, depth_, key)) {
+						surface = OUT_OF_BOUNDS;
+						continue;
+					}
 
+					// Finding the cell of the surface
+					for (unsigned int r = 0; r < column_keys.size(); ++r) {
+						key[2] = column_keys[r];
+						octomap::OcTreeNode* node = octomap->search(key, depth_);
+						if (node != NULL && octomap->isNodeOccupied(node)) {
+							surface = r;
 							break;
 						}
 					}
-					r++;
 				}
 			}
+		});
+
+		// Adding the surface cells in the order of the search area
+		for (unsigned int row = 0; row < num_rows; ++row) {
+			for (unsigned int col = 0; col < width; ++col) {
+				int surface = surface_grid[row * width + col];
+				if (surface == NO_SURFACE)
+					continue;
+				else if (surface == OUT_OF_BOUNDS) {
+					printf(RED_ "Cell out of bounds \n" COLOR_RESET);
+					return;
+				}
+
+				// Getting position of the occupied cell
+				double xc = x_coords[col] - robot_state(0);
+				double yc = y_coords[row] - robot_state(1);
+				octomap::OcTreeKey key;
+				octomap->coordToKeyChecked(xc * cos_yaw - yc * sin_yaw + robot_state(0),
+										   xc * sin_yaw + yc * cos_yaw + robot_state(1),
+										   max_z, depth_, key);
+				key[2] = column_keys[surface];
+				octomap::point3d height_point = octomap->keyToCoord(key, depth_);
+
+				// Setting the obstacle cell sizes
+				Cell obstacle_cell;
+				obstacle_cell.plane_size = space_discretization_.getEnvironmentResolution(true);
+				obstacle_cell.height_size = space_discretization_.getEnvironmentResolution(false);
+				Eigen::Vector3d cell_position(height_point(0), height_point(1), height_point(2));
+				space_discretization_.coordToKeyChecked(obstacle_cell.key, cell_position);
+
+				// Adding the obstacle to map
+				addCellToObstacleMap(obstacle_cell);
+			}
 		}
 	}
 
@@ -154,25 +200,28 @@ void ObstacleMap::removeObstacleOutsideInterestRegion(const Eigen::Vector3d& rob
 {
 	// Getting the orientation of the body
 	double yaw = robot_state(2);
+	double cos_yaw = cos(yaw);
+	double sin_yaw = sin(yaw);
 
-	for (std::map<Vertex,Cell>::iterator vertex_iter = obstacle_map_.begin();
-			vertex_iter != obstacle_map_.end();
-			vertex_iter++)
-	{
-		Vertex v = vertex_iter->first;
+	std::map<Vertex,Cell>::iterator vertex_iter = obstacle_map_.begin();
+	while (vertex_iter != obstacle_map_.end()) {
 		Eigen::Vector2d point;
-		space_discretization_.vertexToCoord(point, v);
+		space_discretization_.vertexToCoord(point, vertex_iter->first);
 
+		bool is_outside;
 		double xc = point(0) - robot_state(0);
 		double yc = point(1) - robot_state(1);
-		if (xc * cos(yaw) + yc * sin(yaw) >= 0.0) {
-			if (pow(xc * cos(yaw) + yc * sin(yaw), 2) / pow(interest_radius_y_, 2) +
-					pow(xc * sin(yaw) - yc * cos(yaw), 2) / pow(interest_radius_x_, 2) > 1)
-				obstacle_map_.erase(v);
-		} else {
-			if (pow(xc, 2) + pow(yc, 2) > pow(interest_radius_x_, 2))
-				obstacle_map_.erase(v);
-		}
+		if (xc * cos_yaw + yc * sin_yaw >= 0.0) {
+			is_outside = pow(xc * cos_yaw + yc * sin_yaw, 2) / pow(interest_radius_y_, 2) +
+					pow(xc * sin_yaw - yc * cos_yaw, 2) / pow(interest_radius_x_, 2) > 1;
+		} else
+			is_outside = pow(xc, 2) + pow(yc, 2) > pow(interest_radius_x_, 2);
+
+		// Note that the iterator of the erased vertex is invalidated
+		if (is_outside)
+			vertex_iter = obstacle_map_.erase(vertex_iter);
+		else
+			++vertex_iter;
 	}
 }
 
@@ -185,6 +234,12 @@ void ObstacleMap::addCellToObstacleMap(Cell& cell)
 }
 
 
+void ObstacleMap::setNumberOfThreads(unsigned int num_threads)
+{
+	workers_.setNumberOfThreads(num_threads);
+}
+
+
 void ObstacleMap::setInterestRegion(double radius_x,
 									double radius_y)
 {
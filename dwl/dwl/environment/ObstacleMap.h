@@ -2,6 +2,7 @@
 #define DWL__ENVIRONMENT__OBSTACLE_MAP__H
 
 #include <dwl/environment/SpaceDiscretization.h>
+#include <dwl/utils/WorkerPool.h>
 #include <dwl/utils/utils.h>
 
 #include <octomap/octomap.h>
@@ -30,7 +31,9 @@ class ObstacleMap
 		void reset();
 
 		/**
-		 * @brief Computes the obstacle map according the robot position and model of the terrain
+		 * @brief Computes the obstacle map according the robot position and model of the terrain.
+		 * The columns of the search areas are evaluated in tiles of rows, and each column only
+		 * visits the octomap nodes of the height range of the search area
 		 * @param octomap::OcTree* Octomap model of the environment
 		 * @param const Eigen::Vector4d& robot_state The position of the robot and the yaw angle
 		 */
@@ -64,6 +67,13 @@ class ObstacleMap
 		 */
 		void addCellToObstacleMap(Cell& cell);
 
+		/**
+		 * @brief Sets the number of threads that evaluate the columns of the search areas. Zero
+		 * uses the number of hardware threads
+		 * @param unsigned int Number of threads
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
 		/**
 		 * @brief Sets a interest region
 		 * @param double Radius along the x-axis
@@ -95,6 +105,13 @@ class ObstacleMap
 
 
 	private:
+		/** @brief Values of the surface grid for the columns without surface or out of bounds */
+		static const int NO_SURFACE = -1;
+		static const int OUT_OF_BOUNDS = -2;
+
+		/** @brief Number of rows of the tiles of a search area */
+		static const unsigned int OBSTACLE_TILE_ROWS = 8;
+
 		/** @brief Object of the SpaceDiscretization class for defining the grid routines */
 		SpaceDiscretization space_discretization_;
 
@@ -115,6 +132,9 @@ class ObstacleMap
 
 		/** @brief Resolution of the obstacle map server */
 		double resolution_;
+
+		/** @brief Worker pool for evaluating the tiles of the search areas */
+		utils::WorkerPool workers_;
 };
 
 } //@namespace environment
@@ -0,0 +1,140 @@
+#include <dwl/environment/RollingGrid.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+RollingGrid::RollingGrid() : origin_x_(0), origin_y_(0), width_(0), height_(0)
+{
+
+}
+
+
+RollingGrid::~RollingGrid()
+{
+
+}
+
+
+void RollingGrid::resize(unsigned int width,
+						 unsigned int height)
+{
+	width_ = width;
+	height_ = height;
+
+	unsigned int num_cells = width * height;
+	cost_.assign(num_cells, 0.);
+	height_layer_.assign(num_cells, 0.);
+	normal_.assign(num_cells, Eigen::Vector3d::UnitZ());
+	cell_.assign(num_cells, NULL);
+	valid_.assign(num_cells, 0);
+}
+
+
+void RollingGrid::clear()
+{
+	std::fill(valid_.begin(), valid_.end(), 0);
+}
+
+
+void RollingGrid::moveTo(int origin_x,
+						 int origin_y)
+{
+	int dx = origin_x - origin_x_;
+	int dy = origin_y - origin_y_;
+	if (dx == 0 && dy == 0)
+		return;
+
+	if (std::abs(dx) >= (int) width_ || std::abs(dy) >= (int) height_)
+		clear();
+	else {
+		// The columns and rows that leave the window are reused by the entering keys
+		if (dx > 0) {
+			for (int x = origin_x_; x < origin_x; ++x)
+				clearColumn(x);
+		} else {
+			for (int x = origin_x; x < origin_x_; ++x)
+				clearColumn(x);
+		}
+
+		if (dy > 0) {
+			for (int y = origin_y_; y < origin_y; ++y)
+				clearRow(y);
+		} else {
+			for (int y = origin_y; y < origin_y_; ++y)
+				clearRow(y);
+		}
+	}
+
+	origin_x_ = origin_x;
+	origin_y_ = origin_y;
+}
+
+
+void RollingGrid::setCell(unsigned int index,
+						  const TerrainCell& cell,
+						  double height)
+{
+	cost_[index] = cell.cost;
+	height_layer_[index] = height;
+	normal_[index] = cell.normal;
+	cell_[index] = &cell;
+	valid_[index] = 1;
+}
+
+
+void RollingGrid::clearCell(unsigned int index)
+{
+	valid_[index] = 0;
+}
+
+
+bool RollingGrid::isEnabled() const
+{
+	return width_ != 0 && height_ != 0;
+}
+
+
+int RollingGrid::getOriginX() const
+{
+	return origin_x_;
+}
+
+
+int RollingGrid::getOriginY() const
+{
+	return origin_y_;
+}
+
+
+unsigned int RollingGrid::getWidth() const
+{
+	return width_;
+}
+
+
+unsigned int RollingGrid::getHeight() const
+{
+	return height_;
+}
+
+
+void RollingGrid::clearColumn(int key_x)
+{
+	unsigned int column = key_x % width_;
+	for (unsigned int row = 0; row < height_; ++row)
+		valid_[row * width_ + column] = 0;
+}
+
+
+void RollingGrid::clearRow(int key_y)
+{
+	unsigned int row = (key_y % height_) * width_;
+	std::fill(valid_.begin() + row, valid_.begin() + row + width_, 0);
+}
+
+} //@namespace environment
+} //@namespace dwl
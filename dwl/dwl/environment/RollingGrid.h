@@ -0,0 +1,173 @@
+#ifndef DWL__ENVIRONMENT__ROLLING_GRID__H
+#define DWL__ENVIRONMENT__ROLLING_GRID__H
+
+#include <dwl/utils/utils.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class RollingGrid
+ * @brief Robot-centric 2d grid of terrain cells with O(1) indexed access. The grid is a window of
+ * plane keys that is stored as a ring buffer, i.e. a key is stored in the cell given by the key
+ * modulo the window size. So, moving the window doesn't copy the cells, it only clears the rows
+ * and columns that leave the window, which are reused by the keys that enter. The cost, height and
+ * normal of the cells are stored in separate contiguous layers, together with a pointer to the
+ * terrain cell, which has to be valid while it's set in the window
+ */
+class RollingGrid
+{
+	public:
+		/** @brief Constructor function */
+		RollingGrid();
+
+		/** @brief Destructor function */
+		~RollingGrid();
+
+		/**
+		 * @brief Resizes the window, which clears all the cells
+		 * @param unsigned int Number of cells along the x-axis
+		 * @param unsigned int Number of cells along the y-axis
+		 */
+		void resize(unsigned int width,
+					unsigned int height);
+
+		/** @brief Clears all the cells */
+		void clear();
+
+		/**
+		 * @brief Moves the window to a new origin, i.e. its minimum key. The rows and columns
+		 * that leave the window are cleared
+		 * @param int Minimum key along the x-axis
+		 * @param int Minimum key along the y-axis
+		 */
+		void moveTo(int origin_x,
+					int origin_y);
+
+		/**
+		 * @brief Gets the index of a plane key
+		 * @param unsigned int& Cell index
+		 * @param int Key along the x-axis
+		 * @param int Key along the y-axis
+		 * @return True if the key is inside the window
+		 */
+		inline bool getIndex(unsigned int& index,
+							 int key_x,
+							 int key_y) const
+		{
+			int x = key_x - origin_x_;
+			int y = key_y - origin_y_;
+			if (x < 0 || y < 0 || x >= (int) width_ || y >= (int) height_)
+				return false;
+
+			index = (key_y % height_) * width_ + key_x % width_;
+			return true;
+		}
+
+		/**
+		 * @brief Sets the values of a cell
+		 * @param unsigned int Cell index
+		 * @param const TerrainCell& Values of the cell, which is referenced by the window
+		 * @param double Height of the cell, i.e. the coordinate of its height key
+		 */
+		void setCell(unsigned int index,
+					 const TerrainCell& cell,
+					 double height);
+
+		/**
+		 * @brief Clears a cell
+		 * @param unsigned int Cell index
+		 */
+		void clearCell(unsigned int index);
+
+		/** @brief Indicates if there is terrain information in the cell */
+		inline bool isValid(unsigned int index) const
+		{
+			return valid_[index] != 0;
+		}
+
+		/** @brief Gets the cost of the cell */
+		inline const Weight& getCost(unsigned int index) const
+		{
+			return cost_[index];
+		}
+
+		/** @brief Gets the height of the cell */
+		inline double getHeight(unsigned int index) const
+		{
+			return height_layer_[index];
+		}
+
+		/** @brief Gets the normal of the cell */
+		inline const Eigen::Vector3d& getNormal(unsigned int index) const
+		{
+			return normal_[index];
+		}
+
+		/** @brief Gets the terrain cell, or NULL if there isn't terrain information */
+		inline const TerrainCell* getCell(unsigned int index) const
+		{
+			return valid_[index] != 0 ? cell_[index] : NULL;
+		}
+
+		/** @brief Indicates if the window has cells */
+		bool isEnabled() const;
+
+		/** @brief Gets the minimum key of the window along the x-axis */
+		int getOriginX() const;
+
+		/** @brief Gets the minimum key of the window along the y-axis */
+		int getOriginY() const;
+
+		/** @brief Gets the number of cells along the x-axis */
+		unsigned int getWidth() const;
+
+		/** @brief Gets the number of cells along the y-axis */
+		unsigned int getHeight() const;
+
+
+	private:
+		/**
+		 * @brief Clears the cells of a column of the ring buffer
+		 * @param int Key along the x-axis
+		 */
+		void clearColumn(int key_x);
+
+		/**
+		 * @brief Clears the cells of a row of the ring buffer
+		 * @param int Key along the y-axis
+		 */
+		void clearRow(int key_y);
+
+		/** @brief Cost layer */
+		std::vector<Weight> cost_;
+
+		/** @brief Height layer */
+		std::vector<double> height_layer_;
+
+		/** @brief Normal layer */
+		std::vector<Eigen::Vector3d> normal_;
+
+		/** @brief Terrain cells referenced by the window */
+		std::vector<const TerrainCell*> cell_;
+
+		/** @brief Indicates if there is terrain information in each cell */
+		std::vector<char> valid_;
+
+		/** @brief Minimum key of the window */
+		int origin_x_;
+		int origin_y_;
+
+		/** @brief Size of the window */
+		unsigned int width_;
+		unsigned int height_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,81 @@
+#include <dwl/environment/SlopeFeature.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+SlopeFeature::SlopeFeature() : flat_threshold_(10. * M_PI / 180.),
+		steep_threshold_(40. * M_PI / 180.)
+{
+	name_ = "Slope";
+	max_cost_ = 10.;
+}
+
+
+SlopeFeature::~SlopeFeature()
+{
+
+}
+
+
+void SlopeFeature::setThresholds(double flat_threshold,
+								 double steep_threshold)
+{
+	if (steep_threshold <= flat_threshold) {
+		printf(YELLOW_ "Warning: the steep threshold should be bigger than the flat"
+				" threshold\n" COLOR_RESET);
+		return;
+	}
+
+	flat_threshold_ = flat_threshold;
+	steep_threshold_ = steep_threshold;
+}
+
+
+void SlopeFeature::computeCost(double& cost_value,
+							   const Terrain& terrain_info)
+{
+	double normal_z = std::min(std::max(terrain_info.surface_normal(rbd::Z), -1.), 1.);
+	cost_value = getSlopeCost(fabs(acos(normal_z)));
+}
+
+
+void SlopeFeature::computeCost(std::vector<double>& cost_values,
+							   const TerrainGrid& grid,
+							   unsigned int min_row,
+							   unsigned int max_row)
+{
+	// The flat and steep cells are classified by the vertical component of the normal, so
+	// the angle is only computed in the cells between both thresholds
+	double flat_normal_z = cos(flat_threshold_);
+	double steep_normal_z = cos(steep_threshold_);
+	unsigned int min_index = min_row * grid.width;
+	unsigned int max_index = max_row * grid.width;
+	const double* normal_z = grid.normal_z.data();
+	double* cost = cost_values.data();
+	for (unsigned int i = min_index; i < max_index; ++i) {
+		if (normal_z[i] >= flat_normal_z)
+			cost[i] = 0.;
+		else if (normal_z[i] <= steep_normal_z)
+			cost[i] = max_cost_;
+		else
+			cost[i] = getSlopeCost(acos(normal_z[i]));
+	}
+}
+
+
+double SlopeFeature::getSlopeCost(double slope) const
+{
+	if (slope <= flat_threshold_)
+		return 0.;
+	else if (slope >= steep_threshold_)
+		return max_cost_;
+	else
+		return max_cost_ * (slope - flat_threshold_) / (steep_threshold_ - flat_threshold_);
+}
+
+} //@namespace environment
+} //@namespace dwl
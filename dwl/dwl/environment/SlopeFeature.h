@@ -0,0 +1,77 @@
+#ifndef DWL__ENVIRONMENT__SLOPE_FEATURE__H
+#define DWL__ENVIRONMENT__SLOPE_FEATURE__H
+
+#include <dwl/environment/Feature.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class SlopeFeature
+ * @brief Class for computing the cost of the slope of the terrain, i.e. the angle between the
+ * surface normal and the vertical. The cost is zero for flat cells, maximum for steep cells, and
+ * it increases linearly with the slope in between
+ */
+class SlopeFeature : public Feature
+{
+	public:
+		/** @brief Constructor function */
+		SlopeFeature();
+
+		/** @brief Destructor function */
+		~SlopeFeature();
+
+		/**
+		 * @brief Sets the slope thresholds
+		 * @param double Maximum slope of the flat cells (in radians)
+		 * @param double Minimum slope of the steep cells (in radians)
+		 */
+		void setThresholds(double flat_threshold,
+						   double steep_threshold);
+
+		/**
+		 * @brief Computes the slope cost of a terrain cell
+		 * @param double& Cost value
+		 * @param const Terrain& Information about the terrain
+		 */
+		void computeCost(double& cost_value,
+						 const Terrain& terrain_info);
+
+		/**
+		 * @brief Computes the slope cost of the rows of a terrain grid
+		 * @param std::vector<double>& Cost values of the grid cells (row-major)
+		 * @param const TerrainGrid& Terrain grid
+		 * @param unsigned int First row
+		 * @param unsigned int Last row (excluded)
+		 */
+		void computeCost(std::vector<double>& cost_values,
+						 const TerrainGrid& grid,
+						 unsigned int min_row,
+						 unsigned int max_row);
+
+		using Feature::computeCost;
+
+
+	private:
+		/**
+		 * @brief Computes the cost of a slope
+		 * @param double Slope (in radians)
+		 * @return The cost value
+		 */
+		double getSlopeCost(double slope) const;
+
+		/** @brief Maximum slope of the flat cells */
+		double flat_threshold_;
+
+		/** @brief Minimum slope of the steep cells */
+		double steep_threshold_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
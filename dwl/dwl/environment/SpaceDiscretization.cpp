@@ -14,9 +14,7 @@ SpaceDiscretization::SpaceDiscretization(double environment_resolution) :
 		position_resolution_(0), angular_resolution_(0),
 		max_key_val_(32768)
 {
-	max_key_count_ = std::numeric_limits<unsigned short int>::max() + 1;
-	max_position_count_ = std::numeric_limits<unsigned short int>::max() + 1;
-	max_angular_count_ = ceil(2 * M_PI / angular_resolution_) + 1;
+
 }
 
 
@@ -28,9 +26,7 @@ SpaceDiscretization::SpaceDiscretization(double environment_resolution,
 		angular_resolution_(0),
 		max_key_val_(32768)
 {
-	max_key_count_ = std::numeric_limits<unsigned short int>::max() + 1;
-	max_position_count_ = std::numeric_limits<unsigned short int>::max() + 1;
-	max_angular_count_ = ceil(2 * M_PI / angular_resolution_) + 1;
+
 }
 
 
@@ -43,9 +39,7 @@ SpaceDiscretization::SpaceDiscretization(double environment_resolution,
 		angular_resolution_(angular_resolution),
 		max_key_val_(32768)
 {
-	max_key_count_ = std::numeric_limits<unsigned short int>::max() + 1;
-	max_position_count_ = std::numeric_limits<unsigned short int>::max() + 1;
-	max_angular_count_ = ceil(2 * M_PI / angular_resolution_) + 1;
+
 }
 
 
@@ -73,81 +67,58 @@ bool SpaceDiscretization::coordToKeyChecked(unsigned short int& key,
 											const double coordinate,
 											bool plane) const
 {
-	// scale to resolution and shift center for tree_max_val
-	unsigned short int scaled_coord;
-	coordToKey(scaled_coord, coordinate, plane);
+	// scale to resolution and shift center for tree_max_val. The range is checked before
+	// converting to key, since the conversion of an out-of-range value is undefined
+	double resolution = plane ? plane_resolution_ : height_resolution_;
+	double scaled_coord = floor(coordinate / resolution) + max_key_val_;
 
 	// keyval within range of tree?
-	if ((scaled_coord >= 0) &&
-			(((unsigned int) scaled_coord) < (2 * max_key_val_))) {
-		key = scaled_coord;
-    	return true;
+	if ((scaled_coord >= 0) && (scaled_coord < 2 * max_key_val_)) {
+		key = (unsigned short int) scaled_coord;
+		return true;
 	}
 
 	return false;
 }
 
 
-void SpaceDiscretization::coordToKey(unsigned short int& key,
-									 const double coordinate,
-									 bool plane) const
+void SpaceDiscretization::coordToVertex(Vertex& vertex,
+										const Eigen::Vector2d& coordinate) const
 {
-	if (plane)
-		key = (unsigned short int) (floor(coordinate / plane_resolution_) + max_key_val_);
-	else
-		key = (unsigned short int) (floor(coordinate / height_resolution_) + max_key_val_);
+	Key key;
+	coordToKeyChecked(key.x, (double) coordinate(rbd::X), true);
+	coordToKeyChecked(key.y, (double) coordinate(rbd::Y), true);
+
+	keyToVertex(vertex, key, true);
 }
 
 
-void SpaceDiscretization::keyToCoord(double& coordinate,
-									 const unsigned short int key,
+void SpaceDiscretization::coordToKey(unsigned short int* keys,
+									 const double* coordinates,
+									 unsigned int num_coords,
 									 bool plane) const
 {
-	if (plane)
-		coordinate = ((key - max_key_val_) + 0.5) * plane_resolution_;
-	else
-		coordinate = ((key - max_key_val_) + 0.5) * height_resolution_;
+	double resolution = plane ? plane_resolution_ : height_resolution_;
+	for (unsigned int i = 0; i < num_coords; ++i)
+		keys[i] = (unsigned short int) (floor(coordinates[i] / resolution) + max_key_val_);
 }
 
 
-void SpaceDiscretization::keyToVertex(Vertex& vertex,
-									  const Key& key,
-									  bool plane) const
+void SpaceDiscretization::coordToVertex(Vertex* vertices,
+										const Eigen::Vector2d* coordinates,
+										unsigned int num_coords) const
 {
-	if (plane)
-		vertex = key.y + max_key_count_ * key.x;
-	else
-		vertex = key.z + max_key_count_ * key.y + max_key_count_ * max_key_count_ * key.x;
-}
+	// The keys are checked as in the single conversion, so both give the same vertexes
+	for (unsigned int i = 0; i < num_coords; ++i) {
+		Key key;
+		coordToKeyChecked(key.x, (double) coordinates[i](rbd::X), true);
+		coordToKeyChecked(key.y, (double) coordinates[i](rbd::Y), true);
 
-
-void SpaceDiscretization::vertexToKey(Key& key,
-									  const Vertex& vertex,
-									  bool plane) const
-{
-	if (plane) {
-		key.x = floor(vertex / max_key_count_);
-		key.y = vertex - max_key_count_ * key.x;
-	} else {
-		key.x = floor(vertex / (max_key_count_ * max_key_count_));
-		key.y = floor(vertex / max_key_count_) - max_key_count_ * key.x;
-		key.z = vertex - max_key_count_ * key.y - max_key_count_ * max_key_count_ * key.x;
+		keyToVertex(vertices[i], key, true);
 	}
 }
 
 
-void SpaceDiscretization::coordToVertex(Vertex& vertex,
-										const Eigen::Vector2d& coordinate) const
-{
-	Key key;
-	Eigen::Vector3d coord;
-	coord << coordinate, 0;
-	coordToKeyChecked(key, coord);
-
-	keyToVertex(vertex, key, true);
-}
-
-
 void SpaceDiscretization::coordToVertex(Vertex& vertex,
 										const Eigen::Vector3d& coordinate) const
 {
@@ -190,115 +161,6 @@ void SpaceDiscretization::vertexToCoord(Eigen::Vector3d& coordinate,
 }
 
 
-void SpaceDiscretization::stateToKey(unsigned short int& key,
-									 double state,
-									 bool position) const
-{
-	if (position) {
-		if (position_resolution_ == 0)
-			printf(RED_ "Could not get the key because it was not defined the"
-					" position resolution\n" COLOR_RESET);
-		else
-			key = (unsigned short int) (floor(state / position_resolution_) + max_key_val_);
-	}
-	else {
-		if (angular_resolution_ == 0)
-			printf(RED_ "Could not get the key because it was not defined the "
-					"angular resolution\n" COLOR_RESET);
-		else {
-			math::normalizeAngle(state, ZeroTo2Pi);
-
-			unsigned short int max_key_yaw_val_ = 0;
-			key = (unsigned short int) (floor(state / angular_resolution_) + max_key_yaw_val_);
-		}
-	}
-}
-
-
-void SpaceDiscretization::keyToState(double& state,
-									 const unsigned short int& key,
-									 bool position) const
-{
-	if (position) {
-		if (position_resolution_ == 0)
-			printf(RED_ "Could not state of the key because it was not defined "
-					"the position resolution\n"	COLOR_RESET);
-		else
-			state = ((double) ((int) key - (int) max_key_val_) + 0.5) * position_resolution_;
-	}
-	else {
-		if (angular_resolution_ == 0)
-			printf(RED_ "Could not the state because it was not defined the "
-					"angular resolution\n"	COLOR_RESET);
-		else {
-			unsigned short int max_key_yaw_val_ = 0;
-			state = ((double) ((int) key - (int) max_key_yaw_val_)) * angular_resolution_;
-		}
-	}
-}
-
-
-void SpaceDiscretization::stateToVertex(Vertex& vertex,
-										const Eigen::Vector2d& state) const
-{
-	// State is defined as (x,y)
-	unsigned short int key_x, key_y;
-	stateToKey(key_x, (double) state(rbd::X), true);
-	stateToKey(key_y, (double) state(rbd::Y), true);
-
-	vertex = (unsigned long int) (key_y + max_position_count_ * key_x);
-}
-
-
-void SpaceDiscretization::stateToVertex(Vertex& vertex,
-										const Eigen::Vector3d& state) const
-{
-	// State is defined as (x,y,yaw)
-	unsigned short int key_x, key_y, key_yaw;
-	stateToKey(key_x, (double) state(rbd::X), true);
-	stateToKey(key_y, (double) state(rbd::Y), true);
-	stateToKey(key_yaw, (double) state(rbd::Z), false);
-
-	vertex = (unsigned long int) key_yaw + max_angular_count_ * key_y +
-			max_angular_count_ * max_position_count_ * key_x;
-}
-
-
-void SpaceDiscretization::vertexToState(Eigen::Vector2d& state,
-										const Vertex& vertex) const
-{
-	unsigned long int max_count = std::numeric_limits<unsigned short int>::max() + 1;
-	unsigned short int key_x = floor(vertex / (max_count));
-	unsigned short int key_y = vertex - max_count * key_x;
-
-	double x, y;
-	keyToState(x, key_x, true);
-	keyToState(y, key_y, true);
-
-	state(rbd::X) = x;
-	state(rbd::Y) = y;
-}
-
-
-void SpaceDiscretization::vertexToState(Eigen::Vector3d& state,
-										const Vertex& vertex) const
-{
-	unsigned short int key_x = floor(vertex / (max_position_count_ * max_angular_count_));
-	unsigned short int key_y = floor(vertex / max_angular_count_) - max_position_count_ * key_x;
-	unsigned short int key_yaw = vertex - max_angular_count_ * key_y -
-			max_angular_count_ * max_position_count_ * key_x;
-
-	double x, y, yaw;
-	keyToState(x, key_x, true);
-	keyToState(y, key_y, true);
-	keyToState(yaw, key_yaw, false);
-
-	state(rbd::X) = x;
-	state(rbd::Y) = y;
-	state(rbd::Z) = yaw;
-}
-
-
 void SpaceDiscretization::stateVertexToEnvironmentVertex(Vertex& environment_vertex,
 														 const Vertex& state_vertex,
 														 TypeOfState state) const
@@ -364,11 +226,15 @@ void SpaceDiscretization::setEnvironmentResolution(double resolution,
 void SpaceDiscretization::setStateResolution(double position_resolution,
 											 double angular_resolution)
 {
+	if (position_resolution == 0) {
+		printf(RED_ "Could not set the state resolution because the position resolution"
+				" is zero\n" COLOR_RESET);
+		return;
+	}
+
 	position_resolution_ = position_resolution;
-	if (angular_resolution != 0) {
+	if (angular_resolution != 0)
 		angular_resolution_ = angular_resolution;
-		max_angular_count_ = ceil(2 * M_PI / angular_resolution_) + 1;
-	}
 }
 
 } //@namespace environment
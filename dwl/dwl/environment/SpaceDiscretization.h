@@ -72,8 +72,25 @@ class SpaceDiscretization
 		 * @param const double Cartesian coordinate of a single axis
 		 * @param bool Indicates if the key represents a plane or a height
 		 */
-		void coordToKey(unsigned short int& key,
-						const double coordinate,
+		inline void coordToKey(unsigned short int& key,
+							   const double coordinate,
+							   bool plane) const
+		{
+			double resolution = plane ? plane_resolution_ : height_resolution_;
+			key = (unsigned short int) (floor(coordinate / resolution) + max_key_val_);
+		}
+
+		/**
+		 * @brief Converts an array of single coordinates into keys. The resolution is selected
+		 * once, so the loop is vectorized by the compiler
+		 * @param unsigned short int* Keys
+		 * @param const double* Cartesian coordinates of a single axis
+		 * @param unsigned int Number of coordinates
+		 * @param bool Indicates if the keys represent a plane or a height
+		 */
+		void coordToKey(unsigned short int* keys,
+						const double* coordinates,
+						unsigned int num_coords,
 						bool plane) const;
 
 		/**
@@ -82,9 +99,13 @@ class SpaceDiscretization
 		 * @param const unsigned short int The value of the key
 		 * @param bool Indicates if the key represents a plane or a height
 		 */
-		void keyToCoord(double& coordinate,
-						const unsigned short int key,
-						bool plane) const;
+		inline void keyToCoord(double& coordinate,
+							   const unsigned short int key,
+							   bool plane) const
+		{
+			double resolution = plane ? plane_resolution_ : height_resolution_;
+			coordinate = ((key - max_key_val_) + 0.5) * resolution;
+		}
 
 		/**
 		 * @brief Converts the key to vertex id
@@ -92,9 +113,15 @@ class SpaceDiscretization
 		 * @param const Key& Key value
 		 * @param bool Indicates if the key represents a plane (2d) or a volume (3d)
 		 */
-		void keyToVertex(Vertex& vertex,
-						 const Key& key,
-						 bool plane) const;
+		inline void keyToVertex(Vertex& vertex,
+								const Key& key,
+								bool plane) const
+		{
+			if (plane)
+				vertex = ((Vertex) key.x << KEY_BITS) | key.y;
+			else
+				vertex = ((Vertex) key.x << (2 * KEY_BITS)) | ((Vertex) key.y << KEY_BITS) | key.z;
+		}
 
 		/**
 		 * @brief Converts the vertex id to key
@@ -102,9 +129,19 @@ class SpaceDiscretization
 		 * @param const Vertex& vertex Vertex id
 		 * @param bool Indicates if the key represents a plane (2d) or a volume (3d)
 		 */
-		void vertexToKey(Key& key,
-						 const Vertex& vertex,
-						 bool plane) const;
+		inline void vertexToKey(Key& key,
+								const Vertex& vertex,
+								bool plane) const
+		{
+			if (plane) {
+				key.x = (vertex >> KEY_BITS) & KEY_MASK;
+				key.y = vertex & KEY_MASK;
+			} else {
+				key.x = (vertex >> (2 * KEY_BITS)) & KEY_MASK;
+				key.y = (vertex >> KEY_BITS) & KEY_MASK;
+				key.z = vertex & KEY_MASK;
+			}
+		}
 
 		/**
 		 * @brief Converts 2d coordinate to vertex id
@@ -114,6 +151,16 @@ class SpaceDiscretization
 		void coordToVertex(Vertex& vertex,
 						   const Eigen::Vector2d& coordinate) const;
 
+		/**
+		 * @brief Converts an array of 2d coordinates to vertex ids
+		 * @param Vertex* Vertex ids
+		 * @param const Eigen::Vector2d* 2D coordinates
+		 * @param unsigned int Number of coordinates
+		 */
+		void coordToVertex(Vertex* vertices,
+						   const Eigen::Vector2d* coordinates,
+						   unsigned int num_coords) const;
+
 		/**
 		 * @brief Converts 3d coordinate to vertex id
 		 * @param Vertex& Vertex
@@ -139,56 +186,127 @@ class SpaceDiscretization
 						   const Vertex& vertex) const;
 
 		/**
-		 * @brief Converts a state into a key
+		 * @brief Converts a state into a key. The resolution of the variable has to be
+		 * defined (see setStateResolution)
 		 * @param unsigned short int& Key
 		 * @param double State value
 		 * @param bool Indicates if it's a position variable, or an angular variable
 		 */
-		void stateToKey(unsigned short int& key,
-						double state,
-						bool position) const;
+		inline void stateToKey(unsigned short int& key,
+							   double state,
+							   bool position) const
+		{
+			if (position) {
+				if (position_resolution_ == 0)
+					printf(RED_ "Could not get the key because it was not defined the"
+							" position resolution\n" COLOR_RESET);
+				else
+					key = (unsigned short int) (floor(state / position_resolution_)
+							+ max_key_val_);
+			} else {
+				if (angular_resolution_ == 0)
+					printf(RED_ "Could not get the key because it was not defined the"
+							" angular resolution\n" COLOR_RESET);
+				else {
+					// The yaw keys don't have offset because the angle is normalized
+					math::normalizeAngle(state, ZeroTo2Pi);
+					key = (unsigned short int) floor(state / angular_resolution_);
+				}
+			}
+		}
 
 		/**
-		 * @brief Converts a key into a state value
+		 * @brief Converts a key into a state value. The resolution of the variable has to be
+		 * defined (see setStateResolution)
 		 * @param double& Single state
 		 * @param const unsigned short int& The value of the key
 		 * @param bool Indicates if it's a position variable, or an angular variable
 		 */
-		void keyToState(double& state,
-						const unsigned short int& key,
-						bool position) const;
+		inline void keyToState(double& state,
+							   const unsigned short int& key,
+							   bool position) const
+		{
+			if (position) {
+				if (position_resolution_ == 0)
+					printf(RED_ "Could not get the state because it was not defined the"
+							" position resolution\n" COLOR_RESET);
+				else
+					state = ((double) ((int) key - (int) max_key_val_) + 0.5)
+							* position_resolution_;
+			} else {
+				if (angular_resolution_ == 0)
+					printf(RED_ "Could not get the state because it was not defined the"
+							" angular resolution\n" COLOR_RESET);
+				else
+					state = (double) key * angular_resolution_;
+			}
+		}
 
 		/**
 		 * @brief Converts state (x,y) to a vertex
 		 * @param Vertex& Vertex id
 		 * @param const Eigen::Vector2d& State
 		 */
-		void stateToVertex(Vertex& vertex,
-						   const Eigen::Vector2d& state) const;
+		inline void stateToVertex(Vertex& vertex,
+								  const Eigen::Vector2d& state) const
+		{
+			unsigned short int key_x, key_y;
+			stateToKey(key_x, (double) state(rbd::X), true);
+			stateToKey(key_y, (double) state(rbd::Y), true);
+
+			vertex = ((Vertex) key_x << KEY_BITS) | key_y;
+		}
 
 		/**
-		 * @brief Converts state (x,y,yaw) to a vertex
+		 * @brief Converts state (x,y,yaw) to a vertex. The keys are packed as the keys of a 3d
+		 * environment vertex, where the yaw key takes the place of the height key
 		 * @param Vertex& Vertex id
 		 * @param const Eigen::Vector3d& State
 		 */
-		void stateToVertex(Vertex& vertex,
-						   const Eigen::Vector3d& state) const;
+		inline void stateToVertex(Vertex& vertex,
+								  const Eigen::Vector3d& state) const
+		{
+			unsigned short int key_x, key_y, key_yaw;
+			stateToKey(key_x, (double) state(rbd::X), true);
+			stateToKey(key_y, (double) state(rbd::Y), true);
+			stateToKey(key_yaw, (double) state(rbd::Z), false);
+
+			vertex = ((Vertex) key_x << (2 * KEY_BITS)) | ((Vertex) key_y << KEY_BITS) | key_yaw;
+		}
 
 		/**
 		 * @brief Converts a vertex to a 2d state (x,y)
 		 * @param Eigen::Vector2d& 2D state
 		 * @param const Vertex Vertex id
 		 */
-		void vertexToState(Eigen::Vector2d& state,
-						   const Vertex& vertex) const;
+		inline void vertexToState(Eigen::Vector2d& state,
+								  const Vertex& vertex) const
+		{
+			double x, y;
+			keyToState(x, (vertex >> KEY_BITS) & KEY_MASK, true);
+			keyToState(y, vertex & KEY_MASK, true);
+
+			state(rbd::X) = x;
+			state(rbd::Y) = y;
+		}
 
 		/**
 		 * @brief Converts a vertex to a 3d state (x,y,yaw)
 		 * @param Eigen::Vector3d& 3D state
 		 * @param const Vertex& Vertex id
 		 */
-		void vertexToState(Eigen::Vector3d& state,
-						   const Vertex& vertex) const;
+		inline void vertexToState(Eigen::Vector3d& state,
+								  const Vertex& vertex) const
+		{
+			double x, y, yaw;
+			keyToState(x, (vertex >> (2 * KEY_BITS)) & KEY_MASK, true);
+			keyToState(y, (vertex >> KEY_BITS) & KEY_MASK, true);
+			keyToState(yaw, vertex & KEY_MASK, false);
+
+			state(rbd::X) = x;
+			state(rbd::Y) = y;
+			state(rbd::Z) = yaw;
+		}
 
 		/**
 		 * @brief Converts a state vertex to an environment vertex
@@ -223,7 +341,8 @@ class SpaceDiscretization
 									  bool plane);
 
 		/**
-		 * @brief Sets the resolution of the state
+		 * @brief Sets the resolution of the state. The state conversions don't check the
+		 * resolutions, so a zero position resolution is rejected here
 		 * @param double Resolution of the position's state
 		 * @param double Resolution of the angular's state
 		 */
@@ -232,6 +351,11 @@ class SpaceDiscretization
 
 
 	private:
+		/** @brief Number of bits of a key, i.e. the keys are packed in the vertex id by
+		 * shifts of this size */
+		static const unsigned int KEY_BITS = 16;
+		static const Vertex KEY_MASK = 0xFFFF;
+
 		/** @brief The resolution of the plane of the environment */
 		double plane_resolution_;  ///< in meters
 
@@ -246,15 +370,6 @@ class SpaceDiscretization
 
 		/** @brief The maximum number of discrete key */
 		const unsigned short int max_key_val_;
-
-		/** @brief Maximum count for key variables */
-		unsigned long int max_key_count_;
-
-		/** @brief Maximum count for position state variables */
-		unsigned long int max_position_count_;
-
-		/** @brief Maximum count for angular state variables */
-		unsigned long int max_angular_count_;
 };
 
 } //@namespace environment
@@ -0,0 +1,122 @@
+#include <dwl/environment/TerrainCostPipeline.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+TerrainCostPipeline::TerrainCostPipeline() : tile_size_(16)
+{
+
+}
+
+
+TerrainCostPipeline::~TerrainCostPipeline()
+{
+
+}
+
+
+void TerrainCostPipeline::addFeature(Feature* feature)
+{
+	double weight;
+	feature->getWeight(weight);
+	printf(GREEN_ "Adding the %s feature with a weight of %f\n" COLOR_RESET,
+			feature->getName().c_str(), weight);
+	features_.push_back(feature);
+	feature_costs_.resize(features_.size());
+}
+
+
+void TerrainCostPipeline::setNumberOfThreads(unsigned int num_threads)
+{
+	workers_.setNumberOfThreads(num_threads);
+}
+
+
+void TerrainCostPipeline::setTileSize(unsigned int num_rows)
+{
+	tile_size_ = std::max(num_rows, (unsigned int) 1);
+}
+
+
+void TerrainCostPipeline::computeCost(std::vector<double>& cost_values,
+									  const TerrainGrid& grid)
+{
+	unsigned int num_cells = grid.width * grid.height;
+	cost_values.assign(num_cells, 0.);
+	for (unsigned int i = 0; i < features_.size(); ++i)
+		feature_costs_[i].resize(num_cells);
+
+	// Evaluating the features in tiles of rows, and summing their weighted costs. Note that
+	// each tile only writes its rows
+	unsigned int num_tiles = (grid.height + tile_size_ - 1) / tile_size_;
+	workers_.run(num_tiles, [&](unsigned int tile, unsigned int thread_id) {
+		unsigned int min_row = tile * tile_size_;
+		unsigned int max_row = std::min(min_row + tile_size_, grid.height);
+		unsigned int min_index = min_row * grid.width;
+		unsigned int max_index = max_row * grid.width;
+		for (unsigned int i = 0; i < features_.size(); ++i) {
+			double weight;
+			features_[i]->getWeight(weight);
+			features_[i]->computeCost(feature_costs_[i], grid, min_row, max_row);
+
+			const double* feature_cost = feature_costs_[i].data();
+			double* cost = cost_values.data();
+			for (unsigned int j = min_index; j < max_index; ++j)
+				cost[j] += weight * feature_cost[j];
+		}
+	});
+}
+
+
+bool TerrainCostPipeline::computeCost(TerrainMap& terrain,
+									  const Eigen::Vector2d& min_corner,
+									  const Eigen::Vector2d& max_corner)
+{
+	if (features_.empty()) {
+		printf(YELLOW_ "Warning: could not compute the terrain cost because there are not"
+				" features\n" COLOR_RESET);
+		return false;
+	}
+
+	TerrainGrid grid;
+	terrain.getTerrainGrid(grid, min_corner, max_corner);
+
+	std::vector<double> cost_values;
+	computeCost(cost_values, grid);
+
+	// Writing the changed costs into the terrain map
+	const SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	TerrainData terrain_delta;
+	terrain_delta.plane_size = space_model.getEnvironmentResolution(true);
+	terrain_delta.height_size = space_model.getEnvironmentResolution(false);
+	bool is_terrain_cell = false;
+	Key key;
+	Vertex vertex;
+	for (unsigned int row = 0; row < grid.height; ++row) {
+		key.y = grid.origin.y + row;
+		for (unsigned int col = 0; col < grid.width; ++col) {
+			unsigned int index = row * grid.width + col;
+			if (!grid.valid[index])
+				continue;
+
+			is_terrain_cell = true;
+			key.x = grid.origin.x + col;
+			space_model.keyToVertex(vertex, key, true);
+			const TerrainCell* cell = terrain.findTerrainCell(vertex);
+			if (cell->cost != cost_values[index]) {
+				terrain_delta.data.push_back(*cell);
+				terrain_delta.data.back().cost = cost_values[index];
+			}
+		}
+	}
+	terrain.updateTerrainMap(terrain_delta);
+
+	return is_terrain_cell;
+}
+
+} //@namespace environment
+} //@namespace dwl
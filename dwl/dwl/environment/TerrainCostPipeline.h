@@ -0,0 +1,89 @@
+#ifndef DWL__ENVIRONMENT__TERRAIN_COST_PIPELINE__H
+#define DWL__ENVIRONMENT__TERRAIN_COST_PIPELINE__H
+
+#include <dwl/environment/TerrainMap.h>
+#include <dwl/environment/Feature.h>
+#include <dwl/utils/WorkerPool.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class TerrainCostPipeline
+ * @brief Computes the terrain cost of a whole region as the weighted sum of the costs of a set of
+ * terrain features. The region is copied into the contiguous layers of a terrain grid, the features
+ * are evaluated over tiles of rows that are distributed in a worker pool, and the costs are written
+ * back into the terrain map as a delta, so only the changed cells are updated
+ */
+class TerrainCostPipeline
+{
+	public:
+		/** @brief Constructor function */
+		TerrainCostPipeline();
+
+		/** @brief Destructor function */
+		~TerrainCostPipeline();
+
+		/**
+		 * @brief Adds a terrain feature. Note that the feature isn't deleted by this class
+		 * @param Feature* Terrain feature
+		 */
+		void addFeature(Feature* feature);
+
+		/**
+		 * @brief Sets the number of threads that evaluate the tiles. Zero uses the number of
+		 * hardware threads
+		 * @param unsigned int Number of threads
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
+		/**
+		 * @brief Sets the number of rows of a tile
+		 * @param unsigned int Number of rows
+		 */
+		void setTileSize(unsigned int num_rows);
+
+		/**
+		 * @brief Computes the weighted cost of the features for all the cells of a terrain grid
+		 * @param std::vector<double>& Cost values of the grid cells (row-major)
+		 * @param const TerrainGrid& Terrain grid
+		 */
+		void computeCost(std::vector<double>& cost_values,
+						 const TerrainGrid& grid);
+
+		/**
+		 * @brief Computes the cost of the terrain cells of a rectangular region, and writes it
+		 * into the terrain map. Note that the neighboring areas of the features are clipped
+		 * to the region
+		 * @param TerrainMap& Terrain map
+		 * @param const Eigen::Vector2d& Minimum corner of the region
+		 * @param const Eigen::Vector2d& Maximum corner of the region
+		 * @return True if there were features and terrain cells in the region
+		 */
+		bool computeCost(TerrainMap& terrain,
+						 const Eigen::Vector2d& min_corner,
+						 const Eigen::Vector2d& max_corner);
+
+
+	private:
+		/** @brief Terrain features */
+		std::vector<Feature*> features_;
+
+		/** @brief Cost values of each feature */
+		std::vector<std::vector<double> > feature_costs_;
+
+		/** @brief Worker pool for evaluating the tiles */
+		utils::WorkerPool workers_;
+
+		/** @brief Number of rows of a tile */
+		unsigned int tile_size_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
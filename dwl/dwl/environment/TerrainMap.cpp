@@ -9,8 +9,10 @@ namespace environment
 
 TerrainMap::TerrainMap() :
 		space_discretization_(0.04, 0.04, M_PI / 200),
-		obstacle_discretization_(0.04, 0.04, M_PI / 200),
-		average_cost_(0.), max_cost_(0.),
+		obstacle_discretization_(0.04, 0.04, M_PI / 200), window_size_(0.),
+		window_center_(Eigen::Vector2d::Zero()), obstacle_max_distance_(0.), revision_(0),
+		dirty_history_size_(64),
+		total_cost_(0.), average_cost_(0.), max_cost_(0.),
 		min_height_(std::numeric_limits<double>::max()),
 		terrain_information_(false), obstacle_information_(false),
 		obstacle_resolution_(0.04)
@@ -31,17 +33,26 @@ TerrainMap::~TerrainMap()
 
 void TerrainMap::reset()
 {
+	std::unordered_set<Vertex> cells;
+	for (TerrainDataMap::const_iterator cell_it = terrain_map_.begin();
+			cell_it != terrain_map_.end(); ++cell_it)
+		cells.insert(cell_it->first);
+
 	terrain_map_.clear();
 	terrain_heightmap_.clear();
+	terrain_window_.clear();
+	terrain_pyramid_.clear();
+	computeCostStatistics();
+	commitUpdate(cells);
 }
 
 
 void TerrainMap::setTerrainMap(const TerrainData& terrain_map)
 {
-	// Cleaning the old information
-	TerrainDataMap empty_terrain_cost_map;
-	terrain_map_.swap(empty_terrain_cost_map);
-	average_cost_ = 0.;
+	// Cleaning the old information. Note that the old terrain map is kept for
+	// computing the changed cells
+	TerrainDataMap old_terrain_map;
+	terrain_map_.swap(old_terrain_map);
 
 	// Storing the terrain data according the vertex id
 	Vertex vertex_2d;
@@ -50,45 +61,76 @@ void TerrainMap::setTerrainMap(const TerrainData& terrain_map)
 		// Setting the resolution
 		setResolution(terrain_map.plane_size, true);
 		setResolution(terrain_map.height_size, false);
+		terrain_map_.reserve(num_cells);
 
 		for (unsigned int i = 0; i < num_cells; i++) {
 			// Building a cost-map for a every 3d vertex
 			space_discretization_.keyToVertex(vertex_2d, terrain_map.data[i].key, true);
-			double cost_value = terrain_map.data[i].cost;
 			terrain_map_[vertex_2d] = terrain_map.data[i];
-
-			// Setting up the maximum cost value
-			if (cost_value > max_cost_)
-				max_cost_ = cost_value;
-
-			average_cost_ += cost_value;
 		}
 
-		// Computing the average cost of the terrain
-		average_cost_ /= num_cells;
-
-		// Setting up the values of the default cell. Note that these values
-		// are used for unperceived cells
-		default_cell_.cost = max_cost_;
 		 // TODO compute the default height from robot state
 		space_discretization_.coordToKey(default_cell_.key.z, 0., false);
-
-		terrain_information_ = true;
 	}
+
+	// Computing the average and maximum cost of the terrain, which also resets them for an
+	// empty terrain. Note that the values of the default cell are used for unperceived cells
+	computeCostStatistics();
+
+	refillTerrainWindow();
+	refillTerrainPyramid();
+	std::unordered_set<Vertex> cells;
+	addChangedCells(cells, old_terrain_map);
+	commitUpdate(cells);
 }
 
 
 void TerrainMap::setTerrainMap(const TerrainDataMap& map)
 {
-	terrain_map_ = map;
+	TerrainDataMap old_terrain_map(map);
+	terrain_map_.swap(old_terrain_map);
+	computeCostStatistics();
+
+	refillTerrainWindow();
+	refillTerrainPyramid();
+	std::unordered_set<Vertex> cells;
+	addChangedCells(cells, old_terrain_map);
+	commitUpdate(cells);
+}
+
+
+void TerrainMap::updateTerrainMap(const TerrainData& terrain_delta,
+								  const std::vector<Vertex>& removed_cells)
+{
+	if (!terrain_delta.data.empty()) {
+		setResolution(terrain_delta.plane_size, true);
+		setResolution(terrain_delta.height_size, false);
+	}
+
+	// Applying only the cells that changed, and updating the cost statistics with them
+	std::unordered_set<Vertex> cells;
+	bool is_max_cost_removed = false;
+	Vertex vertex_2d;
+	for (unsigned int i = 0; i < terrain_delta.data.size(); i++) {
+		if (applyCell(vertex_2d, terrain_delta.data[i], is_max_cost_removed))
+			cells.insert(vertex_2d);
+	}
+
+	for (unsigned int i = 0; i < removed_cells.size(); i++) {
+		if (applyRemovedCell(removed_cells[i], is_max_cost_removed))
+			cells.insert(removed_cells[i]);
+	}
+
+	finishUpdate(cells, is_max_cost_removed);
 }
 
 
 void TerrainMap::setObstacleMap(const std::vector<Cell>& obstacle_map)
 {
-	// Cleaning the old information
-	ObstacleMap empty_terrain_obstacle_map;
-	obstaclemap_.swap(empty_terrain_obstacle_map);
+	// Cleaning the old information. Note that the old obstacle map is kept for
+	// computing the changed cells
+	ObstacleMap old_obstacle_map;
+	obstaclemap_.swap(old_obstacle_map);
 
 	//Storing the obstacle-map data according the vertex id
 	Vertex vertex_2d;
@@ -106,6 +148,11 @@ void TerrainMap::setObstacleMap(const std::vector<Cell>& obstacle_map)
 
 		obstacle_information_ = true;
 	}
+
+	updateObstacleDistanceField(old_obstacle_map);
+	std::unordered_set<Vertex> cells;
+	addChangedObstacles(cells, old_obstacle_map);
+	commitUpdate(cells);
 }
 
 
@@ -123,15 +170,24 @@ void TerrainMap::setTerrainCell(TerrainCell& cell,
 
 void TerrainMap::addCellToTerrainMap(const TerrainCell& cell)
 {
+	std::unordered_set<Vertex> cells;
+	bool is_max_cost_removed = false;
 	Vertex vertex_id;
-	space_discretization_.keyToVertex(vertex_id, cell.key, true);
-	terrain_map_[vertex_id] = cell;
+	if (applyCell(vertex_id, cell, is_max_cost_removed))
+		cells.insert(vertex_id);
+
+	finishUpdate(cells, is_max_cost_removed);
 }
 
 
 void TerrainMap::removeCellToTerrainMap(const Vertex& cell_vertex)
 {
-	terrain_map_.erase(cell_vertex);
+	std::unordered_set<Vertex> cells;
+	bool is_max_cost_removed = false;
+	if (applyRemovedCell(cell_vertex, is_max_cost_removed))
+		cells.insert(cell_vertex);
+
+	finishUpdate(cells, is_max_cost_removed);
 }
 
 
@@ -151,6 +207,182 @@ void TerrainMap::removeCellToTerrainHeightMap(const Vertex& cell_vertex)
 }
 
 
+void TerrainMap::setTerrainWindow(double size)
+{
+	window_size_ = size;
+	refillTerrainWindow();
+}
+
+
+void TerrainMap::moveTerrainWindow(const Eigen::Vector2d& position)
+{
+	window_center_ = position;
+	if (!terrain_window_.isEnabled())
+		return;
+
+	// Computing the new origin of the window
+	int width = terrain_window_.getWidth();
+	int height = terrain_window_.getHeight();
+	int origin_x, origin_y;
+	computeWindowOrigin(origin_x, origin_y, width, height);
+	int dx = origin_x - terrain_window_.getOriginX();
+	int dy = origin_y - terrain_window_.getOriginY();
+	terrain_window_.moveTo(origin_x, origin_y);
+
+	// Filling only the rows and columns that entered the window
+	if (std::abs(dx) >= width || std::abs(dy) >= height)
+		fillTerrainWindow(origin_x, origin_x + width, origin_y, origin_y + height);
+	else {
+		if (dx > 0)
+			fillTerrainWindow(origin_x + width - dx, origin_x + width, origin_y, origin_y + height);
+		else if (dx < 0)
+			fillTerrainWindow(origin_x, origin_x - dx, origin_y, origin_y + height);
+
+		if (dy > 0)
+			fillTerrainWindow(origin_x, origin_x + width, origin_y + height - dy, origin_y + height);
+		else if (dy < 0)
+			fillTerrainWindow(origin_x, origin_x + width, origin_y, origin_y - dy);
+	}
+}
+
+
+const RollingGrid& TerrainMap::getTerrainWindow() const
+{
+	return terrain_window_;
+}
+
+
+void TerrainMap::setTerrainPyramid(unsigned int num_levels)
+{
+	terrain_pyramid_.setNumberOfLevels(num_levels);
+	refillTerrainPyramid();
+}
+
+
+const TerrainPyramid& TerrainMap::getTerrainPyramid() const
+{
+	return terrain_pyramid_;
+}
+
+
+void TerrainMap::setObstacleDistanceField(double max_distance)
+{
+	obstacle_max_distance_ = max_distance;
+	refillObstacleDistanceField();
+}
+
+
+const DistanceField& TerrainMap::getObstacleDistanceField() const
+{
+	return obstacle_distance_field_;
+}
+
+
+double TerrainMap::getObstacleDistance(const Eigen::Vector2d& position) const
+{
+	// Getting the cell centers around the position, i.e. its continuous key is shifted by half
+	// a cell
+	double resolution = obstacle_discretization_.getEnvironmentResolution(true);
+	unsigned short int origin_key;
+	obstacle_discretization_.coordToKey(origin_key, 0., true);
+	double key_x = position(rbd::X) / resolution + origin_key - 0.5;
+	double key_y = position(rbd::Y) / resolution + origin_key - 0.5;
+	int x = floor(key_x);
+	int y = floor(key_y);
+	double tx = key_x - x;
+	double ty = key_y - y;
+
+	double d00 = obstacle_distance_field_.getDistance(x, y);
+	double d10 = obstacle_distance_field_.getDistance(x + 1, y);
+	double d01 = obstacle_distance_field_.getDistance(x, y + 1);
+	double d11 = obstacle_distance_field_.getDistance(x + 1, y + 1);
+	double distance = (1 - ty) * ((1 - tx) * d00 + tx * d10) + ty * ((1 - tx) * d01 + tx * d11);
+
+	return distance * resolution;
+}
+
+
+void TerrainMap::getObstacleGradient(Eigen::Vector2d& gradient,
+									 const Eigen::Vector2d& position) const
+{
+	// Differentiating the bilinear interpolation. Note that the distances and positions have
+	// the same scale
+	double resolution = obstacle_discretization_.getEnvironmentResolution(true);
+	unsigned short int origin_key;
+	obstacle_discretization_.coordToKey(origin_key, 0., true);
+	double key_x = position(rbd::X) / resolution + origin_key - 0.5;
+	double key_y = position(rbd::Y) / resolution + origin_key - 0.5;
+	int x = floor(key_x);
+	int y = floor(key_y);
+	double tx = key_x - x;
+	double ty = key_y - y;
+
+	double d00 = obstacle_distance_field_.getDistance(x, y);
+	double d10 = obstacle_distance_field_.getDistance(x + 1, y);
+	double d01 = obstacle_distance_field_.getDistance(x, y + 1);
+	double d11 = obstacle_distance_field_.getDistance(x + 1, y + 1);
+	gradient(rbd::X) = (1 - ty) * (d10 - d00) + ty * (d11 - d01);
+	gradient(rbd::Y) = (1 - tx) * (d01 - d00) + tx * (d11 - d10);
+}
+
+
+double TerrainMap::getObstacleClearance(const Eigen::Vector2d& position) const
+{
+	unsigned short int key_x, key_y;
+	obstacle_discretization_.coordToKey(key_x, position(rbd::X), true);
+	obstacle_discretization_.coordToKey(key_y, position(rbd::Y), true);
+
+	return obstacle_distance_field_.getDistance(key_x, key_y) *
+			obstacle_discretization_.getEnvironmentResolution(true);
+}
+
+
+bool TerrainMap::getTerrainRegion(TerrainRegion& region,
+								  const Eigen::Vector2d& min_corner,
+								  const Eigen::Vector2d& max_corner) const
+{
+	unsigned short int min_x, min_y, max_x, max_y;
+	space_discretization_.coordToKey(min_x, min_corner(rbd::X), true);
+	space_discretization_.coordToKey(min_y, min_corner(rbd::Y), true);
+	space_discretization_.coordToKey(max_x, max_corner(rbd::X), true);
+	space_discretization_.coordToKey(max_y, max_corner(rbd::Y), true);
+	if (terrain_pyramid_.isEnabled())
+		return terrain_pyramid_.getRegion(region, min_x, max_x, min_y, max_y);
+
+	// Scanning the terrain cells of the region
+	region = TerrainRegion();
+	Key key;
+	Vertex vertex;
+	for (unsigned int x = min_x; x <= max_x; ++x) {
+		key.x = x;
+		for (unsigned int y = min_y; y <= max_y; ++y) {
+			key.y = y;
+			space_discretization_.keyToVertex(vertex, key, true);
+			const TerrainCell* cell = findTerrainCell(vertex);
+			if (cell == NULL)
+				continue;
+
+			double height;
+			space_discretization_.keyToCoord(height, cell->key.z, false);
+			region.min_height = std::min(region.min_height, height);
+			region.max_height = std::max(region.max_height, height);
+			region.mean_height += height;
+			region.min_cost = std::min(region.min_cost, cell->cost);
+			region.max_cost = std::max(region.max_cost, cell->cost);
+			region.mean_cost += cell->cost;
+			++region.num_cells;
+		}
+	}
+
+	if (region.num_cells == 0)
+		return false;
+
+	region.mean_height /= region.num_cells;
+	region.mean_cost /= region.num_cells;
+	return true;
+}
+
+
 double TerrainMap::getResolution(bool plane)
 {
 	return space_discretization_.getEnvironmentResolution(plane);
@@ -166,14 +398,24 @@ double TerrainMap::getObstacleResolution()
 void TerrainMap::setResolution(double resolution,
 							   bool plane)
 {
+	if (space_discretization_.getEnvironmentResolution(plane) == resolution)
+		return;
+
 	space_discretization_.setEnvironmentResolution(resolution, plane);
+	refillTerrainWindow();
+	refillTerrainPyramid();
 }
 
 
 void TerrainMap::setObstacleResolution(double resolution,
 									   bool plane)
 {
+	if (obstacle_discretization_.getEnvironmentResolution(plane) == resolution)
+		return;
+
 	obstacle_discretization_.setEnvironmentResolution(resolution, plane);
+	if (plane)
+		refillObstacleDistanceField();
 }
 
 
@@ -205,11 +447,139 @@ const ObstacleMap& TerrainMap::getObstacleMap() const
 }
 
 
-const TerrainCell& TerrainMap::getTerrainData(const Vertex& vertex) const
+unsigned long TerrainMap::getRevision() const
+{
+	return revision_;
+}
+
+
+bool TerrainMap::getDirtyRegion(DirtyRegion& region,
+								unsigned long revision) const
+{
+	region.cells.clear();
+	region.min_key = Key(std::numeric_limits<unsigned short int>::max(),
+						 std::numeric_limits<unsigned short int>::max(), 0);
+	region.max_key = Key();
+	if (revision >= revision_)
+		return true;
+
+	// The updates after the revision should be in the history
+	if (dirty_history_.empty() || dirty_history_.front().revision > revision + 1)
+		return false;
+
+	for (std::deque<DirtyUpdate>::const_iterator update_it = dirty_history_.begin();
+			update_it != dirty_history_.end(); ++update_it) {
+		if (update_it->revision <= revision)
+			continue;
+
+		region.cells.insert(update_it->cells.begin(), update_it->cells.end());
+	}
+
+	// Computing the bounding box of the dirty cells
+	Key key;
+	for (std::unordered_set<Vertex>::const_iterator cell_it = region.cells.begin();
+			cell_it != region.cells.end(); ++cell_it) {
+		space_discretization_.vertexToKey(key, *cell_it, true);
+		region.min_key.x = std::min(region.min_key.x, key.x);
+		region.min_key.y = std::min(region.min_key.y, key.y);
+		region.max_key.x = std::max(region.max_key.x, key.x);
+		region.max_key.y = std::max(region.max_key.y, key.y);
+	}
+
+	return true;
+}
+
+
+void TerrainMap::setDirtyHistorySize(unsigned int size)
 {
+	dirty_history_size_ = size;
+	while (dirty_history_.size() > dirty_history_size_)
+		dirty_history_.pop_front();
+}
+
+
+bool TerrainMap::isTerrainCell(const Vertex& vertex) const
+{
+	unsigned int index;
+	if (getWindowIndex(index, vertex))
+		return terrain_window_.isValid(index);
+
+	return terrain_map_.find(vertex) != terrain_map_.end();
+}
+
+
+const TerrainCell* TerrainMap::findTerrainCell(const Vertex& vertex) const
+{
+	unsigned int index;
+	if (getWindowIndex(index, vertex))
+		return terrain_window_.getCell(index);
+
 	TerrainDataMap::const_iterator cell_it = terrain_map_.find(vertex);
 	if (cell_it != terrain_map_.end())
-		return cell_it->second;
+		return &cell_it->second;
+	else
+		return NULL;
+}
+
+
+void TerrainMap::getTerrainGrid(TerrainGrid& grid,
+								const Eigen::Vector2d& min_corner,
+								const Eigen::Vector2d& max_corner) const
+{
+	const SpaceDiscretization& space_model = space_discretization_;
+	Key max_key;
+	space_model.coordToKey(grid.origin.x, min_corner(rbd::X), true);
+	space_model.coordToKey(grid.origin.y, min_corner(rbd::Y), true);
+	space_model.coordToKey(max_key.x, max_corner(rbd::X), true);
+	space_model.coordToKey(max_key.y, max_corner(rbd::Y), true);
+	grid.width = max_key.x >= grid.origin.x ? max_key.x - grid.origin.x + 1 : 0;
+	grid.height = max_key.y >= grid.origin.y ? max_key.y - grid.origin.y + 1 : 0;
+	grid.resolution = space_model.getEnvironmentResolution(true);
+
+	unsigned int num_cells = grid.width * grid.height;
+	grid.heights.assign(num_cells, 0.);
+	grid.normal_x.assign(num_cells, 0.);
+	grid.normal_y.assign(num_cells, 0.);
+	grid.normal_z.assign(num_cells, 1.);
+	grid.curvatures.assign(num_cells, 0.);
+	grid.valid.assign(num_cells, 0);
+
+	// Copying the terrain cells into the layers
+	Key key;
+	Vertex vertex;
+	for (unsigned int row = 0; row < grid.height; ++row) {
+		key.y = grid.origin.y + row;
+		for (unsigned int col = 0; col < grid.width; ++col) {
+			key.x = grid.origin.x + col;
+			space_model.keyToVertex(vertex, key, true);
+			const TerrainCell* cell = findTerrainCell(vertex);
+			if (cell == NULL)
+				continue;
+
+			unsigned int index = row * grid.width + col;
+			space_model.keyToCoord(grid.heights[index], cell->key.z, false);
+			grid.normal_x[index] = cell->normal(rbd::X);
+			grid.normal_y[index] = cell->normal(rbd::Y);
+			grid.normal_z[index] = cell->normal(rbd::Z);
+			grid.curvatures[index] = cell->curvature;
+			grid.valid[index] = 1;
+		}
+	}
+}
+
+
+bool TerrainMap::isObstacle(const Vertex& vertex) const
+{
+	ObstacleMap::const_iterator obs_it = obstaclemap_.find(vertex);
+	return obs_it != obstaclemap_.end() && obs_it->second;
+}
+
+
+const TerrainCell& TerrainMap::getTerrainData(const Vertex& vertex) const
+{
+	const TerrainCell* cell = findTerrainCell(vertex);
+	if (cell != NULL)
+		return *cell;
 	else
 		return default_cell_;
 }
@@ -228,9 +598,9 @@ const TerrainCell& TerrainMap::getTerrainData(const Eigen::Vector2d& position) c
 bool TerrainMap::getTerrainData(TerrainCell& cell,
 								const Vertex& vertex) const
 {
-	TerrainDataMap::const_iterator cell_it = terrain_map_.find(vertex);
-	if (cell_it != terrain_map_.end()) {
-		cell = cell_it->second;
+	const TerrainCell* terrain_cell = findTerrainCell(vertex);
+	if (terrain_cell != NULL) {
+		cell = *terrain_cell;
 
 		space_discretization_.keyToCoord(cell.height, cell.key.z, false);
 		return true;
@@ -254,6 +624,10 @@ bool TerrainMap::getTerrainData(TerrainCell& cell,
 
 double TerrainMap::getTerrainHeight(const Vertex& vertex) const
 {
+	unsigned int index;
+	if (getWindowIndex(index, vertex) && terrain_window_.isValid(index))
+		return terrain_window_.getHeight(index);
+
 	double height;
 	Key key = getTerrainData(vertex).key;
 	space_discretization_.keyToCoord(height, key.z, false);
@@ -275,6 +649,12 @@ double TerrainMap::getTerrainHeight(const Eigen::Vector2d& position) const
 bool TerrainMap::getTerrainHeight(double& height,
 								  const Vertex& vertex) const
 {
+	unsigned int index;
+	if (getWindowIndex(index, vertex) && terrain_window_.isValid(index)) {
+		height = terrain_window_.getHeight(index);
+		return true;
+	}
+
 	TerrainCell cell;
 	bool data = getTerrainData(cell, vertex);
 	Key key = cell.key;
@@ -297,6 +677,14 @@ bool TerrainMap::getTerrainHeight(double& height,
 
 const Weight& TerrainMap::getTerrainCost(const Vertex& vertex) const
 {
+	unsigned int index;
+	if (getWindowIndex(index, vertex)) {
+		if (terrain_window_.isValid(index))
+			return terrain_window_.getCost(index);
+		else
+			return default_cell_.cost;
+	}
+
 	return getTerrainData(vertex).cost;
 }
 
@@ -314,6 +702,13 @@ const Weight& TerrainMap::getTerrainCost(const Eigen::Vector2d& position) const
 bool TerrainMap::getTerrainCost(Weight& cost,
 								const Vertex& vertex) const
 {
+	unsigned int index;
+	if (getWindowIndex(index, vertex)) {
+		bool data = terrain_window_.isValid(index);
+		cost = data ? terrain_window_.getCost(index) : default_cell_.cost;
+		return data;
+	}
+
 	TerrainCell cell;
 	bool data = getTerrainData(cell, vertex);
 	cost = cell.cost;
@@ -335,6 +730,14 @@ bool TerrainMap::getTerrainCost(Weight& cost,
 
 const Eigen::Vector3d& TerrainMap::getTerrainNormal(const Vertex& vertex) const
 {
+	unsigned int index;
+	if (getWindowIndex(index, vertex)) {
+		if (terrain_window_.isValid(index))
+			return terrain_window_.getNormal(index);
+		else
+			return default_cell_.normal;
+	}
+
 	return getTerrainData(vertex).normal;
 }
 
@@ -352,6 +755,13 @@ const Eigen::Vector3d& TerrainMap::getTerrainNormal(const Eigen::Vector2d& posit
 bool TerrainMap::getTerrainNormal(Eigen::Vector3d& normal,
 								  const Vertex& vertex) const
 {
+	unsigned int index;
+	if (getWindowIndex(index, vertex)) {
+		bool data = terrain_window_.isValid(index);
+		normal = data ? terrain_window_.getNormal(index) : default_cell_.normal;
+		return data;
+	}
+
 	TerrainCell cell;
 	bool data = getTerrainData(cell, vertex);
 	normal = cell.normal;
@@ -389,6 +799,373 @@ double TerrainMap::getAverageCostOfTerrain()
 }
 
 
+void TerrainMap::addChangedCells(std::unordered_set<Vertex>& cells,
+								 const TerrainDataMap& old_map)
+{
+	// Adding the new and modified cells
+	for (TerrainDataMap::const_iterator cell_it = terrain_map_.begin();
+			cell_it != terrain_map_.end(); ++cell_it) {
+		TerrainDataMap::const_iterator old_it = old_map.find(cell_it->first);
+		if (old_it == old_map.end() || !isSameCell(old_it->second, cell_it->second))
+			cells.insert(cell_it->first);
+	}
+
+	// Adding the removed cells
+	for (TerrainDataMap::const_iterator old_it = old_map.begin();
+			old_it != old_map.end(); ++old_it) {
+		if (terrain_map_.find(old_it->first) == terrain_map_.end())
+			cells.insert(old_it->first);
+	}
+}
+
+
+void TerrainMap::addChangedObstacles(std::unordered_set<Vertex>& cells,
+									 const ObstacleMap& old_map)
+{
+	Eigen::Vector2d coord;
+	Vertex terrain_vertex;
+
+	// Adding the new and removed obstacles, note that the obstacle vertexes are converted
+	// to terrain vertexes because both maps could have different resolutions
+	for (ObstacleMap::const_iterator obs_it = obstaclemap_.begin();
+			obs_it != obstaclemap_.end(); ++obs_it) {
+		ObstacleMap::const_iterator old_it = old_map.find(obs_it->first);
+		if (old_it == old_map.end() || old_it->second != obs_it->second) {
+			obstacle_discretization_.vertexToCoord(coord, obs_it->first);
+			space_discretization_.coordToVertex(terrain_vertex, coord);
+			cells.insert(terrain_vertex);
+		}
+	}
+	for (ObstacleMap::const_iterator old_it = old_map.begin();
+			old_it != old_map.end(); ++old_it) {
+		if (obstaclemap_.find(old_it->first) == obstaclemap_.end()) {
+			obstacle_discretization_.vertexToCoord(coord, old_it->first);
+			space_discretization_.coordToVertex(terrain_vertex, coord);
+			cells.insert(terrain_vertex);
+		}
+	}
+}
+
+
+void TerrainMap::commitUpdate(const std::unordered_set<Vertex>& cells)
+{
+	++revision_;
+
+	// Logging the update, which allows to get the dirty region since a previous revision
+	dirty_history_.push_back(DirtyUpdate());
+	dirty_history_.back().revision = revision_;
+	dirty_history_.back().cells.assign(cells.begin(), cells.end());
+	while (dirty_history_.size() > dirty_history_size_)
+		dirty_history_.pop_front();
+}
+
+
+bool TerrainMap::isSameCell(const TerrainCell& cell,
+							const TerrainCell& other) const
+{
+	return cell.cost == other.cost && cell.key.z == other.key.z &&
+			cell.height == other.height && cell.normal == other.normal &&
+			cell.curvature == other.curvature;
+}
+
+
+bool TerrainMap::applyCell(Vertex& vertex,
+						   const TerrainCell& cell,
+						   bool& is_max_cost_removed)
+{
+	space_discretization_.keyToVertex(vertex, cell.key, true);
+	TerrainDataMap::iterator cell_it = terrain_map_.find(vertex);
+	if (cell_it != terrain_map_.end()) {
+		TerrainCell& old_cell = cell_it->second;
+		if (isSameCell(old_cell, cell))
+			return false;
+
+		total_cost_ -= old_cell.cost;
+		if (old_cell.cost == max_cost_ && cell.cost < max_cost_)
+			is_max_cost_removed = true;
+		old_cell = cell;
+	} else
+		terrain_map_[vertex] = cell;
+
+	total_cost_ += cell.cost;
+	if (cell.cost > max_cost_)
+		max_cost_ = cell.cost;
+	updateWindowCell(vertex);
+	updatePyramidCell(vertex);
+
+	return true;
+}
+
+
+bool TerrainMap::applyRemovedCell(const Vertex& vertex,
+								  bool& is_max_cost_removed)
+{
+	TerrainDataMap::iterator cell_it = terrain_map_.find(vertex);
+	if (cell_it == terrain_map_.end())
+		return false;
+
+	total_cost_ -= cell_it->second.cost;
+	if (cell_it->second.cost == max_cost_)
+		is_max_cost_removed = true;
+	terrain_map_.erase(cell_it);
+	updateWindowCell(vertex);
+	updatePyramidCell(vertex);
+
+	return true;
+}
+
+
+void TerrainMap::finishUpdate(const std::unordered_set<Vertex>& cells,
+							  bool is_max_cost_removed)
+{
+	// Nothing changed, so the downstream information is still valid
+	if (cells.empty())
+		return;
+
+	// Rescanning the terrain only if a cell with the maximum cost decreased. Note that the
+	// cost of the default cell is the maximum cost
+	if (is_max_cost_removed)
+		computeCostStatistics();
+	else {
+		average_cost_ = terrain_map_.empty() ? 0. : total_cost_ / terrain_map_.size();
+		if (!terrain_map_.empty())
+			default_cell_.cost = max_cost_;
+	}
+	terrain_information_ = !terrain_map_.empty();
+
+	commitUpdate(cells);
+}
+
+
+void TerrainMap::computeCostStatistics()
+{
+	total_cost_ = 0.;
+	max_cost_ = 0.;
+	for (TerrainDataMap::const_iterator cell_it = terrain_map_.begin();
+			cell_it != terrain_map_.end(); ++cell_it) {
+		total_cost_ += cell_it->second.cost;
+		if (cell_it->second.cost > max_cost_)
+			max_cost_ = cell_it->second.cost;
+	}
+
+	if (!terrain_map_.empty()) {
+		average_cost_ = total_cost_ / terrain_map_.size();
+		default_cell_.cost = max_cost_;
+	} else {
+		average_cost_ = 0.;
+		default_cell_.cost = std::numeric_limits<double>::max();
+	}
+	terrain_information_ = !terrain_map_.empty();
+}
+
+
+bool TerrainMap::getWindowIndex(unsigned int& index,
+								const Vertex& vertex) const
+{
+	if (!terrain_window_.isEnabled())
+		return false;
+
+	Key key;
+	space_discretization_.vertexToKey(key, vertex, true);
+	return terrain_window_.getIndex(index, key.x, key.y);
+}
+
+
+void TerrainMap::refillTerrainWindow()
+{
+	if (window_size_ <= 0.) {
+		terrain_window_.resize(0, 0);
+		return;
+	}
+
+	// Resizing the window according to the current resolution
+	unsigned int num_cells = ceil(window_size_ / space_discretization_.getEnvironmentResolution(true));
+	if (terrain_window_.getWidth() != num_cells || terrain_window_.getHeight() != num_cells)
+		terrain_window_.resize(num_cells, num_cells);
+	else
+		terrain_window_.clear();
+
+	// Centering the window, and filling it by iterating the smallest of the window and
+	// the terrain map
+	int origin_x, origin_y;
+	computeWindowOrigin(origin_x, origin_y, num_cells, num_cells);
+	terrain_window_.moveTo(origin_x, origin_y);
+	if (terrain_map_.size() < num_cells * num_cells) {
+		for (TerrainDataMap::const_iterator cell_it = terrain_map_.begin();
+				cell_it != terrain_map_.end(); ++cell_it)
+			updateWindowCell(cell_it->first);
+	} else
+		fillTerrainWindow(origin_x, origin_x + num_cells, origin_y, origin_y + num_cells);
+}
+
+
+void TerrainMap::computeWindowOrigin(int& origin_x, int& origin_y,
+									 int width, int height) const
+{
+	// The window is kept inside the key range, so the keys of its cells don't wrap
+	unsigned short int center_x, center_y;
+	space_discretization_.coordToKey(center_x, window_center_(rbd::X), true);
+	space_discretization_.coordToKey(center_y, window_center_(rbd::Y), true);
+	int num_keys = (int) std::numeric_limits<unsigned short int>::max() + 1;
+	origin_x = std::max(std::min((int) center_x - width / 2, num_keys - width), 0);
+	origin_y = std::max(std::min((int) center_y - height / 2, num_keys - height), 0);
+}
+
+
+void TerrainMap::fillTerrainWindow(int min_x, int max_x,
+								   int min_y, int max_y)
+{
+	Key key;
+	Vertex vertex;
+	max_x = std::min(max_x, (int) std::numeric_limits<unsigned short int>::max() + 1);
+	max_y = std::min(max_y, (int) std::numeric_limits<unsigned short int>::max() + 1);
+	for (int x = min_x; x < max_x; ++x) {
+		for (int y = min_y; y < max_y; ++y) {
+			key.x = x;
+			key.y = y;
+			space_discretization_.keyToVertex(vertex, key, true);
+			updateWindowCell(vertex);
+		}
+	}
+}
+
+
+void TerrainMap::updateWindowCell(const Vertex& vertex)
+{
+	unsigned int index;
+	if (!getWindowIndex(index, vertex))
+		return;
+
+	TerrainDataMap::const_iterator cell_it = terrain_map_.find(vertex);
+	if (cell_it != terrain_map_.end()) {
+		double height;
+		space_discretization_.keyToCoord(height, cell_it->second.key.z, false);
+		terrain_window_.setCell(index, cell_it->second, height);
+	} else
+		terrain_window_.clearCell(index);
+}
+
+
+void TerrainMap::refillTerrainPyramid()
+{
+	if (!terrain_pyramid_.isEnabled())
+		return;
+
+	terrain_pyramid_.clear();
+	Key key;
+	for (TerrainDataMap::const_iterator cell_it = terrain_map_.begin();
+			cell_it != terrain_map_.end(); ++cell_it) {
+		double height;
+		space_discretization_.vertexToKey(key, cell_it->first, true);
+		space_discretization_.keyToCoord(height, cell_it->second.key.z, false);
+		terrain_pyramid_.insertCell(key.x, key.y, height, cell_it->second.cost);
+	}
+	terrain_pyramid_.build();
+}
+
+
+void TerrainMap::updatePyramidCell(const Vertex& vertex)
+{
+	if (!terrain_pyramid_.isEnabled())
+		return;
+
+	Key key;
+	space_discretization_.vertexToKey(key, vertex, true);
+	TerrainDataMap::const_iterator cell_it = terrain_map_.find(vertex);
+	if (cell_it != terrain_map_.end()) {
+		double height;
+		space_discretization_.keyToCoord(height, cell_it->second.key.z, false);
+		terrain_pyramid_.updateCell(key.x, key.y, height, cell_it->second.cost);
+	} else
+		terrain_pyramid_.removeCell(key.x, key.y);
+}
+
+
+void TerrainMap::refillObstacleDistanceField()
+{
+	double resolution = obstacle_discretization_.getEnvironmentResolution(true);
+	if (obstacle_max_distance_ <= 0. || resolution <= 0.) {
+		obstacle_distance_field_.resize(0, 0, 0, 0);
+		return;
+	}
+
+	// Getting the bounding box of the obstacles
+	Key key;
+	int min_x = std::numeric_limits<int>::max(), min_y = std::numeric_limits<int>::max();
+	int max_x = std::numeric_limits<int>::min(), max_y = std::numeric_limits<int>::min();
+	for (ObstacleMap::const_iterator obs_it = obstaclemap_.begin();
+			obs_it != obstaclemap_.end(); ++obs_it) {
+		if (!obs_it->second)
+			continue;
+
+		obstacle_discretization_.vertexToKey(key, obs_it->first, true);
+		min_x = std::min(min_x, (int) key.x);
+		min_y = std::min(min_y, (int) key.y);
+		max_x = std::max(max_x, (int) key.x);
+		max_y = std::max(max_y, (int) key.y);
+	}
+
+	unsigned int max_distance = ceil(obstacle_max_distance_ / resolution);
+	obstacle_distance_field_.setMaximumDistance(max_distance);
+	if (min_x > max_x) {
+		obstacle_distance_field_.resize(0, 0, 0, 0);
+		return;
+	}
+
+	// Adding a margin of the maximum distance around the obstacles, so the distances of the
+	// cells outside the grid are truncated
+	int margin = max_distance + 1;
+	obstacle_distance_field_.resize(min_x - margin, min_y - margin,
+									max_x - min_x + 2 * margin + 1,
+									max_y - min_y + 2 * margin + 1);
+	for (ObstacleMap::const_iterator obs_it = obstaclemap_.begin();
+			obs_it != obstaclemap_.end(); ++obs_it) {
+		if (!obs_it->second)
+			continue;
+
+		obstacle_discretization_.vertexToKey(key, obs_it->first, true);
+		obstacle_distance_field_.setObstacle(key.x, key.y);
+	}
+	obstacle_distance_field_.update();
+}
+
+
+void TerrainMap::updateObstacleDistanceField(const ObstacleMap& old_map)
+{
+	if (obstacle_max_distance_ <= 0.)
+		return;
+
+	// Setting the new obstacles, and rebuilding the distance field if some of them is outside
+	// its grid or its margin
+	Key key;
+	int margin = obstacle_distance_field_.getMaximumDistance() + 1;
+	for (ObstacleMap::const_iterator obs_it = obstaclemap_.begin();
+			obs_it != obstaclemap_.end(); ++obs_it) {
+		if (!obs_it->second)
+			continue;
+
+		obstacle_discretization_.vertexToKey(key, obs_it->first, true);
+		if (!obstacle_distance_field_.isInside(key.x - margin, key.y - margin) ||
+				!obstacle_distance_field_.isInside(key.x + margin, key.y + margin)) {
+			refillObstacleDistanceField();
+			return;
+		}
+		obstacle_distance_field_.setObstacle(key.x, key.y);
+	}
+
+	// Removing the old obstacles
+	for (ObstacleMap::const_iterator old_it = old_map.begin();
+			old_it != old_map.end(); ++old_it) {
+		ObstacleMap::const_iterator obs_it = obstaclemap_.find(old_it->first);
+		if (obs_it == obstaclemap_.end() || !obs_it->second) {
+			obstacle_discretization_.vertexToKey(key, old_it->first, true);
+			obstacle_distance_field_.removeObstacle(key.x, key.y);
+		}
+	}
+	obstacle_distance_field_.update();
+}
+
+
 bool TerrainMap::isTerrainInformation()
 {
 	return terrain_information_;
@@ -2,7 +2,12 @@
 #define DWL__ENVIRONMENT__TERRAIN_MAP__H
 
 #include <dwl/environment/SpaceDiscretization.h>
+#include <dwl/environment/RollingGrid.h>
+#include <dwl/environment/TerrainPyramid.h>
+#include <dwl/environment/DistanceField.h>
 #include <dwl/utils/utils.h>
+#include <unordered_set>
+#include <deque>
 
 
 namespace dwl
@@ -11,9 +16,23 @@ namespace dwl
 namespace environment
 {
 
+/**
+ * @brief Struct that defines the terrain region changed since a revision, i.e. the changed
+ * terrain vertexes and their bounding box of plane keys
+ */
+struct DirtyRegion
+{
+	std::unordered_set<Vertex> cells;
+	Key min_key;
+	Key max_key;
+};
+
 /**
  * @class TerrainMap
- * @brief Class for defining the terrain information
+ * @brief Class for defining the terrain information. The terrain cells are mapped using the
+ * vertex id, and optionally the cells around the robot are mirrored in a rolling window grid
+ * (see RollingGrid), which serves the terrain queries inside the window by indexing instead of
+ * hashing. Note that the window references the cells, so the terrain map isn't copyable
  */
 class TerrainMap
 {
@@ -31,6 +50,16 @@ class TerrainMap
 		void setTerrainMap(const TerrainData& terrain_map);
 		void setTerrainMap(const TerrainDataMap& map);
 
+		/**
+		 * @brief Applies a delta of the terrain map, i.e. the new or modified cells and the
+		 * removed ones. Only the cells that really changed are applied, and the cost statistics
+		 * are updated incrementally. The revision doesn't change if nothing changed
+		 * @param const TerrainData& New or modified terrain cells
+		 * @param const std::vector<Vertex>& Removed terrain vertexes
+		 */
+		void updateTerrainMap(const TerrainData& terrain_delta,
+							  const std::vector<Vertex>& removed_cells = std::vector<Vertex>());
+
 		/**
 		 * @brief Sets the obstacle map
 		 * @param const std::vector<Cell>& Obstacle map
@@ -50,7 +79,8 @@ class TerrainMap
 							const Terrain& terrain_info);
 
 		/**
-		 * @brief Adds a cell to the terrain map
+		 * @brief Adds a cell to the terrain map. It shares the update path of the terrain
+		 * deltas, so it's only committed if the cell changed
 		 * @param const TerrainCell& Cell values for adding to the terrain map
 		 */
 		void addCellToTerrainMap(const TerrainCell& cell);
@@ -75,6 +105,83 @@ class TerrainMap
 		 */
 		void removeCellToTerrainHeightMap(const Vertex& cell_vertex);
 
+		/**
+		 * @brief Sets the size of the rolling window of terrain cells, which is centered in
+		 * the last position given by moveTerrainWindow(). A zero size disables the window, so
+		 * all the queries use the vertex map
+		 * @param double Size of the squared window (in meters)
+		 */
+		void setTerrainWindow(double size);
+
+		/**
+		 * @brief Moves the rolling window to a new center, e.g. the robot position. Only the
+		 * rows and columns that enter the window are filled
+		 * @param const Eigen::Vector2d& Center of the window
+		 */
+		void moveTerrainWindow(const Eigen::Vector2d& position);
+
+		/** @brief Gets the rolling window of terrain cells */
+		const RollingGrid& getTerrainWindow() const;
+
+		/**
+		 * @brief Sets the number of levels of the terrain pyramid, which is updated on every
+		 * change of the terrain cells. Zero levels disables the pyramid, so the region queries
+		 * scan the terrain cells
+		 * @param unsigned int Number of levels
+		 */
+		void setTerrainPyramid(unsigned int num_levels);
+
+		/** @brief Gets the pyramid of terrain cells */
+		const TerrainPyramid& getTerrainPyramid() const;
+
+		/**
+		 * @brief Sets the maximum distance of the signed distance field of the obstacle map,
+		 * which is updated on every change of the obstacles. A zero distance disables the
+		 * distance field
+		 * @param double Maximum distance (in meters)
+		 */
+		void setObstacleDistanceField(double max_distance);
+
+		/** @brief Gets the signed distance field of the obstacle map */
+		const DistanceField& getObstacleDistanceField() const;
+
+		/**
+		 * @brief Gets the signed distance to the obstacles of a position, which is bilinearly
+		 * interpolated between the obstacle cells. The distances are negative inside the
+		 * obstacles, and truncated to the maximum distance
+		 * @param const Eigen::Vector2d& Position
+		 * @return Signed distance (in meters)
+		 */
+		double getObstacleDistance(const Eigen::Vector2d& position) const;
+
+		/**
+		 * @brief Gets the gradient of the signed distance to the obstacles of a position
+		 * @param Eigen::Vector2d& Gradient of the signed distance
+		 * @param const Eigen::Vector2d& Position
+		 */
+		void getObstacleGradient(Eigen::Vector2d& gradient,
+								 const Eigen::Vector2d& position) const;
+
+		/**
+		 * @brief Gets the clearance of the obstacle cell of a position, i.e. the signed distance
+		 * between its center and the center of the closest obstacle cell
+		 * @param const Eigen::Vector2d& Position
+		 * @return Clearance of the cell (in meters)
+		 */
+		double getObstacleClearance(const Eigen::Vector2d& position) const;
+
+		/**
+		 * @brief Gets the height (min, max and mean) and cost (min, max and mean) of the terrain
+		 * cells of a rectangular region
+		 * @param TerrainRegion& Aggregated information of the region
+		 * @param const Eigen::Vector2d& Minimum corner of the region
+		 * @param const Eigen::Vector2d& Maximum corner of the region
+		 * @return True if there are terrain cells in the region
+		 */
+		bool getTerrainRegion(TerrainRegion& region,
+							  const Eigen::Vector2d& min_corner,
+							  const Eigen::Vector2d& max_corner) const;
+
 		/**
 		 * @brief Gets the environment resolution of the terrain map
 		 * @param bool Indicates if the key represents a plane or a height
@@ -118,6 +225,67 @@ class TerrainMap
 		/** @brief Gets the obstacle-map (using vertex id) */
 		const ObstacleMap& getObstacleMap() const;
 
+		/**
+		 * @brief Gets the revision of the terrain information. It increases after every
+		 * change of the terrain or obstacle map, so it allows to reuse derived information
+		 * (e.g. heuristic fields) while the terrain doesn't change
+		 * @return The terrain revision
+		 */
+		unsigned long getRevision() const;
+
+		/**
+		 * @brief Gets the terrain region that changed since a revision. Each consumer (e.g.
+		 * planners or derived maps) keeps the revision of its last update, so it could update
+		 * only the dirty region. The changes are kept for a limited number of revisions
+		 * @param DirtyRegion& Dirty region
+		 * @param unsigned long Revision of the last update of the consumer
+		 * @return False if the revision is older than the kept changes, so the consumer has to
+		 * update all its information
+		 */
+		bool getDirtyRegion(DirtyRegion& region,
+							unsigned long revision) const;
+
+		/**
+		 * @brief Sets the number of revisions whose changes are kept for getDirtyRegion()
+		 * @param unsigned int Number of kept revisions
+		 */
+		void setDirtyHistorySize(unsigned int size);
+
+		/**
+		 * @brief Indicates if there is terrain information in a certain vertex. This is
+		 * a read-only O(1) query, so it doesn't require to copy the terrain map
+		 * @param const Vertex& Terrain vertex
+		 * @return True if the vertex is a terrain cell
+		 */
+		bool isTerrainCell(const Vertex& vertex) const;
+
+		/**
+		 * @brief Finds the terrain cell of a certain vertex. The vertexes inside the rolling
+		 * window are found by indexing, and the rest by hashing
+		 * @param const Vertex& Terrain vertex
+		 * @return A pointer to the cell, or NULL if the vertex isn't a terrain cell
+		 */
+		const TerrainCell* findTerrainCell(const Vertex& vertex) const;
+
+		/**
+		 * @brief Gets the terrain grid of a rectangular region, i.e. the terrain cells of the
+		 * region copied into contiguous layers. The heights are the ones of the height keys,
+		 * as in the rest of the terrain queries, and the curvatures are the ones stored in the cells
+		 * @param TerrainGrid& Terrain grid
+		 * @param const Eigen::Vector2d& Minimum corner of the region
+		 * @param const Eigen::Vector2d& Maximum corner of the region
+		 */
+		void getTerrainGrid(TerrainGrid& grid,
+							const Eigen::Vector2d& min_corner,
+							const Eigen::Vector2d& max_corner) const;
+
+		/**
+		 * @brief Indicates if there is an obstacle in a certain vertex of the obstacle map
+		 * @param const Vertex& Obstacle vertex
+		 * @return True if the vertex is an obstacle
+		 */
+		bool isObstacle(const Vertex& vertex) const;
+
 		/**
 		 * @brief Gets the terrain data value give a vertex or 2d position
 		 * @return The cell data
@@ -196,6 +364,144 @@ class TerrainMap
 
 
 	protected:
+		/**
+		 * @brief The terrain map isn't copyable, because the rolling window references the
+		 * cells of the terrain map. They are declared but not defined
+		 */
+		TerrainMap(const TerrainMap& other);
+		TerrainMap& operator=(const TerrainMap& other);
+
+		/**
+		 * @brief Adds the terrain cells that are different in the old and current terrain map
+		 * to a set of changed cells
+		 * @param std::unordered_set<Vertex>& Changed terrain vertexes
+		 * @param const TerrainDataMap& Old terrain map
+		 */
+		void addChangedCells(std::unordered_set<Vertex>& cells,
+							 const TerrainDataMap& old_map);
+
+		/**
+		 * @brief Adds the obstacles that are different in the old and current obstacle map
+		 * to a set of changed cells, i.e. using terrain vertexes
+		 * @param std::unordered_set<Vertex>& Changed terrain vertexes
+		 * @param const ObstacleMap& Old obstacle map
+		 */
+		void addChangedObstacles(std::unordered_set<Vertex>& cells,
+								 const ObstacleMap& old_map);
+
+		/**
+		 * @brief Commits an update of the terrain information, i.e. increases the revision
+		 * and records the changed cells
+		 * @param const std::unordered_set<Vertex>& Changed terrain vertexes
+		 */
+		void commitUpdate(const std::unordered_set<Vertex>& cells);
+
+		/**
+		 * @brief Indicates if two terrain cells have the same information, i.e. if replacing
+		 * one by the other doesn't change the terrain
+		 * @param const TerrainCell& Terrain cell
+		 * @param const TerrainCell& Other terrain cell
+		 * @return True if both cells have the same information
+		 */
+		bool isSameCell(const TerrainCell& cell,
+						const TerrainCell& other) const;
+
+		/**
+		 * @brief Applies a new or modified cell to the terrain map, i.e. the update path
+		 * shared by the incremental updates. It updates the total and maximum cost, the
+		 * rolling window and the pyramid
+		 * @param Vertex& Terrain vertex of the cell
+		 * @param const TerrainCell& New or modified terrain cell
+		 * @param bool& Set to true if a cell with the maximum cost decreased
+		 * @return True if the cell changed
+		 */
+		bool applyCell(Vertex& vertex,
+					   const TerrainCell& cell,
+					   bool& is_max_cost_removed);
+
+		/**
+		 * @brief Removes a cell of the terrain map, and updates the total cost, the rolling
+		 * window and the pyramid
+		 * @param const Vertex& Terrain vertex
+		 * @param bool& Set to true if a cell with the maximum cost was removed
+		 * @return True if the cell was removed
+		 */
+		bool applyRemovedCell(const Vertex& vertex,
+							  bool& is_max_cost_removed);
+
+		/**
+		 * @brief Finishes an incremental update, i.e. updates the average cost and the cost
+		 * of the default cell, and commits the changed cells
+		 * @param const std::unordered_set<Vertex>& Changed terrain vertexes
+		 * @param bool Indicates if a cell with the maximum cost decreased or was removed
+		 */
+		void finishUpdate(const std::unordered_set<Vertex>& cells,
+						  bool is_max_cost_removed);
+
+		/**
+		 * @brief Computes the total, average and maximum cost of the terrain cells, and the cost
+		 * of the default cell. An empty terrain resets them and the terrain information flag
+		 */
+		void computeCostStatistics();
+
+		/**
+		 * @brief Gets the window index of a terrain vertex
+		 * @param unsigned int& Window index
+		 * @param const Vertex& Terrain vertex
+		 * @return True if the vertex is inside the rolling window
+		 */
+		bool getWindowIndex(unsigned int& index,
+							const Vertex& vertex) const;
+
+		/** @brief Resizes and fills the whole rolling window from the terrain map */
+		void refillTerrainWindow();
+
+		/**
+		 * @brief Computes the origin of the rolling window centered in the window center, which
+		 * is clamped to the key range
+		 * @param int& Minimum key along the x-axis
+		 * @param int& Minimum key along the y-axis
+		 * @param int Number of cells along the x-axis
+		 * @param int Number of cells along the y-axis
+		 */
+		void computeWindowOrigin(int& origin_x, int& origin_y,
+								 int width, int height) const;
+
+		/** @brief Rebuilds the whole terrain pyramid from the terrain map */
+		void refillTerrainPyramid();
+
+		/** @brief Resizes the distance field to the obstacle map, and rebuilds it */
+		void refillObstacleDistanceField();
+
+		/**
+		 * @brief Updates the distance field with the obstacles that are different in the old
+		 * and current obstacle map
+		 * @param const ObstacleMap& Old obstacle map
+		 */
+		void updateObstacleDistanceField(const ObstacleMap& old_map);
+
+		/**
+		 * @brief Updates the pyramid cell of a terrain vertex from the terrain map
+		 * @param const Vertex& Terrain vertex
+		 */
+		void updatePyramidCell(const Vertex& vertex);
+
+		/**
+		 * @brief Fills a region of the rolling window from the terrain map
+		 * @param int Minimum key along the x-axis
+		 * @param int Maximum key along the x-axis (excluded)
+		 * @param int Minimum key along the y-axis
+		 * @param int Maximum key along the y-axis (excluded)
+		 */
+		void fillTerrainWindow(int min_x, int max_x,
+							   int min_y, int max_y);
+
+		/**
+		 * @brief Updates a cell of the rolling window from the terrain map
+		 * @param const Vertex& Terrain vertex
+		 */
+		void updateWindowCell(const Vertex& vertex);
+
 		/** @brief Object of the SpaceDiscretization class for defining the
 		 *  grid routines */
 		SpaceDiscretization space_discretization_;
@@ -208,12 +514,45 @@ class TerrainMap
 		/** @brief Terrain values mapped using vertex id */
 		TerrainDataMap terrain_map_;
 
+		/** @brief Rolling window of the terrain cells around the robot */
+		RollingGrid terrain_window_;
+
+		/** @brief Size and center of the rolling window */
+		double window_size_;
+		Eigen::Vector2d window_center_;
+
+		/** @brief Pyramid of the terrain cells */
+		TerrainPyramid terrain_pyramid_;
+
+		/** @brief Signed distance field of the obstacle map and its maximum distance */
+		DistanceField obstacle_distance_field_;
+		double obstacle_max_distance_;
+
 		/** @brief Terrain height map */
 		HeightMap terrain_heightmap_;
 
 		/** @brief Gathers the obstacles that are mapped using the vertex id */
 		ObstacleMap obstaclemap_;
 
+		/** @brief Revision of the terrain information */
+		unsigned long revision_;
+
+		/** @brief Changed terrain vertexes of a revision */
+		struct DirtyUpdate
+		{
+			unsigned long revision;
+			std::vector<Vertex> cells;
+		};
+
+		/** @brief Changed cells of the last revisions */
+		std::deque<DirtyUpdate> dirty_history_;
+
+		/** @brief Number of revisions kept in the history */
+		unsigned int dirty_history_size_;
+
+		/** @brief Total cost of the terrain cells */
+		double total_cost_;
+
 		/** @brief Default values of the cell, e.g. for unperceived cells */
 		TerrainCell default_cell_;
 
@@ -0,0 +1,542 @@
+#include <dwl/environment/TerrainMapFile.h>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @brief Identifier, version and byte-order tag of the snapshot format. The tag is read
+ * swapped in machines with other byte order
+ */
+static const char TERRAIN_MAP_MAGIC[8] = {'D', 'W', 'L', 'T', 'M', 'A', 'P', '\0'};
+static const uint32_t TERRAIN_MAP_VERSION = 1;
+static const uint32_t TERRAIN_MAP_BYTE_ORDER = 0x01020304;
+
+/** @brief Maximum number of cells per side of the snapshot, i.e. the range of the plane keys */
+static const uint64_t TERRAIN_MAP_MAX_CELLS = 1 << 16;
+
+/**
+ * @brief Maximum number of cells per side of a tile. A cell takes 51 bytes, so a tile takes
+ * less than 3.4 MB, which bounds the buffers of the written tiles and the pages of a read tile
+ */
+static const unsigned int TERRAIN_MAP_MAX_TILE_SIZE = 256;
+
+/** @brief Number of layers of doubles of a tile, i.e. cost, height, normal and curvature */
+static const uint64_t TERRAIN_MAP_NUM_LAYERS = 6;
+
+
+TerrainMapFile::TerrainMapFile() : data_(NULL), size_(0), header_(NULL), tiles_(NULL)
+{
+
+}
+
+
+TerrainMapFile::~TerrainMapFile()
+{
+	close();
+}
+
+
+bool TerrainMapFile::write(const std::string& filename,
+						   const TerrainMap& terrain,
+						   unsigned int tile_size)
+{
+	if (tile_size == 0 || tile_size > TERRAIN_MAP_MAX_TILE_SIZE) {
+		printf(RED_ "Could not write the terrain map because the tile size isn't between 1 and"
+				" %u\n" COLOR_RESET, TERRAIN_MAP_MAX_TILE_SIZE);
+		return false;
+	}
+
+	// Getting the bounding box of the plane keys of the terrain cells
+	const SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	const TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	Key key;
+	int min_x = std::numeric_limits<int>::max(), min_y = std::numeric_limits<int>::max();
+	int max_x = std::numeric_limits<int>::min(), max_y = std::numeric_limits<int>::min();
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		space_model.vertexToKey(key, cell_it->first, true);
+		min_x = std::min(min_x, (int) key.x);
+		min_y = std::min(min_y, (int) key.y);
+		max_x = std::max(max_x, (int) key.x);
+		max_y = std::max(max_y, (int) key.y);
+	}
+
+	FileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, TERRAIN_MAP_MAGIC, sizeof(header.magic));
+	header.version = TERRAIN_MAP_VERSION;
+	header.byte_order = TERRAIN_MAP_BYTE_ORDER;
+	header.tile_size = tile_size;
+	header.plane_resolution = space_model.getEnvironmentResolution(true);
+	header.height_resolution = space_model.getEnvironmentResolution(false);
+	header.obstacle_plane_resolution =
+			terrain.getObstacleSpaceModel().getEnvironmentResolution(true);
+	header.obstacle_height_resolution =
+			terrain.getObstacleSpaceModel().getEnvironmentResolution(false);
+	header.num_cells = terrain_map.size();
+	if (!terrain_map.empty()) {
+		header.num_tiles_x = (max_x - min_x) / tile_size + 1;
+		header.num_tiles_y = (max_y - min_y) / tile_size + 1;
+
+		// Shifting the origin for fitting the tiles inside the key range, otherwise the keys of
+		// the last tiles wrap
+		int max_origin_x = (int) TERRAIN_MAP_MAX_CELLS - (int) (header.num_tiles_x * tile_size);
+		int max_origin_y = (int) TERRAIN_MAP_MAX_CELLS - (int) (header.num_tiles_y * tile_size);
+		if (max_origin_x < 0 || max_origin_y < 0) {
+			printf(RED_ "Could not write the terrain map because its tiles exceed the key range,"
+					" use a tile size that divides %u\n" COLOR_RESET,
+					(unsigned int) TERRAIN_MAP_MAX_CELLS);
+			return false;
+		}
+		header.origin_x = std::min(min_x, max_origin_x);
+		header.origin_y = std::min(min_y, max_origin_y);
+	}
+
+	// Getting the obstacle vertexes
+	const ObstacleMap& obstacle_map = terrain.getObstacleMap();
+	std::vector<uint64_t> obstacles;
+	for (ObstacleMap::const_iterator obs_it = obstacle_map.begin();
+			obs_it != obstacle_map.end(); ++obs_it) {
+		if (obs_it->second)
+			obstacles.push_back(obs_it->first);
+	}
+	std::sort(obstacles.begin(), obstacles.end());
+	header.num_obstacles = obstacles.size();
+
+	// Filling the layers of the tiles
+	unsigned int num_tiles = header.num_tiles_x * header.num_tiles_y;
+	uint64_t tile_cells = (uint64_t) tile_size * tile_size;
+	uint64_t tile_bytes = getTileBytes(tile_size);
+	std::vector<TileEntry> tiles(num_tiles);
+	std::vector<std::vector<char> > tile_data(num_tiles);
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		space_model.vertexToKey(key, cell_it->first, true);
+		unsigned int col = key.x - header.origin_x;
+		unsigned int row = key.y - header.origin_y;
+		unsigned int tile = (row / tile_size) * header.num_tiles_x + col / tile_size;
+		std::vector<char>& data = tile_data[tile];
+		if (data.empty())
+			data.assign(tile_bytes, 0);
+
+		const TerrainCell& cell = cell_it->second;
+		uint64_t i = (row % tile_size) * tile_size + col % tile_size;
+		double* layers = (double*) data.data();
+		layers[i] = cell.cost;
+		layers[tile_cells + i] = cell.height;
+		layers[2 * tile_cells + i] = cell.normal(rbd::X);
+		layers[3 * tile_cells + i] = cell.normal(rbd::Y);
+		layers[4 * tile_cells + i] = cell.normal(rbd::Z);
+		layers[5 * tile_cells + i] = cell.curvature;
+		uint16_t* height_keys = (uint16_t*) (layers + TERRAIN_MAP_NUM_LAYERS * tile_cells);
+		height_keys[i] = cell.key.z;
+		((uint8_t*) (height_keys + tile_cells))[i] = 1;
+		tiles[tile].num_cells++;
+	}
+
+	// Computing the offsets of the obstacles and the non-empty tiles
+	uint64_t offset = sizeof(FileHeader) + num_tiles * sizeof(TileEntry);
+	header.obstacles_offset = offset;
+	offset += obstacles.size() * sizeof(uint64_t);
+	for (unsigned int i = 0; i < num_tiles; ++i) {
+		if (tiles[i].num_cells != 0) {
+			tiles[i].offset = offset;
+			offset += tile_bytes;
+		}
+	}
+
+	std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		printf(RED_ "Could not open the %s file for writing\n" COLOR_RESET, filename.c_str());
+		return false;
+	}
+	file.write((const char*) &header, sizeof(header));
+	file.write((const char*) tiles.data(), num_tiles * sizeof(TileEntry));
+	file.write((const char*) obstacles.data(), obstacles.size() * sizeof(uint64_t));
+	for (unsigned int i = 0; i < num_tiles; ++i) {
+		if (tiles[i].num_cells != 0)
+			file.write(tile_data[i].data(), tile_bytes);
+	}
+
+	if (!file.good()) {
+		printf(RED_ "Could not write the %s file\n" COLOR_RESET, filename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+
+bool TerrainMapFile::open(const std::string& filename)
+{
+	close();
+
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		printf(RED_ "Could not open the %s file\n" COLOR_RESET, filename.c_str());
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size < (off_t) sizeof(FileHeader)) {
+		printf(RED_ "Could not read the %s file\n" COLOR_RESET, filename.c_str());
+		::close(fd);
+		return false;
+	}
+
+	// Note that the mapping is kept after closing the file descriptor
+	size_t size = file_stat.st_size;
+	void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) {
+		printf(RED_ "Could not map the %s file\n" COLOR_RESET, filename.c_str());
+		return false;
+	}
+	data_ = (const char*) data;
+	size_ = size;
+
+	// Validating the header. Note that the tiles cover the range of plane keys
+	header_ = (const FileHeader*) data_;
+	tiles_ = (const TileEntry*) (data_ + sizeof(FileHeader));
+	if (memcmp(header_->magic, TERRAIN_MAP_MAGIC, sizeof(header_->magic)) != 0 ||
+			header_->version != TERRAIN_MAP_VERSION) {
+		printf(RED_ "Could not open the %s file because it isn't a terrain map of version %u\n"
+				COLOR_RESET, filename.c_str(), TERRAIN_MAP_VERSION);
+		close();
+		return false;
+	}
+
+	if (header_->byte_order != TERRAIN_MAP_BYTE_ORDER) {
+		printf(RED_ "Could not open the %s file because it was written with other byte order\n"
+				COLOR_RESET, filename.c_str());
+		close();
+		return false;
+	}
+
+	uint64_t tile_size = header_->tile_size;
+	uint64_t num_tiles = (uint64_t) header_->num_tiles_x * header_->num_tiles_y;
+	uint64_t tiles_end = sizeof(FileHeader) + num_tiles * sizeof(TileEntry);
+	if (tile_size == 0 || tile_size > TERRAIN_MAP_MAX_TILE_SIZE ||
+			header_->origin_x < 0 || header_->origin_y < 0 ||
+			header_->origin_x + header_->num_tiles_x * tile_size > TERRAIN_MAP_MAX_CELLS ||
+			header_->origin_y + header_->num_tiles_y * tile_size > TERRAIN_MAP_MAX_CELLS ||
+			num_tiles > (size_ - sizeof(FileHeader)) / sizeof(TileEntry) ||
+			header_->obstacles_offset % sizeof(uint64_t) != 0 ||
+			header_->obstacles_offset < tiles_end || header_->obstacles_offset > size_ ||
+			header_->num_obstacles > (size_ - header_->obstacles_offset) / sizeof(uint64_t)) {
+		printf(RED_ "Could not open the %s file because it is truncated or corrupted\n"
+				COLOR_RESET, filename.c_str());
+		close();
+		return false;
+	}
+
+	// Validating the tiles, which are stored in order after the obstacles without overlapping.
+	// So, the number of cells is bounded by the file size
+	uint64_t tile_cells = tile_size * tile_size;
+	uint64_t tile_bytes = getTileBytes(tile_size);
+	uint64_t min_offset = header_->obstacles_offset + header_->num_obstacles * sizeof(uint64_t);
+	uint64_t num_cells = 0;
+	for (uint64_t i = 0; i < num_tiles; ++i) {
+		const TileEntry& tile = tiles_[i];
+		if (tile.num_cells == 0)
+			continue;
+
+		if (tile.num_cells > tile_cells || tile.offset % sizeof(uint64_t) != 0 ||
+				tile.offset < min_offset || tile.offset > size_ ||
+				tile_bytes > size_ - tile.offset) {
+			printf(RED_ "Could not open the %s file because it is truncated or corrupted\n"
+					COLOR_RESET, filename.c_str());
+			close();
+			return false;
+		}
+		min_offset = tile.offset + tile_bytes;
+		num_cells += tile.num_cells;
+	}
+
+	if (num_cells != header_->num_cells) {
+		printf(RED_ "Could not open the %s file because it is truncated or corrupted\n"
+				COLOR_RESET, filename.c_str());
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+
+void TerrainMapFile::close()
+{
+	if (data_ != NULL)
+		munmap((void*) data_, size_);
+
+	data_ = NULL;
+	size_ = 0;
+	header_ = NULL;
+	tiles_ = NULL;
+}
+
+
+bool TerrainMapFile::isOpen() const
+{
+	return data_ != NULL;
+}
+
+
+bool TerrainMapFile::load(TerrainMap& terrain) const
+{
+	if (!isOpen()) {
+		printf(YELLOW_ "Warning: could not load the terrain map because the file isn't opened\n"
+				COLOR_RESET);
+		return false;
+	}
+
+	TerrainData terrain_data;
+	terrain_data.plane_size = header_->plane_resolution;
+	terrain_data.height_size = header_->height_resolution;
+	// Note that the number of cells was validated with the tiles when the file was opened
+	terrain_data.data.reserve(header_->num_cells);
+	for (unsigned int tile_y = 0; tile_y < header_->num_tiles_y; ++tile_y) {
+		for (unsigned int tile_x = 0; tile_x < header_->num_tiles_x; ++tile_x)
+			addTileCells(terrain_data, tile_x, tile_y);
+	}
+	terrain.setTerrainMap(terrain_data);
+
+	// Loading the obstacles, whose vertexes are 2d keys
+	const uint64_t* obstacle_vertexes = (const uint64_t*) (data_ + header_->obstacles_offset);
+	std::vector<Cell> obstacles(header_->num_obstacles);
+	for (uint64_t i = 0; i < header_->num_obstacles; ++i) {
+		obstacles[i].key.x = (obstacle_vertexes[i] >> 16) & 0xFFFF;
+		obstacles[i].key.y = obstacle_vertexes[i] & 0xFFFF;
+		obstacles[i].plane_size = header_->obstacle_plane_resolution;
+		obstacles[i].height_size = header_->obstacle_height_resolution;
+	}
+	terrain.setObstacleMap(obstacles);
+
+	return true;
+}
+
+
+bool TerrainMapFile::loadRegion(TerrainMap& terrain,
+								const Eigen::Vector2d& min_corner,
+								const Eigen::Vector2d& max_corner,
+								bool replace) const
+{
+	if (!isOpen()) {
+		printf(YELLOW_ "Warning: could not load the terrain region because the file isn't"
+				" opened\n" COLOR_RESET);
+		return false;
+	}
+
+	// Getting the range of keys and tiles of the region
+	SpaceDiscretization space_model(header_->plane_resolution);
+	unsigned short int min_x, min_y, max_x, max_y;
+	space_model.coordToKey(min_x, min_corner(rbd::X), true);
+	space_model.coordToKey(min_y, min_corner(rbd::Y), true);
+	space_model.coordToKey(max_x, max_corner(rbd::X), true);
+	space_model.coordToKey(max_y, max_corner(rbd::Y), true);
+	int tile_size = header_->tile_size;
+	int min_tile_x = std::max(((int) min_x - header_->origin_x) / tile_size, 0);
+	int min_tile_y = std::max(((int) min_y - header_->origin_y) / tile_size, 0);
+	int max_col = std::min((int) max_x - header_->origin_x,
+						   tile_size * (int) header_->num_tiles_x - 1);
+	int max_row = std::min((int) max_y - header_->origin_y,
+						   tile_size * (int) header_->num_tiles_y - 1);
+
+	// Getting the cells of the tiles that are inside the region
+	TerrainData tile_data;
+	if (max_col >= 0 && max_row >= 0) {
+		for (int tile_y = min_tile_y; tile_y <= max_row / tile_size; ++tile_y) {
+			for (int tile_x = min_tile_x; tile_x <= max_col / tile_size; ++tile_x)
+				addTileCells(tile_data, tile_x, tile_y);
+		}
+	}
+	TerrainData terrain_delta;
+	terrain_delta.plane_size = header_->plane_resolution;
+	terrain_delta.height_size = header_->height_resolution;
+	for (unsigned int i = 0; i < tile_data.data.size(); ++i) {
+		const Key& key = tile_data.data[i].key;
+		if (key.x >= min_x && key.x <= max_x && key.y >= min_y && key.y <= max_y)
+			terrain_delta.data.push_back(tile_data.data[i]);
+	}
+
+	if (!replace) {
+		terrain.updateTerrainMap(terrain_delta);
+		return true;
+	}
+
+	// Evicting the cells that are outside the region or aren't in the snapshot. Note that
+	// the unchanged cells of the region aren't applied again
+	const SpaceDiscretization& terrain_model = terrain.getTerrainSpaceModel();
+	const TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	std::vector<Vertex> removed_cells;
+	Key key;
+	TerrainCell cell;
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		terrain_model.vertexToKey(key, cell_it->first, true);
+		if (key.x < min_x || key.x > max_x || key.y < min_y || key.y > max_y ||
+				!getTerrainCell(cell, cell_it->first))
+			removed_cells.push_back(cell_it->first);
+	}
+	terrain.updateTerrainMap(terrain_delta, removed_cells);
+
+	// Loading the obstacles of the region. The obstacle vertexes are sorted 2d keys, so the
+	// columns of the region are a contiguous range of them
+	std::vector<Cell> obstacles;
+	if (header_->num_obstacles != 0) {
+		SpaceDiscretization obstacle_model(header_->obstacle_plane_resolution);
+		unsigned short int min_obs_x, min_obs_y, max_obs_x, max_obs_y;
+		obstacle_model.coordToKey(min_obs_x, min_corner(rbd::X), true);
+		obstacle_model.coordToKey(min_obs_y, min_corner(rbd::Y), true);
+		obstacle_model.coordToKey(max_obs_x, max_corner(rbd::X), true);
+		obstacle_model.coordToKey(max_obs_y, max_corner(rbd::Y), true);
+
+		const uint64_t* obstacle_vertexes =
+				(const uint64_t*) (data_ + header_->obstacles_offset);
+		const uint64_t* obstacles_end = obstacle_vertexes + header_->num_obstacles;
+		uint64_t max_vertex = ((uint64_t) max_obs_x << 16) | 0xFFFF;
+		const uint64_t* obs_it = std::lower_bound(obstacle_vertexes, obstacles_end,
+												  (uint64_t) min_obs_x << 16);
+		for (; obs_it != obstacles_end && *obs_it <= max_vertex; ++obs_it) {
+			Cell obstacle;
+			obstacle.key.x = (*obs_it >> 16) & 0xFFFF;
+			obstacle.key.y = *obs_it & 0xFFFF;
+			if (obstacle.key.y < min_obs_y || obstacle.key.y > max_obs_y)
+				continue;
+
+			obstacle.plane_size = header_->obstacle_plane_resolution;
+			obstacle.height_size = header_->obstacle_height_resolution;
+			obstacles.push_back(obstacle);
+		}
+	}
+	terrain.setObstacleMap(obstacles);
+
+	return true;
+}
+
+
+bool TerrainMapFile::getTile(TerrainData& terrain_data,
+							 unsigned int tile_x,
+							 unsigned int tile_y) const
+{
+	terrain_data.data.clear();
+	if (!isOpen() || tile_x >= header_->num_tiles_x || tile_y >= header_->num_tiles_y)
+		return false;
+
+	terrain_data.plane_size = header_->plane_resolution;
+	terrain_data.height_size = header_->height_resolution;
+	addTileCells(terrain_data, tile_x, tile_y);
+
+	return true;
+}
+
+
+bool TerrainMapFile::getTerrainCell(TerrainCell& cell,
+									const Vertex& vertex) const
+{
+	if (!isOpen())
+		return false;
+
+	int col = (int) ((vertex >> 16) & 0xFFFF) - header_->origin_x;
+	int row = (int) (vertex & 0xFFFF) - header_->origin_y;
+	int tile_size = header_->tile_size;
+	if (col < 0 || row < 0 ||
+			col >= tile_size * (int) header_->num_tiles_x ||
+			row >= tile_size * (int) header_->num_tiles_y)
+		return false;
+
+	const TileEntry& tile = tiles_[(row / tile_size) * header_->num_tiles_x + col / tile_size];
+	if (tile.num_cells == 0)
+		return false;
+
+	uint64_t tile_cells = (uint64_t) tile_size * tile_size;
+	uint64_t i = (uint64_t) (row % tile_size) * tile_size + col % tile_size;
+	const double* layers = (const double*) (data_ + tile.offset);
+	const uint16_t* height_keys =
+			(const uint16_t*) (layers + TERRAIN_MAP_NUM_LAYERS * tile_cells);
+	const uint8_t* valid = (const uint8_t*) (height_keys + tile_cells);
+	if (!valid[i])
+		return false;
+
+	cell.key.x = (vertex >> 16) & 0xFFFF;
+	cell.key.y = vertex & 0xFFFF;
+	cell.key.z = height_keys[i];
+	cell.cost = layers[i];
+	cell.height = layers[tile_cells + i];
+	cell.normal << layers[2 * tile_cells + i], layers[3 * tile_cells + i],
+			layers[4 * tile_cells + i];
+	cell.curvature = layers[5 * tile_cells + i];
+
+	return true;
+}
+
+
+unsigned int TerrainMapFile::getNumberOfTilesX() const
+{
+	return isOpen() ? header_->num_tiles_x : 0;
+}
+
+
+unsigned int TerrainMapFile::getNumberOfTilesY() const
+{
+	return isOpen() ? header_->num_tiles_y : 0;
+}
+
+
+uint64_t TerrainMapFile::getTileBytes(unsigned int tile_size)
+{
+	// Layers of doubles, one of height keys and one of flags
+	uint64_t tile_cells = (uint64_t) tile_size * tile_size;
+	uint64_t bytes = tile_cells *
+			(TERRAIN_MAP_NUM_LAYERS * sizeof(double) + sizeof(uint16_t) + sizeof(uint8_t));
+	return (bytes + 7) & ~((uint64_t) 7);
+}
+
+
+void TerrainMapFile::addTileCells(TerrainData& terrain_data,
+								  unsigned int tile_x,
+								  unsigned int tile_y) const
+{
+	const TileEntry& tile = tiles_[tile_y * header_->num_tiles_x + tile_x];
+	if (tile.num_cells == 0)
+		return;
+
+	unsigned int tile_size = header_->tile_size;
+	uint64_t tile_cells = (uint64_t) tile_size * tile_size;
+	const double* layers = (const double*) (data_ + tile.offset);
+	const uint16_t* height_keys =
+			(const uint16_t*) (layers + TERRAIN_MAP_NUM_LAYERS * tile_cells);
+	const uint8_t* valid = (const uint8_t*) (height_keys + tile_cells);
+	TerrainCell cell;
+	for (unsigned int row = 0; row < tile_size; ++row) {
+		for (unsigned int col = 0; col < tile_size; ++col) {
+			uint64_t i = (uint64_t) row * tile_size + col;
+			if (!valid[i])
+				continue;
+
+			cell.key.x = header_->origin_x + tile_x * tile_size + col;
+			cell.key.y = header_->origin_y + tile_y * tile_size + row;
+			cell.key.z = height_keys[i];
+			cell.cost = layers[i];
+			cell.height = layers[tile_cells + i];
+			cell.normal << layers[2 * tile_cells + i], layers[3 * tile_cells + i],
+					layers[4 * tile_cells + i];
+			cell.curvature = layers[5 * tile_cells + i];
+			terrain_data.data.push_back(cell);
+		}
+	}
+}
+
+} //@namespace environment
+} //@namespace dwl
@@ -0,0 +1,168 @@
+#ifndef DWL__ENVIRONMENT__TERRAIN_MAP_FILE__H
+#define DWL__ENVIRONMENT__TERRAIN_MAP_FILE__H
+
+#include <dwl/environment/TerrainMap.h>
+#include <stdint.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/**
+ * @class TerrainMapFile
+ * @brief Reads and writes snapshots of the terrain and obstacle maps in a versioned binary
+ * format. The terrain cells are stored in squared tiles of contiguous layers (cost, height,
+ * normal, curvature, height key and validity), and a table of tiles gives the offset of each
+ * tile. The file is memory-mapped for reading, so the cells are served from the mapping
+ * without building the terrain map, and only the pages of the accessed tiles are read. Note
+ * that the values are stored with the byte order of the machine, so the snapshots written with
+ * other byte order are rejected. The header, table of tiles and offsets are validated against
+ * the file size when it's opened, so a truncated or corrupted snapshot isn't served. The tiles
+ * have to be inside the key range, otherwise their keys wrap
+ */
+class TerrainMapFile
+{
+	public:
+		/** @brief Constructor function */
+		TerrainMapFile();
+
+		/** @brief Destructor function */
+		~TerrainMapFile();
+
+		/**
+		 * @brief Writes a snapshot of the terrain and obstacle maps
+		 * @param const std::string& Name of the file
+		 * @param const TerrainMap& Terrain map
+		 * @param unsigned int Number of cells per side of a tile (from 1 to 256)
+		 * @return True if the file was written
+		 */
+		bool write(const std::string& filename,
+				   const TerrainMap& terrain,
+				   unsigned int tile_size = 64);
+
+		/**
+		 * @brief Opens and memory-maps a snapshot
+		 * @param const std::string& Name of the file
+		 * @return True if the file is a valid snapshot of the machine byte order
+		 */
+		bool open(const std::string& filename);
+
+		/** @brief Closes the opened snapshot */
+		void close();
+
+		/** @brief Indicates if a snapshot is opened */
+		bool isOpen() const;
+
+		/**
+		 * @brief Loads the whole snapshot into a terrain map
+		 * @param TerrainMap& Terrain map
+		 * @return True if the snapshot was loaded
+		 */
+		bool load(TerrainMap& terrain) const;
+
+		/**
+		 * @brief Loads the cells of a rectangular region into a terrain map, which are read
+		 * from the tiles that overlap it. The cells are applied as a delta of the terrain map.
+		 * Replacing the region evicts the cells outside the region (or that aren't in the
+		 * snapshot) and loads the obstacles of the region, so the terrain map is the region of
+		 * the snapshot, e.g. around the robot
+		 * @param TerrainMap& Terrain map
+		 * @param const Eigen::Vector2d& Minimum corner of the region
+		 * @param const Eigen::Vector2d& Maximum corner of the region
+		 * @param bool Indicates if the terrain map is replaced by the region
+		 * @return True if the region was loaded
+		 */
+		bool loadRegion(TerrainMap& terrain,
+						const Eigen::Vector2d& min_corner,
+						const Eigen::Vector2d& max_corner,
+						bool replace = false) const;
+
+		/**
+		 * @brief Gets the terrain cells of a tile
+		 * @param TerrainData& Terrain cells of the tile
+		 * @param unsigned int Index of the tile along the x-axis
+		 * @param unsigned int Index of the tile along the y-axis
+		 * @return True if the tile is inside the snapshot
+		 */
+		bool getTile(TerrainData& terrain_data,
+					 unsigned int tile_x,
+					 unsigned int tile_y) const;
+
+		/**
+		 * @brief Gets a terrain cell from the mapped snapshot
+		 * @param TerrainCell& Terrain cell
+		 * @param const Vertex& Terrain vertex
+		 * @return True if the vertex is a terrain cell
+		 */
+		bool getTerrainCell(TerrainCell& cell,
+							const Vertex& vertex) const;
+
+		/** @brief Gets the number of tiles along the x-axis */
+		unsigned int getNumberOfTilesX() const;
+
+		/** @brief Gets the number of tiles along the y-axis */
+		unsigned int getNumberOfTilesY() const;
+
+
+	private:
+		/** @brief Header of the snapshot */
+		struct FileHeader
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t byte_order;
+			uint32_t tile_size;
+			uint32_t reserved;
+			double plane_resolution;
+			double height_resolution;
+			double obstacle_plane_resolution;
+			double obstacle_height_resolution;
+			int32_t origin_x;
+			int32_t origin_y;
+			uint32_t num_tiles_x;
+			uint32_t num_tiles_y;
+			uint64_t num_cells;
+			uint64_t num_obstacles;
+			uint64_t obstacles_offset;
+		};
+
+		/** @brief Entry of the table of tiles, whose offset is zero for the empty tiles */
+		struct TileEntry
+		{
+			uint64_t offset;
+			uint64_t num_cells;
+		};
+
+		/**
+		 * @brief Gets the size of the layers of a tile, which is padded to 8 bytes
+		 * @param unsigned int Number of cells per side of a tile
+		 * @return Size of the tile (in bytes)
+		 */
+		static uint64_t getTileBytes(unsigned int tile_size);
+
+		/**
+		 * @brief Appends the valid cells of a tile into terrain data
+		 * @param TerrainData& Terrain data
+		 * @param unsigned int Index of the tile along the x-axis
+		 * @param unsigned int Index of the tile along the y-axis
+		 */
+		void addTileCells(TerrainData& terrain_data,
+						  unsigned int tile_x,
+						  unsigned int tile_y) const;
+
+		/** @brief Mapped snapshot and its size */
+		const char* data_;
+		size_t size_;
+
+		/** @brief Header and table of tiles of the mapped snapshot */
+		const FileHeader* header_;
+		const TileEntry* tiles_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
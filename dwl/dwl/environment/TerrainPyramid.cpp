@@ -0,0 +1,225 @@
+#include <dwl/environment/TerrainPyramid.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+TerrainPyramid::TerrainPyramid()
+{
+
+}
+
+
+TerrainPyramid::~TerrainPyramid()
+{
+
+}
+
+
+void TerrainPyramid::setNumberOfLevels(unsigned int num_levels)
+{
+	// The blocks of the last level can't be bigger than the key range
+	levels_.clear();
+	levels_.resize(std::min(num_levels, (unsigned int) 17));
+}
+
+
+void TerrainPyramid::clear()
+{
+	for (unsigned int l = 0; l < levels_.size(); ++l)
+		levels_[l].clear();
+}
+
+
+void TerrainPyramid::insertCell(unsigned short int key_x,
+								unsigned short int key_y,
+								double height,
+								Weight cost)
+{
+	if (levels_.empty())
+		return;
+
+	PyramidBlock& block = levels_[0][getBlockVertex(key_x, key_y)];
+	block.min_height = height;
+	block.max_height = height;
+	block.sum_height = height;
+	block.min_cost = cost;
+	block.max_cost = cost;
+	block.sum_cost = cost;
+	block.num_cells = 1;
+}
+
+
+void TerrainPyramid::build()
+{
+	for (unsigned int l = 1; l < levels_.size(); ++l) {
+		levels_[l].clear();
+		for (PyramidLevel::const_iterator child_it = levels_[l - 1].begin();
+				child_it != levels_[l - 1].end(); ++child_it) {
+			unsigned int child_x = child_it->first >> 16;
+			unsigned int child_y = child_it->first & 0xFFFF;
+			mergeBlock(levels_[l][getBlockVertex(child_x >> 1, child_y >> 1)], child_it->second);
+		}
+	}
+}
+
+
+void TerrainPyramid::updateCell(unsigned short int key_x,
+								unsigned short int key_y,
+								double height,
+								Weight cost)
+{
+	if (levels_.empty())
+		return;
+
+	insertCell(key_x, key_y, height, cost);
+	updateAncestors(key_x, key_y);
+}
+
+
+void TerrainPyramid::removeCell(unsigned short int key_x,
+								unsigned short int key_y)
+{
+	if (levels_.empty())
+		return;
+
+	if (levels_[0].erase(getBlockVertex(key_x, key_y)) != 0)
+		updateAncestors(key_x, key_y);
+}
+
+
+bool TerrainPyramid::getRegion(TerrainRegion& region,
+							   int min_x, int max_x,
+							   int min_y, int max_y) const
+{
+	region = TerrainRegion();
+	min_x = std::max(min_x, 0);
+	min_y = std::max(min_y, 0);
+	max_x = std::min(max_x, (int) std::numeric_limits<unsigned short int>::max());
+	max_y = std::min(max_y, (int) std::numeric_limits<unsigned short int>::max());
+	if (levels_.empty() || min_x > max_x || min_y > max_y)
+		return false;
+
+	// Starting from the blocks of the last level that overlap the region
+	PyramidBlock aggregate;
+	unsigned int level = levels_.size() - 1;
+	for (int block_x = min_x >> level; block_x <= max_x >> level; ++block_x) {
+		for (int block_y = min_y >> level; block_y <= max_y >> level; ++block_y)
+			searchRegion(aggregate, level, block_x, block_y, min_x, max_x, min_y, max_y);
+	}
+
+	if (aggregate.num_cells == 0)
+		return false;
+
+	region.min_height = aggregate.min_height;
+	region.max_height = aggregate.max_height;
+	region.mean_height = aggregate.sum_height / aggregate.num_cells;
+	region.min_cost = aggregate.min_cost;
+	region.max_cost = aggregate.max_cost;
+	region.mean_cost = aggregate.sum_cost / aggregate.num_cells;
+	region.num_cells = aggregate.num_cells;
+
+	return true;
+}
+
+
+bool TerrainPyramid::isEnabled() const
+{
+	return !levels_.empty();
+}
+
+
+unsigned int TerrainPyramid::getNumberOfLevels() const
+{
+	return levels_.size();
+}
+
+
+void TerrainPyramid::mergeBlock(PyramidBlock& block,
+								const PyramidBlock& child) const
+{
+	if (block.num_cells == 0)
+		block = child;
+	else {
+		block.min_height = std::min(block.min_height, child.min_height);
+		block.max_height = std::max(block.max_height, child.max_height);
+		block.sum_height += child.sum_height;
+		block.min_cost = std::min(block.min_cost, child.min_cost);
+		block.max_cost = std::max(block.max_cost, child.max_cost);
+		block.sum_cost += child.sum_cost;
+		block.num_cells += child.num_cells;
+	}
+}
+
+
+void TerrainPyramid::updateAncestors(unsigned short int key_x,
+									 unsigned short int key_y)
+{
+	for (unsigned int l = 1; l < levels_.size(); ++l) {
+		// Recomputing the block from its four children, since the minimum and maximum
+		// values can't be removed incrementally
+		unsigned int block_x = key_x >> l;
+		unsigned int block_y = key_y >> l;
+		PyramidBlock block;
+		for (unsigned int i = 0; i < 2; ++i) {
+			for (unsigned int j = 0; j < 2; ++j) {
+				PyramidLevel::const_iterator child_it =
+						levels_[l - 1].find(getBlockVertex(2 * block_x + i, 2 * block_y + j));
+				if (child_it != levels_[l - 1].end())
+					mergeBlock(block, child_it->second);
+			}
+		}
+
+		if (block.num_cells == 0)
+			levels_[l].erase(getBlockVertex(block_x, block_y));
+		else
+			levels_[l][getBlockVertex(block_x, block_y)] = block;
+	}
+}
+
+
+void TerrainPyramid::searchRegion(PyramidBlock& region,
+								  unsigned int level,
+								  unsigned int block_x,
+								  unsigned int block_y,
+								  int min_x, int max_x,
+								  int min_y, int max_y) const
+{
+	PyramidLevel::const_iterator block_it = levels_[level].find(getBlockVertex(block_x, block_y));
+	if (block_it == levels_[level].end())
+		return;
+
+	// Using the whole block if it is inside the region
+	int block_min_x = block_x << level;
+	int block_min_y = block_y << level;
+	int block_max_x = block_min_x + (1 << level) - 1;
+	int block_max_y = block_min_y + (1 << level) - 1;
+	if (block_min_x >= min_x && block_max_x <= max_x &&
+			block_min_y >= min_y && block_max_y <= max_y) {
+		mergeBlock(region, block_it->second);
+		return;
+	}
+
+	// Otherwise descending to the children that overlap the region
+	int half_size = 1 << (level - 1);
+	for (unsigned int i = 0; i < 2; ++i) {
+		int child_min_x = block_min_x + i * half_size;
+		if (child_min_x > max_x || child_min_x + half_size - 1 < min_x)
+			continue;
+
+		for (unsigned int j = 0; j < 2; ++j) {
+			int child_min_y = block_min_y + j * half_size;
+			if (child_min_y > max_y || child_min_y + half_size - 1 < min_y)
+				continue;
+
+			searchRegion(region, level - 1, 2 * block_x + i, 2 * block_y + j,
+						 min_x, max_x, min_y, max_y);
+		}
+	}
+}
+
+} //@namespace environment
+} //@namespace dwl
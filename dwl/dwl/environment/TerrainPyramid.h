@@ -0,0 +1,184 @@
+#ifndef DWL__ENVIRONMENT__TERRAIN_PYRAMID__H
+#define DWL__ENVIRONMENT__TERRAIN_PYRAMID__H
+
+#include <dwl/utils/utils.h>
+
+
+namespace dwl
+{
+
+namespace environment
+{
+
+/** @brief Struct that defines the aggregated terrain information of a region */
+struct TerrainRegion
+{
+	TerrainRegion() : min_height(std::numeric_limits<double>::max()),
+			max_height(-std::numeric_limits<double>::max()), mean_height(0.),
+			min_cost(std::numeric_limits<Weight>::max()), max_cost(0.), mean_cost(0.),
+			num_cells(0) {}
+	double min_height;
+	double max_height;
+	double mean_height;
+	Weight min_cost;
+	Weight max_cost;
+	Weight mean_cost;
+	unsigned int num_cells;
+};
+
+/**
+ * @class TerrainPyramid
+ * @brief Mip-map style pyramid of the terrain cells. The level zero has a block per terrain
+ * cell, and each block of the level l aggregates the height (min, max and sum) and cost (min, max
+ * and sum) of the 2^l x 2^l cells below it. The blocks are mapped by their plane keys, so only the
+ * blocks with terrain cells are stored. A rectangular region is answered from the biggest blocks
+ * that fit inside it, i.e. it only descends to the finer levels along the border of the region,
+ * instead of scanning every cell. Changing a cell only updates its ancestors
+ */
+class TerrainPyramid
+{
+	public:
+		/** @brief Constructor function */
+		TerrainPyramid();
+
+		/** @brief Destructor function */
+		~TerrainPyramid();
+
+		/**
+		 * @brief Sets the number of levels, which clears all the blocks. Zero levels disables
+		 * the pyramid
+		 * @param unsigned int Number of levels
+		 */
+		void setNumberOfLevels(unsigned int num_levels);
+
+		/** @brief Clears all the blocks */
+		void clear();
+
+		/**
+		 * @brief Inserts a cell into the level zero without updating its ancestors. It allows
+		 * to build the whole pyramid at once (see build())
+		 * @param unsigned short int Key along the x-axis
+		 * @param unsigned short int Key along the y-axis
+		 * @param double Height of the cell
+		 * @param Weight Cost of the cell
+		 */
+		void insertCell(unsigned short int key_x,
+						unsigned short int key_y,
+						double height,
+						Weight cost);
+
+		/** @brief Builds the blocks of all the levels from the level zero */
+		void build();
+
+		/**
+		 * @brief Sets the values of a cell, and updates its ancestors
+		 * @param unsigned short int Key along the x-axis
+		 * @param unsigned short int Key along the y-axis
+		 * @param double Height of the cell
+		 * @param Weight Cost of the cell
+		 */
+		void updateCell(unsigned short int key_x,
+						unsigned short int key_y,
+						double height,
+						Weight cost);
+
+		/**
+		 * @brief Removes a cell, and updates its ancestors
+		 * @param unsigned short int Key along the x-axis
+		 * @param unsigned short int Key along the y-axis
+		 */
+		void removeCell(unsigned short int key_x,
+						unsigned short int key_y);
+
+		/**
+		 * @brief Gets the aggregated information of the cells of a rectangular region of keys
+		 * @param TerrainRegion& Aggregated information of the region
+		 * @param int Minimum key along the x-axis
+		 * @param int Maximum key along the x-axis (included)
+		 * @param int Minimum key along the y-axis
+		 * @param int Maximum key along the y-axis (included)
+		 * @return True if there are terrain cells in the region
+		 */
+		bool getRegion(TerrainRegion& region,
+					   int min_x, int max_x,
+					   int min_y, int max_y) const;
+
+		/** @brief Indicates if the pyramid has levels */
+		bool isEnabled() const;
+
+		/** @brief Gets the number of levels */
+		unsigned int getNumberOfLevels() const;
+
+
+	private:
+		/** @brief Aggregated information of the cells of a block */
+		struct PyramidBlock
+		{
+			PyramidBlock() : min_height(0.), max_height(0.), sum_height(0.),
+					min_cost(0.), max_cost(0.), sum_cost(0.), num_cells(0) {}
+			double min_height;
+			double max_height;
+			double sum_height;
+			Weight min_cost;
+			Weight max_cost;
+			Weight sum_cost;
+			unsigned int num_cells;
+		};
+
+		typedef std::unordered_map<Vertex,PyramidBlock> PyramidLevel;
+
+		/**
+		 * @brief Gets the vertex of a block from its keys
+		 * @param unsigned int Key of the block along the x-axis
+		 * @param unsigned int Key of the block along the y-axis
+		 * @return Vertex of the block
+		 */
+		inline Vertex getBlockVertex(unsigned int block_x,
+									 unsigned int block_y) const
+		{
+			return ((Vertex) block_x << 16) | block_y;
+		}
+
+		/**
+		 * @brief Merges the information of a block into another one
+		 * @param PyramidBlock& Block that is merged into
+		 * @param const PyramidBlock& Merged block
+		 */
+		void mergeBlock(PyramidBlock& block,
+						const PyramidBlock& child) const;
+
+		/**
+		 * @brief Recomputes the ancestors of a cell from their children
+		 * @param unsigned short int Key along the x-axis
+		 * @param unsigned short int Key along the y-axis
+		 */
+		void updateAncestors(unsigned short int key_x,
+							 unsigned short int key_y);
+
+		/**
+		 * @brief Aggregates the blocks of a level that are inside a rectangular region,
+		 * descending to the children of the blocks that partially overlap it
+		 * @param PyramidBlock& Aggregated information
+		 * @param unsigned int Level
+		 * @param unsigned int Key of the block along the x-axis
+		 * @param unsigned int Key of the block along the y-axis
+		 * @param int Minimum key along the x-axis
+		 * @param int Maximum key along the x-axis (included)
+		 * @param int Minimum key along the y-axis
+		 * @param int Maximum key along the y-axis (included)
+		 */
+		void searchRegion(PyramidBlock& region,
+						  unsigned int level,
+						  unsigned int block_x,
+						  unsigned int block_y,
+						  int min_x, int max_x,
+						  int min_y, int max_y) const;
+
+		/** @brief Blocks of each level */
+		std::vector<PyramidLevel> levels_;
+};
+
+} //@namespace environment
+} //@namespace dwl
+
+#endif
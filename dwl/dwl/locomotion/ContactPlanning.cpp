@@ -30,6 +30,7 @@ void ContactPlanning::reset(robot::Robot* robot,
 	printf(BLUE_ "Setting the terrain information in the %s contact"
 			" planner \n" COLOR_RESET, name_.c_str());
 	terrain_ = terrain;
+	foothold_map_.setRobot(robot);
 
 	for (int i = 0; i < (int) features_.size(); i++)
 		features_[i]->reset(robot);
@@ -71,5 +72,20 @@ std::vector<ContactSearchRegion> ContactPlanning::getContactSearchRegions()
 	return contact_search_regions;
 }
 
+
+environment::FootholdMap& ContactPlanning::getFootholdMap()
+{
+	return foothold_map_;
+}
+
+
+bool ContactPlanning::updateFootholdMap()
+{
+	if (terrain_ == NULL || !terrain_->isTerrainInformation())
+		return false;
+
+	return foothold_map_.update(*terrain_);
+}
+
 } //@namespace locomotion
 } //@namespace dwl
@@ -3,6 +3,7 @@
 
 #include <dwl/environment/TerrainMap.h>
 #include <dwl/environment/Feature.h>
+#include <dwl/environment/FootholdMap.h>
 #include <dwl/robot/Robot.h>
 #include <dwl/utils/utils.h>
 
@@ -66,8 +67,22 @@ class ContactPlanning
 		 */
 		std::vector<dwl::ContactSearchRegion> getContactSearchRegions();
 
+		/**
+		 * @brief Gets the foothold map, e.g. for setting the weights of the foothold scores
+		 * @return The foothold map
+		 */
+		environment::FootholdMap& getFootholdMap();
+
 
 	protected:
+		/**
+		 * @brief Updates the foothold map if the terrain changed since its last update. The
+		 * implementations have to call it before selecting the footholds of a contact sequence.
+		 * Note that there isn't an implementation in this tree yet, so nothing calls it
+		 * @return True if there is foothold information
+		 */
+		bool updateFootholdMap();
+
 		/** @brief Name of the contact planning */
 		std::string name_;
 
@@ -77,6 +92,10 @@ class ContactPlanning
 		/** @brief Pointer to the robot properties information */
 		robot::Robot* robot_;
 
+		/** @brief Foothold scores and reachable cells per leg, which are precomputed once per
+		 * terrain update */
+		environment::FootholdMap foothold_map_;
+
 		/** @brief Vector of features */
 		std::vector<environment::Feature*> features_;
 
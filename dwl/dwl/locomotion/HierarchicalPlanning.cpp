@@ -36,6 +36,9 @@ bool HierarchicalPlanning::compute(Pose current_pose)
 	robot_->setCurrentPose(current_pose);
 
 	if (terrain_->isTerrainInformation()) {
+		// Centering the rolling window of terrain cells in the robot
+		terrain_->moveTerrainWindow(current_pose.position.head<2>());
+
 		// Cleaning global variables
 		std::vector<Pose> empty_body_trajectory;
 		body_path_.swap(empty_body_trajectory);
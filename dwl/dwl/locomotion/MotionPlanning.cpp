@@ -47,6 +47,12 @@ void MotionPlanning::reset(solver::SearchTreeSolver* solver)
 }
 
 
+void MotionPlanning::updateTerrainCells(const std::unordered_set<Vertex>& changed_cells)
+{
+	path_solver_->updateTerrainCells(changed_cells);
+}
+
+
 void MotionPlanning::setComputationTime(double computation_time,
 										bool path_solver)
 {
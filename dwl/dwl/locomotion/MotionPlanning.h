@@ -32,7 +32,7 @@ class MotionPlanning
 		 * @param robot::Robot* Encapsulates all the properties of the robot
 		 * @param environment::TerrainMap* Encapsulates all the terrain information
 		 */
-		void reset(robot::Robot* robot,
+		virtual void reset(robot::Robot* robot,
 				   environment::TerrainMap* environment);
 
 		/**
@@ -51,6 +51,13 @@ class MotionPlanning
 								 Pose start_pose,
 								 Pose goal_pose) = 0;
 
+		/**
+		 * @brief Notifies the terrain cells that changed since the last computed path to the
+		 * path solver, so the incremental solvers could repair their previous search
+		 * @param const std::unordered_set<Vertex>& Changed terrain vertexes
+		 */
+		void updateTerrainCells(const std::unordered_set<Vertex>& changed_cells);
+
 		/**
 		 * @brief Sets the computation time
 		 * @param double Computation time
@@ -0,0 +1,427 @@
+#include <dwl/locomotion/MultiResolutionPlanning.h>
+#include <dwl/utils/Orientation.h>
+
+
+namespace dwl
+{
+
+namespace locomotion
+{
+
+MultiResolutionPlanning::MultiResolutionPlanning() : coarse_solver_(NULL), coarse_revision_(0),
+		block_size_(5), cost_aggregation_(MaxCost), corridor_width_(0.5),
+		is_coarse_terrain_(false)
+{
+	name_ = "Multi-resolution";
+}
+
+
+MultiResolutionPlanning::~MultiResolutionPlanning()
+{
+	delete coarse_solver_;
+}
+
+
+void MultiResolutionPlanning::reset(robot::Robot* robot,
+									environment::TerrainMap* terrain)
+{
+	printf(BLUE_ "Setting the robot properties in the %s planner \n" COLOR_RESET,
+			name_.c_str());
+	robot_ = robot;
+
+	printf(BLUE_ "Setting the environment information in the %s planner\n" COLOR_RESET,
+			name_.c_str());
+	terrain_ = terrain;
+	is_coarse_terrain_ = false;
+
+	// Each level searches over its own terrain information
+	path_solver_->reset(robot, &corridor_terrain_);
+	if (coarse_solver_ != NULL)
+		coarse_solver_->reset(robot, &coarse_terrain_);
+}
+
+
+void MultiResolutionPlanning::setCoarseSolver(solver::SearchTreeSolver* solver)
+{
+	printf(BLUE_ "Setting the %s coarse solver in the %s planner\n" COLOR_RESET,
+			solver->getName().c_str(), name_.c_str());
+	delete coarse_solver_;
+	coarse_solver_ = solver;
+	coarse_solver_->init();
+
+	if (terrain_ != NULL)
+		coarse_solver_->reset(robot_, &coarse_terrain_);
+}
+
+
+void MultiResolutionPlanning::setBlockSize(unsigned int block_size)
+{
+	if (block_size == 0) {
+		printf(YELLOW_ "Warning: the block size should be at least one cell\n" COLOR_RESET);
+		return;
+	}
+
+	block_size_ = block_size;
+	is_coarse_terrain_ = false;
+}
+
+
+void MultiResolutionPlanning::setCostAggregation(CostAggregation aggregation)
+{
+	cost_aggregation_ = aggregation;
+	is_coarse_terrain_ = false;
+}
+
+
+void MultiResolutionPlanning::setCorridorWidth(double width)
+{
+	corridor_width_ = width;
+}
+
+
+bool MultiResolutionPlanning::computePath(std::vector<Pose>& body_path,
+										  Pose start_pose,
+										  Pose goal_pose)
+{
+	if (coarse_solver_ == NULL) {
+		printf(RED_ "Could not compute the body path because it is required to define the"
+				" coarse solver\n" COLOR_RESET);
+		return false;
+	}
+
+	if (terrain_ == NULL || !terrain_->isTerrainInformation())
+		return false;
+
+	// The corridor only confines the grid successors, i.e. the lattice successors would leave it
+	model::AdjacencyModel* adjacency = path_solver_->getAdjacencyModel();
+	if (adjacency == NULL || adjacency->isLatticeRepresentation()) {
+		printf(RED_ "Could not compute the body path because the path solver requires a grid"
+				" adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	// Downsampling the terrain if it changed since the last path. Only the dirty blocks are
+	// updated if the changes are known, and an incremental coarse solver gets the changed
+	// blocks from the dirty region of the coarse terrain
+	if (!is_coarse_terrain_)
+		downsampleTerrain();
+	else if (coarse_revision_ != terrain_->getRevision()) {
+		environment::DirtyRegion region;
+		if (terrain_->getDirtyRegion(region, coarse_revision_))
+			updateCoarseTerrain(region);
+		else
+			downsampleTerrain();
+	}
+
+	Eigen::Vector3d start_state, goal_state;
+	poseToState(start_state, start_pose);
+	poseToState(goal_state, goal_pose);
+
+	// Computing the coarse path over the downsampled terrain. Note that the path is checked
+	// because some solvers don't report the unreachable targets
+	Vertex coarse_start, coarse_goal;
+	coarse_terrain_.getTerrainSpaceModel().stateToVertex(coarse_start, start_state);
+	coarse_terrain_.getTerrainSpaceModel().stateToVertex(coarse_goal, goal_state);
+	std::list<Vertex> coarse_path;
+	if (coarse_solver_->compute(coarse_start, coarse_goal, path_computation_time_))
+		coarse_path = coarse_solver_->getShortestPath(coarse_start, coarse_goal);
+	if (coarse_path.empty() || coarse_path.front() != coarse_start) {
+		printf(YELLOW_ "Could not found a coarse body path\n" COLOR_RESET);
+		return false;
+	}
+
+	// Refining the path in the corridor of the coarse path. The incremental solvers get the
+	// changes of the corridor from its dirty region, so they could repair their previous search
+	buildCorridor(coarse_path);
+
+	Vertex start_vertex, goal_vertex;
+	const environment::SpaceDiscretization& space_model = corridor_terrain_.getTerrainSpaceModel();
+	space_model.stateToVertex(start_vertex, start_state);
+	space_model.stateToVertex(goal_vertex, goal_state);
+	std::list<Vertex> shortest_path;
+	if (path_solver_->compute(start_vertex, goal_vertex, path_computation_time_))
+		shortest_path = path_solver_->getShortestPath(start_vertex, goal_vertex);
+	if (shortest_path.empty() || shortest_path.front() != start_vertex) {
+		printf(YELLOW_ "Could not refine the body path in the corridor\n" COLOR_RESET);
+		return false;
+	}
+
+	// Converting the vertexes to poses. Note that the height of the body is kept
+	body_path.clear();
+	body_path.reserve(shortest_path.size());
+	for (std::list<Vertex>::const_iterator vertex_iter = shortest_path.begin();
+			vertex_iter != shortest_path.end(); ++vertex_iter) {
+		Eigen::Vector3d state;
+		space_model.vertexToState(state, *vertex_iter);
+
+		Pose pose;
+		pose.position << state(0), state(1), start_pose.position(2);
+		pose.orientation = math::getQuaternion(Eigen::Vector3d(0., 0., state(2)));
+		body_path.push_back(pose);
+	}
+
+	return true;
+}
+
+
+const environment::TerrainMap& MultiResolutionPlanning::getCoarseTerrain() const
+{
+	return coarse_terrain_;
+}
+
+
+const environment::TerrainMap& MultiResolutionPlanning::getCorridorTerrain() const
+{
+	return corridor_terrain_;
+}
+
+
+void MultiResolutionPlanning::downsampleTerrain()
+{
+	// Setting the resolution of the coarse level, i.e. the size of the blocks
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	double resolution = terrain_->getResolution(true);
+	double coarse_resolution = block_size_ * resolution;
+	coarse_terrain_.setResolution(coarse_resolution, true);
+	coarse_terrain_.setResolution(terrain_->getResolution(false), false);
+	coarse_terrain_.setStateResolution(coarse_resolution,
+									   space_model.getStateResolution(false));
+
+	// Accumulating the terrain cells of each block
+	std::unordered_map<Vertex, BlockAggregate> blocks;
+	const environment::SpaceDiscretization& coarse_model = coarse_terrain_.getTerrainSpaceModel();
+	const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		Eigen::Vector2d coord;
+		Vertex block_vertex;
+		space_model.vertexToCoord(coord, cell_it->first);
+		coarse_model.coordToVertex(block_vertex, coord);
+
+		addCellToBlock(blocks[block_vertex], cell_it->second);
+	}
+
+	// Building the downsampled terrain
+	TerrainData coarse_data;
+	coarse_data.plane_size = coarse_resolution;
+	coarse_data.height_size = terrain_->getResolution(false);
+	coarse_data.data.reserve(blocks.size());
+	for (std::unordered_map<Vertex, BlockAggregate>::const_iterator block_it = blocks.begin();
+			block_it != blocks.end(); ++block_it) {
+		TerrainCell cell;
+		getBlockCell(cell, block_it->first, block_it->second);
+		coarse_data.data.push_back(cell);
+	}
+	coarse_terrain_.setTerrainMap(coarse_data);
+	copyObstacles(coarse_terrain_);
+
+	coarse_revision_ = terrain_->getRevision();
+	is_coarse_terrain_ = true;
+}
+
+
+void MultiResolutionPlanning::updateCoarseTerrain(const environment::DirtyRegion& region)
+{
+	// Getting the blocks of the dirty cells
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	const environment::SpaceDiscretization& coarse_model = coarse_terrain_.getTerrainSpaceModel();
+	std::unordered_set<Vertex> dirty_blocks;
+	for (std::unordered_set<Vertex>::const_iterator cell_it = region.cells.begin();
+			cell_it != region.cells.end(); ++cell_it) {
+		Eigen::Vector2d coord;
+		Vertex block_vertex;
+		space_model.vertexToCoord(coord, *cell_it);
+		coarse_model.coordToVertex(block_vertex, coord);
+		dirty_blocks.insert(block_vertex);
+	}
+
+	// Aggregating again the terrain cells of the dirty blocks
+	TerrainData coarse_delta;
+	coarse_delta.plane_size = coarse_terrain_.getResolution(true);
+	coarse_delta.height_size = coarse_terrain_.getResolution(false);
+	std::vector<Vertex> removed_blocks;
+	for (std::unordered_set<Vertex>::const_iterator block_it = dirty_blocks.begin();
+			block_it != dirty_blocks.end(); ++block_it) {
+		Key first_key;
+		getBlockFirstKey(first_key, *block_it);
+
+		BlockAggregate block;
+		for (unsigned int i = 0; i < block_size_; ++i) {
+			for (unsigned int j = 0; j < block_size_; ++j) {
+				Key key = first_key;
+				key.x += i;
+				key.y += j;
+				Vertex vertex;
+				space_model.keyToVertex(vertex, key, true);
+				const TerrainCell* cell = terrain_->findTerrainCell(vertex);
+				if (cell != NULL)
+					addCellToBlock(block, *cell);
+			}
+		}
+
+		if (block.num_cells == 0)
+			removed_blocks.push_back(*block_it);
+		else {
+			TerrainCell cell;
+			getBlockCell(cell, *block_it, block);
+			coarse_delta.data.push_back(cell);
+		}
+	}
+	coarse_terrain_.updateTerrainMap(coarse_delta, removed_blocks);
+
+	// Synchronizing the obstacles, note that only the changed ones are notified by the
+	// coarse terrain
+	copyObstacles(coarse_terrain_);
+
+	coarse_revision_ = terrain_->getRevision();
+}
+
+
+void MultiResolutionPlanning::addCellToBlock(BlockAggregate& block,
+											 const TerrainCell& cell)
+{
+	if (cost_aggregation_ == MaxCost)
+		block.cost = std::max(block.cost, cell.cost);
+	else
+		block.cost += cell.cost;
+	block.height_key += cell.key.z;
+	block.normal += cell.normal;
+	block.num_cells++;
+}
+
+
+void MultiResolutionPlanning::getBlockCell(TerrainCell& cell,
+										   Vertex block_vertex,
+										   const BlockAggregate& block)
+{
+	coarse_terrain_.getTerrainSpaceModel().vertexToKey(cell.key, block_vertex, true);
+	cell.key.z = round(block.height_key / block.num_cells);
+	cell.cost = block.cost;
+	if (cost_aggregation_ == MeanCost)
+		cell.cost /= block.num_cells;
+	terrain_->getTerrainSpaceModel().keyToCoord(cell.height, cell.key.z, false);
+	cell.normal = block.normal.normalized();
+}
+
+
+void MultiResolutionPlanning::getBlockFirstKey(Key& first_key,
+											   Vertex block_vertex)
+{
+	// Getting the center of the first terrain cell of the block
+	Eigen::Vector2d block_coord;
+	double resolution = terrain_->getResolution(true);
+	coarse_terrain_.getTerrainSpaceModel().vertexToCoord(block_coord, block_vertex);
+	block_coord.array() -= 0.5 * (coarse_terrain_.getResolution(true) - resolution);
+
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	space_model.coordToKey(first_key.x, block_coord(rbd::X), true);
+	space_model.coordToKey(first_key.y, block_coord(rbd::Y), true);
+}
+
+
+void MultiResolutionPlanning::buildCorridor(const std::list<Vertex>& coarse_path)
+{
+	// Getting the blocks within the corridor width of the coarse path
+	const environment::SpaceDiscretization& coarse_model = coarse_terrain_.getTerrainSpaceModel();
+	int radius = ceil(corridor_width_ / coarse_terrain_.getResolution(true));
+	std::unordered_set<Vertex> corridor_blocks;
+	for (std::list<Vertex>::const_iterator vertex_iter = coarse_path.begin();
+			vertex_iter != coarse_path.end(); ++vertex_iter) {
+		Vertex block_vertex;
+		Key block_key;
+		coarse_model.stateVertexToEnvironmentVertex(block_vertex, *vertex_iter, XY_Y);
+		coarse_model.vertexToKey(block_key, block_vertex, true);
+		for (int dx = -radius; dx <= radius; ++dx) {
+			for (int dy = -radius; dy <= radius; ++dy) {
+				int x = (int) block_key.x + dx, y = (int) block_key.y + dy;
+				if (x < 0 || y < 0 || x > std::numeric_limits<unsigned short int>::max() ||
+						y > std::numeric_limits<unsigned short int>::max())
+					continue;
+
+				Key key = block_key;
+				key.x = x;
+				key.y = y;
+				coarse_model.keyToVertex(block_vertex, key, true);
+				corridor_blocks.insert(block_vertex);
+			}
+		}
+	}
+
+	// Getting the terrain cells of the corridor blocks
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	TerrainData corridor_data;
+	corridor_data.plane_size = terrain_->getResolution(true);
+	corridor_data.height_size = terrain_->getResolution(false);
+	for (std::unordered_set<Vertex>::const_iterator block_it = corridor_blocks.begin();
+			block_it != corridor_blocks.end(); ++block_it) {
+		Key first_key;
+		getBlockFirstKey(first_key, *block_it);
+		for (unsigned int i = 0; i < block_size_; ++i) {
+			for (unsigned int j = 0; j < block_size_; ++j) {
+				Key key = first_key;
+				key.x += i;
+				key.y += j;
+				Vertex vertex;
+				space_model.keyToVertex(vertex, key, true);
+				const TerrainCell* cell = terrain_->findTerrainCell(vertex);
+				if (cell != NULL)
+					corridor_data.data.push_back(*cell);
+			}
+		}
+	}
+
+	corridor_terrain_.setStateResolution(space_model.getStateResolution(true),
+										 space_model.getStateResolution(false));
+	corridor_terrain_.setTerrainMap(corridor_data);
+	copyObstacles(corridor_terrain_, &corridor_blocks);
+}
+
+
+void MultiResolutionPlanning::copyObstacles(environment::TerrainMap& level_terrain,
+											const std::unordered_set<Vertex>* blocks)
+{
+	if (!terrain_->isObstacleInformation() && !level_terrain.isObstacleInformation())
+		return;
+
+	// Getting the obstacles, and the ones inside the blocks if they are defined
+	const environment::SpaceDiscretization& obstacle_model = terrain_->getObstacleSpaceModel();
+	const environment::SpaceDiscretization& coarse_model = coarse_terrain_.getTerrainSpaceModel();
+	double obstacle_resolution = terrain_->getObstacleResolution();
+	const ObstacleMap& obstacle_map = terrain_->getObstacleMap();
+	std::vector<Cell> obstacles;
+	obstacles.reserve(obstacle_map.size());
+	for (ObstacleMap::const_iterator obs_it = obstacle_map.begin();
+			obs_it != obstacle_map.end(); ++obs_it) {
+		if (!obs_it->second)
+			continue;
+
+		if (blocks != NULL) {
+			Eigen::Vector2d coord;
+			Vertex block_vertex;
+			obstacle_model.vertexToCoord(coord, obs_it->first);
+			coarse_model.coordToVertex(block_vertex, coord);
+			if (blocks->find(block_vertex) == blocks->end())
+				continue;
+		}
+
+		Cell cell;
+		obstacle_model.vertexToKey(cell.key, obs_it->first, true);
+		cell.plane_size = obstacle_resolution;
+		cell.height_size = obstacle_resolution;
+		obstacles.push_back(cell);
+	}
+
+	// Setting the obstacles, which notifies the changed obstacles to the level terrain
+	level_terrain.setObstacleMap(obstacles);
+}
+
+
+void MultiResolutionPlanning::poseToState(Eigen::Vector3d& state,
+										  const Pose& pose)
+{
+	Eigen::Vector3d rpy = math::getRPY(pose.orientation);
+	state << pose.position(0), pose.position(1), rpy(2);
+}
+
+} //@namespace locomotion
+} //@namespace dwl
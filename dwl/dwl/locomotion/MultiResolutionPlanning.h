@@ -0,0 +1,193 @@
+#ifndef DWL__LOCOMOTION__MULTI_RESOLUTION_PLANNING__H
+#define DWL__LOCOMOTION__MULTI_RESOLUTION_PLANNING__H
+
+#include <dwl/locomotion/MotionPlanning.h>
+
+
+namespace dwl
+{
+
+namespace locomotion
+{
+
+/** @brief Defines how the cost of the terrain cells is aggregated in a coarse block */
+enum CostAggregation {MaxCost, MeanCost};
+
+/**
+ * @class MultiResolutionPlanning
+ * @brief Computes the body path using a coarse-to-fine approach. First, it searches a coarse path
+ * over a downsampled terrain grid, where each coarse cell aggregates the cost (max or mean) of a
+ * block of terrain cells. Then, it refines the path at the terrain resolution, but confining the
+ * search to a corridor around the coarse path. This class derives from MotionPlanning, the path
+ * solver refines the path and the coarse solver searches over the downsampled terrain, so both
+ * levels could use any SearchTreeSolver. The coarse level could use any adjacency model, but the
+ * path solver requires a grid adjacency model: the grid successors are terrain cells, so they
+ * stay in the corridor, while the lattice successors could leave it because the cells outside
+ * the corridor are unknown instead of forbidden
+ */
+class MultiResolutionPlanning : public MotionPlanning
+{
+	public:
+		/** @brief Constructor function */
+		MultiResolutionPlanning();
+
+		/** @brief Destructor function */
+		~MultiResolutionPlanning();
+
+		using MotionPlanning::reset;
+
+		/**
+		 * @brief Defines the robot and environment information. Note that the coarse solver
+		 * searches over the downsampled terrain, and the path solver over the corridor terrain
+		 * @param robot::Robot* Encapsulates all the properties of the robot
+		 * @param environment::TerrainMap* Encapsulates all the terrain information
+		 */
+		void reset(robot::Robot* robot,
+				   environment::TerrainMap* terrain);
+
+		/**
+		 * @brief Defines the solver of the coarse level. Note that the coarse solver is deleted
+		 * by this class
+		 * @param solver::SearchTreeSolver* Coarse path solver
+		 */
+		void setCoarseSolver(solver::SearchTreeSolver* solver);
+
+		/**
+		 * @brief Sets the number of terrain cells per side of a coarse block
+		 * @param unsigned int Block size (in cells)
+		 */
+		void setBlockSize(unsigned int block_size);
+
+		/**
+		 * @brief Sets how the cost of the terrain cells is aggregated in a coarse block
+		 * @param CostAggregation Type of aggregation
+		 */
+		void setCostAggregation(CostAggregation aggregation);
+
+		/**
+		 * @brief Sets the half width of the corridor around the coarse path
+		 * @param double Half width of the corridor (in meters)
+		 */
+		void setCorridorWidth(double width);
+
+		/**
+		 * @brief Computes a path from start pose to goal pose using the coarse path for
+		 * confining the refinement. The computation time is allowed for each level. It fails
+		 * if the adjacency model of the path solver is a lattice one
+		 * @param std::vector<Pose>& Planned path
+		 * @param Pose Start pose
+		 * @param Pose Goal pose
+		 * @return True if it was computed the path
+		 */
+		bool computePath(std::vector<Pose>& path,
+						 Pose start_pose,
+						 Pose goal_pose);
+
+		/** @brief Gets the downsampled terrain of the coarse level */
+		const environment::TerrainMap& getCoarseTerrain() const;
+
+		/** @brief Gets the corridor terrain of the last refinement */
+		const environment::TerrainMap& getCorridorTerrain() const;
+
+
+	private:
+		/** @brief Defines the aggregated information of the terrain cells of a block */
+		struct BlockAggregate
+		{
+			BlockAggregate() : cost(0.), height_key(0.),
+					normal(Eigen::Vector3d::Zero()), num_cells(0) {}
+			Weight cost;
+			double height_key;
+			Eigen::Vector3d normal;
+			unsigned int num_cells;
+		};
+
+		/** @brief Downsamples the terrain information into blocks */
+		void downsampleTerrain();
+
+		/**
+		 * @brief Updates the blocks of the downsampled terrain that contain dirty cells
+		 * @param const environment::DirtyRegion& Dirty region of the terrain
+		 */
+		void updateCoarseTerrain(const environment::DirtyRegion& region);
+
+		/**
+		 * @brief Adds a terrain cell to the aggregated information of a block
+		 * @param BlockAggregate& Aggregated information of the block
+		 * @param const TerrainCell& Terrain cell
+		 */
+		void addCellToBlock(BlockAggregate& block,
+							const TerrainCell& cell);
+
+		/**
+		 * @brief Gets the coarse cell of a block
+		 * @param TerrainCell& Coarse cell
+		 * @param Vertex Vertex of the block
+		 * @param const BlockAggregate& Aggregated information of the block
+		 */
+		void getBlockCell(TerrainCell& cell,
+						  Vertex block_vertex,
+						  const BlockAggregate& block);
+
+		/**
+		 * @brief Gets the key of the first terrain cell of a block, i.e. its minimum x and y keys
+		 * @param Key& Key of the first terrain cell
+		 * @param Vertex Vertex of the block
+		 */
+		void getBlockFirstKey(Key& first_key,
+							  Vertex block_vertex);
+
+		/**
+		 * @brief Builds the corridor terrain from the terrain cells of the blocks within the
+		 * corridor width of the coarse path. Only the cells of those blocks are visited
+		 * @param const std::list<Vertex>& Coarse path
+		 */
+		void buildCorridor(const std::list<Vertex>& coarse_path);
+
+		/**
+		 * @brief Copies the obstacles of the terrain into the terrain of a level, so both
+		 * levels avoid them. The obstacles keep their resolution
+		 * @param environment::TerrainMap& Terrain of the level
+		 * @param const std::unordered_set<Vertex>* Coarse blocks whose obstacles are copied,
+		 * all the obstacles are copied if it's NULL
+		 */
+		void copyObstacles(environment::TerrainMap& level_terrain,
+						   const std::unordered_set<Vertex>* blocks = NULL);
+
+		/**
+		 * @brief Gets the state (x, y and yaw) of a pose
+		 * @param Eigen::Vector3d& State
+		 * @param const Pose& Pose
+		 */
+		void poseToState(Eigen::Vector3d& state,
+						 const Pose& pose);
+
+		/** @brief Pointer to the coarse path solver */
+		solver::SearchTreeSolver* coarse_solver_;
+
+		/** @brief Downsampled terrain of the coarse level */
+		environment::TerrainMap coarse_terrain_;
+
+		/** @brief Terrain cells of the corridor of the fine level */
+		environment::TerrainMap corridor_terrain_;
+
+		/** @brief Terrain revision of the downsampled terrain */
+		unsigned long coarse_revision_;
+
+		/** @brief Number of terrain cells per side of a coarse block */
+		unsigned int block_size_;
+
+		/** @brief Type of cost aggregation of the blocks */
+		CostAggregation cost_aggregation_;
+
+		/** @brief Half width of the corridor */
+		double corridor_width_;
+
+		/** @brief Indicates if the downsampled terrain is computed */
+		bool is_coarse_terrain_;
+};
+
+} //@namespace locomotion
+} //@namespace dwl
+
+#endif
@@ -147,6 +147,13 @@ void PlanningOfMotionSequence::setTerrainMap(const TerrainData& terrain_map)
 }
 
 
+void PlanningOfMotionSequence::updateTerrainMap(const TerrainData& terrain_delta,
+												const std::vector<Vertex>& removed_cells)
+{
+	terrain_->updateTerrainMap(terrain_delta, removed_cells);
+}
+
+
 void PlanningOfMotionSequence::setObstacleMap(std::vector<Cell> obstacle_map)
 {
 	terrain_->setObstacleMap(obstacle_map);
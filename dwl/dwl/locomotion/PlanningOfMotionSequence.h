@@ -94,6 +94,14 @@ class PlanningOfMotionSequence //TODO clean and define the final class
 		 */
 		void setTerrainMap(const TerrainData& terrain_map);
 
+		/**
+		 * @brief Updates the terrain map with a delta, i.e. the changed and removed cells
+		 * @param const TerrainData& New or modified terrain cells
+		 * @param const std::vector<Vertex>& Removed terrain vertexes
+		 */
+		void updateTerrainMap(const TerrainData& terrain_delta,
+							  const std::vector<Vertex>& removed_cells = std::vector<Vertex>());
+
 		/**
 		 * @brief Sets the obstacle terrain map
 		 * @param std::vector<Cell> Obstacle map of the environment
@@ -110,7 +110,8 @@ ocp::DynamicalSystem* WholeBodyTrajectoryOptimization::getDynamicalSystem()
 
 const WholeBodyTrajectory& WholeBodyTrajectoryOptimization::getWholeBodyTrajectory()
 {
-	return oc_model_.evaluateSolution(solver_->getSolution());
+	oc_model_.evaluateSolution(solver_->getSolution());
+	return oc_model_.getWholeBodyTrajectory();
 }
 
 
@@ -120,7 +121,7 @@ const WholeBodyTrajectory& WholeBodyTrajectoryOptimization::getInterpolatedWhole
 	interpolated_trajectory_.clear();
 
 	// Getting the whole-body trajectory
-	WholeBodyTrajectory trajectory = getWholeBodyTrajectory();
+	const WholeBodyTrajectory& trajectory = getWholeBodyTrajectory();
 
 	// Getting the number of joints and end-effectors
 	unsigned int num_joints = getDynamicalSystem()->getFloatingBaseSystem().getJointDoF();
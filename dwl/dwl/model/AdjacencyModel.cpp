@@ -7,8 +7,8 @@ namespace dwl
 namespace model
 {
 
-AdjacencyModel::AdjacencyModel() :	robot_(NULL), terrain_(NULL), is_lattice_(false),
-		is_added_feature_(false), uncertainty_factor_(1.15)
+AdjacencyModel::AdjacencyModel() :	robot_(NULL), terrain_(NULL), heuristic_field_(NULL),
+		is_lattice_(false), is_added_feature_(false), uncertainty_factor_(1.15)
 {
 
 }
@@ -30,6 +30,8 @@ void AdjacencyModel::reset(robot::Robot* robot,
 	printf(BLUE_ "Setting the environment information in the %s adjacency model"
 			" \n" COLOR_RESET, name_.c_str());
 	terrain_ = environment;
+	if (heuristic_field_ != NULL)
+		heuristic_field_->reset(this, environment);
 
 	for (int i = 0; i < (int) features_.size(); i++)
 		features_[i]->reset(robot);
@@ -45,17 +47,38 @@ void AdjacencyModel::computeAdjacencyMap(AdjacencyMap& adjacency_map,
 }
 
 
+void AdjacencyModel::getPredecessors(std::list<Edge>& predecessors,
+									 Vertex state_vertex)
+{
+	std::list<Edge> neighbors;
+	getSuccessors(neighbors, state_vertex);
+	for (std::list<Edge>::const_iterator neighbor_it = neighbors.begin();
+			neighbor_it != neighbors.end(); ++neighbor_it) {
+		// Getting the weight of the edge from the neighbor to the current vertex
+		std::list<Edge> successors;
+		getSuccessors(successors, neighbor_it->target);
+		for (std::list<Edge>::const_iterator edge_it = successors.begin();
+				edge_it != successors.end(); ++edge_it) {
+			if (edge_it->target == state_vertex) {
+				predecessors.push_back(Edge(neighbor_it->target, edge_it->weight));
+				break;
+			}
+		}
+	}
+}
+
+
 void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 													 Vertex& closest_target,
 													 Vertex source,
 													 Vertex target)
 {
 	// Checking if the start and goal vertex are part of the terrain information
-	bool is_there_start_vertex, is_there_goal_vertex = false;
+	bool is_there_start_vertex = false, is_there_goal_vertex = false;
 	std::vector<Vertex> vertex_map;
 	if (terrain_->isTerrainInformation()) {
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-		for (TerrainDataMap::iterator vertex_iter = terrain_map.begin();
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
 				vertex_iter != terrain_map.end(); vertex_iter++) {
 			Vertex current_vertex = vertex_iter->first;
 			if (source == current_vertex) {
@@ -78,7 +101,8 @@ void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 		return;
 	}
 
-	// Start and goal state
+	// Start and goal state. Note that the terrain cells are stored in a hash map, so the ties
+	// are broken by the lowest vertex id for getting the same vertex regardless of the order
 	Eigen::Vector3d start_state, goal_state;
 	terrain_->getTerrainSpaceModel().vertexToState(start_state, source);
 	terrain_->getTerrainSpaceModel().vertexToState(goal_state, target);
@@ -97,13 +121,17 @@ void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 			double goal_distant = (goal_state.head(2) - current_state.head(2)).norm();
 
 			// Recording the closest vertex from the start position
-			if (start_distant < closest_source_distant) {
+			if (start_distant < closest_source_distant ||
+					(start_distant == closest_source_distant &&
+							vertex_map[i] < start_closest_vertex)) {
 				start_closest_vertex = vertex_map[i];
 				closest_source_distant = start_distant;
 			}
 
 			// Recording the closest vertex from the goal position
-			if (goal_distant < closest_target_distant) {
+			if (goal_distant < closest_target_distant ||
+					(goal_distant == closest_target_distant &&
+							vertex_map[i] < goal_closest_vertex)) {
 				goal_closest_vertex = vertex_map[i];
 				closest_target_distant = goal_distant;
 			}
@@ -122,7 +150,9 @@ void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 			double start_distant = (start_state.head(2) - current_state.head(2)).norm();
 
 			// Recording the closest vertex from the start position
-			if (start_distant < closest_source_distant) {
+			if (start_distant < closest_source_distant ||
+					(start_distant == closest_source_distant &&
+							vertex_map[i] < start_closest_vertex)) {
 				start_closest_vertex = vertex_map[i];
 				closest_source_distant = start_distant;
 			}
@@ -140,7 +170,9 @@ void AdjacencyModel::getTheClosestStartAndGoalVertex(Vertex& closest_source,
 			double goal_distant = (goal_state.head(2) - current_state.head(2)).norm();
 
 			// Recording the closest vertex from the goal position
-			if (goal_distant < closest_target_distant) {
+			if (goal_distant < closest_target_distant ||
+					(goal_distant == closest_target_distant &&
+							vertex_map[i] < goal_closest_vertex)) {
 				goal_closest_vertex = vertex_map[i];
 				closest_target_distant = goal_distant;
 			}
@@ -158,8 +190,8 @@ void AdjacencyModel::getTheClosestVertex(Vertex& closest_vertex,
 	// Checking if the  vertex is part of the terrain information
 	std::vector<Vertex> vertex_map;
 	if (terrain_->isTerrainInformation()) {
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-		for (TerrainDataMap::iterator vertex_iter = terrain_map.begin();
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
 				vertex_iter != terrain_map.end(); vertex_iter++) {
 			Vertex current_vertex = vertex_iter->first;
 			if (vertex == current_vertex) {
@@ -191,8 +223,10 @@ void AdjacencyModel::getTheClosestVertex(Vertex& closest_vertex,
 		double start_distant = (state_vertex.head(2)
 				- current_state_vertex.head(2)).norm();
 
-		// Recording the closest vertex from the start position
-		if (start_distant < closest_distant) {
+		// Recording the closest vertex from the start position, the ties are broken by the
+		// lowest vertex id
+		if (start_distant < closest_distant ||
+				(start_distant == closest_distant && vertex_map[i] < closest_vertex)) {
 			closest_vertex = vertex_map[i];
 			closest_distant = start_distant;
 		}
@@ -202,6 +236,21 @@ void AdjacencyModel::getTheClosestVertex(Vertex& closest_vertex,
 
 double AdjacencyModel::heuristicCost(Vertex source,
 									 Vertex target)
+{
+	// Getting the cost-to-go from the heuristic field, which is computed only for new
+	// targets or terrain information
+	if (heuristic_field_ != NULL && heuristic_field_->compute(target)) {
+		Weight cost_to_go;
+		if (heuristic_field_->getCost(cost_to_go, source))
+			return cost_to_go;
+	}
+
+	return computeGeometricHeuristic(source, target);
+}
+
+
+double AdjacencyModel::computeGeometricHeuristic(Vertex source,
+												 Vertex target)
 {
 	Eigen::Vector3d source_state, target_state;
 	terrain_->getTerrainSpaceModel().vertexToState(source_state, source);
@@ -226,6 +275,55 @@ double AdjacencyModel::heuristicCost(Vertex source,
 }
 
 
+double AdjacencyModel::computeAdmissibleHeuristic(Vertex source,
+												  Vertex target)
+{
+	return 0.;
+}
+
+
+double AdjacencyModel::heuristicCost(Vertex source,
+									 const std::vector<Vertex>& targets)
+{
+	if (targets.size() == 1)
+		return heuristicCost(source, targets.front());
+
+	// Getting the cost-to-go to the closest target from the heuristic field
+	if (heuristic_field_ != NULL && heuristic_field_->compute(targets)) {
+		Weight cost_to_go;
+		if (heuristic_field_->getCost(cost_to_go, source))
+			return cost_to_go;
+	}
+
+	double heuristic = std::numeric_limits<double>::max();
+	for (unsigned int i = 0; i < targets.size(); i++)
+		heuristic = std::min(heuristic, computeGeometricHeuristic(source, targets[i]));
+
+	return heuristic;
+}
+
+
+void AdjacencyModel::setHeuristicField(HeuristicField* heuristic_field)
+{
+	// The goal of the lattice models is reached within a tolerance, so the cost-to-go of the
+	// target vertex isn't a lower bound
+	if (isLatticeRepresentation()) {
+		printf(YELLOW_ "Warning: could not set the heuristic field because it isn't supported"
+				" by the %s adjacency model\n" COLOR_RESET, name_.c_str());
+		return;
+	}
+
+	heuristic_field_ = heuristic_field;
+	heuristic_field_->reset(this, terrain_);
+}
+
+
+bool AdjacencyModel::isHeuristicField()
+{
+	return heuristic_field_ != NULL;
+}
+
+
 bool AdjacencyModel::isReachedGoal(Vertex target,
 								   Vertex current)
 {
@@ -3,6 +3,7 @@
 
 #include <dwl/environment/TerrainMap.h>
 #include <dwl/environment/Feature.h>
+#include <dwl/model/HeuristicField.h>
 #include <dwl/robot/Robot.h>
 #include <dwl/utils/utils.h>
 
@@ -33,8 +34,8 @@ class AdjacencyModel
 		 * @param environment::TerrainMap* Pointer to object that describes the
 		 * terrain environment
 		 */
-		void reset(robot::Robot* robot,
-				   environment::TerrainMap* environment);
+		virtual void reset(robot::Robot* robot,
+						   environment::TerrainMap* environment);
 
 		/**
 		 * @brief Abstract method that computes the whole adjacency map, which
@@ -55,6 +56,17 @@ class AdjacencyModel
 		virtual void getSuccessors(std::list<Edge>& successors,
 								   Vertex state_vertex) = 0;
 
+		/**
+		 * @brief Gets the predecessors of a certain vertex, which are required by backward
+		 * searches such as D* Lite. By default, it assumes that the successors are also the
+		 * predecessors, and the edge weights are computed from their successors. So, the
+		 * models with directed successors have to override it
+		 * @param std::list<Edge>& The predecessors of a certain vertex
+		 * @param Vertex Current state vertex
+		 */
+		virtual void getPredecessors(std::list<Edge>& predecessors,
+									 Vertex state_vertex);
+
 		/**
 		 * @brief Gets the closest start and goal vertex if it is not belong to
 		 * the terrain information
@@ -77,13 +89,63 @@ class AdjacencyModel
 								 Vertex vertex);
 
 		/**
-		 * @brief Estimates the heuristic cost from a source to a target vertex
+		 * @brief Estimates the heuristic cost from a source to a target vertex. It uses the
+		 * heuristic field if it was set, otherwise a geometric estimation
 		 * @param Vertex Source vertex
 		 * @param Vertex Target vertex
 		 */
 		virtual double heuristicCost(Vertex source,
 									 Vertex target);
 
+		/**
+		 * @brief Estimates the heuristic cost from a source to a target vertex from their
+		 * distance and orientation error, i.e. without the heuristic field. The searches
+		 * whose heuristic target changes per query have to use it, because the field would
+		 * be recomputed for each new target
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		virtual double computeGeometricHeuristic(Vertex source,
+												 Vertex target);
+
+		/**
+		 * @brief Estimates a lower bound of the cost from a source to a target vertex, i.e. an
+		 * admissible heuristic. The searches that repair a previous search (e.g. D* Lite)
+		 * require it, because an overestimated cost stops the repair before the changes of
+		 * the edge weights reach the source. By default it's zero, which is admissible for
+		 * every adjacency model, and the geometric heuristic isn't admissible
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		virtual double computeAdmissibleHeuristic(Vertex source,
+												  Vertex target);
+
+		/**
+		 * @brief Estimates the heuristic cost from a source to the closest vertex of a set of
+		 * targets, i.e. the minimum heuristic cost. The heuristic field is computed for the
+		 * whole set of targets
+		 * @param Vertex Source vertex
+		 * @param const std::vector<Vertex>& Target vertexes
+		 */
+		double heuristicCost(Vertex source,
+							 const std::vector<Vertex>& targets);
+
+		/**
+		 * @brief Sets a precomputed heuristic field, which is the cost-to-go of the adjacency
+		 * model for each new target, and it's reused while the terrain doesn't change. Note
+		 * that it's only suitable for forward searches (e.g. A* and ARA*), where the heuristic
+		 * target is fixed, and it isn't supported by the lattice adjacency models. The adjacency
+		 * model doesn't own the field, so the caller has to keep it alive and delete it
+		 * @param HeuristicField* Pointer to the heuristic field
+		 */
+		void setHeuristicField(HeuristicField* heuristic_field);
+
+		/**
+		 * @brief Indicates if it was set a heuristic field
+		 * @return True if it was set a heuristic field
+		 */
+		bool isHeuristicField();
+
 		/**
 		 * @brief Indicates if it is reached the goal
 		 * @param Vertex Goal vertex
@@ -136,6 +198,9 @@ class AdjacencyModel
 		/** @brief Vector of pointers to the Feature class */
 		std::vector<environment::Feature*> features_;
 
+		/** @brief Pointer to the precomputed heuristic field */
+		HeuristicField* heuristic_field_;
+
 		/** @brief Indicates if it is a lattice-based graph */
 		bool is_lattice_;
 
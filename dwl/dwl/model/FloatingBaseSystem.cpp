@@ -667,7 +667,7 @@ const Eigen::VectorXd& FloatingBaseSystem::toGeneralizedJointState(const rbd::Ve
 
 void FloatingBaseSystem::fromGeneralizedJointState(rbd::Vector6d& base_state,
 												   Eigen::VectorXd& joint_state,
-												   const Eigen::VectorXd& generalized_state)
+												   const Eigen::Ref<const Eigen::VectorXd>& generalized_state)
 {
 	// Resizing the joint state
 	joint_state.resize(getJointDoF());
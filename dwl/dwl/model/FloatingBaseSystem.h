@@ -353,11 +353,11 @@ class FloatingBaseSystem
 		 * @brief Converts the generalized joint state to base and joint states
 		 * @param Vector6d& Base state
 		 * @param Eigen::VectorXd& Joint state
-		 * @param const Eigen::VectorXd Generalized joint state
+		 * @param const Eigen::Ref<const Eigen::VectorXd>& Generalized joint state
 		 */
 		void fromGeneralizedJointState(rbd::Vector6d& base_state,
 									   Eigen::VectorXd& joint_state,
-									   const Eigen::VectorXd& generalized_state);
+									   const Eigen::Ref<const Eigen::VectorXd>& generalized_state);
 
 		/**
 		 * @brief Sets the joint state given a branch values
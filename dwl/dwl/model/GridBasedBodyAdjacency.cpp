@@ -1,4 +1,5 @@
 #include <dwl/model/GridBasedBodyAdjacency.h>
+#include <algorithm>
 
 
 namespace dwl
@@ -8,7 +9,8 @@ namespace model
 {
 
 GridBasedBodyAdjacency::GridBasedBodyAdjacency() : is_stance_adjacency_(true),
-		neighboring_definition_(3), number_top_cost_(5), uncertainty_factor_(1.15)
+		neighboring_definition_(3), number_top_cost_(5), uncertainty_factor_(1.15),
+		min_step_cost_(0.), min_step_cost_revision_(0), is_min_step_cost_(false)
 {
 	name_ = "Grid-based Body";
 	is_lattice_ = false;
@@ -21,6 +23,20 @@ GridBasedBodyAdjacency::~GridBasedBodyAdjacency()
 }
 
 
+void GridBasedBodyAdjacency::reset(robot::Robot* robot,
+								   environment::TerrainMap* environment)
+{
+	AdjacencyModel::reset(robot, environment);
+	is_min_step_cost_ = false;
+
+	// Computing a default stance areas
+	if (robot != NULL) {
+		Eigen::Vector3d full_action = Eigen::Vector3d::Zero();
+		stance_areas_ = robot->getFootstepSearchAreas(full_action);
+	}
+}
+
+
 void GridBasedBodyAdjacency::computeAdjacencyMap(AdjacencyMap& adjacency_map,
 												 Vertex source,
 												 Vertex target)
@@ -48,13 +64,20 @@ void GridBasedBodyAdjacency::computeAdjacencyMap(AdjacencyMap& adjacency_map,
 			adjacency_map[closest_target].push_back(Edge(target, 0));
 		}
 
-		// Computing the adjacency map given the terrain information
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-		for (TerrainDataMap::iterator vertex_iter = terrain_map.begin();
-				vertex_iter != terrain_map.end();
-				vertex_iter++)
-		{
-			Vertex vertex = vertex_iter->first;
+		// Computing the adjacency map given the terrain information. The terrain cells are
+		// stored in a hash map, so they are visited in vertex order for getting the same order
+		// of the edges (and the same tie-breaking of the search) in every run
+		const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+		std::vector<Vertex> terrain_vertices;
+		terrain_vertices.reserve(terrain_map.size());
+		for (TerrainDataMap::const_iterator vertex_iter = terrain_map.begin();
+				vertex_iter != terrain_map.end(); vertex_iter++)
+			terrain_vertices.push_back(vertex_iter->first);
+		std::sort(terrain_vertices.begin(), terrain_vertices.end());
+
+		for (unsigned int v = 0; v < terrain_vertices.size(); v++) {
+			Vertex vertex = terrain_vertices[v];
+			TerrainDataMap::const_iterator vertex_iter = terrain_map.find(vertex);
 			Eigen::Vector2d current_coord;
 
 			Vertex state_vertex;
@@ -98,9 +121,6 @@ void GridBasedBodyAdjacency::getSuccessors(std::list<Edge>& successors,
 	std::vector<Vertex> neighbor_actions;
 	searchNeighbors(neighbor_actions, state_vertex);
 	if (terrain_->isTerrainInformation()) {
-		// Getting the terrain map
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-
 		unsigned int action_size = neighbor_actions.size();
 		for (unsigned int i = 0; i < action_size; i++) {
 			// Converting the state vertex (x,y,yaw) to a terrain vertex (x,y)
@@ -124,6 +144,58 @@ void GridBasedBodyAdjacency::getSuccessors(std::list<Edge>& successors,
 }
 
 
+void GridBasedBodyAdjacency::getPredecessors(std::list<Edge>& predecessors,
+											 Vertex state_vertex)
+{
+	if (terrain_->isTerrainInformation()) {
+		// The successors are always terrain cells, so only they have predecessors
+		Vertex terrain_vertex;
+		terrain_->getTerrainSpaceModel().stateVertexToEnvironmentVertex(
+				terrain_vertex,	state_vertex, XY_Y);
+		if (!terrain_->isTerrainCell(terrain_vertex))
+			return;
+
+		// Computing the cost of the current vertex, which is the weight of every edge
+		// that arrives to it
+		double cost;
+		if (!isStanceAdjacency())
+			cost = terrain_->getTerrainCost(terrain_vertex);
+		else
+			computeBodyCost(cost, state_vertex);
+
+		std::vector<Vertex> neighbor_actions;
+		searchNeighbors(neighbor_actions, state_vertex);
+		unsigned int action_size = neighbor_actions.size();
+		for (unsigned int i = 0; i < action_size; i++)
+			predecessors.push_back(Edge(neighbor_actions[i], cost));
+	} else
+		printf(RED_ "Could not computed the predecessors because there is not"
+				" terrain information \n" COLOR_RESET);
+}
+
+
+double GridBasedBodyAdjacency::computeAdmissibleHeuristic(Vertex source,
+														  Vertex target)
+{
+	// Getting the keys of the terrain cells of both vertexes
+	Vertex source_vertex, target_vertex;
+	Key source_key, target_key;
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	space_model.stateVertexToEnvironmentVertex(source_vertex, source, XY_Y);
+	space_model.stateVertexToEnvironmentVertex(target_vertex, target, XY_Y);
+	space_model.vertexToKey(source_key, source_vertex, true);
+	space_model.vertexToKey(target_key, target_vertex, true);
+
+	// Computing the minimum number of edges, i.e. the grid distance over the neighboring
+	// definition
+	int grid_distance = std::max(abs((int) target_key.x - (int) source_key.x),
+								 abs((int) target_key.y - (int) source_key.y));
+	int num_edges = (grid_distance + neighboring_definition_ - 1) / neighboring_definition_;
+
+	return num_edges * getMinimumStepCost();
+}
+
+
 void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_states,
 											 Vertex state_vertex)
 {
@@ -145,9 +217,6 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 	bool is_found_neighbor_positive_xy = false, is_found_neighbor_negative_xy = false;
 	bool is_found_neighbor_positive_yx = false, is_found_neighbor_negative_yx = false;
 	if (terrain_->isTerrainInformation()) {
-		// Getting the terrain map
-		TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-
 		double x, y, yaw;
 
 		// Searching the states neighbors
@@ -159,7 +228,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x + r;
 			searching_key.y = terrain_key.y;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_positive_x)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_positive_x)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -175,7 +244,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x - r;
 			searching_key.y = terrain_key.y;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_negative_x)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_negative_x)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -191,7 +260,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x;
 			searching_key.y = terrain_key.y + r;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_positive_y)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_positive_y)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -207,7 +276,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x;
 			searching_key.y = terrain_key.y - r;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_negative_y)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_negative_y)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -223,7 +292,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x + r;
 			searching_key.y = terrain_key.y + r;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_positive_xy)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_positive_xy)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -239,7 +308,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x - r;
 			searching_key.y = terrain_key.y - r;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_negative_xy)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_negative_xy)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -255,7 +324,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x - r;
 			searching_key.y = terrain_key.y + r;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_positive_yx)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_positive_yx)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -271,7 +340,7 @@ void GridBasedBodyAdjacency::searchNeighbors(std::vector<Vertex>& neighbor_state
 			searching_key.x = terrain_key.x + r;
 			searching_key.y = terrain_key.y - r;
 			terrain_->getTerrainSpaceModel().keyToVertex(neighbor_vertex, searching_key, true);
-			if ((terrain_map.count(neighbor_vertex) > 0) && (!is_found_neighbor_negative_yx)) {
+			if (terrain_->isTerrainCell(neighbor_vertex) && (!is_found_neighbor_negative_yx)) {
 				// Getting the state vertex of the neighbor
 				terrain_->getTerrainSpaceModel().keyToState(x, searching_key.x, true);
 				terrain_->getTerrainSpaceModel().keyToState(y, searching_key.y, true);
@@ -296,9 +365,6 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 	Eigen::Vector3d state;
 	terrain_->getTerrainSpaceModel().vertexToState(state, state_vertex);
 
-	// Getting the terrain map
-	TerrainDataMap terrain_map = terrain_->getTerrainDataMap();
-
 	// Computing the terrain cost
 	double terrain_cost = 0;
 	unsigned int area_size = stance_areas_.size();
@@ -327,10 +393,10 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 				terrain_->getTerrainSpaceModel().coordToVertex(current_2d_vertex, point_position);
 
 				// Inserts the element in an organized vertex queue, according to the maximum value
-				if (terrain_map.count(current_2d_vertex) > 0)
-					stance_cost_queue.insert(std::pair<Weight, Vertex>(
-							terrain_->getTerrainCost(current_2d_vertex),
-							current_2d_vertex));
+				const TerrainCell* cell = terrain_->findTerrainCell(current_2d_vertex);
+				if (cell != NULL)
+					stance_cost_queue.insert(std::pair<Weight, Vertex>(cell->cost,
+																	   current_2d_vertex));
 			}
 		}
 
@@ -361,7 +427,7 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 	info.body_action = default_action;
 	info.pose.position = (Eigen::Vector2d) state.head(2);
 	info.pose.orientation = (double) state(2);
-	info.height_map = terrain_->getTerrainHeightMap();
+	info.height_map = &terrain_->getTerrainHeightMap();
 	info.resolution = terrain_->getResolution(true);
 
 	// Computing the cost of the body features
@@ -379,10 +445,43 @@ void GridBasedBodyAdjacency::computeBodyCost(double& cost,
 }
 
 
+void GridBasedBodyAdjacency::setStanceAdjacency(bool stance_adjacency)
+{
+	is_stance_adjacency_ = stance_adjacency;
+}
+
+
 bool GridBasedBodyAdjacency::isStanceAdjacency()
 {
 	return is_stance_adjacency_;
 }
 
+
+double GridBasedBodyAdjacency::getMinimumStepCost()
+{
+	if (is_min_step_cost_ && min_step_cost_revision_ == terrain_->getRevision())
+		return min_step_cost_;
+
+	// The successors are terrain cells, so their weights are at least the minimum cost of
+	// the terrain cells
+	const TerrainDataMap& terrain_map = terrain_->getTerrainDataMap();
+	double min_cost = std::numeric_limits<double>::max();
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); cell_it++)
+		min_cost = std::min(min_cost, (double) cell_it->second.cost);
+	if (terrain_map.empty())
+		min_cost = 0.;
+
+	// The stance cost of a non-perceived area is the uncertainty cost
+	if (isStanceAdjacency())
+		min_cost = std::min(min_cost, uncertainty_factor_ * terrain_->getAverageCostOfTerrain());
+
+	min_step_cost_ = std::max(min_cost, 0.);
+	min_step_cost_revision_ = terrain_->getRevision();
+	is_min_step_cost_ = true;
+
+	return min_step_cost_;
+}
+
 } //@namespace model
 } //@namespace dwl
@@ -24,6 +24,17 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 		/** @brief Destructor function */
 		~GridBasedBodyAdjacency();
 
+		/**
+		 * @brief Sets the robot and terrain information, and gets the default stance areas of
+		 * the robot, which are required by the successors and predecessors of the stance
+		 * adjacency
+		 * @param robot::Robot* The robot defines all the properties of the robot
+		 * @param environment::TerrainMap* Pointer to object that describes the
+		 * terrain environment
+		 */
+		void reset(robot::Robot* robot,
+				   environment::TerrainMap* environment);
+
 		/**
 		 * @brief Computes the whole adjacency map
 		 * @param AdjacencyMap& Adjacency map
@@ -42,6 +53,34 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 		void getSuccessors(std::list<Edge>& successors,
 						   Vertex state_vertex);
 
+		/**
+		 * @brief Gets the predecessors of the current vertex. Note that the neighborhood is
+		 * symmetric, and the weight of every edge is the cost of its target vertex
+		 * @param std::list<Edge>& List of predecessors
+		 * @param Vertex Current state vertex
+		 */
+		void getPredecessors(std::list<Edge>& predecessors,
+							 Vertex state_vertex);
+
+		/**
+		 * @brief Estimates a lower bound of the cost from a source to a target vertex. Every
+		 * edge moves at most the neighboring definition along each axis, and its weight is
+		 * at least the minimum step cost, so the bound is the minimum number of edges (from
+		 * the grid distance) times the minimum step cost. It assumes that the body features
+		 * add a non-negative cost
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		double computeAdmissibleHeuristic(Vertex source,
+										  Vertex target);
+
+		/**
+		 * @brief Sets if it is computed a stance adjacency (body cost from the stance areas) or
+		 * a terrain adjacency (cost of the terrain cell)
+		 * @param bool True for stance adjacency
+		 */
+		void setStanceAdjacency(bool stance_adjacency);
+
 
 	private:
 		/**
@@ -62,6 +101,14 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 		/** @brief Asks if it is requested a stance adjacency */
 		bool isStanceAdjacency();
 
+		/**
+		 * @brief Gets the minimum weight of the edges, i.e. the minimum cost of the terrain
+		 * cells, or the cost of the non-perceived stance areas if it's lower. It's
+		 * recomputed only when the terrain revision changes
+		 * @return The minimum weight of the edges
+		 */
+		double getMinimumStepCost();
+
 		/** @brief Indicates it was requested a stance or terrain adjacency */
 		bool is_stance_adjacency_;
 
@@ -76,6 +123,11 @@ class GridBasedBodyAdjacency : public AdjacencyModel
 
 		/** @brief Uncertainty factor which is applied in non-perceived environment */
 		double uncertainty_factor_; // For unknown (non-perceive) areas
+
+		/** @brief Minimum weight of the edges and the terrain revision of its computation */
+		double min_step_cost_;
+		unsigned long min_step_cost_revision_;
+		bool is_min_step_cost_;
 };
 
 } //@namespace model
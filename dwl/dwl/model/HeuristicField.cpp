@@ -0,0 +1,101 @@
+#include <dwl/model/HeuristicField.h>
+#include <dwl/solver/Dijkstrap.h>
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+HeuristicField::HeuristicField() : adjacency_(NULL), terrain_(NULL),
+		solver_(new solver::Dijkstrap()), revision_(0), weight_(1.), is_computed_(false)
+{
+
+}
+
+
+HeuristicField::~HeuristicField()
+{
+	delete solver_;
+}
+
+
+void HeuristicField::reset(AdjacencyModel* adjacency,
+						   environment::TerrainMap* terrain)
+{
+	// Note that the solver doesn't delete the adjacency model, because the field is used by
+	// the adjacency model. Both are owned by the caller of AdjacencyModel::setHeuristicField
+	solver_->setAdjacencyModel(adjacency, false);
+	adjacency_ = adjacency;
+	terrain_ = terrain;
+	is_computed_ = false;
+}
+
+
+bool HeuristicField::compute(Vertex target)
+{
+	if (isComputed(target))
+		return true;
+
+	return compute(std::vector<Vertex>(1, target));
+}
+
+
+bool HeuristicField::compute(const std::vector<Vertex>& targets)
+{
+	if (adjacency_ == NULL || terrain_ == NULL || !terrain_->isTerrainInformation()) {
+		printf(YELLOW_ "Warning: could not compute the heuristic field because there is not"
+				" terrain information\n" COLOR_RESET);
+		return false;
+	}
+
+	if (isComputed(targets))
+		return true;
+
+	// Expanding backwards the whole graph that reaches the targets, i.e. the cost-to-go of
+	// every vertex with the edge weights of the adjacency model
+	targets_ = targets;
+	revision_ = terrain_->getRevision();
+	is_computed_ = solver_->computeCostField(targets);
+
+	return is_computed_;
+}
+
+
+bool HeuristicField::isComputed(Vertex target) const
+{
+	if (!is_computed_ || terrain_ == NULL || revision_ != terrain_->getRevision())
+		return false;
+
+	return targets_.size() == 1 && targets_.front() == target;
+}
+
+
+bool HeuristicField::isComputed(const std::vector<Vertex>& targets) const
+{
+	if (!is_computed_ || terrain_ == NULL || revision_ != terrain_->getRevision())
+		return false;
+
+	return targets_ == targets;
+}
+
+
+bool HeuristicField::getCost(Weight& cost,
+							 Vertex state_vertex) const
+{
+	if (!is_computed_ || !solver_->getCost(cost, state_vertex))
+		return false;
+
+	cost *= weight_;
+	return true;
+}
+
+
+void HeuristicField::setWeight(double weight)
+{
+	weight_ = weight;
+}
+
+} //@namespace model
+} //@namespace dwl
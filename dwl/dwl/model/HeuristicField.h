@@ -0,0 +1,122 @@
+#ifndef DWL__MODEL__HEURISTIC_FIELD__H
+#define DWL__MODEL__HEURISTIC_FIELD__H
+
+#include <dwl/environment/TerrainMap.h>
+#include <dwl/utils/utils.h>
+
+
+namespace dwl
+{
+
+// Forward declarations, because the adjacency models and the solvers include the field
+namespace solver
+{
+class Dijkstrap;
+}
+
+namespace model
+{
+
+class AdjacencyModel;
+
+/**
+ * @class HeuristicField
+ * @brief Precomputes the cost-to-go field from a target, and serves it as heuristic of the
+ * adjacency models with O(1) queries. The field is computed by the one-to-all Dijkstrap pass,
+ * which expands the predecessors of the adjacency model, so it's the exact cost-to-go of the
+ * adjacency model (e.g. the terrain and stance adjacencies). The field could be computed for a
+ * set of targets, i.e. the cost-to-go to the closest one. The field is reused while the targets
+ * and the terrain revision don't change. Note that it isn't supported by lattice adjacency
+ * models, because their goal is reached within a tolerance
+ */
+class HeuristicField
+{
+	public:
+		/** @brief Constructor function */
+		HeuristicField();
+
+		/** @brief Destructor function */
+		~HeuristicField();
+
+		/**
+		 * @brief Sets the adjacency model and the terrain information
+		 * @param AdjacencyModel* Pointer to the adjacency model, which isn't owned by the field
+		 * @param environment::TerrainMap* Pointer to the terrain information
+		 */
+		void reset(AdjacencyModel* adjacency,
+				   environment::TerrainMap* terrain);
+
+		/**
+		 * @brief Computes the cost-to-go field of a target, if it wasn't computed for the
+		 * current terrain information
+		 * @param Vertex Target state vertex
+		 * @return True if the field is available
+		 */
+		bool compute(Vertex target);
+
+		/**
+		 * @brief Computes the cost-to-go field of a set of targets, i.e. the cost-to-go to
+		 * the closest target, if it wasn't computed for the current terrain information
+		 * @param const std::vector<Vertex>& Target state vertexes
+		 * @return True if the field is available
+		 */
+		bool compute(const std::vector<Vertex>& targets);
+
+		/**
+		 * @brief Indicates if the field is computed for a target and the current terrain
+		 * @param Vertex Target state vertex
+		 * @return True if it's computed
+		 */
+		bool isComputed(Vertex target) const;
+
+		/**
+		 * @brief Indicates if the field is computed for a set of targets and the current terrain
+		 * @param const std::vector<Vertex>& Target state vertexes
+		 * @return True if it's computed
+		 */
+		bool isComputed(const std::vector<Vertex>& targets) const;
+
+		/**
+		 * @brief Gets the cost-to-go of a state vertex, scaled by the weight of the field
+		 * @param Weight& Cost-to-go
+		 * @param Vertex State vertex
+		 * @return True if the state could reach the target
+		 */
+		bool getCost(Weight& cost,
+					 Vertex state_vertex) const;
+
+		/**
+		 * @brief Sets the weight of the field, e.g. higher than one for trading the optimality
+		 * of the search for less expansions
+		 * @param double Weight of the field
+		 */
+		void setWeight(double weight);
+
+
+	private:
+		/** @brief Pointer of the adjacency model whose cost-to-go is computed */
+		AdjacencyModel* adjacency_;
+
+		/** @brief Pointer of the TerrainMap object which describes the terrain */
+		environment::TerrainMap* terrain_;
+
+		/** @brief One-to-all Dijkstrap solver, which keeps the cost-to-go of the field */
+		solver::Dijkstrap* solver_;
+
+		/** @brief Target state vertexes of the field */
+		std::vector<Vertex> targets_;
+
+		/** @brief Terrain revision of the field */
+		unsigned long revision_;
+
+		/** @brief Weight of the field */
+		double weight_;
+
+		/** @brief Indicates if the field was computed */
+		bool is_computed_;
+};
+
+} //@namespace model
+} //@namespace dwl
+
+#endif
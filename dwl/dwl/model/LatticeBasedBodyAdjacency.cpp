@@ -1,4 +1,5 @@
 #include <dwl/model/LatticeBasedBodyAdjacency.h>
+#include <algorithm>
 
 
 namespace dwl
@@ -7,8 +8,9 @@ namespace dwl
 namespace model
 {
 
-LatticeBasedBodyAdjacency::LatticeBasedBodyAdjacency() : is_stance_adjacency_(true),
-		number_top_cost_(10)
+LatticeBasedBodyAdjacency::LatticeBasedBodyAdjacency() : body_radius_(0.), table_robot_(NULL),
+		table_angular_resolution_(0.), table_obstacle_resolution_(0.),
+		is_stance_adjacency_(true), number_top_cost_(10)
 {
 	name_ = "Lattice-based Body";
 	is_lattice_ = true;
@@ -21,136 +23,294 @@ LatticeBasedBodyAdjacency::~LatticeBasedBodyAdjacency()
 }
 
 
+void LatticeBasedBodyAdjacency::reset(robot::Robot* robot,
+									  environment::TerrainMap* environment)
+{
+	AdjacencyModel::reset(robot, environment);
+
+	// The properties of the robot (e.g. its motor primitives or search areas) could change
+	// without changing its pointer, so the tables are built again in the next expansion
+	primitive_table_.clear();
+	body_footprints_.clear();
+	table_robot_ = NULL;
+}
+
+
 void LatticeBasedBodyAdjacency::getSuccessors(std::list<Edge>& successors,
 											  Vertex state_vertex)
 {
-	// Getting the 3d pose for generating the actions
-	std::vector<Action3d> actions;
+	if (!terrain_->isTerrainInformation()) {
+		printf(RED_ "Could not computed the successors because there is not terrain information \n"
+				COLOR_RESET);
+		return;
+	}
+
+	if (!buildPrimitiveTables())
+		return;
+
+	// Getting the 3d pose and the primitives of its heading
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
 	Eigen::Vector3d current_state;
-	terrain_->getTerrainSpaceModel().vertexToState(current_state, state_vertex);
-
-	// Converting state to pose
-	Pose3d current_pose;
-	current_pose.position = current_state.head(2);
-	current_pose.orientation = current_state(2);
-
-	// Gets actions according the defined body motor primitives
-	robot_->getBodyMotorPrimitive().generateActions(actions, current_pose);
-
-	// Evaluating every action (body motor primitives)
-	if (terrain_->isTerrainInformation()) {
-		unsigned int action_size = actions.size();
-		for (unsigned int i = 0; i < action_size; i++) {
-			// Converting the action to current vertex
-			Eigen::Vector3d action_state;
-			action_state << actions[i].pose.position, actions[i].pose.orientation;
-			Vertex current_action_vertex, terrain_vertex;
-			terrain_->getTerrainSpaceModel().stateToVertex(current_action_vertex, action_state);
-
-			// Converting state vertex to environment vertex
-			terrain_->getTerrainSpaceModel().stateVertexToEnvironmentVertex(terrain_vertex,
-					current_action_vertex, XY_Y);
-
-			// Computing the current action
-			current_action_ = action_state - current_state;
-
-			// Checks if there is an obstacle
-			if (isFreeOfObstacle(current_action_vertex, XY_Y, true)) {
-				if (!isStanceAdjacency()) {
-					double terrain_cost;
-					if (terrain_->getTerrainDataMap().count(terrain_vertex) == 0)
-						terrain_cost = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
-					else
-						terrain_cost = terrain_->getTerrainCost(terrain_vertex);
-
-					successors.push_back(Edge(current_action_vertex, terrain_cost));
-				} else {
-					// Computing the body cost
-					double body_cost;
-					computeBodyCost(body_cost, action_state);
-					body_cost += actions[i].cost;
-					successors.push_back(Edge(current_action_vertex, body_cost));
+	space_model.vertexToState(current_state, state_vertex);
+	const std::vector<HeadingPrimitive>& primitives =
+			primitive_table_[getHeadingIndex(current_state(2))];
+
+	// Evaluating every action (body motor primitives). Each action is stored in its slot, so
+	// the successors keep the order of the primitives
+	unsigned int action_size = primitives.size();
+	action_edges_.resize(action_size);
+	is_free_action_.resize(action_size);
+	stance_costs_.resize(worker_pool_.getNumberOfThreads());
+	worker_pool_.run(action_size, [&](unsigned int action_id, unsigned int thread_id) {
+		is_free_action_[action_id] = evaluateAction(action_edges_[action_id], current_state,
+													primitives[action_id],
+													stance_costs_[thread_id]);
+	});
+
+	for (unsigned int i = 0; i < action_size; i++) {
+		if (is_free_action_[i])
+			successors.push_back(action_edges_[i]);
+	}
+}
+
+
+void LatticeBasedBodyAdjacency::setNumberOfThreads(unsigned int num_threads)
+{
+	worker_pool_.setNumberOfThreads(num_threads);
+}
+
+
+bool LatticeBasedBodyAdjacency::evaluateAction(Edge& edge,
+											   const Eigen::Vector3d& current_state,
+											   const HeadingPrimitive& primitive,
+											   std::vector<Weight>& stance_costs)
+{
+	// Converting the action to current vertex
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	Eigen::Vector3d action_state;
+	action_state << current_state.head(2) + primitive.offset.head(2), primitive.offset(2);
+	Vertex current_action_vertex, terrain_vertex;
+	space_model.stateToVertex(current_action_vertex, action_state);
+
+	// Converting state vertex to environment vertex
+	space_model.stateVertexToEnvironmentVertex(terrain_vertex, current_action_vertex, XY_Y);
+
+	// Checks if there is an obstacle
+	if (!isFreeOfObstacle(current_action_vertex, XY_Y, true))
+		return false;
+
+	edge.target = current_action_vertex;
+	if (!isStanceAdjacency()) {
+		const TerrainCell* cell = terrain_->findTerrainCell(terrain_vertex);
+		if (cell == NULL)
+			edge.weight = uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+		else
+			edge.weight = cell->cost;
+	} else {
+		// Computing the body cost
+		double body_cost;
+		computeBodyCost(body_cost, action_state, primitive, stance_costs);
+		edge.weight = body_cost + primitive.cost;
+	}
+
+	return true;
+}
+
+
+bool LatticeBasedBodyAdjacency::buildPrimitiveTables()
+{
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	double angular_resolution = space_model.getStateResolution(false);
+	double obstacle_resolution = terrain_->getObstacleResolution();
+	if (!primitive_table_.empty() && table_robot_ == robot_ &&
+			table_angular_resolution_ == angular_resolution &&
+			table_obstacle_resolution_ == obstacle_resolution)
+		return true;
+
+	if (angular_resolution <= 0) {
+		printf(RED_ "Could not build the primitive tables because it was not defined the"
+				" angular resolution\n" COLOR_RESET);
+		return false;
+	}
+
+	// Getting the body area of the robot, which is checked with the obstacle resolution
+	SearchArea body_workspace = robot_->getPredefinedBodyWorkspace();
+	double body_resolution = std::max(body_workspace.resolution, obstacle_resolution);
+
+	unsigned int num_headings = ceil(2 * M_PI / angular_resolution);
+	primitive_table_.assign(num_headings, std::vector<HeadingPrimitive>());
+	body_footprints_.assign(num_headings, Eigen::Matrix2Xd());
+	body_radius_ = 0.;
+	for (unsigned int k = 0; k < num_headings; k++) {
+		// Generating the actions from the origin with the yaw of the heading
+		double yaw;
+		space_model.keyToState(yaw, k, false);
+		Pose3d heading_pose;
+		heading_pose.position = Eigen::Vector2d::Zero();
+		heading_pose.orientation = yaw;
+		std::vector<Action3d> actions;
+		robot_->getBodyMotorPrimitive().generateActions(actions, heading_pose);
+
+		primitive_table_[k].resize(actions.size());
+		for (unsigned int i = 0; i < actions.size(); i++) {
+			HeadingPrimitive& primitive = primitive_table_[k][i];
+			primitive.offset << actions[i].pose.position, actions[i].pose.orientation;
+			primitive.body_action << actions[i].pose.position, actions[i].pose.orientation - yaw;
+			primitive.cost = actions[i].cost;
+
+			// Rotating the stance areas of the action by the yaw of the successor
+			SearchAreaMap stance_areas = robot_->getFootstepSearchAreas(primitive.body_action);
+			primitive.stance_footprints.resize(stance_areas.size());
+			primitive.stance_min_corners.setZero(2, stance_areas.size());
+			primitive.stance_max_corners.setZero(2, stance_areas.size());
+			unsigned int n = 0;
+			for (SearchAreaMap::const_iterator area_it = stance_areas.begin();
+					area_it != stance_areas.end(); ++area_it, ++n) {
+				Eigen::Matrix2Xd& footprint = primitive.stance_footprints[n];
+				computeFootprint(footprint, area_it->second,
+								 area_it->second.resolution, primitive.offset(2));
+				if (footprint.cols() != 0) {
+					primitive.stance_min_corners.col(n) = footprint.rowwise().minCoeff();
+					primitive.stance_max_corners.col(n) = footprint.rowwise().maxCoeff();
 				}
 			}
 		}
-	} else
-		printf(RED_ "Could not computed the successors because there is not terrain information \n"
-				COLOR_RESET);
+
+		computeFootprint(body_footprints_[k], body_workspace, body_resolution, yaw);
+		if (body_footprints_[k].cols() != 0)
+			body_radius_ = std::max(body_radius_, body_footprints_[k].colwise().norm().maxCoeff());
+	}
+
+	table_robot_ = robot_;
+	table_angular_resolution_ = angular_resolution;
+	table_obstacle_resolution_ = obstacle_resolution;
+
+	return true;
 }
 
 
-void LatticeBasedBodyAdjacency::computeBodyCost(double& cost,
-												Eigen::Vector3d state)
+unsigned int LatticeBasedBodyAdjacency::getHeadingIndex(double yaw) const
+{
+	// The yaw of a state vertex is a multiple of the angular resolution
+	int num_headings = primitive_table_.size();
+	int index = (int) round(yaw / table_angular_resolution_) % num_headings;
+	if (index < 0)
+		index += num_headings;
+
+	return index;
+}
+
+
+void LatticeBasedBodyAdjacency::computeFootprint(Eigen::Matrix2Xd& footprint,
+												 const SearchArea& area,
+												 double resolution,
+												 double yaw)
 {
-	// Getting the stance areas according to the action
-	stance_areas_ = robot_->getFootstepSearchAreas(current_action_);
+	if (resolution <= 0) {
+		footprint.resize(2, 0);
+		return;
+	}
+
+	// Counting the grid points of the area
+	unsigned int num_x = 0, num_y = 0;
+	for (double x = area.min_x; x <= area.max_x; x += resolution)
+		num_x++;
+	for (double y = area.min_y; y <= area.max_y; y += resolution)
+		num_y++;
+
+	// Computing the rotated coordinate according to the orientation of the body
+	footprint.resize(2, num_x * num_y);
+	double cos_yaw = cos(yaw);
+	double sin_yaw = sin(yaw);
+	unsigned int point = 0;
+	for (double y = area.min_y; y <= area.max_y; y += resolution) {
+		for (double x = area.min_x; x <= area.max_x; x += resolution) {
+			footprint(0, point) = x * cos_yaw - y * sin_yaw;
+			footprint(1, point) = x * sin_yaw + y * cos_yaw;
+			point++;
+		}
+	}
+}
+
 
+void LatticeBasedBodyAdjacency::computeBodyCost(double& cost,
+												const Eigen::Vector3d& state,
+												const HeadingPrimitive& primitive,
+												std::vector<Weight>& stance_costs)
+{
 	// Computing the terrain cost
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	bool is_pyramid = terrain_->getTerrainPyramid().isEnabled();
 	double terrain_cost = 0;
-	unsigned int area_size = stance_areas_.size();
+	unsigned int area_size = primitive.stance_footprints.size();
 	for (unsigned int n = 0; n < area_size; n++) {
-		// Computing the boundary of stance area
-		Eigen::Vector2d boundary_min, boundary_max;
-		boundary_min(0) = stance_areas_[n].min_x + state(0);
-		boundary_min(1) = stance_areas_[n].min_y + state(1);
-		boundary_max(0) = stance_areas_[n].max_x + state(0);
-		boundary_max(1) = stance_areas_[n].max_y + state(1);
-
-		// Computing the stance cost
-		std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > stance_cost_queue;
-		double stance_cost = 0;
-		double resolution = stance_areas_[n].resolution;
-		for (double y = boundary_min(1); y <= boundary_max(1); y += resolution) {
-			for (double x = boundary_min(0); x <= boundary_max(0); x += resolution) {
-				// Computing the rotated coordinate according to the orientation of the body
-				Eigen::Vector2d point_position;
-				double current_x = state(0);
-				double current_y = state(1);
-				double current_yaw = state(2);
-				point_position(0) = (x - current_x) * cos(current_yaw) -
-						(y - current_y) * sin(current_yaw) + current_x;
-				point_position(1) = (x - current_x) * sin(current_yaw) +
-						(y - current_y) * cos(current_yaw) + current_y;
-
-				Vertex current_2d_vertex;
-				terrain_->getTerrainSpaceModel().coordToVertex(current_2d_vertex, point_position);
+		// Querying the bounding box of the stance area in the terrain pyramid. The cells
+		// aren't gathered if there isn't terrain cells, or if all the cells have the same
+		// cost, since the stance cost is known in both cases
+		const Eigen::Matrix2Xd& footprint = primitive.stance_footprints[n];
+		if (is_pyramid && footprint.cols() != 0) {
+			Eigen::Vector2d min_corner = state.head(2) + primitive.stance_min_corners.col(n);
+			Eigen::Vector2d max_corner = state.head(2) + primitive.stance_max_corners.col(n);
+			environment::TerrainRegion region;
+			if (!terrain_->getTerrainRegion(region, min_corner, max_corner)) {
+				terrain_cost += uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
+				continue;
+			}
 
-				// Inserts the element in an organized vertex queue, according to the maximum value
-				if (terrain_->getTerrainDataMap().count(current_2d_vertex) > 0) {
-					stance_cost_queue.insert(std::pair<Weight, Vertex>(
-							terrain_->getTerrainCost(current_2d_vertex),
-							current_2d_vertex));
-				}
+			unsigned short int min_x, min_y, max_x, max_y;
+			space_model.coordToKey(min_x, min_corner(rbd::X), true);
+			space_model.coordToKey(min_y, min_corner(rbd::Y), true);
+			space_model.coordToKey(max_x, max_corner(rbd::X), true);
+			space_model.coordToKey(max_y, max_corner(rbd::Y), true);
+			unsigned int num_cells = (max_x - min_x + 1) * (max_y - min_y + 1);
+			if (number_top_cost_ != 0 && region.num_cells == num_cells &&
+					region.min_cost == region.max_cost) {
+				terrain_cost += region.max_cost;
+				continue;
 			}
 		}
 
-		// Averaging the 5-best (lowest) cost
+		// Gathering the cost of the terrain cells of the stance area
+		stance_costs.clear();
+		for (unsigned int p = 0; p < footprint.cols(); p++) {
+			Eigen::Vector2d point_position = state.head(2) + footprint.col(p);
+			Vertex current_2d_vertex;
+			space_model.coordToVertex(current_2d_vertex, point_position);
+
+			const TerrainCell* cell = terrain_->findTerrainCell(current_2d_vertex);
+			if (cell != NULL)
+				stance_costs.push_back(cell->cost);
+		}
+
+		// Averaging the best (lowest) different costs
+		std::sort(stance_costs.begin(), stance_costs.end());
+		stance_costs.erase(std::unique(stance_costs.begin(), stance_costs.end()),
+						   stance_costs.end());
 		unsigned int number_top_cost = number_top_cost_;
-		if (stance_cost_queue.size() < number_top_cost)
-			number_top_cost = stance_cost_queue.size();
+		if (stance_costs.size() < number_top_cost)
+			number_top_cost = stance_costs.size();
 
+		double stance_cost = 0;
 		if (number_top_cost == 0) {
 			stance_cost += uncertainty_factor_ * terrain_->getAverageCostOfTerrain();
 		} else {
-			for (unsigned int i = 0; i < number_top_cost; i++) {
-				stance_cost += stance_cost_queue.begin()->first;
-				stance_cost_queue.erase(stance_cost_queue.begin());
-			}
+			for (unsigned int i = 0; i < number_top_cost; i++)
+				stance_cost += stance_costs[i];
 
 			stance_cost /= number_top_cost;
 		}
 
 		terrain_cost += stance_cost;
 	}
-	terrain_cost /= stance_areas_.size();
+	terrain_cost /= area_size;
 
 
 	// Getting robot and terrain information
 	RobotAndTerrain info;
-	info.body_action = current_action_;
+	info.body_action = primitive.body_action;
 	info.pose.position = (Eigen::Vector2d) state.head(2);
 	info.pose.orientation = (double) state(2);
-	info.height_map = terrain_->getTerrainHeightMap();
+	info.height_map = &terrain_->getTerrainHeightMap();
 	info.resolution = terrain_->getResolution(true);
 
 	// Computing the cost of the body features
@@ -172,9 +332,6 @@ bool LatticeBasedBodyAdjacency::isFreeOfObstacle(Vertex state_vertex,
 												 TypeOfState state_representation,
 												 bool body)
 {
-	// Getting the terrain obstacle map
-	ObstacleMap obstacle_map = terrain_->getObstacleMap();
-
 	// Converting the vertex to state (x,y,yaw)
 	Eigen::Vector3d state_3d;
 	Eigen::Vector2d state_2d;
@@ -194,40 +351,28 @@ bool LatticeBasedBodyAdjacency::isFreeOfObstacle(Vertex state_vertex,
 	bool is_free = true;
 	if (terrain_->isObstacleInformation()) {
 		if (body) {
-			// Getting the body area of the robot
-			SearchArea body_workspace = robot_->getPredefinedBodyWorkspace();
-
-			// Computing the boundary of stance area
-			Eigen::Vector2d boundary_min, boundary_max;
-			boundary_min(0) = body_workspace.min_x + current_x;
-			boundary_min(1) = body_workspace.min_y + current_y;
-			boundary_max(0) = body_workspace.max_x + current_x;
-			boundary_max(1) = body_workspace.max_y + current_y;
-
-			// Getting the resolution of the obstacle map
-			double obstacle_resolution = terrain_->getObstacleResolution();
-			if (body_workspace.resolution > obstacle_resolution)
-				obstacle_resolution = body_workspace.resolution;
-
-			for (double y = boundary_min(1); y <= boundary_max(1); y += obstacle_resolution) {
-				for (double x = boundary_min(0); x <= boundary_max(0); x += obstacle_resolution) {
-					// Computing the rotated coordinate according to the orientation of the body
-					Eigen::Vector2d point_position;
-					point_position(0) = (x - current_x) * cos(current_yaw) -
-							(y - current_y) * sin(current_yaw) + current_x;
-					point_position(1) = (x - current_x) * sin(current_yaw) +
-							(y - current_y) * cos(current_yaw) + current_y;
-
-					Vertex current_2d_vertex;
-					terrain_->getObstacleSpaceModel().coordToVertex(current_2d_vertex, point_position);
-
-					// Checking if there is an obstacle
-					if (obstacle_map.count(current_2d_vertex) > 0) {
-						if (obstacle_map.find(current_2d_vertex)->second) {
-							is_free = false;
-							goto found_obstacle;
-						}
-					}
+			// Checking the obstacles in the body footprint of the heading
+			if (!buildPrimitiveTables())
+				return false;
+
+			// The footprint is free if the closest obstacle is farther than the footprint,
+			// where the cell sizes of the footprint points and body center are added
+			Eigen::Vector2d current_position(current_x, current_y);
+			double cell_size = sqrt(2) * terrain_->getObstacleSpaceModel().getEnvironmentResolution(true);
+			if (terrain_->getObstacleDistanceField().isEnabled() &&
+					terrain_->getObstacleClearance(current_position) > body_radius_ + cell_size)
+				return true;
+
+			const Eigen::Matrix2Xd& footprint = body_footprints_[getHeadingIndex(current_yaw)];
+			for (unsigned int p = 0; p < footprint.cols(); p++) {
+				Eigen::Vector2d point_position = current_position + footprint.col(p);
+				Vertex current_2d_vertex;
+				terrain_->getObstacleSpaceModel().coordToVertex(current_2d_vertex, point_position);
+
+				// Checking if there is an obstacle
+				if (terrain_->isObstacle(current_2d_vertex)) {
+					is_free = false;
+					break;
 				}
 			}
 		} else {
@@ -236,14 +381,11 @@ bool LatticeBasedBodyAdjacency::isFreeOfObstacle(Vertex state_vertex,
 			terrain_->getObstacleSpaceModel().stateVertexToEnvironmentVertex(terrain_vertex,
 					state_vertex, state_representation);
 
-			if (obstacle_map.count(terrain_vertex) > 0) {
-				if (obstacle_map.find(terrain_vertex)->second)
-					is_free = false;
-			}
+			if (terrain_->isObstacle(terrain_vertex))
+				is_free = false;
 		}
 	}
 
-	found_obstacle:
 	return is_free;
 }
 
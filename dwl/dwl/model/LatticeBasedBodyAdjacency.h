@@ -2,6 +2,7 @@
 #define DWL__MODEL__LATTICE_BASED_BODY_ADJACENCY__H
 
 #include <dwl/model/AdjacencyModel.h>
+#include <dwl/utils/WorkerPool.h>
 
 
 namespace dwl
@@ -10,10 +11,31 @@ namespace dwl
 namespace model
 {
 
+/**
+ * @brief Defines a body motor primitive precomputed for a discretized heading, i.e. the
+ * displacement and yaw of the successor, the body action, the footprints of the stance areas
+ * rotated by the successor yaw and their bounding boxes (a column per stance area)
+ */
+struct HeadingPrimitive
+{
+	Eigen::Vector3d offset;
+	Eigen::Vector3d body_action;
+	Weight cost;
+	std::vector<Eigen::Matrix2Xd> stance_footprints;
+	Eigen::Matrix2Xd stance_min_corners;
+	Eigen::Matrix2Xd stance_max_corners;
+};
+
+
 /**
  * @class LatticeBasedBodyAdjacency
  * @brief Class for building a lattice-based adjacency map of the environment. This class derives
- * from AdjacencyModel class
+ * from AdjacencyModel class. The body motor primitives are precomputed per discretized heading,
+ * so the successors are generated by table lookups and gathers of terrain costs. The gathers are
+ * skipped for the stance areas without terrain cells or with a uniform cost, which are found by
+ * region queries of the terrain pyramid (if it's enabled). The actions of an expansion could be
+ * evaluated in parallel, which gives the same successors than the serial evaluation. Note that
+ * the features have to be reentrant in that case
  */
 class LatticeBasedBodyAdjacency : public AdjacencyModel
 {
@@ -24,6 +46,16 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 		/** @brief Destructor function */
 		~LatticeBasedBodyAdjacency();
 
+		/**
+		 * @brief Sets the robot and terrain information, and discards the primitive tables, so
+		 * they are built again from the current properties of the robot
+		 * @param robot::Robot* The robot defines all the properties of the robot
+		 * @param environment::TerrainMap* Pointer to object that describes the
+		 * terrain environment
+		 */
+		void reset(robot::Robot* robot,
+				   environment::TerrainMap* environment);
+
 		/**
 		 * @brief Gets the successors of the current vertex
 		 * @param std::list<Edge>& List of successors
@@ -32,8 +64,56 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 		void getSuccessors(std::list<Edge>& successors,
 						   Vertex state_vertex);
 
+		/**
+		 * @brief Sets the number of threads that evaluate the actions of an expansion. One
+		 * thread (default) evaluates them serially, and zero uses the hardware threads. With
+		 * more threads, the body features are computed concurrently, so their computeCost
+		 * (from robot and terrain information) has to be reentrant
+		 * @param unsigned int Number of threads
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
 
 	private:
+		/**
+		 * @brief Builds the primitive and body footprint tables per discretized heading, if
+		 * they weren't built since the last reset or the resolutions changed
+		 * @return True if the tables are available
+		 */
+		bool buildPrimitiveTables();
+
+		/**
+		 * @brief Gets the heading index of a yaw angle
+		 * @param double Yaw angle
+		 * @return The heading index
+		 */
+		unsigned int getHeadingIndex(double yaw) const;
+
+		/**
+		 * @brief Computes the rotated offsets of the grid points of an area
+		 * @param Eigen::Matrix2Xd& Rotated offsets
+		 * @param const SearchArea& Area relative to the body
+		 * @param double Resolution of the grid points
+		 * @param double Yaw angle of the body
+		 */
+		void computeFootprint(Eigen::Matrix2Xd& footprint,
+							  const SearchArea& area,
+							  double resolution,
+							  double yaw);
+
+		/**
+		 * @brief Evaluates an action of the current state
+		 * @param Edge& Edge to the successor
+		 * @param const Eigen::Vector3d& Current state (x,y,yaw)
+		 * @param const HeadingPrimitive& Primitive of the action
+		 * @param std::vector<Weight>& Workspace for the stance costs
+		 * @return True if the successor is free of obstacles
+		 */
+		bool evaluateAction(Edge& edge,
+							const Eigen::Vector3d& current_state,
+							const HeadingPrimitive& primitive,
+							std::vector<Weight>& stance_costs);
+
 		/**
 		 * @brief Searches the neighbors of a current vertex
 		 * @param std::vector<Vertex>& The set of neighbors
@@ -44,10 +124,15 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 
 		/**
 		 * @brief Computes the body cost of a current vertex
-		 * @param Eigen::Vector3d Current robot state (x,y,yaw)
+		 * @param double& Body cost
+		 * @param const Eigen::Vector3d& Current robot state (x,y,yaw)
+		 * @param const HeadingPrimitive& Primitive that reaches the current state
+		 * @param std::vector<Weight>& Workspace for the stance costs
 		 */
 		void computeBodyCost(double& cost,
-							 Eigen::Vector3d state);
+							 const Eigen::Vector3d& state,
+							 const HeadingPrimitive& primitive,
+							 std::vector<Weight>& stance_costs);
 
 		/**
 		 * @brief Indicates if the free of obstacle
@@ -66,14 +151,32 @@ class LatticeBasedBodyAdjacency : public AdjacencyModel
 		 */
 		bool isStanceAdjacency();
 
-		/** @brief Current action of the body */
-		Eigen::Vector3d current_action_;
+		/** @brief Precomputed body motor primitives per heading index */
+		std::vector<std::vector<HeadingPrimitive> > primitive_table_;
+
+		/** @brief Rotated offsets of the body workspace per heading index */
+		std::vector<Eigen::Matrix2Xd> body_footprints_;
+
+		/** @brief Maximum distance between the body footprint and its center */
+		double body_radius_;
+
+		/** @brief Robot and resolutions used for building the tables */
+		robot::Robot* table_robot_;
+		double table_angular_resolution_;
+		double table_obstacle_resolution_;
 
 		/** @brief Indicates it was requested a stance or terrain adjacency */
 		bool is_stance_adjacency_;
 
-		/** @brief Map of search areas */
-		SearchAreaMap stance_areas_;
+		/** @brief Pool of threads that evaluate the actions */
+		utils::WorkerPool worker_pool_;
+
+		/** @brief Edges of the evaluated actions, and if they are free of obstacles */
+		std::vector<Edge> action_edges_;
+		std::vector<char> is_free_action_;
+
+		/** @brief Cost of the cells of a stance area per thread, kept for avoiding allocations */
+		std::vector<std::vector<Weight> > stance_costs_;
 
 		/** @brief Number of top cost for computing the stance cost */
 		int number_top_cost_;
@@ -148,80 +148,78 @@ void OptimizationModel::evaluateConstraints(double* constraint, int constraint_d
 double OptimizationModel::evaluateAsSoftConstraints(
 												  const double* decision, int decision_dim)
 {
-	// Initialization of the cost value
-	double cost = 0.;
-
-	// Getting the constraint value and bounds
-	double g[constraint_dimension_];
-	Eigen::Map<Eigen::VectorXd> constraint(g, constraint_dimension_);
-
-	// Computing the constraint
-	evaluateConstraints(g, constraint_dimension_,
+	// Getting the bounds of the optimization problem and allocating the workspace. Note that
+	// it's allocated again if the dimension of the constraints changed, otherwise the
+	// evaluation writes outside the buffer
+	if (!bounds_ || soft_constraint_.size() != (int) constraint_dimension_)
+		initSoftConstraintWorkspace(decision_dim);
+
+	// Computing the constraint inside the preallocated buffer
+	evaluateConstraints(soft_constraint_.data(), constraint_dimension_,
 						decision, decision_dim);
 
+	// Computing the violation vector given the soft-constraint family
+	switch (soft_properties_.family) {
+	case UNWEIGHTED:
+		computeUnweightedViolation(soft_violation_, soft_constraint_);
+		break;
+	case QUADRATIC:
+		computeQuadraticViolation(soft_violation_, soft_constraint_);
+		break;
+	default:
+		computeQuadraticViolation(soft_violation_, soft_constraint_);
+		break;
+	}
 
-	// Getting the bounds of the optimization problem just ones
-	if (!bounds_) {
-		// Eigen interfacing to raw buffers
-		double x_l[decision_dim], x_u[decision_dim];
-		double g_l[constraint_dimension_], g_u[constraint_dimension_];
-		Eigen::Map<Eigen::VectorXd> state_lower_bound(x_l, decision_dim);
-		Eigen::Map<Eigen::VectorXd> state_upper_bound(x_u, decision_dim);
-		Eigen::Map<Eigen::VectorXd> constraint_lower_bound(g_l, constraint_dimension_);
-		Eigen::Map<Eigen::VectorXd> constraint_upper_bound(g_u, constraint_dimension_);
+	// Adding the offset cost if any of the (non-thresholded) bounds is violated
+	double offset_cost = 0.;
+	if ((soft_constraint_.array() > g_ubound_.array()).any() ||
+			(soft_constraint_.array() < g_lbound_.array()).any())
+		offset_cost = soft_properties_.offset;
 
-		// Evaluating the bounds. Note that CMA-ES cannot handle hard constraints
-		evaluateBounds(x_l, decision_dim, x_u, decision_dim,
-					   g_l, constraint_dimension_, g_u, constraint_dimension_);
-		g_lbound_ = constraint_lower_bound;
-		g_ubound_ = constraint_upper_bound;
+	// Computing a weighted quadratic cost of the constraint violation
+	return soft_properties_.weight * soft_violation_.norm() + offset_cost;
+}
 
-		bounds_ = true;
-	}
 
-	// Computing the violation vector
-	double offset_cost = 0.;
-	Eigen::VectorXd violation_vec = Eigen::VectorXd::Zero(constraint_dimension_);
-	for (unsigned int i = 0; i < constraint_dimension_; ++i) {
-		double lower_val = g_lbound_(i) + soft_properties_.threshold;
-		double upper_val = g_ubound_(i) - soft_properties_.threshold;
-		double const_val = constraint(i);
-		if (lower_val > const_val) {
-			switch (soft_properties_.family) {
-			case UNWEIGHTED:
-				violation_vec(i) += 1.;
-				break;
-			case QUADRATIC:
-				violation_vec(i) += lower_val - const_val;
-				break;
-			default:
-				violation_vec(i) += lower_val - const_val;
-				break;
-			}
-		}
+void OptimizationModel::initSoftConstraintWorkspace(int decision_dim)
+{
+	// Allocating the soft-constraint buffers
+	soft_constraint_.setZero(constraint_dimension_);
+	soft_violation_.setZero(constraint_dimension_);
+
+	// Evaluating the bounds. Note that CMA-ES cannot handle hard constraints
+	Eigen::VectorXd x_lbound(decision_dim), x_ubound(decision_dim);
+	g_lbound_.resize(constraint_dimension_);
+	g_ubound_.resize(constraint_dimension_);
+	evaluateBounds(x_lbound.data(), decision_dim,
+				   x_ubound.data(), decision_dim,
+				   g_lbound_.data(), constraint_dimension_,
+				   g_ubound_.data(), constraint_dimension_);
+
+	bounds_ = true;
+}
 
-		if (upper_val < const_val) {
-			switch (soft_properties_.family) {
-			case UNWEIGHTED:
-				violation_vec(i) += 1.;
-				break;
-			case QUADRATIC:
-				violation_vec(i) += const_val - upper_val;
-				break;
-			default:
-				violation_vec(i) += const_val - upper_val;
-				break;
-			}
-		}
 
-		if (g_ubound_(i) < const_val || g_lbound_(i) > const_val)
-			offset_cost = soft_properties_.offset;
-	}
+void OptimizationModel::computeQuadraticViolation(Eigen::VectorXd& violation,
+												  const Eigen::VectorXd& constraint)
+{
+	// Distance to the thresholded lower and upper bounds, zero inside the bounds
+	double threshold = soft_properties_.threshold;
+	violation =
+			(g_lbound_.array() + threshold - constraint.array()).max(0.) +
+			(constraint.array() - g_ubound_.array() + threshold).max(0.);
+}
 
-	// Computing a weighted quadratic cost of the constraint violation
-	cost = soft_properties_.weight * violation_vec.norm() + offset_cost;
 
-	return cost;
+void OptimizationModel::computeUnweightedViolation(Eigen::VectorXd& violation,
+												   const Eigen::VectorXd& constraint)
+{
+	// One per each violated thresholded bound
+	double threshold = soft_properties_.threshold;
+	violation =
+			(g_lbound_.array() + threshold > constraint.array()).cast<double>() +
+			(g_ubound_.array() - threshold < constraint.array()).cast<double>();
 }
 
 
@@ -295,5 +293,11 @@ bool OptimizationModel::isSoftConstraint()
 	return soft_constraints_;
 }
 
+
+utils::Profiler& OptimizationModel::getProfiler()
+{
+	return profiler_;
+}
+
 } //@namespace model
 } //@namespace dwl
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define DWL__MODEL__OPTIMIZATION_MODEL__H
 
 #include <dwl/utils/utils.h>
+#include <dwl/utils/Profiler.h>
 #include <unsupported/Eigen/NumericalDiff>
 
 #define NO_BOUND 2e19
@@ -255,8 +256,39 @@ class OptimizationModel
 		/** @brief Indicates is the constraint is implemented as soft-constraint */
 		bool isSoftConstraint();
 
+		/**
+		 * @brief Gets the profiler that records the evaluations of this model
+		 * @return utils::Profiler& The profiler
+		 */
+		utils::Profiler& getProfiler();
+
 
 	protected:
+		/**
+		 * @brief Initializes the soft-constraint workspace, i.e. it allocates the constraint
+		 * and violation buffers, and evaluates the constraint bounds just once
+		 * @param int Number of decision variables (dimension of $x$)
+		 */
+		void initSoftConstraintWorkspace(int decision_dim);
+
+		/**
+		 * @brief Computes the violation vector for the quadratic family, i.e. the distance
+		 * of the constraint value to the (thresholded) bounds
+		 * @param Eigen::VectorXd& Violation vector
+		 * @param const Eigen::VectorXd& Constraint value, $g(x)$
+		 */
+		void computeQuadraticViolation(Eigen::VectorXd& violation,
+									   const Eigen::VectorXd& constraint);
+
+		/**
+		 * @brief Computes the violation vector for the unweighted family, i.e. one for
+		 * each violated (thresholded) bound
+		 * @param Eigen::VectorXd& Violation vector
+		 * @param const Eigen::VectorXd& Constraint value, $g(x)$
+		 */
+		void computeUnweightedViolation(Eigen::VectorXd& violation,
+										const Eigen::VectorXd& constraint);
+
 		/**@brief The solution vector */
 		double* solution_;
 
@@ -272,6 +304,9 @@ class OptimizationModel
 		/** @brief Number of nonzero values of the Hessian */
 		unsigned int nonzero_hessian_;
 
+		/** @brief Profiler of the evaluations done by the solvers */
+		utils::Profiler profiler_;
+
 
 	private:
 		/** @brief True if the gradient of the cost function is implemented */
@@ -304,6 +339,12 @@ class OptimizationModel
 		/** @brief Lower and upper bound of the constraints */
 		Eigen::VectorXd g_lbound_, g_ubound_;
 
+		/** @brief Soft-constraint workspace, i.e. the constraint value and its violation.
+		 * These buffers are preallocated in order to avoid heap (or stack) allocations
+		 * in every soft-constraint evaluation. Note that the solvers (e.g. CMA-ES) have
+		 * to serialize the fitness calls that use this workspace */
+		Eigen::VectorXd soft_constraint_, soft_violation_;
+
 		/** @brief Soft-constraints properties */
 		SoftConstraintProperties soft_properties_;
 };
@@ -3,6 +3,7 @@
 
 #include <dwl/model/WholeBodyKinematics.h>
 #include <dwl/model/WholeBodyDynamics.h>
+#include <dwl/ocp/WholeBodyStateView.h>
 #include <dwl/utils/URDF.h>
 #include <dwl/utils/utils.h>
 #include <boost/shared_ptr.hpp>
@@ -95,6 +96,14 @@ class Constraint
 		void computeSoft(double& constraint_cost,
 						 const TState& state);
 
+		/**
+		 * @brief Computes the soft-value of the constraint given a view of the decision state
+		 * @param double& Soft-value or the associated cost to the constraint
+		 * @param const WholeBodyStateView& View of the decision state
+		 */
+		void computeSoft(double& constraint_cost,
+						 const WholeBodyStateView& state_view);
+
 		/**
 		 * @brief Computes the constraint vector given a certain state
 		 * @param Eigen::VectorXd& Evaluated constraint function
@@ -103,6 +112,17 @@ class Constraint
 		virtual void compute(Eigen::VectorXd& constraint,
 							 const TState& state) = 0;
 
+		/**
+		 * @brief Computes the constraint vector given a view of the decision state. By
+		 * default, the whole-body constraints evaluate the decoded whole-body state of the
+		 * view, so the ones that only read a few variables could override it for reading them
+		 * from the decision buffer. The other constraints have to implement it
+		 * @param Eigen::VectorXd& Evaluated constraint function
+		 * @param const WholeBodyStateView& View of the decision state
+		 */
+		virtual void compute(Eigen::VectorXd& constraint,
+							 const WholeBodyStateView& state_view);
+
 		/**
 		 * @brief Gets the lower and upper bounds of the constraint
 		 * @param Eigen::VectorXd& Lower constraint bound
@@ -123,9 +143,9 @@ class Constraint
 
 		/**
 		 * @brief Sets the last state that could be used for the constraint
-		 * @param TState& Last whole-body state
+		 * @param const TState& Last whole-body state
 		 */
-		void setLastState(TState& last_state);
+		void setLastState(const TState& last_state);
 
 		/** @brief Resets the state buffer */
 		void resetStateBuffer();
@@ -141,6 +161,14 @@ class Constraint
 
 
 	protected:
+		/**
+		 * @brief Computes the soft-value of an evaluated constraint vector
+		 * @param double& Soft-value or the associated cost to the constraint
+		 * @param const Eigen::VectorXd& Evaluated constraint function
+		 */
+		void computeSoftValue(double& constraint_cost,
+							  const Eigen::VectorXd& constraint);
+
 		/** @brief Name of the constraint */
 		std::string name_;
 
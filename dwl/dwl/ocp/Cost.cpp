@@ -19,6 +19,13 @@ Cost::~Cost()
 }
 
 
+void Cost::compute(double& cost,
+				   const WholeBodyStateView& state_view)
+{
+	compute(cost, state_view.getWholeBodyState());
+}
+
+
 void Cost::setWeights(const WholeBodyState& weights)
 {
 	// Checking the cost variables
@@ -1,6 +1,7 @@
 #ifndef DWL__OCP__COST__H
 #define DWL__OCP__COST__H
 
+#include <dwl/ocp/WholeBodyStateView.h>
 #include <dwl/utils/utils.h>
 
 
@@ -52,6 +53,16 @@ class Cost
 		virtual void compute(double& cost,
 							 const WholeBodyState& state) = 0;
 
+		/**
+		 * @brief Computes the cost value given a view of the decision state. By default, it
+		 * evaluates the decoded whole-body state of the view, so the costs that only read a
+		 * few variables could override it for reading them from the decision buffer
+		 * @param double& Cost value
+		 * @param const WholeBodyStateView& View of the decision state
+		 */
+		virtual void compute(double& cost,
+							 const WholeBodyStateView& state_view);
+
 		/**
 		 * @brief Sets the whole-body state weights which are used by specific cost function
 		 * @param WholeBodyState& Whole-body weights
@@ -9,7 +9,7 @@ namespace ocp
 
 DynamicalSystem::DynamicalSystem() : state_dimension_(0), terminal_constraint_dimension_(0),
 		system_variables_(false), integration_method_(Fixed), step_time_(0.1),
-		is_full_trajectory_optimization_(false)
+		is_layout_computed_(false), is_full_trajectory_optimization_(false)
 {
 
 }
@@ -274,133 +274,125 @@ void DynamicalSystem::setFullTrajectoryOptimization()
 void DynamicalSystem::toWholeBodyState(WholeBodyState& system_state,
 									   const Eigen::VectorXd& generalized_state)
 {
-	// Resizing the joint dimensions
-	system_state.joint_pos = Eigen::VectorXd::Zero(system_.getJointDoF());
-	system_state.joint_vel = Eigen::VectorXd::Zero(system_.getJointDoF());
-	system_state.joint_acc = Eigen::VectorXd::Zero(system_.getJointDoF());
-	system_state.joint_eff = Eigen::VectorXd::Zero(system_.getJointDoF());
+	toWholeBodyState(system_state, getStateView(generalized_state.data()));
+}
+
+
+void DynamicalSystem::toWholeBodyState(WholeBodyState& system_state,
+									   const WholeBodyStateView& state_view)
+{
+	// Resizing the joint dimensions. Note that there isn't memory allocation if the
+	// whole-body state has already the right dimension
+	unsigned int num_joints = system_.getJointDoF();
+	system_state.joint_pos.setZero(num_joints);
+	system_state.joint_vel.setZero(num_joints);
+	system_state.joint_acc.setZero(num_joints);
+	system_state.joint_eff.setZero(num_joints);
 
 	// Converting the generalized state vector to locomotion state
-	unsigned int idx = 0;
-	if (system_variables_.time) {
-		system_state.duration = generalized_state(idx);
-		++idx;
-	}
-	if (system_variables_.position) {
+	if (state_view.hasTime())
+		system_state.duration = state_view.getDuration();
+	if (state_view.hasPosition())
 		system_.fromGeneralizedJointState(system_state.base_pos,
 										  system_state.joint_pos,
-										  (Eigen::VectorXd) generalized_state.segment(idx, system_.getSystemDoF()));
-		idx += system_.getSystemDoF();
-	}
-	if (system_variables_.velocity) {
+										  state_view.getGeneralizedPosition());
+	if (state_view.hasVelocity())
 		system_.fromGeneralizedJointState(system_state.base_vel,
 										  system_state.joint_vel,
-										  (Eigen::VectorXd) generalized_state.segment(idx, system_.getSystemDoF()));
-		idx += system_.getSystemDoF();
-	}
-	if (system_variables_.acceleration) {
+										  state_view.getGeneralizedVelocity());
+	if (state_view.hasAcceleration())
 		system_.fromGeneralizedJointState(system_state.base_acc,
 										  system_state.joint_acc,
-										  (Eigen::VectorXd) generalized_state.segment(idx, system_.getSystemDoF()));
-		idx += system_.getSystemDoF();
-	}
-	if (system_variables_.effort) {
-		// Defining a fake floating-base system (fixed-base) for converting only joint effort
-		model::FloatingBaseSystem fake_system(false, system_.getJointDoF());
-		fake_system.fromGeneralizedJointState(system_state.base_eff,
-											  system_state.joint_eff,
-											  (Eigen::VectorXd) generalized_state.segment(idx, system_.getJointDoF()));
-		idx += system_.getJointDoF();
+										  state_view.getGeneralizedAcceleration());
+	if (state_view.hasEffort()) {
+		// Only the joint efforts are decision variables, i.e. a fixed-base conversion
+		system_state.base_eff.setZero();
+		system_state.joint_eff = state_view.getJointEffort();
 	}
-	if (system_variables_.contact_pos || system_variables_.contact_vel ||
-			system_variables_.contact_acc || system_variables_.contact_for) {
-		urdf_model::LinkID contact_links = system_.getEndEffectors();
+	if (state_view.getLayout().contacts >= 0) {
+		const urdf_model::LinkID& contact_links = system_.getEndEffectors();
+		unsigned int contact_idx = 0;
 		for (urdf_model::LinkID::const_iterator contact_it = contact_links.begin();
 				contact_it != contact_links.end(); contact_it++) {
-			std::string name = contact_it->first;
-
-			if (system_variables_.contact_pos) {
-				system_state.contact_pos[name] = generalized_state.segment<3>(idx);
-				idx += 3;
-			}
-			if (system_variables_.contact_vel) {
-				system_state.contact_vel[name] = generalized_state.segment<3>(idx);
-				idx += 3;
-			}
-			if (system_variables_.contact_acc) {
-				system_state.contact_acc[name] = generalized_state.segment<3>(idx);
-				idx += 3;
-			}
-			if (system_variables_.contact_for) {
-				system_state.contact_eff[name] << 0, 0, 0, generalized_state.segment<3>(idx);
-				idx += 3;
-			}
+			const std::string& name = contact_it->first;
+
+			if (state_view.hasContactPosition())
+				system_state.contact_pos[name] = state_view.getContactPosition(contact_idx);
+			if (state_view.hasContactVelocity())
+				system_state.contact_vel[name] = state_view.getContactVelocity(contact_idx);
+			if (state_view.hasContactAcceleration())
+				system_state.contact_acc[name] = state_view.getContactAcceleration(contact_idx);
+			if (state_view.hasContactForce())
+				system_state.contact_eff[name] << 0, 0, 0, state_view.getContactForce(contact_idx);
+			++contact_idx;
 		}
 	}
 }
 
 
+WholeBodyStateView DynamicalSystem::getStateView(const double* generalized_state) const
+{
+	return WholeBodyStateView(generalized_state, getCachedStateLayout());
+}
+
+
+const WholeBodyStateLayout& DynamicalSystem::getStateLayout() const
+{
+	updateStateLayout();
+	return state_layout_;
+}
+
+
 void DynamicalSystem::fromWholeBodyState(Eigen::VectorXd& generalized_state,
 										 const WholeBodyState& system_state)
 {
 	// Resizing the generalized state vector
 	generalized_state.resize(state_dimension_);
 
-	// Converting the generalized state vector to locomotion state
-	unsigned int idx = 0;
-	if (system_variables_.time) {
-		generalized_state(idx) = system_state.duration;
-		++idx;
-	}
-	if (system_variables_.position) {
-		generalized_state.segment(idx, system_.getSystemDoF()) =
+	// Converting the locomotion state to generalized state vector with the same layout than
+	// toWholeBodyState
+	const WholeBodyStateLayout& layout = getCachedStateLayout();
+	if (layout.time >= 0)
+		generalized_state(layout.time) = system_state.duration;
+	if (layout.position >= 0)
+		generalized_state.segment(layout.position, layout.system_dof) =
 				system_.toGeneralizedJointState(system_state.base_pos,
 												system_state.joint_pos);
-		idx += system_.getSystemDoF();
-	}
-	if (system_variables_.velocity) {
-		generalized_state.segment(idx, system_.getSystemDoF()) =
+	if (layout.velocity >= 0)
+		generalized_state.segment(layout.velocity, layout.system_dof) =
 				system_.toGeneralizedJointState(system_state.base_vel,
 												system_state.joint_vel);
-		idx += system_.getSystemDoF();
-	}
-	if (system_variables_.acceleration) {
-		generalized_state.segment(idx, system_.getSystemDoF()) =
+	if (layout.acceleration >= 0)
+		generalized_state.segment(layout.acceleration, layout.system_dof) =
 				system_.toGeneralizedJointState(system_state.base_acc,
 												system_state.joint_acc);
-		idx += system_.getSystemDoF();
-	}
-	if (system_variables_.effort) {
+	if (layout.effort >= 0) {
 		// Defining a fake floating-base system (fixed-base) for converting only joint effort
-		model::FloatingBaseSystem fake_system(false, system_.getJointDoF());
-		generalized_state.segment(idx, system_.getJointDoF()) =
+		model::FloatingBaseSystem fake_system(false, layout.joint_dof);
+		generalized_state.segment(layout.effort, layout.joint_dof) =
 				fake_system.toGeneralizedJointState(system_state.base_eff,
-											 	 	system_state.joint_eff);
-		idx += system_.getJointDoF();
+													system_state.joint_eff);
 	}
-	if (system_variables_.contact_pos || system_variables_.contact_vel ||
-			system_variables_.contact_acc || system_variables_.contact_for) {
-		urdf_model::LinkID contact_links = system_.getEndEffectors();
+	if (layout.contacts >= 0) {
+		const urdf_model::LinkID& contact_links = system_.getEndEffectors();
+		unsigned int idx = layout.contacts;
 		for (urdf_model::LinkID::const_iterator contact_it = contact_links.begin();
 				contact_it != contact_links.end(); contact_it++) {
-			std::string name = contact_it->first;
-
-			if (system_variables_.contact_pos) {
-				generalized_state.segment<3>(idx) = system_state.contact_pos.at(name);
-				idx += 3;
-			}
-			if (system_variables_.contact_vel) {
-				generalized_state.segment<3>(idx) = system_state.contact_vel.at(name);
-				idx += 3;
-			}
-			if (system_variables_.contact_acc) {
-				generalized_state.segment<3>(idx) = system_state.contact_acc.at(name);
-				idx += 3;
-			}
-			if (system_variables_.contact_for) {
-				generalized_state.segment<3>(idx) = system_state.contact_eff.at(name).segment<3>(rbd::LZ);
-				idx += 3;
-			}
+			const std::string& name = contact_it->first;
+
+			if (layout.contact_pos >= 0)
+				generalized_state.segment<3>(idx + layout.contact_pos) =
+						system_state.contact_pos.at(name);
+			if (layout.contact_vel >= 0)
+				generalized_state.segment<3>(idx + layout.contact_vel) =
+						system_state.contact_vel.at(name);
+			if (layout.contact_acc >= 0)
+				generalized_state.segment<3>(idx + layout.contact_acc) =
+						system_state.contact_acc.at(name);
+			if (layout.contact_for >= 0)
+				generalized_state.segment<3>(idx + layout.contact_for) =
+						system_state.contact_eff.at(name).segment<3>(rbd::LZ);
+			idx += layout.contact_stride;
 		}
 	}
 }
@@ -427,6 +419,91 @@ void DynamicalSystem::computeStateDimension()
 			(system_variables_.contact_pos + system_variables_.contact_vel +
 					system_variables_.contact_acc + system_variables_.contact_for) *
 					system_.getNumberOfEndEffectors();
+
+	// Computing the layout of the whole-body variables in the generalized state
+	is_layout_computed_ = false;
+	updateStateLayout();
+}
+
+
+void DynamicalSystem::updateStateLayout() const
+{
+	if (is_layout_computed_ &&
+			state_layout_.system_dof == system_.getSystemDoF() &&
+			state_layout_.joint_dof == system_.getJointDoF() &&
+			state_layout_.num_contacts == system_.getNumberOfEndEffectors() &&
+			layout_variables_.time == system_variables_.time &&
+			layout_variables_.position == system_variables_.position &&
+			layout_variables_.velocity == system_variables_.velocity &&
+			layout_variables_.acceleration == system_variables_.acceleration &&
+			layout_variables_.effort == system_variables_.effort &&
+			layout_variables_.contact_pos == system_variables_.contact_pos &&
+			layout_variables_.contact_vel == system_variables_.contact_vel &&
+			layout_variables_.contact_acc == system_variables_.contact_acc &&
+			layout_variables_.contact_for == system_variables_.contact_for)
+		return;
+
+	// The layout has to be consistent with the toWholeBodyState and fromWholeBodyState
+	// conversions
+	state_layout_ = WholeBodyStateLayout();
+	state_layout_.system_dof = system_.getSystemDoF();
+	state_layout_.joint_dof = system_.getJointDoF();
+	state_layout_.num_contacts = system_.getNumberOfEndEffectors();
+	int idx = 0;
+	if (system_variables_.time) {
+		state_layout_.time = idx;
+		++idx;
+	}
+	if (system_variables_.position) {
+		state_layout_.position = idx;
+		idx += state_layout_.system_dof;
+	}
+	if (system_variables_.velocity) {
+		state_layout_.velocity = idx;
+		idx += state_layout_.system_dof;
+	}
+	if (system_variables_.acceleration) {
+		state_layout_.acceleration = idx;
+		idx += state_layout_.system_dof;
+	}
+	if (system_variables_.effort) {
+		state_layout_.effort = idx;
+		idx += state_layout_.joint_dof;
+	}
+	if (system_variables_.contact_pos || system_variables_.contact_vel ||
+			system_variables_.contact_acc || system_variables_.contact_for) {
+		state_layout_.contacts = idx;
+		int contact_idx = 0;
+		if (system_variables_.contact_pos) {
+			state_layout_.contact_pos = contact_idx;
+			contact_idx += 3;
+		}
+		if (system_variables_.contact_vel) {
+			state_layout_.contact_vel = contact_idx;
+			contact_idx += 3;
+		}
+		if (system_variables_.contact_acc) {
+			state_layout_.contact_acc = contact_idx;
+			contact_idx += 3;
+		}
+		if (system_variables_.contact_for) {
+			state_layout_.contact_for = contact_idx;
+			contact_idx += 3;
+		}
+		state_layout_.contact_stride = contact_idx;
+	}
+
+	layout_variables_ = system_variables_;
+	is_layout_computed_ = true;
+}
+
+
+const WholeBodyStateLayout& DynamicalSystem::getCachedStateLayout() const
+{
+	if (!is_layout_computed_)
+		updateStateLayout();
+
+	return state_layout_;
 }
 
 
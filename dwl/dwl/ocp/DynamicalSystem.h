@@ -2,6 +2,7 @@
 #define DWL__OCP__DYNAMICAL_SYSTEM__H
 
 #include <dwl/ocp/Constraint.h>
+#include <dwl/ocp/WholeBodyStateView.h>
 
 
 namespace dwl
@@ -66,6 +67,7 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		 */
 		void compute(Eigen::VectorXd& constraint,
 					 const WholeBodyState& state);
+		using Constraint<WholeBodyState>::compute;
 
 		/**
 		 * @brief Computes the dynamical constraint vector given a certain state. Note that the
@@ -198,6 +200,32 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		void toWholeBodyState(WholeBodyState& system_state,
 							  const Eigen::VectorXd& generalized_state);
 
+		/**
+		 * @brief Converts a view of the generalized state vector to whole-body state. The
+		 * conversion doesn't allocate memory once the whole-body state has the right dimensions
+		 * @param WholeBodyState& Whole-body state
+		 * @param const WholeBodyStateView& View of the generalized state vector
+		 */
+		void toWholeBodyState(WholeBodyState& system_state,
+							  const WholeBodyStateView& state_view);
+
+		/**
+		 * @brief Gets a view of the generalized state vector, i.e. the decision state. It uses
+		 * the cached layout, i.e. it doesn't check if the whole-body variables changed (see
+		 * getStateLayout())
+		 * @param const double* Generalized state buffer
+		 * @return The view of the generalized state
+		 */
+		WholeBodyStateView getStateView(const double* generalized_state) const;
+
+		/**
+		 * @brief Gets the layout of the generalized state vector. It computes the layout again
+		 * if the whole-body variables or the DoFs changed since the last computation, so it's
+		 * called once before evaluating the decision states (see OptimalControl::init())
+		 * @return The layout of the generalized state vector
+		 */
+		const WholeBodyStateLayout& getStateLayout() const;
+
 		/**
 		 * @brief Converts the whole-body state to generalized state vector
 		 * @param Eigen::VectorXd& Generalized state vector
@@ -235,6 +263,12 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 		/** @brief Whole-body variables defined given a dynamical system constraint */
 		WholeBodyVariables system_variables_;
 
+		/** @brief Layout of the whole-body variables in the generalized state vector. It's
+		 * computed the first time that it's used, and checked again only by init(),
+		 * setStepIntegrationMethod() and getStateLayout(). So the derived systems could define
+		 * system_variables_ directly, and the views don't compare the variables per knot */
+		mutable WholeBodyStateLayout state_layout_;
+
 		/** @brief Step integration method */
 		StepIntegrationMethod integration_method_;
 
@@ -243,9 +277,22 @@ class DynamicalSystem : public Constraint<WholeBodyState>
 
 
 	private:
-		/** @brief Computes the state dimension of the dynamical constraint */
+		/** @brief Computes the state dimension and layout of the dynamical constraint */
 		void computeStateDimension();
 
+		/**
+		 * @brief Computes the layout of the generalized state if the whole-body variables or
+		 * the DoFs changed since its last computation
+		 */
+		void updateStateLayout() const;
+
+		/** @brief Gets the cached layout, it's computed only if there isn't one */
+		const WholeBodyStateLayout& getCachedStateLayout() const;
+
+		/** @brief Whole-body variables used for computing the state layout */
+		mutable WholeBodyVariables layout_variables_;
+		mutable bool is_layout_computed_;
+
 		/** @brief Initializes conditions of the dynamical constraint */
 		void initialConditions();
 
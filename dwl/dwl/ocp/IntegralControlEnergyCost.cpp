@@ -34,5 +34,27 @@ void IntegralControlEnergyCost::compute(double& cost,
 	cost *= state.duration;
 }
 
+
+void IntegralControlEnergyCost::compute(double& cost,
+										const WholeBodyStateView& state_view)
+{
+	// Checking sizes
+	if (state_view.getLayout().joint_dof != locomotion_weights_.joint_eff.size()) {
+		printf(RED_ "FATAL: the joint efforts dimensions are not consistent\n" COLOR_RESET);
+		exit(EXIT_FAILURE);
+	}
+
+	// The joint efforts are zero if they aren't decision variables
+	if (!state_view.hasEffort()) {
+		cost = 0.;
+		return;
+	}
+
+	// Computing the control cost
+	WholeBodyStateView::ConstVectorMap joint_eff = state_view.getJointEffort();
+	cost = joint_eff.transpose() * locomotion_weights_.joint_eff.asDiagonal() * joint_eff;
+	cost *= state_view.getDuration();
+}
+
 } //@namespace ocp
 } //@namespace dwl
@@ -31,6 +31,15 @@ class IntegralControlEnergyCost : public Cost
 		 */
 		void compute(double& cost,
 					 const WholeBodyState& state);
+
+		/**
+		 * @brief Computes the control energy cost given a view of the decision state. It reads
+		 * the joint efforts from the decision buffer, i.e. without decoding the whole-body state
+		 * @param double& Cost value
+		 * @param const WholeBodyStateView& View of the decision state
+		 */
+		void compute(double& cost,
+					 const WholeBodyStateView& state_view);
 };
 
 } //@namespace ocp
@@ -1,4 +1,5 @@
 #include <dwl/ocp/OptimalControl.h>
+#include <set>
 
 
 namespace dwl
@@ -7,9 +8,39 @@ namespace dwl
 namespace ocp
 {
 
+KnotStateDecoder::KnotStateDecoder() : system_(NULL)
+{
+
+}
+
+
+KnotStateDecoder::~KnotStateDecoder()
+{
+
+}
+
+
+void KnotStateDecoder::reset(DynamicalSystem* system)
+{
+	system_ = system;
+	state_ = WholeBodyState(system_->getFloatingBaseSystem().getJointDoF());
+}
+
+
+const WholeBodyState& KnotStateDecoder::decode(const WholeBodyStateView& state_view)
+{
+	// Converting the decision variables of the knot, it reads directly from the decision buffer
+	system_->toWholeBodyState(state_, state_view);
+	state_.duration = state_view.getDuration();
+	state_.time = state_view.getTime();
+
+	return state_;
+}
+
+
 OptimalControl::OptimalControl() : dynamical_system_(NULL),
 		is_added_dynamic_system_(false), is_added_constraint_(false), is_added_cost_(false),
-		terminal_constraint_dimension_(0), horizon_(1)
+		terminal_constraint_dimension_(0), horizon_(1), is_trajectory_updated_(false)
 {
 
 }
@@ -35,8 +66,10 @@ OptimalControl::~OptimalControl()
 
 void OptimalControl::init(bool only_soft_constraints)
 {
-	// Reading the state dimension
+	// Reading the state dimension, and checking the layout of the decision state once
 	state_dimension_ = dynamical_system_->getDimensionOfState();
+	dynamical_system_->getStateLayout();
+	knot_decoder_.reset(dynamical_system_);
 
 	// Initializing the constraint dimension
 	constraint_dimension_ = 0;
@@ -63,10 +96,46 @@ void OptimalControl::init(bool only_soft_constraints)
 }
 
 
-void OptimalControl::setStartingTrajectory(WholeBodyTrajectory& initial_trajectory)
+void OptimalControl::setStartingTrajectory(const WholeBodyTrajectory& initial_trajectory)
 {
 	//TODO should convert to the defined horizon and time step integration
-	motion_solution_ = initial_trajectory;
+	is_trajectory_updated_ = false;
+	if (initial_trajectory.empty()) {
+		motion_solution_.clear();
+		return;
+	}
+
+	// Getting the dimensions of the samples, i.e. the joints of the first state and the
+	// contacts defined in any state
+	std::set<std::string> contact_set;
+	for (unsigned int k = 0; k < initial_trajectory.size(); k++) {
+		const WholeBodyState& state = initial_trajectory[k];
+		for (rbd::BodyVectorXd::const_iterator contact_it = state.contact_pos.begin();
+				contact_it != state.contact_pos.end(); contact_it++)
+			contact_set.insert(contact_it->first);
+		for (rbd::BodyVectorXd::const_iterator contact_it = state.contact_vel.begin();
+				contact_it != state.contact_vel.end(); contact_it++)
+			contact_set.insert(contact_it->first);
+		for (rbd::BodyVectorXd::const_iterator contact_it = state.contact_acc.begin();
+				contact_it != state.contact_acc.end(); contact_it++)
+			contact_set.insert(contact_it->first);
+		for (rbd::BodyVector6d::const_iterator contact_it = state.contact_eff.begin();
+				contact_it != state.contact_eff.end(); contact_it++)
+			contact_set.insert(contact_it->first);
+	}
+	std::vector<std::string> contact_names(contact_set.begin(), contact_set.end());
+	motion_solution_.setDimensions(initial_trajectory[0].joint_pos.size(), contact_names);
+	motion_solution_.fromWholeBodyTrajectory(initial_trajectory);
+}
+
+
+void OptimalControl::setStartingTrajectory(WholeBodyTrajectory&& initial_trajectory)
+{
+	// The states are swapped into the whole-body trajectory, which is the starting point until
+	// a solution is recorded in the contiguous buffer
+	solution_trajectory_.swap(initial_trajectory);
+	motion_solution_.clear();
+	is_trajectory_updated_ = true;
 }
 
 
@@ -75,7 +144,9 @@ void OptimalControl::getStartingPoint(double* decision, int decision_dim)
 	// Eigen interfacing to raw buffers
 	Eigen::Map<Eigen::VectorXd> full_initial_point(decision, decision_dim);
 
-	if (motion_solution_.size() == 0) {
+	unsigned int num_samples =
+			is_trajectory_updated_ ? solution_trajectory_.size() : motion_solution_.size();
+	if (num_samples == 0) {
 		// Getting the initial and ending locomotion state
 		WholeBodyState starting_system_state = dynamical_system_->getInitialState();
 		WholeBodyState ending_system_state = dynamical_system_->getTerminalState();
@@ -131,9 +202,15 @@ void OptimalControl::getStartingPoint(double* decision, int decision_dim)
 	} else {
 		// Defining the current locomotion solution as starting point
 		unsigned int state_dimension = dynamical_system_->getDimensionOfState();
+		WholeBodyState system_state;
+		Eigen::VectorXd current_state;
 		for (unsigned int k = 0; k < horizon_; k++) {
-			Eigen::VectorXd current_state;
-			dynamical_system_->fromWholeBodyState(current_state, motion_solution_[k]);
+			if (is_trajectory_updated_)
+				dynamical_system_->fromWholeBodyState(current_state, solution_trajectory_[k]);
+			else {
+				motion_solution_.getState(system_state, k);
+				dynamical_system_->fromWholeBodyState(current_state, system_state);
+			}
 
 			full_initial_point.segment(k * state_dimension, state_dimension) = current_state;
 		}
@@ -268,18 +345,11 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 	}
 
 	// Computing the active and inactive constraints for a predefined horizon
-	WholeBodyState system_state(dynamical_system_->getFloatingBaseSystem().getJointDoF());
-	Eigen::VectorXd decision_state = Eigen::VectorXd::Zero(state_dimension_);
 	unsigned int index = 0;
+	double time = 0.;
 	for (unsigned int k = 0; k < horizon_; k++) {
-		// Converting the decision variable for a certain time to a robot state
-		decision_state = decision_var.segment(k * state_dimension_, state_dimension_);
-		dynamical_system_->toWholeBodyState(system_state, decision_state);
-
-		// Adding the time information in cases that time is not a decision variable
-		if (dynamical_system_->isFixedStepIntegration())
-			system_state.duration = dynamical_system_->getFixedStepTime();
-		system_state.time += system_state.duration;
+		// Getting the view of the decision variables for a certain time
+		WholeBodyStateView state_view = getKnotView(decision, k, time);
 
 		// Computing the constraints for a certain time
 		if (constraint_dimension_ != 0) {
@@ -289,8 +359,12 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 				if (j == 0) {// dynamic system constraint
 					// Evaluating the dynamical constraint
 					if (!dynamical_system_->isSoftConstraint()) {
-						dynamical_system_->compute(constraint, system_state);
-						dynamical_system_->setLastState(system_state);
+						utils::Profiler::Clock::time_point started = profiler_.tic();
+						dynamical_system_->compute(constraint, state_view);
+						dynamical_system_->setLastState(state_view.getWholeBodyState());
+						if (profiler_.isEnabled())
+							profiler_.addTermEvaluation(dynamical_system_->getName(), k,
+														profiler_.toc(started));
 
 						// Checking the constraint dimension
 						current_constraint_dim = dynamical_system_->getConstraintDimension();
@@ -303,8 +377,12 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 				} else {
 					// Evaluating the constraints
 					if (!constraints_[j-1]->isSoftConstraint()) {
-						constraints_[j-1]->compute(constraint, system_state);
-						constraints_[j-1]->setLastState(system_state);
+						utils::Profiler::Clock::time_point started = profiler_.tic();
+						constraints_[j-1]->compute(constraint, state_view);
+						constraints_[j-1]->setLastState(state_view.getWholeBodyState());
+						if (profiler_.isEnabled())
+							profiler_.addTermEvaluation(constraints_[j-1]->getName(), k,
+														profiler_.toc(started));
 
 						// Checking the constraint dimension
 						current_constraint_dim = constraints_[j-1]->getConstraintDimension();
@@ -327,7 +405,8 @@ void OptimalControl::evaluateConstraints(double* constraint, int constraint_dim,
 		if (dynamical_system_->isFullTrajectoryOptimization()) {
 			if (k == horizon_ - 1) {
 				Eigen::VectorXd constraint;
-				dynamical_system_->computeTerminalConstraint(constraint, system_state);
+				dynamical_system_->computeTerminalConstraint(constraint,
+															 state_view.getWholeBodyState());
 
 				// Setting in the full constraint vector
 				full_constraint.segment(index, terminal_constraint_dimension_) = constraint;
@@ -374,37 +453,42 @@ void OptimalControl::evaluateCosts(double& cost,
 	}
 
 	// Computing the cost for predefined horizon
-	WholeBodyState system_state(dynamical_system_->getFloatingBaseSystem().getJointDoF());
+	double time = 0.;
 	for (unsigned int k = 0; k < horizon_; k++) {
-		// Converting the decision variable for a certain time to a robot state
-		Eigen::VectorXd decision_state = decision_var.segment(k * state_dimension_, state_dimension_);
-		dynamical_system_->toWholeBodyState(system_state, decision_state);
-
-		// Adding the time information in cases that time is not a decision variable
-		if (dynamical_system_->isFixedStepIntegration())
-			system_state.duration = dynamical_system_->getFixedStepTime();
-		system_state.time += system_state.duration;
+		// Getting the view of the decision variables for a certain time
+		WholeBodyStateView state_view = getKnotView(decision, k, time);
 
 		// Computing the cost function for a certain time
 		double simple_cost;
 		unsigned int num_cost_functions = costs_.size();
 		for (unsigned int j = 0; j < num_cost_functions; j++) {
-			costs_[j]->compute(simple_cost, system_state);
+			utils::Profiler::Clock::time_point started = profiler_.tic();
+			costs_[j]->compute(simple_cost, state_view);
 			cost += simple_cost;
+			if (profiler_.isEnabled())
+				profiler_.addTermEvaluation(costs_[j]->getName(), k, profiler_.toc(started));
 		}
 
 		// Computing the soft-constraints for a certain time
 		for (unsigned int j = 0; j < num_constraints + 1; j++) {
 			if (j == 0) {// dynamic system constraint
 				if (dynamical_system_->isSoftConstraint()) {
-					dynamical_system_->computeSoft(simple_cost, system_state);
-					dynamical_system_->setLastState(system_state);
+					utils::Profiler::Clock::time_point started = profiler_.tic();
+					dynamical_system_->computeSoft(simple_cost, state_view);
+					dynamical_system_->setLastState(state_view.getWholeBodyState());
 					cost += simple_cost;
+					if (profiler_.isEnabled())
+						profiler_.addTermEvaluation(dynamical_system_->getName(), k,
+													profiler_.toc(started));
 				}
 			} else if (constraints_[j-1]->isSoftConstraint()) {
-				constraints_[j-1]->computeSoft(simple_cost, system_state);
-				constraints_[j-1]->setLastState(system_state);
+				utils::Profiler::Clock::time_point started = profiler_.tic();
+				constraints_[j-1]->computeSoft(simple_cost, state_view);
+				constraints_[j-1]->setLastState(state_view.getWholeBodyState());
 				cost += simple_cost;
+				if (profiler_.isEnabled())
+					profiler_.addTermEvaluation(constraints_[j-1]->getName(), k,
+												profiler_.toc(started));
 			}
 		}
 	}
@@ -419,21 +503,42 @@ void OptimalControl::evaluateCosts(double& cost,
 }
 
 
-WholeBodyTrajectory& OptimalControl::evaluateSolution(const Eigen::Ref<const Eigen::VectorXd>& solution)
+WholeBodyStateView OptimalControl::getKnotView(const double* decision,
+											  unsigned int knot,
+											  double& time)
+{
+	WholeBodyStateView state_view =
+			dynamical_system_->getStateView(decision + knot * state_dimension_);
+
+	// Adding the time information, the duration is the fixed step if time is not a decision
+	// variable
+	double duration = state_view.hasTime() ?
+			state_view.getDuration() : dynamical_system_->getFixedStepTime();
+	time += duration;
+	state_view.setKnot(time, duration);
+	state_view.setDecoder(&knot_decoder_);
+
+	return state_view;
+}
+
+
+void OptimalControl::evaluateSolution(const Eigen::Ref<const Eigen::VectorXd>& solution)
 {
 	// Getting the state dimension
 	unsigned int state_dim = dynamical_system_->getDimensionOfState();
 
-	// Recording the solution
-	motion_solution_.clear();
+	// Recording the solution. Note that the buffer keeps its memory between solutions
+	model::FloatingBaseSystem& floating_base = dynamical_system_->getFloatingBaseSystem();
+	motion_solution_.setDimensions(floating_base.getJointDoF(),
+								   floating_base.getEndEffectorNames());
+	motion_solution_.reserve(horizon_ + 1);
 	motion_solution_.push_back(dynamical_system_->getInitialState());
-	Eigen::VectorXd decision_state = Eigen::VectorXd::Zero(state_dim);
 	double current_time = dynamical_system_->getInitialState().time;
 	for (unsigned int k = 0; k < horizon_; k++) {
 		// Converting the decision variable for a certain time to a robot state
 		WholeBodyState system_state;
-		decision_state = solution.segment(k * state_dim, state_dim);
-		dynamical_system_->toWholeBodyState(system_state, decision_state);
+		dynamical_system_->toWholeBodyState(system_state,
+				dynamical_system_->getStateView(solution.data() + k * state_dim));
 
 		// Setting the time information in cases where time is not a decision variable
 		if (dynamical_system_->isFixedStepIntegration())
@@ -448,8 +553,8 @@ WholeBodyTrajectory& OptimalControl::evaluateSolution(const Eigen::Ref<const Eig
 		if (k == 0)
 			last_system_state = dynamical_system_->getInitialState();
 		else {
-			Eigen::VectorXd last_decision_state = solution.segment((k - 1) * state_dim, state_dim);
-			dynamical_system_->toWholeBodyState(last_system_state, last_decision_state);
+			dynamical_system_->toWholeBodyState(last_system_state,
+					dynamical_system_->getStateView(solution.data() + (k - 1) * state_dim));
 		}
 
 		if (system_state.base_acc.isZero() && system_state.joint_acc.isZero()) {
@@ -515,7 +620,7 @@ WholeBodyTrajectory& OptimalControl::evaluateSolution(const Eigen::Ref<const Eig
 
 
 		std::cout << "-------------------------------------" << std::endl;
-		std::cout << "x = " << decision_state.transpose() << std::endl;
+		std::cout << "x = " << solution.segment(k * state_dim, state_dim).transpose() << std::endl;
 		std::cout << "time = " << system_state.time << std::endl;
 		std::cout << "duration = " << system_state.duration << std::endl;
 		std::cout << "base_pos = " << system_state.base_pos.transpose() << std::endl;
@@ -537,7 +642,18 @@ WholeBodyTrajectory& OptimalControl::evaluateSolution(const Eigen::Ref<const Eig
 		std::cout << "-------------------------------------" << std::endl;
 	}
 
-	return motion_solution_;
+	is_trajectory_updated_ = false;
+}
+
+
+const WholeBodyTrajectory& OptimalControl::getWholeBodyTrajectory()
+{
+	if (!is_trajectory_updated_) {
+		motion_solution_.toWholeBodyTrajectory(solution_trajectory_);
+		is_trajectory_updated_ = true;
+	}
+
+	return solution_trajectory_;
 }
 
 
@@ -2,6 +2,7 @@
 #define DWL__OCP__OPTIMAL_CONTROL__H
 
 #include <dwl/model/OptimizationModel.h>
+#include <dwl/WholeBodyTrajectoryBuffer.h>
 #include <dwl/ocp/DynamicalSystem.h>
 #include <dwl/ocp/Constraint.h>
 #include <dwl/ocp/Cost.h>
@@ -14,6 +15,42 @@ namespace dwl
 namespace ocp
 {
 
+/**
+ * @class KnotStateDecoder
+ * @brief Decodes the whole-body states of the knots of the decision trajectory. The same
+ * whole-body state is reused by all the knots, so the decoding doesn't allocate memory
+ */
+class KnotStateDecoder : public WholeBodyStateDecoder
+{
+	public:
+		/** @brief Constructor function */
+		KnotStateDecoder();
+
+		/** @brief Destructor function */
+		~KnotStateDecoder();
+
+		/**
+		 * @brief Resets the dynamical system that defines the decision state
+		 * @param DynamicalSystem* Dynamical system
+		 */
+		void reset(DynamicalSystem* system);
+
+		/**
+		 * @brief Decodes the whole-body state of a knot, with its time information
+		 * @param const WholeBodyStateView& View of the knot
+		 * @return The whole-body state of the knot
+		 */
+		const WholeBodyState& decode(const WholeBodyStateView& state_view);
+
+
+	private:
+		/** @brief Dynamical system that defines the decision state */
+		DynamicalSystem* system_;
+
+		/** @brief Whole-body state of the last decoded knot */
+		WholeBodyState state_;
+};
+
 /**
  * @class OptimalControl
  * @brief An optimal control problem requires information of constraints (dynamical, active or
@@ -36,9 +73,16 @@ class OptimalControl : public model::OptimizationModel
 
 		/**
 		 * @brief Sets the initial trajectory
-		 * @param WholeBodyTrajectory& Initial whole-body trajectory
+		 * @param const WholeBodyTrajectory& Initial whole-body trajectory
+		 */
+		void setStartingTrajectory(const WholeBodyTrajectory& initial_trajectory);
+
+		/**
+		 * @brief Sets the initial trajectory without copying it, i.e. its states are swapped
+		 * into the whole-body trajectory of the solution
+		 * @param WholeBodyTrajectory&& Initial whole-body trajectory
 		 */
-		void setStartingTrajectory(WholeBodyTrajectory& initial_trajectory);
+		void setStartingTrajectory(WholeBodyTrajectory&& initial_trajectory);
 
 		/**
 		 * @brief Gets the starting point of the problem
@@ -85,11 +129,17 @@ class OptimalControl : public model::OptimizationModel
 								 const double* decision, int decision_dim);
 
 		/**
-		 * @brief Evaluates the solution from an optimizer
+		 * @brief Evaluates the solution from an optimizer. The solution is recorded in the
+		 * contiguous buffer, and it's converted to whole-body trajectory only when it's requested
 		 * @param const Eigen::Ref<const Eigen::VectorXd>& Solution vector
-		 * @return WholeBodyTrajectory& Returns the whole-body trajectory solution
 		 */
-		WholeBodyTrajectory& evaluateSolution(const Eigen::Ref<const Eigen::VectorXd>& solution);
+		void evaluateSolution(const Eigen::Ref<const Eigen::VectorXd>& solution);
+
+		/**
+		 * @brief Gets the whole-body trajectory of the last evaluated solution
+		 * @return const WholeBodyTrajectory& Returns the whole-body trajectory solution
+		 */
+		const WholeBodyTrajectory& getWholeBodyTrajectory();
 
 		/**
 		 * @brief Adds the dynamical system (active constraints) to the optimization problem
@@ -144,9 +194,24 @@ class OptimalControl : public model::OptimizationModel
 
 
 	protected:
+		/**
+		 * @brief Gets the view of a knot of the decision trajectory. The costs and constraints
+		 * evaluate the view, and its whole-body state is decoded only if they need it
+		 * @param const double* Decision trajectory
+		 * @param unsigned int Knot index
+		 * @param double& Time of the last knot, it's updated with the time of this one
+		 * @return The view of the knot
+		 */
+		WholeBodyStateView getKnotView(const double* decision,
+									   unsigned int knot,
+									   double& time);
+
 		/** @brief Dynamical system constraint pointer */
 		DynamicalSystem* dynamical_system_;
 
+		/** @brief Decoder of the whole-body states of the knots */
+		KnotStateDecoder knot_decoder_;
+
 		/** @brief Vector of active and inactive constraints pointers */
 		std::vector<Constraint<WholeBodyState>*> constraints_;
 
@@ -168,8 +233,16 @@ class OptimalControl : public model::OptimizationModel
 		/** @brief Horizon of the optimal control problem */
 		unsigned int horizon_;
 
-		/** @brief Whole-body solution */
-		WholeBodyTrajectory motion_solution_;
+		/** @brief Whole-body solution. It's stored contiguously, so the starting points of the
+		 * next solves are read without allocating whole-body states per sample */
+		WholeBodyTrajectoryBuffer motion_solution_;
+
+		/** @brief Whole-body trajectory of the last evaluated solution */
+		WholeBodyTrajectory solution_trajectory_;
+
+		/** @brief Indicates if the whole-body trajectory has the current solution, otherwise it's
+		 * in the contiguous buffer */
+		bool is_trajectory_updated_;
 };
 
 } //@namespace ocp
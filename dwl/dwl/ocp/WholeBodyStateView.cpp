@@ -0,0 +1,246 @@
+#include <dwl/ocp/WholeBodyStateView.h>
+#include <dwl/utils/Macros.h>
+
+
+namespace dwl
+{
+
+namespace ocp
+{
+
+/** @brief Layout of the views that aren't mapped onto a decision buffer */
+static const WholeBodyStateLayout EMPTY_LAYOUT;
+
+
+WholeBodyStateView::WholeBodyStateView() : state_(NULL), layout_(&EMPTY_LAYOUT), time_(0.),
+		duration_(0.), decoder_(NULL), decoded_state_(NULL)
+{
+
+}
+
+
+WholeBodyStateView::WholeBodyStateView(const double* state,
+									   const WholeBodyStateLayout& layout) :
+		state_(state), layout_(&layout), time_(0.), duration_(0.), decoder_(NULL),
+		decoded_state_(NULL)
+{
+
+}
+
+
+WholeBodyStateView::~WholeBodyStateView()
+{
+
+}
+
+
+void WholeBodyStateView::setKnot(double time,
+								 double duration)
+{
+	time_ = time;
+	duration_ = duration;
+}
+
+
+void WholeBodyStateView::setDecoder(WholeBodyStateDecoder* decoder)
+{
+	decoder_ = decoder;
+	decoded_state_ = NULL;
+}
+
+
+const WholeBodyState& WholeBodyStateView::getWholeBodyState() const
+{
+	if (decoded_state_ == NULL) {
+		if (decoder_ == NULL) {
+			printf(RED_ "FATAL: the whole-body state view doesn't have a decoder\n" COLOR_RESET);
+			exit(EXIT_FAILURE);
+		}
+		decoded_state_ = &decoder_->decode(*this);
+	}
+
+	return *decoded_state_;
+}
+
+
+bool WholeBodyStateView::isValid() const
+{
+	return state_ != NULL;
+}
+
+
+const WholeBodyStateLayout& WholeBodyStateView::getLayout() const
+{
+	return *layout_;
+}
+
+
+const double* WholeBodyStateView::data() const
+{
+	return state_;
+}
+
+
+bool WholeBodyStateView::hasTime() const
+{
+	return layout_->time >= 0;
+}
+
+
+bool WholeBodyStateView::hasPosition() const
+{
+	return layout_->position >= 0;
+}
+
+
+bool WholeBodyStateView::hasVelocity() const
+{
+	return layout_->velocity >= 0;
+}
+
+
+bool WholeBodyStateView::hasAcceleration() const
+{
+	return layout_->acceleration >= 0;
+}
+
+
+bool WholeBodyStateView::hasEffort() const
+{
+	return layout_->effort >= 0;
+}
+
+
+bool WholeBodyStateView::hasContactPosition() const
+{
+	return layout_->contacts >= 0 && layout_->contact_pos >= 0;
+}
+
+
+bool WholeBodyStateView::hasContactVelocity() const
+{
+	return layout_->contacts >= 0 && layout_->contact_vel >= 0;
+}
+
+
+bool WholeBodyStateView::hasContactAcceleration() const
+{
+	return layout_->contacts >= 0 && layout_->contact_acc >= 0;
+}
+
+
+bool WholeBodyStateView::hasContactForce() const
+{
+	return layout_->contacts >= 0 && layout_->contact_for >= 0;
+}
+
+
+double WholeBodyStateView::getTime() const
+{
+	return time_;
+}
+
+
+double WholeBodyStateView::getDuration() const
+{
+	if (!hasTime())
+		return duration_;
+
+	return state_[layout_->time];
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getGeneralizedPosition() const
+{
+	return map(layout_->position, layout_->system_dof);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getGeneralizedVelocity() const
+{
+	return map(layout_->velocity, layout_->system_dof);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getGeneralizedAcceleration() const
+{
+	return map(layout_->acceleration, layout_->system_dof);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getJointPosition() const
+{
+	// The joint states are the last entries of the generalized states
+	if (!hasPosition())
+		return map(-1, 0);
+
+	return map(layout_->position + layout_->system_dof - layout_->joint_dof, layout_->joint_dof);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getJointVelocity() const
+{
+	if (!hasVelocity())
+		return map(-1, 0);
+
+	return map(layout_->velocity + layout_->system_dof - layout_->joint_dof, layout_->joint_dof);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getJointAcceleration() const
+{
+	if (!hasAcceleration())
+		return map(-1, 0);
+
+	return map(layout_->acceleration + layout_->system_dof - layout_->joint_dof, layout_->joint_dof);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::getJointEffort() const
+{
+	return map(layout_->effort, layout_->joint_dof);
+}
+
+
+WholeBodyStateView::ConstVector3dMap WholeBodyStateView::getContactPosition(unsigned int contact) const
+{
+	return mapContact(contact, layout_->contact_pos);
+}
+
+
+WholeBodyStateView::ConstVector3dMap WholeBodyStateView::getContactVelocity(unsigned int contact) const
+{
+	return mapContact(contact, layout_->contact_vel);
+}
+
+
+WholeBodyStateView::ConstVector3dMap WholeBodyStateView::getContactAcceleration(unsigned int contact) const
+{
+	return mapContact(contact, layout_->contact_acc);
+}
+
+
+WholeBodyStateView::ConstVector3dMap WholeBodyStateView::getContactForce(unsigned int contact) const
+{
+	return mapContact(contact, layout_->contact_for);
+}
+
+
+WholeBodyStateView::ConstVectorMap WholeBodyStateView::map(int offset,
+														   unsigned int dim) const
+{
+	if (offset < 0)
+		return ConstVectorMap(NULL, 0);
+
+	return ConstVectorMap(state_ + offset, dim);
+}
+
+
+WholeBodyStateView::ConstVector3dMap WholeBodyStateView::mapContact(unsigned int contact,
+																	int offset) const
+{
+	return ConstVector3dMap(state_ + layout_->contacts + contact * layout_->contact_stride + offset);
+}
+
+} //@namespace ocp
+} //@namespace dwl
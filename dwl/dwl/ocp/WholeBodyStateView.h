@@ -0,0 +1,205 @@
+#ifndef DWL__OCP__WHOLE_BODY_STATE_VIEW__H
+#define DWL__OCP__WHOLE_BODY_STATE_VIEW__H
+
+#include <dwl/WholeBodyState.h>
+
+
+namespace dwl
+{
+
+namespace ocp
+{
+
+/**
+ * @brief Defines the layout of the whole-body variables inside a decision state. The
+ * offsets are the first index of each variable, and they are negative for those variables
+ * that aren't part of the decision state. The contact variables are stored per contact,
+ * i.e. [pos, vel, acc, for]_0, ..., [pos, vel, acc, for]_P
+ */
+struct WholeBodyStateLayout
+{
+	WholeBodyStateLayout() : time(-1), position(-1), velocity(-1), acceleration(-1),
+			effort(-1), contacts(-1), contact_pos(-1), contact_vel(-1), contact_acc(-1),
+			contact_for(-1), contact_stride(0), system_dof(0), joint_dof(0),
+			num_contacts(0) {}
+
+	int time;
+	int position;
+	int velocity;
+	int acceleration;
+	int effort;
+	int contacts;
+	int contact_pos;
+	int contact_vel;
+	int contact_acc;
+	int contact_for;
+	unsigned int contact_stride;
+	unsigned int system_dof;
+	unsigned int joint_dof;
+	unsigned int num_contacts;
+};
+
+class WholeBodyStateView;
+
+/**
+ * @class WholeBodyStateDecoder
+ * @brief Abstract class for decoding the whole-body state of a view on demand (see
+ * WholeBodyStateView::getWholeBodyState())
+ */
+class WholeBodyStateDecoder
+{
+	public:
+		/** @brief Destructor function */
+		virtual ~WholeBodyStateDecoder() {}
+
+		/**
+		 * @brief Decodes the whole-body state of a view
+		 * @param const WholeBodyStateView& View of the decision state
+		 * @return The whole-body state, which is owned by the decoder
+		 */
+		virtual const WholeBodyState& decode(const WholeBodyStateView& state_view) = 0;
+};
+
+/**
+ * @class WholeBodyStateView
+ * @brief Read-only view of a decision state. It maps the whole-body variables directly onto
+ * the raw decision buffer, so they could be read without copying them in a WholeBodyState.
+ * The costs and constraints receive the views of the knots, and the ones that need the
+ * whole-body state get it decoded once per knot (see getWholeBodyState()). Note that the view
+ * doesn't own the buffer and the layout, and it's valid as long as they are alive
+ */
+class WholeBodyStateView
+{
+	public:
+		typedef Eigen::Map<const Eigen::VectorXd> ConstVectorMap;
+		typedef Eigen::Map<const Eigen::Vector3d> ConstVector3dMap;
+
+		/** @brief Constructor function */
+		WholeBodyStateView();
+
+		/**
+		 * @brief Constructor function
+		 * @param const double* Decision state buffer
+		 * @param const WholeBodyStateLayout& Layout of the decision state
+		 */
+		WholeBodyStateView(const double* state,
+						   const WholeBodyStateLayout& layout);
+
+		/** @brief Destructor function */
+		~WholeBodyStateView();
+
+		/**
+		 * @brief Sets the time information of the knot of the view
+		 * @param double Time of the knot
+		 * @param double Duration of the step. It's used if time isn't a decision variable
+		 */
+		void setKnot(double time,
+					 double duration);
+
+		/**
+		 * @brief Sets the decoder of the whole-body state
+		 * @param WholeBodyStateDecoder* Whole-body state decoder
+		 */
+		void setDecoder(WholeBodyStateDecoder* decoder);
+
+		/**
+		 * @brief Gets the whole-body state of the view. It's decoded the first time, and the
+		 * decoded state is shared by the next calls
+		 * @return The whole-body state
+		 */
+		const WholeBodyState& getWholeBodyState() const;
+
+		/** @brief Returns true if the view is mapped onto a decision buffer */
+		bool isValid() const;
+
+		/** @brief Gets the layout of the decision state */
+		const WholeBodyStateLayout& getLayout() const;
+
+		/** @brief Gets the raw decision state buffer */
+		const double* data() const;
+
+		/** @brief Returns true if the time and the variables are part of the decision state */
+		bool hasTime() const;
+		bool hasPosition() const;
+		bool hasVelocity() const;
+		bool hasAcceleration() const;
+		bool hasEffort() const;
+		bool hasContactPosition() const;
+		bool hasContactVelocity() const;
+		bool hasContactAcceleration() const;
+		bool hasContactForce() const;
+
+		/** @brief Gets the time of the knot (see setKnot()) */
+		double getTime() const;
+
+		/**
+		 * @brief Gets the duration of the step. It's the knot duration (see setKnot()) if time
+		 * isn't a decision variable
+		 */
+		double getDuration() const;
+
+		/**
+		 * @brief Gets the generalized (base and joint) position, velocity and acceleration.
+		 * The map is empty if the variable isn't part of the decision state
+		 */
+		ConstVectorMap getGeneralizedPosition() const;
+		ConstVectorMap getGeneralizedVelocity() const;
+		ConstVectorMap getGeneralizedAcceleration() const;
+
+		/**
+		 * @brief Gets the joint position, velocity, acceleration and effort. The map is
+		 * empty if the variable isn't part of the decision state
+		 */
+		ConstVectorMap getJointPosition() const;
+		ConstVectorMap getJointVelocity() const;
+		ConstVectorMap getJointAcceleration() const;
+		ConstVectorMap getJointEffort() const;
+
+		/**
+		 * @brief Gets the contact position, velocity, acceleration and force given the
+		 * contact index, which follows the end-effector order of the floating-base system.
+		 * Note that these variables have to be part of the decision state
+		 * @param unsigned int Contact index
+		 */
+		ConstVector3dMap getContactPosition(unsigned int contact) const;
+		ConstVector3dMap getContactVelocity(unsigned int contact) const;
+		ConstVector3dMap getContactAcceleration(unsigned int contact) const;
+		ConstVector3dMap getContactForce(unsigned int contact) const;
+
+
+	private:
+		/**
+		 * @brief Maps a variable of the decision state
+		 * @param int Offset of the variable
+		 * @param unsigned int Dimension of the variable
+		 */
+		ConstVectorMap map(int offset,
+						   unsigned int dim) const;
+
+		/**
+		 * @brief Maps a contact variable of the decision state
+		 * @param unsigned int Contact index
+		 * @param int Offset of the variable inside the contact block
+		 */
+		ConstVector3dMap mapContact(unsigned int contact,
+									int offset) const;
+
+		/** @brief Decision state buffer */
+		const double* state_;
+
+		/** @brief Layout of the decision state */
+		const WholeBodyStateLayout* layout_;
+
+		/** @brief Time and duration of the knot */
+		double time_;
+		double duration_;
+
+		/** @brief Decoder and decoded whole-body state */
+		WholeBodyStateDecoder* decoder_;
+		mutable const WholeBodyState* decoded_state_;
+};
+
+} //@namespace ocp
+} //@namespace dwl
+
+#endif
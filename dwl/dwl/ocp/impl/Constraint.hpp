@@ -73,14 +73,50 @@ void Constraint<TState>::init(bool info)
 template <typename TState>
 void Constraint<TState>::computeSoft(double& constraint_cost,
 									 const TState& state)
+{
+	Eigen::VectorXd constraint;
+	compute(constraint, state);
+	computeSoftValue(constraint_cost, constraint);
+}
+
+
+template <typename TState>
+void Constraint<TState>::computeSoft(double& constraint_cost,
+									 const WholeBodyStateView& state_view)
+{
+	Eigen::VectorXd constraint;
+	compute(constraint, state_view);
+	computeSoftValue(constraint_cost, constraint);
+}
+
+
+template <typename TState>
+void Constraint<TState>::compute(Eigen::VectorXd& constraint,
+								 const WholeBodyStateView& state_view)
+{
+	printf(RED_ "FATAL: the %s constraint doesn't evaluate whole-body state views\n"
+			COLOR_RESET, name_.c_str());
+	exit(EXIT_FAILURE);
+}
+
+
+template <>
+inline void Constraint<WholeBodyState>::compute(Eigen::VectorXd& constraint,
+												const WholeBodyStateView& state_view)
+{
+	compute(constraint, state_view.getWholeBodyState());
+}
+
+
+template <typename TState>
+void Constraint<TState>::computeSoftValue(double& constraint_cost,
+										  const Eigen::VectorXd& constraint)
 {
 	// Initialization of the cost value
 	constraint_cost = 0.;
 
-	// Getting the constraint value and bounds
-	Eigen::VectorXd constraint, lower_bound, upper_bound;
-	compute(constraint, state);
-
+	// Getting the constraint bounds
+	Eigen::VectorXd lower_bound, upper_bound;
 	getBounds(lower_bound, upper_bound);
 
 	// Computing the violation vector
@@ -143,7 +179,7 @@ void Constraint<TState>::setSoftProperties(const SoftConstraintProperties& prope
 
 
 template <typename TState>
-void Constraint<TState>::setLastState(TState& last_state)
+void Constraint<TState>::setLastState(const TState& last_state)
 {
 	state_buffer_.push_front(last_state);
 }
@@ -1,4 +1,5 @@
 #include <dwl/solver/AStar.h>
+#include <algorithm>
 
 
 namespace dwl
@@ -7,7 +8,7 @@ namespace dwl
 namespace solver
 {
 
-AStar::AStar() : expansions_(0)
+AStar::AStar()
 {
 	name_ = "A-star";
 }
@@ -15,7 +16,7 @@ AStar::AStar() : expansions_(0)
 
 AStar::~AStar()
 {
-	policy_.clear();
+
 }
 
 
@@ -36,57 +37,81 @@ bool AStar::compute(Vertex source,
 	}
 
 	// Computing the shortest path
-	findShortestPath(source, target);
+	findShortestPath(source, std::vector<Vertex>(1, target));
 
 	return true;
 }
 
 
-void AStar::findShortestPath(Vertex source,
-							 Vertex target)
+bool AStar::computeMultiGoal(Vertex source,
+							 const std::vector<Vertex>& targets,
+							 double computation_time)
 {
-	// Defining the f_cost and g_cost
-	CostMap f_cost;
-	CostMap g_cost;
+	if (!is_set_adjacency_model_) {
+		printf(RED_ "Could not computed the shortest path because "
+				"it is required to defined an adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	if (targets.empty()) {
+		printf(RED_ "Could not computed the shortest path because there are not targets\n"
+				COLOR_RESET);
+		return false;
+	}
+
+	// Computing the shortest path
+	return findShortestPath(source, targets);
+}
+
 
+bool AStar::findShortestPath(Vertex source,
+							 const std::vector<Vertex>& targets)
+{
 	// Setting the initial time
 	time_started_ = clock();
 
 	// Number of expansions
 	expansions_ = 0;
 
-	// Defining the set of nodes already evaluated (openset), the set of
-	// tentative nodes to be evaluated (openset), and ordered openset queue
-	std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > openset_queue;
-	std::map<Vertex, bool> openset;
-	std::map<Vertex, bool> closedset;
-
-	// Cost from start along best known path.
-	g_cost[source] = 0;
-
-	// Estimated total cost from start to goal
-	f_cost[source] = g_cost[source] + adjacency_->heuristicCost(source, target);
+	// Resetting the costs, parents, closed set and openset queue of the previous search
+	search_space_.reset();
+	openset_.clear();
+
+	// Cost from start along best known path, and estimated total cost from start to goal.
+	// The target index is the best target found, i.e. the first one until a target is reached
+	unsigned int source_idx = search_space_.getIndex(source);
+	std::vector<unsigned int> target_idxs(targets.size());
+	for (unsigned int i = 0; i < targets.size(); i++)
+		target_idxs[i] = search_space_.getIndex(targets[i]);
+	unsigned int target_idx = target_idxs.front();
+	std::vector<unsigned int> sorted_target_idxs(target_idxs);
+	std::sort(sorted_target_idxs.begin(), sorted_target_idxs.end());
+	search_space_.setCost(source_idx, 0.);
 
 	// Adding the start vertex to the openset
-	openset_queue.insert(std::pair<Weight, Vertex>(f_cost[source], source));
-	openset[source] = true;
-	double min_f_cost = std::numeric_limits<double>::max();
-	while ((!openset.empty()) && (g_cost[target] < min_f_cost)) {
-		Vertex current = openset_queue.begin()->second;
-
-		// Checking if it is getted the target
-		if (adjacency_->isReachedGoal(target, current)) {
-			policy_[target] = current;
-			g_cost[target] = g_cost[current];
-			break;
+	openset_.push(source_idx, adjacency_->heuristicCost(source, targets));
+	while (!openset_.empty() && (search_space_.getCost(target_idx) > openset_.topKey())) {
+		unsigned int current_idx = openset_.pop();
+		Vertex current = search_space_.getVertex(current_idx);
+		Weight current_g_cost = search_space_.getCost(current_idx);
+
+		// Checking if it is getted a target
+		bool is_reached = false;
+		for (unsigned int i = 0; i < targets.size() && !is_reached; i++) {
+			if (adjacency_->isReachedGoal(targets[i], current)) {
+				target_idx = target_idxs[i];
+				if (current_idx != target_idx) {
+					search_space_.setParent(target_idx, current_idx);
+					search_space_.setCost(target_idx, current_g_cost);
+				}
+				is_reached = true;
+			}
 		}
-
-		// Deleting the current vertex to the openset list
-		openset_queue.erase(openset_queue.begin());
-		openset.erase(current);
+		if (is_reached)
+			break;
 
 		// Adding the current vertex to the closedset
-		closedset[current] = true;
+		search_space_.close(current_idx);
 
 		// Visit each edge exiting in the current vertex
 		std::list<Edge> successors;
@@ -98,32 +123,33 @@ void AStar::findShortestPath(Vertex source,
 			Vertex neighbor = edge_iter->target;
 			Weight weight = edge_iter->weight;
 
-			if (closedset.count(neighbor) > 0)
+			unsigned int neighbor_idx = search_space_.getIndex(neighbor);
+			if (search_space_.isClosed(neighbor_idx))
 				continue;
 
-			Weight tentative_g_cost = g_cost[current] + weight;
-			if ((openset.count(neighbor) == 0) || (tentative_g_cost < g_cost[neighbor])) {
-				policy_[neighbor] = current;
-				g_cost[neighbor] = tentative_g_cost;
-				f_cost[neighbor] = g_cost[neighbor] + adjacency_->heuristicCost(neighbor, target);
-
-				if (openset.count(neighbor) == 0) {
-					openset[neighbor] = true;
-					openset_queue.insert(std::pair<Weight, Vertex>(f_cost[neighbor], neighbor));
-				}
+			// Updating the cost of the neighbor, i.e. decrease-key in the openset queue
+			Weight tentative_g_cost = current_g_cost + weight;
+			if (tentative_g_cost < search_space_.getCost(neighbor_idx)) {
+				search_space_.setParent(neighbor_idx, current_idx);
+				search_space_.setCost(neighbor_idx, tentative_g_cost);
+				openset_.push(neighbor_idx,
+							  tentative_g_cost + adjacency_->heuristicCost(neighbor, targets));
+
+				// Keeping the cheapest target that was found
+				if (tentative_g_cost < search_space_.getCost(target_idx) &&
+						std::binary_search(sorted_target_idxs.begin(), sorted_target_idxs.end(),
+										   neighbor_idx))
+					target_idx = neighbor_idx;
 			}
 		}
 		expansions_++;
-
-		// Computing the minimum f cost
-		Vertex current_vertex = openset_queue.begin()->second;
-		double current_f_cost = openset_queue.begin()->first;
-		min_f_cost = current_f_cost + adjacency_->heuristicCost(current_vertex, target);
 	}
 
-	total_cost_ = g_cost[target];
+	reached_target_ = search_space_.getVertex(target_idx);
+	total_cost_ = search_space_.getCost(target_idx);
+
+	return total_cost_ < std::numeric_limits<Weight>::max();
 }
 
 } //@namespace solver
 } //@namespace dwl
-
@@ -41,18 +41,29 @@ class AStar : public SearchTreeSolver
 					 Vertex target,
 					 double computation_time);
 
+		/**
+		 * @brief Computes a shortest-path to the first reached vertex of a set of targets using
+		 * A* algorithm. The heuristic is the cost-to-go to the closest target
+		 * @param Vertex Source vertex
+		 * @param const std::vector<Vertex>& Target vertexes
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if it was reached a target
+		 */
+		bool computeMultiGoal(Vertex source,
+							  const std::vector<Vertex>& targets,
+							  double computation_time);
+
 
 	private:
 		/**
 		 * @brief Computes the minimum cost and previous vertex according to the shortest A* path
+		 * to the first reached target
 		 * @param Vertex Source vertex
-		 * @param Vertex Target vertex
+		 * @param const std::vector<Vertex>& Target vertexes
+		 * @return True if it was reached a target
 		 */
-		void findShortestPath(Vertex source,
-							  Vertex target);
-
-		/** @brief number of expansions */
-		int expansions_;
+		bool findShortestPath(Vertex source,
+							  const std::vector<Vertex>& targets);
 };
 
 } //@namespace solver
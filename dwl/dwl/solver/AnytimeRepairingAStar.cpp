@@ -1,5 +1,4 @@
 #include <dwl/solver/AnytimeRepairingAStar.h>
-#include <time.h>
 
 
 namespace dwl
@@ -8,9 +7,10 @@ namespace dwl
 namespace solver
 {
 
-AnytimeRepairingAStar::AnytimeRepairingAStar(double initial_inflation) :
-		initial_inflation_(initial_inflation), satisfied_inflation_(1.0),
-		min_f_cost_(std::numeric_limits<double>::max()), expansions_(0)
+AnytimeRepairingAStar::AnytimeRepairingAStar(double initial_inflation,
+											 double inflation_decrease) :
+		initial_inflation_(initial_inflation), inflation_decrease_(inflation_decrease),
+		current_inflation_(initial_inflation), satisfied_inflation_(1.0), allocated_time_(0.)
 {
 	name_ = "Anytime Repairing A*";
 }
@@ -18,8 +18,7 @@ AnytimeRepairingAStar::AnytimeRepairingAStar(double initial_inflation) :
 
 AnytimeRepairingAStar::~AnytimeRepairingAStar()
 {
-	policy_.clear();
-	g_cost_.clear();
+
 }
 
 
@@ -39,80 +38,121 @@ bool AnytimeRepairingAStar::compute(Vertex source,
 		return false;
 	}
 
-	// Defining the set of nodes already evaluated (openset), the set of tentative nodes
-	// to be evaluated (openset), and ordered openset queue
-	SetQueue openset_queue;
-	Set openset, visitedset;
+	// Resetting the costs, parents, closed set, openset queue and inconsistent
+	// set of the previous search
+	search_space_.reset();
+	openset_.clear();
+	inconsistentset_.clear();
 
-	// Setting the initial time
-	time_started_ = clock();
+	// Setting the deadline with a monotonic clock, which isn't affected by the CPU time of
+	// other threads or by changes of the system time
+	started_ = std::chrono::steady_clock::now();
+	allocated_time_ = computation_time;
+	{
+		std::lock_guard<std::mutex> lock(path_mutex_);
+		best_path_ = AnytimePath();
+	}
 
 	satisfied_inflation_ = initial_inflation_;
-	double current_inflation = initial_inflation_;
+	current_inflation_ = initial_inflation_;
+	total_cost_ = std::numeric_limits<Weight>::max();
 
 	// Number of expansions
 	expansions_ = 0;
 
-	// Getting the allocated time for computing a solution
-	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
-
 	// Setting the g cost of the start and goal state
-	g_cost_[source] = 0;
-	g_cost_[target] = std::numeric_limits<double>::max();
-
-	// Estimated total cost from start to goal
-	double f_cost = g_cost_[source] +
-			satisfied_inflation_ * adjacency_->heuristicCost(source, target);
-
-	// Adding the start vertex to the openset
-	openset_queue.insert(std::pair<Weight, Vertex>(f_cost, source));
-	openset[source] = true;
-
-	// Computing the minimum f cost
-	Vertex current_vertex = openset_queue.begin()->second;
-	double current_f_cost = openset_queue.begin()->first;
-	min_f_cost_ = current_f_cost +
-			satisfied_inflation_ * adjacency_->heuristicCost(current_vertex, target);
-
-	while ((satisfied_inflation_ > 1) && ((clock() - time_started_) < allocated_time_secs)) {
-		// Computing a path with reuse of states values
-		if (improvePath(openset_queue, visitedset, target, computation_time)) {
-			// Decreasing the current inflation gain
-			double next_inflation = min_f_cost_ / g_cost_[target];
-			if (current_inflation > next_inflation)
-				current_inflation = next_inflation;
-
-			if (current_inflation < 1)
-				current_inflation = 1;
-			satisfied_inflation_ = current_inflation;
-
-			total_cost_ = g_cost_[target];
+	unsigned int source_idx = search_space_.getIndex(source);
+	unsigned int target_idx = search_space_.getIndex(target);
+	search_space_.setCost(source_idx, 0.);
+
+	// Adding the start vertex to the openset with its estimated total cost
+	openset_.push(source_idx, current_inflation_ * adjacency_->heuristicCost(source, target));
+
+	while (!isExpired()) {
+		// Computing a path with reuse of states values. Note that the path of an interrupted
+		// iteration isn't published, so the last completed solution and its bound are kept
+		if (!improvePath(target))
+			break;
+
+		// Publishing the improved path or bound, i.e. a path inside the current
+		// sub-optimality bound
+		total_cost_ = search_space_.getCost(target_idx);
+		if (total_cost_ < best_path_.cost || current_inflation_ < best_path_.inflation)
+			publishPath(source, target);
+		if (current_inflation_ <= 1)
+			break;
+
+		// Decreasing the current inflation gain and updating the openset
+		current_inflation_ -= inflation_decrease_;
+		if (current_inflation_ < 1)
+			current_inflation_ = 1;
+		double min_f_cost = updateOpenSet(target);
+
+		// Computing the sub-optimality bound of the current path
+		double next_inflation = total_cost_ / min_f_cost;
+		if (next_inflation < satisfied_inflation_)
+			satisfied_inflation_ = next_inflation;
+		if (satisfied_inflation_ <= 1) {
+			satisfied_inflation_ = 1;
+			break;
 		}
 	}
 
+	return total_cost_ < std::numeric_limits<Weight>::max();
+}
+
+
+void AnytimeRepairingAStar::setPathCallback(const AnytimePathCallback& callback)
+{
+	path_callback_ = callback;
+}
+
+
+bool AnytimeRepairingAStar::getBestPath(AnytimePath& path) const
+{
+	std::lock_guard<std::mutex> lock(path_mutex_);
+	if (best_path_.path.empty())
+		return false;
+
+	path = best_path_;
 	return true;
 }
 
 
-bool AnytimeRepairingAStar::improvePath(SetQueue& openset_queue,
-										Set& visitedset,
-										Vertex target,
-										double computation_time)
+std::list<Vertex> AnytimeRepairingAStar::getShortestPath(Vertex source,
+														Vertex target)
 {
-	// Setting an empty closed set and inconsistent set
-	Set closedset;
-	SetQueue inconsistentset_queue;
+	std::lock_guard<std::mutex> lock(path_mutex_);
+	if (!best_path_.path.empty() && best_path_.path.front() == source &&
+			best_path_.path.back() == target)
+		return best_path_.path;
 
-	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
-	while ((!openset_queue.empty()) && ((clock() - time_started_) < allocated_time_secs)
-			&& (g_cost_[target] > min_f_cost_)) {
-		Vertex current = openset_queue.begin()->second;
+	return std::list<Vertex>();
+}
+
+
+bool AnytimeRepairingAStar::improvePath(Vertex target)
+{
+	unsigned int target_idx = search_space_.getIndex(target);
 
-		// Deleting the current vertex to the openset list
-		openset_queue.erase(openset_queue.begin());
+	while ((!openset_.empty()) && !isExpired()
+			&& (search_space_.getCost(target_idx) > openset_.topKey())) {
+		unsigned int current_idx = openset_.pop();
+		Vertex current = search_space_.getVertex(current_idx);
+		Weight current_g_cost = search_space_.getCost(current_idx);
 
 		// Adding the current vertex to the closedset
-		closedset[current] = true;
+		search_space_.close(current_idx);
+
+		// Checking if it is getted the target
+		if (adjacency_->isReachedGoal(target, current)) {
+			if (current_idx != target_idx &&
+					current_g_cost < search_space_.getCost(target_idx)) {
+				search_space_.setParent(target_idx, current_idx);
+				search_space_.setCost(target_idx, current_g_cost);
+			}
+			continue;
+		}
 
 		// Visit each edge exiting in the current vertex
 		std::list<Edge> successors;
@@ -124,44 +164,79 @@ bool AnytimeRepairingAStar::improvePath(SetQueue& openset_queue,
 			Vertex neighbor = edge_iter->target;
 			Weight weight = edge_iter->weight;
 
-			if (visitedset.count(neighbor) == 0) {
-				g_cost_[neighbor] = std::numeric_limits<double>::max();
-				visitedset[neighbor] = true;
-			}
-
-			Weight tentative_g_cost = g_cost_[current] + weight;
-			if (tentative_g_cost < g_cost_[neighbor]) {
-				policy_[neighbor] = current;
-				g_cost_[neighbor] = tentative_g_cost;
-				double f_cost = g_cost_[neighbor] +
-						satisfied_inflation_ * adjacency_->heuristicCost(neighbor, target);
-				if (closedset.count(neighbor) == 0) {
-					openset_queue.insert(std::pair<Weight, Vertex>(f_cost, neighbor));
-				} else {
-					inconsistentset_queue.insert(std::pair<Weight, Vertex>(f_cost, neighbor));
-				}
+			unsigned int neighbor_idx = search_space_.getIndex(neighbor);
+			Weight tentative_g_cost = current_g_cost + weight;
+			if (tentative_g_cost < search_space_.getCost(neighbor_idx)) {
+				search_space_.setParent(neighbor_idx, current_idx);
+				search_space_.setCost(neighbor_idx, tentative_g_cost);
+				if (!search_space_.isClosed(neighbor_idx)) {
+					double f_cost = tentative_g_cost +
+							current_inflation_ * adjacency_->heuristicCost(neighbor, target);
+					openset_.push(neighbor_idx, f_cost);
+				} else
+					inconsistentset_.push_back(neighbor_idx);
 			}
 		}
 
 		expansions_++;
 	}
 
-	// Setting open set with all over consistent states
-	for (SetQueue::iterator incons_iter = inconsistentset_queue.begin();
-			incons_iter != inconsistentset_queue.end(); incons_iter++)
+	// The iteration is completed if there isn't a state whose inflated f cost is lower than
+	// the target cost, otherwise it was interrupted by the deadline
+	bool is_completed = openset_.empty() ||
+			search_space_.getCost(target_idx) <= openset_.topKey();
+
+	return is_completed && search_space_.getCost(target_idx) < std::numeric_limits<Weight>::max();
+}
+
+
+bool AnytimeRepairingAStar::isExpired() const
+{
+	double elapsed_time =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+
+	return elapsed_time >= allocated_time_;
+}
+
+
+void AnytimeRepairingAStar::publishPath(Vertex source,
+										Vertex target)
+{
+	AnytimePath path;
+	search_space_.getPath(path.path, source, target);
+	path.cost = total_cost_;
+	path.inflation = current_inflation_;
+	path.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
 	{
-		double f_cost = incons_iter->first;
-		Vertex vertex = incons_iter->second;
-		openset_queue.insert(std::pair<Weight, Vertex>(f_cost, vertex));
+		std::lock_guard<std::mutex> lock(path_mutex_);
+		best_path_ = path;
 	}
 
-	// Computing the minimum f cost
-	Vertex current_vertex = openset_queue.begin()->second;
-	double current_f_cost = openset_queue.begin()->first;
-	min_f_cost_ = current_f_cost +
-			satisfied_inflation_ * adjacency_->heuristicCost(current_vertex, target);
+	if (path_callback_)
+		path_callback_(path);
+}
 
-	return true;
+
+double AnytimeRepairingAStar::updateOpenSet(Vertex target)
+{
+	// Moving the inconsistent states to the openset and updating the f cost of every state
+	// with the current inflation gain. The heap is rebuilt in place, and the duplicated
+	// inconsistent states are added once
+	double min_f_cost = std::numeric_limits<double>::max();
+	openset_.rebuild(inconsistentset_, [&](unsigned int state_idx) {
+		double g_cost = search_space_.getCost(state_idx);
+		double h_cost = adjacency_->heuristicCost(search_space_.getVertex(state_idx), target);
+		if (g_cost + h_cost < min_f_cost)
+			min_f_cost = g_cost + h_cost;
+
+		return g_cost + current_inflation_ * h_cost;
+	});
+	inconsistentset_.clear();
+
+	// Starting with an empty closed set
+	search_space_.resetClosedSet();
+
+	return min_f_cost;
 }
 
 } //@namespace solver
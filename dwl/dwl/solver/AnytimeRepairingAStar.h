@@ -2,6 +2,9 @@
 #define DWL__SOLVER__ANYTIME_REPAIRING_ASTAR__H
 
 #include <dwl/solver/SearchTreeSolver.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
 
 
 namespace dwl
@@ -10,16 +13,42 @@ namespace dwl
 namespace solver
 {
 
+/**
+ * @brief Defines a path published by the anytime planner, i.e. the path, its cost, its
+ * sub-optimality bound (inflation) and the elapsed time since the computation started
+ */
+struct AnytimePath
+{
+	AnytimePath() : cost(std::numeric_limits<Weight>::max()), inflation(0.), time(0.) {}
+
+	std::list<Vertex> path;
+	Weight cost;
+	double inflation;
+	double time;
+};
+
+/** @brief Defines the callback function that receives each improved path */
+typedef std::function<void(const AnytimePath&)> AnytimePathCallback;
+
+
 /**
  * @class AnytimeRepairingAStar
  * @brief Class for solving a shortest-search problem using the ARA* algorithm. This class derives
- * from the SearchTreeSolver class
+ * from the SearchTreeSolver class. The computation time is a wall-clock deadline, and each
+ * improved path is published through a callback and a polled handle, so the controller could
+ * take the best path at any time. Only the paths of the completed iterations are published, i.e.
+ * the paths inside their sub-optimality bound
  */
 class AnytimeRepairingAStar : public SearchTreeSolver
 {
 	public:
-		/** @brief Constructor function */
-		AnytimeRepairingAStar(double initial_inflation = 3.0);
+		/**
+		 * @brief Constructor function
+		 * @param double Initial inflation of the heuristic
+		 * @param double Decrease of the inflation after each improved path
+		 */
+		AnytimeRepairingAStar(double initial_inflation = 3.0,
+							  double inflation_decrease = 0.5);
 
 		/** @brief Destructor function */
 		~AnytimeRepairingAStar();
@@ -41,40 +70,85 @@ class AnytimeRepairingAStar : public SearchTreeSolver
 					 Vertex target,
 					 double computation_time);
 
-		/** @brief Defines a ordered queue according to the less weight */
-		typedef std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > SetQueue;
+		/**
+		 * @brief Sets the callback function that receives each improved path. Note that it's
+		 * called from the thread that computes the path
+		 * @param const AnytimePathCallback& Callback function
+		 */
+		void setPathCallback(const AnytimePathCallback& callback);
+
+		/**
+		 * @brief Gets the best path published in the current computation. It could be called
+		 * from another thread while the path is computed
+		 * @param AnytimePath& Best path
+		 * @return True if there is a published path
+		 */
+		bool getBestPath(AnytimePath& path) const;
 
-		/** @brief Defines a set of known vertex */
-		typedef std::map<Vertex, bool> Set;
+		/**
+		 * @brief Gets the best path published in the last computation. Note that the search
+		 * space could have a path of an iteration that was interrupted by the deadline
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 * @return The path as a list of vertex, which is empty if there isn't a published path
+		 */
+		std::list<Vertex> getShortestPath(Vertex source,
+										  Vertex target);
 
 
 	private:
 		/**
-		 * @brief Improves the path according to inflation gain
-		 * @param SetQueue& openset_queue Openset queue
-		 * @param Set& visitedset Visited set
+		 * @brief Improves the path according to the current inflation gain
+		 * @param Vertex target Target vertex
+		 * @return True if there is a path inside the current sub-optimality bound, i.e. the
+		 * iteration wasn't interrupted by the deadline
+		 */
+		bool improvePath(Vertex target);
+
+		/** @brief Returns true if the deadline of the current computation was reached */
+		bool isExpired() const;
+
+		/**
+		 * @brief Publishes the current path to the callback function and the polled handle
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		void publishPath(Vertex source,
+						 Vertex target);
+
+		/**
+		 * @brief Moves the inconsistent states to the openset, and updates the openset
+		 * queue according to the current inflation gain
 		 * @param Vertex target Target vertex
-		 * @return True if the path was improved
+		 * @return The minimum non-inflated f cost of the openset
 		 */
-		bool improvePath(SetQueue& openset_queue,
-						 Set& visitedset,
-						 Vertex target,
-						 double computation_time);
+		double updateOpenSet(Vertex target);
 
 		/** @brief Initial inflation */
 		double initial_inflation_;
 
-		/** @brief Satisfied inflation */
+		/** @brief Decrease of the inflation after each improved path */
+		double inflation_decrease_;
+
+		/** @brief Inflation used for the current search */
+		double current_inflation_;
+
+		/** @brief Satisfied inflation, i.e. sub-optimality bound of the current path */
 		double satisfied_inflation_;
 
-		/** @brief G cost */
-		CostMap g_cost_;
+		/** @brief Inconsistent states, i.e. closed states that improved their cost */
+		std::vector<unsigned int> inconsistentset_;
+
+		/** @brief Starting time (monotonic clock) and allocated time of the current computation */
+		std::chrono::steady_clock::time_point started_;
+		double allocated_time_;
 
-		/** @brief Minimum f cost */
-		double min_f_cost_;
+		/** @brief Callback function that receives each improved path */
+		AnytimePathCallback path_callback_;
 
-		/** @brief number of expansions */
-		int expansions_;
+		/** @brief Best path of the current computation, and its mutex */
+		AnytimePath best_path_;
+		mutable std::mutex path_mutex_;
 };
 
 } //@namespace solver
@@ -0,0 +1,223 @@
+#include <dwl/solver/BidirectionalAStar.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+BidirectionalAStar::BidirectionalAStar() : source_(0), target_(0), is_backward_search_(true),
+		best_cost_(std::numeric_limits<Weight>::max()), meeting_vertex_(0)
+{
+	name_ = "Bidirectional A-star";
+}
+
+
+BidirectionalAStar::~BidirectionalAStar()
+{
+
+}
+
+
+bool BidirectionalAStar::init()
+{
+	return true;
+}
+
+
+bool BidirectionalAStar::compute(Vertex source,
+								 Vertex target,
+								 double computation_time)
+{
+	if (!is_set_adjacency_model_) {
+		printf(RED_ "Could not computed the shortest path because "
+				"it is required to defined an adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	if (adjacency_->isLatticeRepresentation()) {
+		printf(RED_ "Could not computed the shortest path because the bidirectional search"
+				" requires a grid adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	// Setting the initial time
+	time_started_ = clock();
+	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
+
+	// Number of expansions
+	expansions_ = 0;
+
+	// Resetting the forward and backward searches
+	search_space_.reset();
+	openset_.clear();
+	backward_space_.reset();
+	backward_openset_.clear();
+	source_ = source;
+	target_ = target;
+	reached_target_ = target;
+	is_backward_search_ = !adjacency_->isHeuristicField();
+	best_cost_ = std::numeric_limits<Weight>::max();
+	if (source == target) {
+		best_cost_ = 0.;
+		meeting_vertex_ = source;
+	}
+
+	unsigned int source_idx = search_space_.getIndex(source);
+	search_space_.setCost(source_idx, 0.);
+	openset_.push(source_idx, computePotential(source));
+	if (is_backward_search_) {
+		unsigned int target_idx = backward_space_.getIndex(target);
+		backward_space_.setCost(target_idx, 0.);
+		backward_openset_.push(target_idx, -computePotential(target));
+	}
+
+	// Expanding the search with the smaller openset until the best path can't be improved
+	bool is_timeout = false;
+	while (!openset_.empty()) {
+		if (is_backward_search_) {
+			if (backward_openset_.empty() ||
+					openset_.topKey() + backward_openset_.topKey() >= best_cost_)
+				break;
+		} else if (openset_.topKey() >= best_cost_)
+			break;
+
+		if ((clock() - time_started_) >= allocated_time_secs) {
+			is_timeout = true;
+			break;
+		}
+
+		if (is_backward_search_ && backward_openset_.size() < openset_.size())
+			expandBackward();
+		else
+			expandForward();
+		expansions_++;
+	}
+
+	total_cost_ = best_cost_;
+	if (best_cost_ == std::numeric_limits<Weight>::max())
+		return false;
+
+	joinPaths();
+
+	return !is_timeout;
+}
+
+
+Weight BidirectionalAStar::computePotential(Vertex vertex)
+{
+	if (!is_backward_search_)
+		return adjacency_->heuristicCost(vertex, target_);
+
+	return 0.5 * (adjacency_->heuristicCost(vertex, target_) -
+			adjacency_->heuristicCost(source_, vertex));
+}
+
+
+void BidirectionalAStar::expandForward()
+{
+	unsigned int current_idx = openset_.pop();
+	Vertex current = search_space_.getVertex(current_idx);
+	Weight current_g_cost = search_space_.getCost(current_idx);
+	search_space_.close(current_idx);
+
+	// Visit each edge exiting in the current vertex
+	std::list<Edge> successors;
+	adjacency_->getSuccessors(successors, current);
+	for (std::list<Edge>::iterator edge_iter = successors.begin();
+			edge_iter != successors.end();
+			edge_iter++)
+	{
+		Vertex neighbor = edge_iter->target;
+		unsigned int neighbor_idx = search_space_.getIndex(neighbor);
+		if (search_space_.isClosed(neighbor_idx))
+			continue;
+
+		Weight tentative_g_cost = current_g_cost + edge_iter->weight;
+		if (tentative_g_cost < search_space_.getCost(neighbor_idx)) {
+			search_space_.setParent(neighbor_idx, current_idx);
+			search_space_.setCost(neighbor_idx, tentative_g_cost);
+			openset_.push(neighbor_idx, tentative_g_cost + computePotential(neighbor));
+
+			// Updating the best path if the neighbor was reached by the backward search, or
+			// if it's the target when there isn't backward search
+			unsigned int backward_idx;
+			if (!is_backward_search_) {
+				if (neighbor == target_) {
+					best_cost_ = tentative_g_cost;
+					meeting_vertex_ = neighbor;
+				}
+			} else if (backward_space_.find(backward_idx, neighbor)) {
+				Weight cost = tentative_g_cost + backward_space_.getCost(backward_idx);
+				if (cost < best_cost_) {
+					best_cost_ = cost;
+					meeting_vertex_ = neighbor;
+				}
+			}
+		}
+	}
+}
+
+
+void BidirectionalAStar::expandBackward()
+{
+	unsigned int current_idx = backward_openset_.pop();
+	Vertex current = backward_space_.getVertex(current_idx);
+	Weight current_g_cost = backward_space_.getCost(current_idx);
+	backward_space_.close(current_idx);
+
+	// Visit each edge entering in the current vertex
+	std::list<Edge> predecessors;
+	adjacency_->getPredecessors(predecessors, current);
+	for (std::list<Edge>::iterator edge_iter = predecessors.begin();
+			edge_iter != predecessors.end();
+			edge_iter++)
+	{
+		Vertex neighbor = edge_iter->target;
+		unsigned int neighbor_idx = backward_space_.getIndex(neighbor);
+		if (backward_space_.isClosed(neighbor_idx))
+			continue;
+
+		Weight tentative_g_cost = current_g_cost + edge_iter->weight;
+		if (tentative_g_cost < backward_space_.getCost(neighbor_idx)) {
+			backward_space_.setParent(neighbor_idx, current_idx);
+			backward_space_.setCost(neighbor_idx, tentative_g_cost);
+			backward_openset_.push(neighbor_idx, tentative_g_cost - computePotential(neighbor));
+
+			// Updating the best path if the neighbor was reached by the forward search
+			unsigned int forward_idx;
+			if (search_space_.find(forward_idx, neighbor)) {
+				Weight cost = tentative_g_cost + search_space_.getCost(forward_idx);
+				if (cost < best_cost_) {
+					best_cost_ = cost;
+					meeting_vertex_ = neighbor;
+				}
+			}
+		}
+	}
+}
+
+
+void BidirectionalAStar::joinPaths()
+{
+	// Following the backward parents from the meeting vertex, which point to the target
+	unsigned int backward_idx;
+	if (!backward_space_.find(backward_idx, meeting_vertex_))
+		return;
+
+	unsigned int current_idx = search_space_.getIndex(meeting_vertex_);
+	unsigned int num_steps = 0;
+	while (backward_space_.getParent(backward_idx) != SearchSpace::NO_INDEX &&
+			num_steps < backward_space_.size()) {
+		backward_idx = backward_space_.getParent(backward_idx);
+		unsigned int next_idx = search_space_.getIndex(backward_space_.getVertex(backward_idx));
+		search_space_.setParent(next_idx, current_idx);
+		search_space_.setCost(next_idx, best_cost_ - backward_space_.getCost(backward_idx));
+		current_idx = next_idx;
+		++num_steps;
+	}
+}
+
+} //@namespace solver
+} //@namespace dwl
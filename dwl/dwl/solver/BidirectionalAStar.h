@@ -0,0 +1,93 @@
+#ifndef DWL__SOLVER__BIDIRECTIONAL_ASTAR__H
+#define DWL__SOLVER__BIDIRECTIONAL_ASTAR__H
+
+#include <dwl/solver/SearchTreeSolver.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class BidirectionalAStar
+ * @brief Class for solving a shortest-search problem using a bidirectional A* algorithm. This
+ * class derives from the SearchTreeSolver class. A forward search from the source and a backward
+ * search from the target (through the predecessors of the adjacency model) are expanded
+ * alternately until the best meeting path can't be improved. Both searches use the average of
+ * the forward and backward heuristics as potential, which keeps the keys of both searches
+ * consistent, so the search stops when the sum of the minimum keys reaches the best cost. It's
+ * only suitable for grid adjacencies, where the target is a single vertex. With a heuristic
+ * field only the forward search is expanded, because the field is already the exact cost-to-go
+ */
+class BidirectionalAStar : public SearchTreeSolver
+{
+	public:
+		/** @brief Constructor function */
+		BidirectionalAStar();
+
+		/** @brief Destructor function */
+		~BidirectionalAStar();
+
+		/**
+		 * @brief Initializes the bidirectional A* algorithm
+		 * @return True if bidirectional A* algorithm was initialized
+		 */
+		bool init();
+
+		/**
+		 * @brief Computes a shortest-path using bidirectional A* algorithm
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if it was computed a solution
+		 */
+		bool compute(Vertex source,
+					 Vertex target,
+					 double computation_time);
+
+
+	private:
+		/**
+		 * @brief Computes the potential of a vertex, i.e. the key offset of the forward search.
+		 * The backward search uses the opposite potential
+		 * @param Vertex Vertex id
+		 * @return The potential of the vertex
+		 */
+		Weight computePotential(Vertex vertex);
+
+		/** @brief Expands the top vertex of the forward search */
+		void expandForward();
+
+		/** @brief Expands the top vertex of the backward search */
+		void expandBackward();
+
+		/**
+		 * @brief Joins the backward path from the meeting vertex to the target to the
+		 * forward parents, so the path is reconstructed from the forward search space
+		 */
+		void joinPaths();
+
+		/** @brief Dense costs, parents and closed set of the backward search */
+		SearchSpace backward_space_;
+
+		/** @brief Openset queue of the backward search */
+		IndexedHeap<> backward_openset_;
+
+		/** @brief Source and target of the current search */
+		Vertex source_;
+		Vertex target_;
+
+		/** @brief Indicates if the backward search is expanded */
+		bool is_backward_search_;
+
+		/** @brief Cost of the best path found, and its meeting vertex */
+		Weight best_cost_;
+		Vertex meeting_vertex_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
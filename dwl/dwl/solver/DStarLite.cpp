@@ -0,0 +1,356 @@
+#include <dwl/solver/DStarLite.h>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+DStarLite::DStarLite() : source_(0), target_(0), last_source_(0), key_modifier_(0.),
+		update_radius_(0.), allocated_time_(0.), terrain_revision_(0), is_initialized_(false)
+{
+	name_ = "D* Lite";
+}
+
+
+DStarLite::~DStarLite()
+{
+
+}
+
+
+bool DStarLite::init()
+{
+	printf("Initialized the D* Lite algorithm\n");
+	return true;
+}
+
+
+bool DStarLite::compute(Vertex source,
+						Vertex target,
+						double computation_time)
+{
+	if (!is_set_adjacency_model_) {
+		printf(RED_ "Could not computed the shortest path because "
+				"it is required to defined an adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	// The lattice successors are directed, so their predecessors aren't the successors that
+	// the default predecessor search assumes
+	if (adjacency_->isLatticeRepresentation()) {
+		printf(RED_ "Could not computed the shortest path because D* Lite requires a grid"
+				" adjacency model\n" COLOR_RESET);
+		return false;
+	}
+
+	// Setting the deadline with a monotonic clock, which isn't affected by the CPU time of
+	// other threads or by changes of the system time
+	started_ = std::chrono::steady_clock::now();
+	allocated_time_ = computation_time;
+
+	// Number of expansions
+	expansions_ = 0;
+
+	// Getting the terrain cells that changed since the last search. A new search is started
+	// if the changes aren't kept in the terrain anymore
+	bool is_repairable = is_initialized_ && target == target_;
+	if (terrain_ != NULL) {
+		environment::DirtyRegion region;
+		if (is_repairable && terrain_->getDirtyRegion(region, terrain_revision_))
+			changed_cells_.insert(region.cells.begin(), region.cells.end());
+		else
+			is_repairable = false;
+		terrain_revision_ = terrain_->getRevision();
+	}
+
+	if (!is_repairable) {
+		// Starting a new search from the target, i.e. the rhs value of the target is zero
+		search_space_.reset();
+		queue_.clear();
+		std::fill(rhs_.begin(), rhs_.end(), std::numeric_limits<Weight>::max());
+		changed_cells_.clear();
+		key_modifier_ = 0.;
+		source_ = source;
+		last_source_ = source;
+		target_ = target;
+
+		unsigned int target_idx = getIndex(target);
+		rhs_[target_idx] = 0.;
+		queue_.push(target_idx, computeKey(target_idx));
+		is_initialized_ = true;
+	} else {
+		// Updating the key modifier according to the movement of the source, which avoids
+		// to reorder the queue. Note that the heuristic could depend on the terrain costs,
+		// so the queued keys aren't lower bounds after a terrain change. In that case, the
+		// keys are recomputed from the current source without key modifier
+		source_ = source;
+		if (changed_cells_.empty())
+			key_modifier_ += adjacency_->computeAdmissibleHeuristic(last_source_, source);
+		else {
+			key_modifier_ = 0.;
+			queue_.rebuild(std::vector<unsigned int>(),
+						   [this](unsigned int index) { return computeKey(index); });
+		}
+		last_source_ = source;
+
+		// Repairing the vertexes affected by the terrain changes
+		repairChangedCells();
+	}
+
+	bool is_solved = computeShortestPath() && extractPath();
+	total_cost_ = search_space_.getCost(getIndex(source_));
+
+	return is_solved;
+}
+
+
+void DStarLite::updateTerrainCells(const std::unordered_set<Vertex>& changed_cells)
+{
+	changed_cells_.insert(changed_cells.begin(), changed_cells.end());
+}
+
+
+void DStarLite::setUpdateRadius(double radius)
+{
+	update_radius_ = radius;
+}
+
+
+void DStarLite::resetSearch()
+{
+	is_initialized_ = false;
+}
+
+
+unsigned int DStarLite::getIndex(Vertex vertex)
+{
+	unsigned int num_vertexes = search_space_.size();
+	unsigned int index = search_space_.getIndex(vertex);
+	if (index >= num_vertexes) {
+		rhs_.push_back(std::numeric_limits<Weight>::max());
+
+		// Registering the state in its terrain vertex, which is used for finding the
+		// states affected by a terrain change
+		if (terrain_ != NULL) {
+			Vertex terrain_vertex;
+			terrain_->getTerrainSpaceModel().stateVertexToEnvironmentVertex(terrain_vertex,
+																			vertex, XY_Y);
+			cell_states_[terrain_vertex].push_back(index);
+		}
+	}
+
+	return index;
+}
+
+
+DStarLite::PriorityKey DStarLite::computeKey(unsigned int index)
+{
+	Weight min_cost = std::min(search_space_.getCost(index), rhs_[index]);
+	if (min_cost == std::numeric_limits<Weight>::max())
+		return PriorityKey(min_cost, min_cost);
+
+	// Note that the heuristic target is the current vertex, so the heuristic field isn't
+	// used, otherwise it would be recomputed for every vertex
+	Weight heuristic = adjacency_->computeAdmissibleHeuristic(source_,
+															   search_space_.getVertex(index));
+	return PriorityKey(min_cost + heuristic + key_modifier_, min_cost);
+}
+
+
+void DStarLite::updateVertex(unsigned int index)
+{
+	// Computing the one-step lookahead cost from the successors
+	Vertex vertex = search_space_.getVertex(index);
+	if (vertex != target_) {
+		Weight rhs = std::numeric_limits<Weight>::max();
+		std::list<Edge> successors;
+		adjacency_->getSuccessors(successors, vertex);
+		for (std::list<Edge>::const_iterator edge_iter = successors.begin();
+				edge_iter != successors.end();
+				edge_iter++)
+		{
+			Weight g_cost = search_space_.getCost(getIndex(edge_iter->target));
+			if (g_cost < std::numeric_limits<Weight>::max() && edge_iter->weight + g_cost < rhs)
+				rhs = edge_iter->weight + g_cost;
+		}
+		rhs_[index] = rhs;
+	}
+
+	// Only the inconsistent vertexes are in the queue
+	if (search_space_.getCost(index) != rhs_[index])
+		queue_.push(index, computeKey(index));
+	else
+		queue_.remove(index);
+}
+
+
+void DStarLite::repairChangedCells()
+{
+	if (changed_cells_.empty() || terrain_ == NULL)
+		return;
+
+	// Getting the visited states within the update radius of the changed cells
+	const environment::SpaceDiscretization& space_model = terrain_->getTerrainSpaceModel();
+	int radius = ceil(update_radius_ / terrain_->getResolution(true));
+	std::unordered_set<unsigned int> affected_states;
+	for (std::unordered_set<Vertex>::const_iterator cell_it = changed_cells_.begin();
+			cell_it != changed_cells_.end(); ++cell_it) {
+		Key cell_key;
+		space_model.vertexToKey(cell_key, *cell_it, true);
+		for (int dx = -radius; dx <= radius; ++dx) {
+			for (int dy = -radius; dy <= radius; ++dy) {
+				int x = (int) cell_key.x + dx, y = (int) cell_key.y + dy;
+				if (x < 0 || y < 0 || x > std::numeric_limits<unsigned short int>::max() ||
+						y > std::numeric_limits<unsigned short int>::max())
+					continue;
+
+				Key key = cell_key;
+				key.x = x;
+				key.y = y;
+				Vertex terrain_vertex;
+				space_model.keyToVertex(terrain_vertex, key, true);
+
+				std::unordered_map<Vertex, std::vector<unsigned int> >::const_iterator states_it =
+						cell_states_.find(terrain_vertex);
+				if (states_it == cell_states_.end())
+					continue;
+
+				for (unsigned int i = 0; i < states_it->second.size(); ++i) {
+					if (search_space_.isVisited(states_it->second[i]))
+						affected_states.insert(states_it->second[i]);
+				}
+			}
+		}
+	}
+	changed_cells_.clear();
+
+	// The weights of the edges that arrive to the affected states could change, so the
+	// affected states and their predecessors are updated
+	for (std::unordered_set<unsigned int>::const_iterator state_it = affected_states.begin();
+			state_it != affected_states.end(); ++state_it) {
+		updateVertex(*state_it);
+
+		std::list<Edge> predecessors;
+		adjacency_->getPredecessors(predecessors, search_space_.getVertex(*state_it));
+		for (std::list<Edge>::const_iterator edge_iter = predecessors.begin();
+				edge_iter != predecessors.end();
+				edge_iter++)
+			updateVertex(getIndex(edge_iter->target));
+	}
+}
+
+
+bool DStarLite::computeShortestPath()
+{
+	unsigned int source_idx = getIndex(source_);
+	while (!queue_.empty() && (queue_.topKey() < computeKey(source_idx) ||
+			rhs_[source_idx] != search_space_.getCost(source_idx))) {
+		if (isExpired())
+			return false;
+
+		// Reinserting the vertexes with outdated keys
+		unsigned int current_idx = queue_.top();
+		PriorityKey old_key = queue_.topKey();
+		PriorityKey new_key = computeKey(current_idx);
+		if (old_key < new_key) {
+			queue_.push(current_idx, new_key);
+			continue;
+		}
+		queue_.pop();
+
+		Vertex current = search_space_.getVertex(current_idx);
+		Weight g_cost = search_space_.getCost(current_idx);
+		std::list<Edge> predecessors;
+		adjacency_->getPredecessors(predecessors, current);
+		if (g_cost > rhs_[current_idx]) {
+			// Over-consistent vertex, i.e. its cost decreased. The rhs of the predecessors
+			// could only decrease through the current vertex
+			g_cost = rhs_[current_idx];
+			search_space_.setCost(current_idx, g_cost);
+			for (std::list<Edge>::const_iterator edge_iter = predecessors.begin();
+					edge_iter != predecessors.end();
+					edge_iter++)
+			{
+				unsigned int pred_idx = getIndex(edge_iter->target);
+				if (edge_iter->target != target_ && edge_iter->weight + g_cost < rhs_[pred_idx]) {
+					rhs_[pred_idx] = edge_iter->weight + g_cost;
+					if (search_space_.getCost(pred_idx) != rhs_[pred_idx])
+						queue_.push(pred_idx, computeKey(pred_idx));
+					else
+						queue_.remove(pred_idx);
+				}
+			}
+		} else {
+			// Under-consistent vertex, i.e. its cost increased. The predecessors that
+			// depended on the current vertex are recomputed
+			search_space_.setCost(current_idx, std::numeric_limits<Weight>::max());
+			for (std::list<Edge>::const_iterator edge_iter = predecessors.begin();
+					edge_iter != predecessors.end();
+					edge_iter++)
+			{
+				unsigned int pred_idx = getIndex(edge_iter->target);
+				if (g_cost < std::numeric_limits<Weight>::max() &&
+						rhs_[pred_idx] == edge_iter->weight + g_cost)
+					updateVertex(pred_idx);
+			}
+			updateVertex(current_idx);
+		}
+		expansions_++;
+	}
+
+	return true;
+}
+
+
+bool DStarLite::isExpired() const
+{
+	double elapsed_time =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+
+	return elapsed_time >= allocated_time_;
+}
+
+
+bool DStarLite::extractPath()
+{
+	unsigned int source_idx = getIndex(source_);
+	unsigned int target_idx = getIndex(target_);
+	if (search_space_.getCost(source_idx) == std::numeric_limits<Weight>::max())
+		return false;
+
+	// Following the successor with minimum cost-to-go, and storing the path as parents.
+	// Note that the number of steps is bounded for avoiding infinite loops
+	unsigned int current_idx = source_idx;
+	unsigned int num_steps = 0;
+	while (current_idx != target_idx && num_steps < search_space_.size()) {
+		std::list<Edge> successors;
+		adjacency_->getSuccessors(successors, search_space_.getVertex(current_idx));
+
+		unsigned int next_idx = SearchSpace::NO_INDEX;
+		Weight min_cost = std::numeric_limits<Weight>::max();
+		for (std::list<Edge>::const_iterator edge_iter = successors.begin();
+				edge_iter != successors.end();
+				edge_iter++)
+		{
+			unsigned int neighbor_idx = getIndex(edge_iter->target);
+			Weight g_cost = search_space_.getCost(neighbor_idx);
+			if (g_cost < std::numeric_limits<Weight>::max() && edge_iter->weight + g_cost < min_cost) {
+				min_cost = edge_iter->weight + g_cost;
+				next_idx = neighbor_idx;
+			}
+		}
+		if (next_idx == SearchSpace::NO_INDEX)
+			return false;
+
+		search_space_.setParent(next_idx, current_idx);
+		current_idx = next_idx;
+		++num_steps;
+	}
+
+	return current_idx == target_idx;
+}
+
+} //@namespace solver
+} //@namespace dwl
@@ -0,0 +1,156 @@
+#ifndef DWL__SOLVER__DSTAR_LITE__H
+#define DWL__SOLVER__DSTAR_LITE__H
+
+#include <dwl/solver/SearchTreeSolver.h>
+#include <chrono>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class DStarLite
+ * @brief Class for solving a shortest-search problem using the D* Lite algorithm. This class
+ * derives from the SearchTreeSolver class. The search is done backward from the target, and it's
+ * kept between calls, so the next searches only repair the vertexes affected by the changed
+ * terrain cells or by the movement of the source. It requires the predecessors of the
+ * adjacency model, so the lattice adjacency models, whose successors are directed, are
+ * rejected. The heuristic target is the expanded vertex, so it uses the admissible
+ * heuristic of the adjacency model instead of the heuristic field, and the repairs are exact.
+ * The computation time is a wall-clock deadline as in the anytime planner
+ */
+class DStarLite : public SearchTreeSolver
+{
+	public:
+		/** @brief Constructor function */
+		DStarLite();
+
+		/** @brief Destructor function */
+		~DStarLite();
+
+		/**
+		 * @brief Initializes the D* Lite algorithm
+		 * @return True if D* Lite algorithm was initialized
+		 */
+		bool init();
+
+		/**
+		 * @brief Computes a shortest-path using D* Lite algorithm. The previous search is
+		 * repaired if the target is the same, otherwise it starts a new search. The changed
+		 * terrain cells are got from the dirty region of the terrain since the last search
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if it was computed a solution
+		 */
+		bool compute(Vertex source,
+					 Vertex target,
+					 double computation_time);
+
+		/**
+		 * @brief Adds the changed terrain vertexes, which are repaired in the next search.
+		 * The changes of the terrain map are got in the search, so it's only needed for the
+		 * changes that aren't recorded in the terrain map
+		 * @param const std::unordered_set<Vertex>& Changed terrain vertexes
+		 */
+		void updateTerrainCells(const std::unordered_set<Vertex>& changed_cells);
+
+		/**
+		 * @brief Sets the radius around a changed terrain cell in which the edge weights
+		 * could change. It should cover the stance areas for stance (body cost) adjacencies
+		 * @param double Update radius (in meters)
+		 */
+		void setUpdateRadius(double radius);
+
+		/** @brief Starts a new search in the next computation */
+		void resetSearch();
+
+
+	private:
+		/** @brief Defines the lexicographic priority key of the vertexes */
+		typedef std::pair<Weight, Weight> PriorityKey;
+
+		/**
+		 * @brief Gets the dense index of a vertex, and registers the new ones
+		 * @param Vertex Vertex id
+		 * @return The dense index
+		 */
+		unsigned int getIndex(Vertex vertex);
+
+		/**
+		 * @brief Computes the priority key of a dense index
+		 * @param unsigned int Dense index
+		 * @return The priority key
+		 */
+		PriorityKey computeKey(unsigned int index);
+
+		/**
+		 * @brief Updates the rhs value of a dense index, and its position in the openset
+		 * @param unsigned int Dense index
+		 */
+		void updateVertex(unsigned int index);
+
+		/**
+		 * @brief Repairs the vertexes affected by the changed terrain cells
+		 */
+		void repairChangedCells();
+
+		/**
+		 * @brief Computes the shortest path until the source is consistent or the deadline
+		 * of the current computation is reached
+		 * @return True if the source is consistent
+		 */
+		bool computeShortestPath();
+
+		/** @brief Returns true if the deadline of the current computation was reached */
+		bool isExpired() const;
+
+		/**
+		 * @brief Extracts the path from the source to the target, and stores it as parents
+		 * @return True if it was extracted the path
+		 */
+		bool extractPath();
+
+		/** @brief Openset queue of dense indexes, ordered by lexicographic keys */
+		IndexedHeap<4, PriorityKey> queue_;
+
+		/** @brief One-step lookahead cost (rhs) of each dense index */
+		std::vector<Weight> rhs_;
+
+		/** @brief Dense indexes of the visited states in each terrain vertex */
+		std::unordered_map<Vertex, std::vector<unsigned int> > cell_states_;
+
+		/** @brief Terrain vertexes that changed since the last search */
+		std::unordered_set<Vertex> changed_cells_;
+
+		/** @brief Source and target of the current search */
+		Vertex source_;
+		Vertex target_;
+
+		/** @brief Source of the last computation, for updating the key modifier */
+		Vertex last_source_;
+
+		/** @brief Key modifier, i.e. accumulated heuristic of the source movements */
+		Weight key_modifier_;
+
+		/** @brief Radius around a changed terrain cell in which the weights could change */
+		double update_radius_;
+
+		/** @brief Starting time (monotonic clock) and allocated time of the current computation */
+		std::chrono::steady_clock::time_point started_;
+		double allocated_time_;
+
+		/** @brief Terrain revision of the last search */
+		unsigned long terrain_revision_;
+
+		/** @brief Indicates if there is a search that could be repaired */
+		bool is_initialized_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
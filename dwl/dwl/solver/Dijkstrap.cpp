@@ -7,7 +7,7 @@ namespace dwl
 namespace solver
 {
 
-Dijkstrap::Dijkstrap() : expansions_(0)
+Dijkstrap::Dijkstrap()
 {
 	name_ = "Dijkstrap";
 }
@@ -15,7 +15,7 @@ Dijkstrap::Dijkstrap() : expansions_(0)
 
 Dijkstrap::~Dijkstrap()
 {
-	policy_.clear();
+
 }
 
 
@@ -34,75 +34,144 @@ bool Dijkstrap::compute(Vertex source,
 		printf(RED_ "Could not computed the shortest path because it is required to defined an adjacency model\n"
 				COLOR_RESET);
 		return false;
-	} else if (adjacency_->isLatticeRepresentation()) {
-		printf(RED_ "Could not computed the shortest path because it is lattice representation\n" COLOR_RESET);
+	}
+
+	// Computing the shortest path
+	findShortestPath(std::vector<Vertex>(1, source), target, false, computation_time);
+
+	return total_cost_ < std::numeric_limits<Weight>::max();
+}
+
+
+bool Dijkstrap::computeCostField(Vertex target,
+								 double computation_time)
+{
+	return computeCostField(std::vector<Vertex>(1, target), computation_time);
+}
+
+
+bool Dijkstrap::computeCostField(const std::vector<Vertex>& targets,
+								 double computation_time)
+{
+	if (!is_set_adjacency_model_) {
+		printf(RED_ "Could not computed the cost field because it is required to defined an adjacency model\n"
+				COLOR_RESET);
 		return false;
 	}
 
-	// Computing adjacency map
-	AdjacencyMap adjacency_map;
-	adjacency_->computeAdjacencyMap(adjacency_map, source, target);
+	if (targets.empty())
+		return false;
 
-	// Computing the shortest path
-	findShortestPath(source, target, adjacency_map);
+	// Expanding backwards the whole graph that reaches the targets
+	return findShortestPath(targets, targets.front(), true, computation_time);
+}
+
+
+bool Dijkstrap::getCost(Weight& cost,
+						Vertex vertex) const
+{
+	unsigned int index;
+	if (!search_space_.find(index, vertex) ||
+			search_space_.getCost(index) == std::numeric_limits<Weight>::max())
+		return false;
 
+	cost = search_space_.getCost(index);
 	return true;
 }
 
 
-void Dijkstrap::findShortestPath(Vertex source,
-								 Vertex target,
-								 AdjacencyMap adjacency_map)
+void Dijkstrap::getCostField(CostMap& cost_field) const
 {
-	// Defining the minimum cost
-	CostMap min_cost;
-
-	for (AdjacencyMap::iterator vertex_iter = adjacency_map.begin();
-		vertex_iter != adjacency_map.end();
-		vertex_iter++)
-	{
-		Vertex v = vertex_iter->first;
-		min_cost[v] = std::numeric_limits<double>::infinity();
+	cost_field.clear();
+	for (unsigned int i = 0; i < search_space_.size(); ++i) {
+		if (search_space_.isVisited(i) &&
+				search_space_.getCost(i) < std::numeric_limits<Weight>::max())
+			cost_field[search_space_.getVertex(i)] = search_space_.getCost(i);
 	}
+}
 
-	min_cost[source] = 0;
-	std::set< std::pair<Weight, Vertex>, pair_first_less<Weight, Vertex> > vertex_queue;
-	for (AdjacencyMap::iterator vertex_iter = adjacency_map.begin();
-		vertex_iter != adjacency_map.end();
-		vertex_iter++)
-	{
-		Vertex v = vertex_iter->first;
-		vertex_queue.insert(std::pair<Weight, Vertex>(min_cost[v], v));
+
+bool Dijkstrap::findShortestPath(const std::vector<Vertex>& sources,
+								 Vertex target,
+								 bool one_to_all,
+								 double computation_time)
+{
+	// Setting the initial time
+	time_started_ = clock();
+	double allocated_time_secs = computation_time * (double) CLOCKS_PER_SEC;
+
+	// Number of expansions
+	expansions_ = 0;
+
+	// Resetting the costs, parents and vertex queue of the previous search. Note that
+	// the unvisited vertexes have infinite cost, so only the reached vertexes are
+	// added to the queue
+	search_space_.reset();
+	openset_.clear();
+
+	for (unsigned int i = 0; i < sources.size(); ++i) {
+		unsigned int source_idx = search_space_.getIndex(sources[i]);
+		search_space_.setCost(source_idx, 0.);
+		openset_.push(source_idx, 0.);
 	}
+	unsigned int target_idx = search_space_.getIndex(target);
+
+	bool is_timeout = false;
+	while (!openset_.empty()) {
+		if ((clock() - time_started_) >= allocated_time_secs) {
+			is_timeout = true;
+			break;
+		}
 
-	while (!vertex_queue.empty()) {
-		Vertex current = vertex_queue.begin()->second;
-		vertex_queue.erase(vertex_queue.begin());
+		unsigned int current_idx = openset_.pop();
+		Vertex current = search_space_.getVertex(current_idx);
+		Weight current_cost = search_space_.getCost(current_idx);
 
-		// Checking if it is get the target
-		if (adjacency_->isReachedGoal(target, current)) {
-			policy_[target] = current;
-			min_cost[target] = min_cost[current];
+		// Checking if it is get the target, note that the whole graph is expanded in
+		// the one-to-all search
+		if (!one_to_all && adjacency_->isReachedGoal(target, current)) {
+			if (current_idx != target_idx) {
+				search_space_.setParent(target_idx, current_idx);
+				search_space_.setCost(target_idx, current_cost);
+			}
 			break;
 		}
 
-		// Visit each edge exiting u
-		for (std::list<Edge>::iterator edge_iter = adjacency_map[current].begin();
-			edge_iter != adjacency_map[current].end();
+		// Adding the current vertex to the closedset
+		search_space_.close(current_idx);
+
+		// Visit each edge exiting in the current vertex, or entering in it for the cost
+		// field. Note that the cost field is the cost-to-go of the predecessors, which
+		// differs from the cost-to-come for non-symmetric edge weights
+		std::list<Edge> edges;
+		if (one_to_all)
+			adjacency_->getPredecessors(edges, current);
+		else
+			adjacency_->getSuccessors(edges, current);
+		for (std::list<Edge>::const_iterator edge_iter = edges.begin();
+			edge_iter != edges.end();
 			edge_iter++)
 		{
 			Vertex neighbor = edge_iter->target;
 			Weight weight = edge_iter->weight;
-			Weight distance_through_current = min_cost[current] + weight;
-			if (distance_through_current < min_cost[neighbor]) {
-				vertex_queue.erase(std::pair<Weight, Vertex>(min_cost[neighbor], neighbor));
 
-				min_cost[neighbor] = distance_through_current;
-				policy_[neighbor] = current;
-				vertex_queue.insert(std::pair<Weight, Vertex>(min_cost[neighbor], neighbor));
+			unsigned int neighbor_idx = search_space_.getIndex(neighbor);
+			if (search_space_.isClosed(neighbor_idx))
+				continue;
+
+			Weight distance_through_current = current_cost + weight;
+			if (distance_through_current < search_space_.getCost(neighbor_idx)) {
+				search_space_.setCost(neighbor_idx, distance_through_current);
+				search_space_.setParent(neighbor_idx, current_idx);
+				openset_.push(neighbor_idx, distance_through_current);
 			}
 		}
+		expansions_++;
 	}
+
+	total_cost_ = one_to_all ? 0. : search_space_.getCost(target_idx);
+
+	return !is_timeout;
 }
 
 } //@namespace solver
@@ -31,29 +31,72 @@ class Dijkstrap : public SearchTreeSolver
 		bool init();
 
 		/**
-		 * @brief Computes a shortest-path using Dijkstrap algorithm
+		 * @brief Computes a shortest-path using Dijkstrap algorithm. The graph is expanded
+		 * lazily through the successors of the adjacency model, and the search finishes
+		 * when the target is reached
 		 * @param Vertex Source vertex
 		 * @param Vertex Target vertex
+		 * @param double Allowed time for computing a solution (in seconds)
 		 * @return True if it was computed a solution
 		 */
 		bool compute(Vertex source,
 					 Vertex target,
 					 double computation_time);
 
+		/**
+		 * @brief Computes the minimum cost from every vertex that reaches the target to it
+		 * (i.e. all-to-one search), which is the cost-to-go field of the target, so it could
+		 * be reused as heuristic. The graph is expanded backwards through the predecessors of
+		 * the adjacency model, so the costs are right for non-symmetric adjacency models
+		 * @param Vertex Target vertex
+		 * @param double Allowed time for computing the cost field (in seconds)
+		 * @return True if it was expanded the whole graph that reaches the target
+		 */
+		bool computeCostField(Vertex target,
+							  double computation_time = std::numeric_limits<double>::max());
+
+		/**
+		 * @brief Computes the minimum cost from every vertex that reaches a set of targets to
+		 * the closest one, i.e. the cost-to-go field of the set of targets
+		 * @param const std::vector<Vertex>& Target vertexes
+		 * @param double Allowed time for computing the cost field (in seconds)
+		 * @return True if it was expanded the whole graph that reaches the targets
+		 */
+		bool computeCostField(const std::vector<Vertex>& targets,
+							  double computation_time = std::numeric_limits<double>::max());
+
+		/**
+		 * @brief Gets the minimum cost of a vertex computed in the last search, i.e. from the
+		 * source of the shortest path or to the target of the cost field
+		 * @param Weight& Minimum cost
+		 * @param Vertex Vertex id
+		 * @return True if the vertex was reached in the last search
+		 */
+		bool getCost(Weight& cost,
+					 Vertex vertex) const;
+
+		/**
+		 * @brief Gets the minimum cost of every vertex reached in the last search
+		 * @param CostMap& Cost field
+		 */
+		void getCostField(CostMap& cost_field) const;
+
 
 	private:
 		/**
 		 * @brief Computes the minimum cost and previous vertex according to the shortest
 		 * Dijkstrap path
-		 * @param Vertex Source vertex
-		 * @param AdjacencyMap Adjacency map
+		 * @param const std::vector<Vertex>& Source vertexes
+		 * @param Vertex Target vertex
+		 * @param bool Indicates if it's expanded backwards the whole graph from the sources,
+		 * i.e. the cost field of the sources
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if the search finished before the allowed time
 		 */
-		void findShortestPath(Vertex source,
+		bool findShortestPath(const std::vector<Vertex>& sources,
 							  Vertex target,
-							  AdjacencyMap adjacency_map);
-
-		/** @brief number of expansions */
-		int expansions_;
+							  bool one_to_all,
+							  double computation_time);
 };
 
 } //@namespace solver
@@ -0,0 +1,129 @@
+#ifndef DWL__SOLVER__INDEXED_HEAP__H
+#define DWL__SOLVER__INDEXED_HEAP__H
+
+#include <dwl/utils/GraphSearching.h>
+#include <vector>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class IndexedHeap
+ * @brief Indexed d-ary min-heap of dense vertex indexes. The heap keeps the position of each
+ * index, so it supports decrease-key (and increase-key) without duplicated entries. The
+ * memory is kept between clear() calls. The key could be any type with a strict weak ordering
+ * (operator<), e.g. lexicographic keys
+ */
+template<unsigned int D = 4, typename Key = Weight>
+class IndexedHeap
+{
+	public:
+		/** @brief Constructor function */
+		IndexedHeap();
+
+		/** @brief Destructor function */
+		~IndexedHeap();
+
+		/** @brief Removes all the indexes of the heap, its cost is linear in the heap size */
+		void clear();
+
+		/** @brief Returns true if the heap is empty */
+		bool empty() const;
+
+		/** @brief Gets the number of indexes in the heap */
+		unsigned int size() const;
+
+		/**
+		 * @brief Returns true if the index is in the heap
+		 * @param unsigned int Dense vertex index
+		 */
+		bool contains(unsigned int index) const;
+
+		/**
+		 * @brief Inserts an index, or updates its key if it's already in the heap
+		 * @param unsigned int Dense vertex index
+		 * @param const Key& Key of the index
+		 */
+		void push(unsigned int index,
+				  const Key& key);
+
+		/** @brief Gets the index with the minimum key */
+		unsigned int top() const;
+
+		/** @brief Gets the minimum key */
+		const Key& topKey() const;
+
+		/**
+		 * @brief Removes the index with the minimum key
+		 * @return The removed index
+		 */
+		unsigned int pop();
+
+		/**
+		 * @brief Removes an index of the heap, if it's in the heap
+		 * @param unsigned int Dense vertex index
+		 */
+		void remove(unsigned int index);
+
+		/**
+		 * @brief Gets the key of an index that is in the heap
+		 * @param unsigned int Dense vertex index
+		 */
+		const Key& getKey(unsigned int index) const;
+
+		/**
+		 * @brief Adds the indexes that aren't in the heap, recomputes the key of every index,
+		 * and restores the heap property in linear time. It avoids the logarithmic cost per
+		 * index of popping and pushing the whole heap when all the keys change, e.g. after
+		 * changing the inflation of the heuristic
+		 * @param const std::vector<unsigned int>& Dense vertex indexes to add
+		 * @param KeyFunction Function object that returns the new key of a dense index
+		 */
+		template<typename KeyFunction>
+		void rebuild(const std::vector<unsigned int>& indexes,
+					 KeyFunction key_function);
+
+
+	private:
+		/** @brief Defines a heap node, i.e. a key and a dense vertex index */
+		struct Node
+		{
+			Node() : key(), index(0) {}
+			Node(const Key& key, unsigned int index) : key(key), index(index) {}
+
+			Key key;
+			unsigned int index;
+		};
+
+		/**
+		 * @brief Moves up a node until the heap property is restored
+		 * @param unsigned int Position of the node
+		 */
+		void siftUp(unsigned int pos);
+
+		/**
+		 * @brief Moves down a node until the heap property is restored
+		 * @param unsigned int Position of the node
+		 */
+		void siftDown(unsigned int pos);
+
+		/** @brief Nodes of the heap */
+		std::vector<Node> heap_;
+
+		/** @brief Position in the heap of each dense index, NOT_IN_HEAP if it's not */
+		std::vector<unsigned int> position_;
+
+		/** @brief Position of the indexes that aren't in the heap */
+		static const unsigned int NOT_IN_HEAP = (unsigned int) -1;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#include <dwl/solver/impl/IndexedHeap.hpp>
+
+#endif
@@ -320,6 +320,7 @@ bool IpoptNLP::compute(double allocated_time_secs)
 {
 	// Setting the initial time
 	clock_t started_time = clock();
+	model_->getProfiler().startSolve(name_);
 
 	// Ask Ipopt to solve the problem
 	Ipopt::ApplicationReturnStatus status;
@@ -343,6 +344,8 @@ bool IpoptNLP::compute(double allocated_time_secs)
 		current_duration_secs = ((double) current_time) / CLOCKS_PER_SEC;
 	}
 
+	model_->getProfiler().stopSolve();
+
 	if (solved) {
 		solution_ = ipopt_.getSolution();
 	} else
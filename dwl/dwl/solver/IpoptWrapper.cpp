@@ -86,6 +86,7 @@ bool IpoptWrapper::get_starting_point(Index n, bool init_x, Number* x,
 bool IpoptWrapper::eval_f(Index n, const Number* x, bool new_x, Number& obj_value)
 {
 	// Numerical evaluation of the cost function
+	utils::Profiler::ScopedTimer timer(opt_model_->getProfiler(), "cost");
 	opt_model_->evaluateCosts(obj_value, x, n);
 
 	return true;
@@ -95,6 +96,7 @@ bool IpoptWrapper::eval_f(Index n, const Number* x, bool new_x, Number& obj_valu
 bool IpoptWrapper::eval_grad_f(Index n, const Number* x, bool new_x, Number* grad_f)
 {
 	// Computing the gradient of the cost function
+	utils::Profiler::ScopedTimer timer(opt_model_->getProfiler(), "gradient");
 	opt_model_->evaluateCostGradient(grad_f, n, x, n);
 
 	return true;
@@ -104,6 +106,7 @@ bool IpoptWrapper::eval_grad_f(Index n, const Number* x, bool new_x, Number* gra
 bool IpoptWrapper::eval_g(Index n, const Number* x, bool new_x, Index m, Number* g)
 {
 	// Numerical evaluation of the constraint function
+	utils::Profiler::ScopedTimer timer(opt_model_->getProfiler(), "constraint");
 	opt_model_->evaluateConstraints(g, m, x, n);
 
 	return true;
@@ -133,6 +136,7 @@ bool IpoptWrapper::eval_jac_g(Index n, const Number* x, bool new_x,
 		}
 	} else {
 		// Computing the Jacobian and its sparsity structure
+		utils::Profiler::ScopedTimer timer(opt_model_->getProfiler(), "jacobian");
 		opt_model_->evaluateConstraintJacobian(values, nele_jac,
 											   row_entries, nele_jac,
 											   col_entries, nele_jac,
@@ -167,6 +171,7 @@ bool IpoptWrapper::eval_h(Index n, const Number* x, bool new_x, Number obj_facto
 		}
 	} else {
 		// Computing the Hessian and its sparsity structure
+		utils::Profiler::ScopedTimer timer(opt_model_->getProfiler(), "hessian");
 		opt_model_->evaluateLagrangianHessian(values, nele_hess,
 											  row_entries, nele_hess,
 											  col_entries, nele_hess,
@@ -178,6 +183,32 @@ bool IpoptWrapper::eval_h(Index n, const Number* x, bool new_x, Number obj_facto
 }
 
 
+bool IpoptWrapper::intermediate_callback(Ipopt::AlgorithmMode mode,
+										 Index iter, Number obj_value,
+										 Number inf_pr, Number inf_du,
+										 Number mu, Number d_norm,
+										 Number regularization_size,
+										 Number alpha_du, Number alpha_pr,
+										 Index ls_trials,
+										 const Ipopt::IpoptData* ip_data,
+										 Ipopt::IpoptCalculatedQuantities* ip_cq)
+{
+	// Recording the convergence information of the current iteration
+	utils::Profiler& profiler = opt_model_->getProfiler();
+	if (profiler.isEnabled()) {
+		utils::IterationData data;
+		data.iteration = iter;
+		data.cost = obj_value;
+		data.primal_infeasibility = inf_pr;
+		data.dual_infeasibility = inf_du;
+		data.elapsed_time = profiler.getElapsedTime();
+		profiler.addIteration(data);
+	}
+
+	return true;
+}
+
+
 void IpoptWrapper::finalize_solution(Ipopt::SolverReturn status,
 									 Index n, const Number* x, const Number* z_L, const Number* z_U,
 									 Index m, const Number* g, const Number* lambda,
@@ -158,6 +158,34 @@ class IpoptWrapper : public Ipopt::TNLP
 					Index m, const Number* lambda, bool new_lambda,
 					Index nele_hess, Index* row_entries, Index* col_entries, Number* values);
 
+		/**
+		 * @brief This method is called by IPOPT once per iteration. It's used for recording
+		 * the convergence information of the iteration
+		 * @param Ipopt::AlgorithmMode Regular or restoration phase mode
+		 * @param Index Current iteration count
+		 * @param Number Unscaled objective value at the current point
+		 * @param Number Unscaled primal infeasibility at the current point
+		 * @param Number Unscaled dual infeasibility at the current point
+		 * @param Number Barrier parameter value
+		 * @param Number Infinity norm of the primal step
+		 * @param Number Value of the regularization term for the Hessian of the Lagrangian
+		 * @param Number Stepsize for the dual variables
+		 * @param Number Stepsize for the primal variables
+		 * @param Index Number of backtracking line search steps
+		 * @param const Ipopt::IpoptData* Ipopt data
+		 * @param Ipopt::IpoptCalculatedQuatities* Ipopt calculated quantities
+		 * @return True for continuing the optimization
+		 */
+		bool intermediate_callback(Ipopt::AlgorithmMode mode,
+								   Index iter, Number obj_value,
+								   Number inf_pr, Number inf_du,
+								   Number mu, Number d_norm,
+								   Number regularization_size,
+								   Number alpha_du, Number alpha_pr,
+								   Index ls_trials,
+								   const Ipopt::IpoptData* ip_data,
+								   Ipopt::IpoptCalculatedQuantities* ip_cq);
+
 		/**
 		 * @brief This method is called by IPOPT after the algorithm has finished (successfully or
 		 * even with most errors), so the TNLP can store/write the solution
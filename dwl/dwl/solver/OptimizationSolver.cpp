@@ -82,5 +82,43 @@ std::string OptimizationSolver::getName()
 	return name_;
 }
 
+
+void OptimizationSolver::enableProfiling(bool enable)
+{
+	if (model_ == NULL) {
+		printf(YELLOW_ "Warning: you have to set the optimization model before enabling"
+				" the profiling\n" COLOR_RESET);
+		return;
+	}
+
+	model_->getProfiler().enable(enable);
+}
+
+
+const utils::ProfileReport& OptimizationSolver::getProfileReport()
+{
+	if (model_ == NULL) {
+		printf(YELLOW_ "Warning: you have to set the optimization model before getting"
+				" the profiling report\n" COLOR_RESET);
+
+		static const utils::ProfileReport empty_report;
+		return empty_report;
+	}
+
+	return model_->getProfiler().getReport();
+}
+
+
+bool OptimizationSolver::writeProfileReport(const std::string& filename)
+{
+	if (model_ == NULL) {
+		printf(YELLOW_ "Warning: you have to set the optimization model before writing"
+				" the profiling report\n" COLOR_RESET);
+		return false;
+	}
+
+	return model_->getProfiler().writeReport(filename);
+}
+
 } //@namespace solver
 } //@namespace dwl
@@ -69,6 +69,27 @@ class OptimizationSolver
 		 */
 		std::string getName();
 
+		/**
+		 * @brief Enables or disables the profiling of the evaluations and iterations
+		 * done by the solver
+		 * @param bool True for enabling the profiling
+		 */
+		void enableProfiling(bool enable = true);
+
+		/**
+		 * @brief Gets the profiling report of the last solve. The report is empty if the
+		 * optimization model wasn't set
+		 * @return const utils::ProfileReport& The profiling report
+		 */
+		const utils::ProfileReport& getProfileReport();
+
+		/**
+		 * @brief Writes the profiling report of the last solve in a yaml file
+		 * @param const std::string& Filename
+		 * @return False if the optimization model wasn't set or the file couldn't be written
+		 */
+		bool writeProfileReport(const std::string& filename);
+
 
 	protected:
 		/** @brief Name of the solver */
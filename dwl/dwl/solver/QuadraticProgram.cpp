@@ -36,5 +36,11 @@ unsigned int QuadraticProgram::getNumberOfConstraints() const
 	return constraints_;
 }
 
+
+utils::Profiler& QuadraticProgram::getProfiler()
+{
+	return profiler_;
+}
+
 } //@namespace solver
 } //@namespace dwl
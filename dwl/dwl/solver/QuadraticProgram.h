@@ -2,6 +2,7 @@
 #define DWL__SOLVER__QUADRATIC_PROGRAM__H
 
 #include <Eigen/Dense>
+#include <dwl/utils/Profiler.h>
 
 namespace dwl
 {
@@ -82,6 +83,12 @@ class QuadraticProgram
 		 */
 		unsigned int getNumberOfConstraints() const;
 
+		/**
+		 * @brief Gets the profiler that records the QP solves
+		 * @return utils::Profiler& The profiler
+		 */
+		utils::Profiler& getProfiler();
+
 
 	protected:
 		/** @brief Label that indicates if QP solver had been initialized */
@@ -95,6 +102,9 @@ class QuadraticProgram
 
 		/** @brief Solution of the QP problem */
 		Eigen::VectorXd solution_;
+
+		/** @brief Profiler of the QP solves */
+		utils::Profiler profiler_;
 };
 
 } //@namepace solver
@@ -0,0 +1,204 @@
+#include <dwl/solver/SearchSpace.h>
+#include <algorithm>
+#include <limits>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+const unsigned int SearchSpace::NO_INDEX;
+
+
+SearchSpace::SearchSpace() : current_generation_(1), closed_generation_(1), capacity_(1 << 20)
+{
+
+}
+
+
+SearchSpace::~SearchSpace()
+{
+
+}
+
+
+void SearchSpace::reset()
+{
+	// Releasing the dense indexes of the previous searches if they exceed the capacity. The
+	// memory of the arrays is kept, so the next search doesn't allocate it again
+	if (capacity_ != 0 && vertex_.size() > capacity_) {
+		index_.clear();
+		vertex_.clear();
+		cost_.clear();
+		parent_.clear();
+		generation_.clear();
+		closed_.clear();
+	}
+
+	// Starting a new generation, so all the vertexes are unvisited. The generation
+	// counters are restarted when they overflow
+	if (++current_generation_ == 0) {
+		std::fill(generation_.begin(), generation_.end(), 0);
+		current_generation_ = 1;
+	}
+
+	resetClosedSet();
+}
+
+
+void SearchSpace::resetClosedSet()
+{
+	if (++closed_generation_ == 0) {
+		std::fill(closed_.begin(), closed_.end(), 0);
+		closed_generation_ = 1;
+	}
+}
+
+
+void SearchSpace::clear()
+{
+	std::unordered_map<Vertex, unsigned int>().swap(index_);
+	std::vector<Vertex>().swap(vertex_);
+	std::vector<Weight>().swap(cost_);
+	std::vector<unsigned int>().swap(parent_);
+	std::vector<unsigned int>().swap(generation_);
+	std::vector<unsigned int>().swap(closed_);
+	current_generation_ = 1;
+	closed_generation_ = 1;
+}
+
+
+void SearchSpace::setCapacity(unsigned int capacity)
+{
+	capacity_ = capacity;
+}
+
+
+void SearchSpace::reserve(unsigned int num_vertexes)
+{
+	index_.reserve(num_vertexes);
+	vertex_.reserve(num_vertexes);
+	cost_.reserve(num_vertexes);
+	parent_.reserve(num_vertexes);
+	generation_.reserve(num_vertexes);
+	closed_.reserve(num_vertexes);
+}
+
+
+unsigned int SearchSpace::getIndex(Vertex vertex)
+{
+	std::pair<std::unordered_map<Vertex, unsigned int>::iterator, bool> it =
+			index_.insert(std::make_pair(vertex, (unsigned int) vertex_.size()));
+	unsigned int index = it.first->second;
+	if (it.second) {
+		// Adding a new dense index
+		vertex_.push_back(vertex);
+		cost_.push_back(std::numeric_limits<Weight>::max());
+		parent_.push_back(NO_INDEX);
+		generation_.push_back(current_generation_);
+		closed_.push_back(0);
+	} else if (generation_[index] != current_generation_) {
+		// Visiting the vertex for the first time in this search
+		cost_[index] = std::numeric_limits<Weight>::max();
+		parent_[index] = NO_INDEX;
+		generation_[index] = current_generation_;
+	}
+
+	return index;
+}
+
+
+bool SearchSpace::find(unsigned int& index,
+					   Vertex vertex) const
+{
+	std::unordered_map<Vertex, unsigned int>::const_iterator it = index_.find(vertex);
+	if (it == index_.end() || generation_[it->second] != current_generation_)
+		return false;
+
+	index = it->second;
+	return true;
+}
+
+
+bool SearchSpace::isVisited(unsigned int index) const
+{
+	return generation_[index] == current_generation_;
+}
+
+
+Vertex SearchSpace::getVertex(unsigned int index) const
+{
+	return vertex_[index];
+}
+
+
+Weight SearchSpace::getCost(unsigned int index) const
+{
+	return cost_[index];
+}
+
+
+void SearchSpace::setCost(unsigned int index, Weight cost)
+{
+	cost_[index] = cost;
+}
+
+
+unsigned int SearchSpace::getParent(unsigned int index) const
+{
+	return parent_[index];
+}
+
+
+void SearchSpace::setParent(unsigned int index, unsigned int parent)
+{
+	parent_[index] = parent;
+}
+
+
+bool SearchSpace::isClosed(unsigned int index) const
+{
+	return closed_[index] == closed_generation_;
+}
+
+
+void SearchSpace::close(unsigned int index)
+{
+	closed_[index] = closed_generation_;
+}
+
+
+void SearchSpace::getPath(std::list<Vertex>& path,
+						  Vertex source,
+						  Vertex target) const
+{
+	path.clear();
+	path.push_front(target);
+
+	unsigned int index;
+	if (!find(index, target))
+		return;
+
+	// Following the parents, note that the number of steps is bounded for avoiding
+	// infinite loops
+	unsigned int num_steps = 0;
+	while (parent_[index] != NO_INDEX && num_steps < vertex_.size()) {
+		index = parent_[index];
+		path.push_front(vertex_[index]);
+		if (vertex_[index] == source)
+			break;
+
+		++num_steps;
+	}
+}
+
+
+unsigned int SearchSpace::size() const
+{
+	return vertex_.size();
+}
+
+} //@namespace solver
+} //@namespace dwl
@@ -0,0 +1,144 @@
+#ifndef DWL__SOLVER__SEARCH_SPACE__H
+#define DWL__SOLVER__SEARCH_SPACE__H
+
+#include <dwl/utils/GraphSearching.h>
+#include <unordered_map>
+#include <vector>
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+/**
+ * @class SearchSpace
+ * @brief Dense storage of the graph-search information, i.e. costs, parents and closed set.
+ * The vertexes of the SpaceDiscretization are mapped to a dense index space the first time that
+ * they are touched, and the costs and parents are stored in flat arrays. The information is
+ * reset in constant time by using generation counters, so the memory is reused across searches.
+ * The dense indexes are released when a search starts if they exceed a capacity, so the vertexes
+ * touched by the previous searches don't accumulate
+ */
+class SearchSpace
+{
+	public:
+		/** @brief Index of the undefined vertexes (e.g. the parent of the source) */
+		static const unsigned int NO_INDEX = (unsigned int) -1;
+
+		/** @brief Constructor function */
+		SearchSpace();
+
+		/** @brief Destructor function */
+		~SearchSpace();
+
+		/**
+		 * @brief Starts a new search, i.e. all the vertexes are unvisited. It doesn't release
+		 * the memory, and the dense indexes are kept unless they exceed the capacity
+		 */
+		void reset();
+
+		/** @brief Resets the closed set, but it keeps the costs and parents */
+		void resetClosedSet();
+
+		/** @brief Releases the memory and the dense indexes */
+		void clear();
+
+		/**
+		 * @brief Sets the maximum number of dense indexes kept between searches. Zero keeps
+		 * all the dense indexes
+		 * @param unsigned int Maximum number of dense indexes
+		 */
+		void setCapacity(unsigned int capacity);
+
+		/**
+		 * @brief Reserves memory for a certain number of vertexes
+		 * @param unsigned int Number of vertexes
+		 */
+		void reserve(unsigned int num_vertexes);
+
+		/**
+		 * @brief Gets the dense index of a vertex. The vertex is added as unvisited, i.e. with
+		 * infinite cost and without parent, if it wasn't visited in the current search
+		 * @param Vertex Vertex id
+		 * @return The dense index
+		 */
+		unsigned int getIndex(Vertex vertex);
+
+		/**
+		 * @brief Finds the dense index of a vertex visited in the current search
+		 * @param unsigned int& Dense index
+		 * @param Vertex Vertex id
+		 * @return True if the vertex was visited in the current search
+		 */
+		bool find(unsigned int& index,
+				  Vertex vertex) const;
+
+		/** @brief Returns true if the dense index was visited in the current search */
+		bool isVisited(unsigned int index) const;
+
+		/** @brief Gets the vertex id of a dense index */
+		Vertex getVertex(unsigned int index) const;
+
+		/** @brief Gets and sets the cost of a dense index */
+		Weight getCost(unsigned int index) const;
+		void setCost(unsigned int index, Weight cost);
+
+		/** @brief Gets and sets the parent of a dense index */
+		unsigned int getParent(unsigned int index) const;
+		void setParent(unsigned int index, unsigned int parent);
+
+		/** @brief Returns true if the dense index is in the closed set */
+		bool isClosed(unsigned int index) const;
+
+		/** @brief Adds the dense index to the closed set */
+		void close(unsigned int index);
+
+		/**
+		 * @brief Gets the path, following the parents, from the source to the target vertex
+		 * @param std::list<Vertex>& Path as a list of vertexes
+		 * @param Vertex Source vertex
+		 * @param Vertex Target vertex
+		 */
+		void getPath(std::list<Vertex>& path,
+					 Vertex source,
+					 Vertex target) const;
+
+		/** @brief Gets the number of dense indexes */
+		unsigned int size() const;
+
+
+	private:
+		/** @brief Map from vertex ids to dense indexes */
+		std::unordered_map<Vertex, unsigned int> index_;
+
+		/** @brief Vertex id of each dense index */
+		std::vector<Vertex> vertex_;
+
+		/** @brief Cost of each dense index */
+		std::vector<Weight> cost_;
+
+		/** @brief Parent of each dense index */
+		std::vector<unsigned int> parent_;
+
+		/** @brief Search generation in which each dense index was visited */
+		std::vector<unsigned int> generation_;
+
+		/** @brief Closed-set generation in which each dense index was closed */
+		std::vector<unsigned int> closed_;
+
+		/** @brief Current search generation */
+		unsigned int current_generation_;
+
+		/** @brief Current closed-set generation */
+		unsigned int closed_generation_;
+
+		/** @brief Maximum number of dense indexes kept between searches */
+		unsigned int capacity_;
+};
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
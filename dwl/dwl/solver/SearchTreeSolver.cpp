@@ -7,9 +7,10 @@ namespace dwl
 namespace solver
 {
 
-SearchTreeSolver::SearchTreeSolver() : adjacency_(NULL),
-		total_cost_(std::numeric_limits<double>::max()), time_started_(clock()),
-		is_set_model_(false), is_set_adjacency_model_(false)
+SearchTreeSolver::SearchTreeSolver() : adjacency_(NULL), terrain_(NULL),
+		total_cost_(std::numeric_limits<double>::max()), reached_target_(0), expansions_(0),
+		time_started_(clock()),
+		is_set_model_(false), is_set_adjacency_model_(false), is_owned_adjacency_model_(true)
 {
 
 }
@@ -17,7 +18,8 @@ SearchTreeSolver::SearchTreeSolver() : adjacency_(NULL),
 
 SearchTreeSolver::~SearchTreeSolver()
 {
-	delete adjacency_;
+	if (is_owned_adjacency_model_)
+		delete adjacency_;
 }
 
 
@@ -26,6 +28,7 @@ void SearchTreeSolver::reset(robot::Robot* robot,
 {
 	printf(BLUE_ "Setting the robot and environment information in the %s "
 			"solver\n" COLOR_RESET,	getName().c_str());
+	terrain_ = environment;
 
 	if (!is_set_adjacency_model_) {
 		printf(YELLOW_ "WARNING: Could not be set the robot and environment "
@@ -37,12 +40,35 @@ void SearchTreeSolver::reset(robot::Robot* robot,
 }
 
 
-void SearchTreeSolver::setAdjacencyModel(model::AdjacencyModel* adjacency_model)
+void SearchTreeSolver::setAdjacencyModel(model::AdjacencyModel* adjacency_model,
+										 bool is_owner)
 {
 	printf(BLUE_ "Setting the %s adjacency model in the %s solver\n" COLOR_RESET,
 			adjacency_model->getName().c_str(), getName().c_str());
 	adjacency_ = adjacency_model;
 	is_set_adjacency_model_ = true;
+	is_owned_adjacency_model_ = is_owner;
+}
+
+
+bool SearchTreeSolver::computeMultiGoal(Vertex source,
+										const std::vector<Vertex>& targets,
+										double computation_time)
+{
+	if (targets.size() != 1) {
+		printf(RED_ "Could not computed the shortest path because the %s solver doesn't support"
+				" a set of targets\n" COLOR_RESET, name_.c_str());
+		return false;
+	}
+
+	reached_target_ = targets.front();
+	return compute(source, targets.front(), computation_time);
+}
+
+
+void SearchTreeSolver::updateTerrainCells(const std::unordered_set<Vertex>& changed_cells)
+{
+
 }
 
 
@@ -50,26 +76,36 @@ std::list<Vertex> SearchTreeSolver::getShortestPath(Vertex source,
 													Vertex target)
 {
 	std::list<Vertex> path;
-	PreviousVertex::iterator prev;
-	Vertex vertex = target;
-	path.push_front(vertex);
-	while ((prev = policy_.find(vertex)) != policy_.end()) {
-		vertex = prev->second;
-		path.push_front(vertex);
-		if (vertex == source)
-			break;
-	}
+	search_space_.getPath(path, source, target);
 
 	return path;
 }
 
 
+Vertex SearchTreeSolver::getReachedTarget()
+{
+	return reached_target_;
+}
+
+
 double SearchTreeSolver::getMinimumCost()
 {
 	return total_cost_;
 }
 
 
+unsigned int SearchTreeSolver::getNumberOfExpansions()
+{
+	return expansions_;
+}
+
+
+model::AdjacencyModel* SearchTreeSolver::getAdjacencyModel()
+{
+	return is_set_adjacency_model_ ? adjacency_ : NULL;
+}
+
+
 std::string SearchTreeSolver::getName()
 {
 	return name_;
@@ -3,6 +3,8 @@
 
 #include <dwl/robot/Robot.h>
 #include <dwl/model/AdjacencyModel.h>
+#include <dwl/solver/SearchSpace.h>
+#include <dwl/solver/IndexedHeap.h>
 #include <dwl/utils/utils.h>
 
 
@@ -43,8 +45,16 @@ class SearchTreeSolver
 		/**
 		 * @brief Sets the adjacency model that is used for graph searching solvers
 		 * @param AdjacencyModel* Adjacency model
+		 * @param bool Indicates if the solver owns the adjacency model, i.e. it deletes it
 		 */
-		void setAdjacencyModel(model::AdjacencyModel* adjacency_model);
+		void setAdjacencyModel(model::AdjacencyModel* adjacency_model,
+							   bool is_owner = true);
+
+		/**
+		 * @brief Gets the adjacency model that is used for graph searching solvers
+		 * @return The adjacency model, or NULL if it wasn't set
+		 */
+		model::AdjacencyModel* getAdjacencyModel();
 
 		/**
 		 * @brief Abstract method for computing a shortest-path using graph search algorithms
@@ -57,12 +67,40 @@ class SearchTreeSolver
 		virtual bool compute(Vertex source, Vertex target,
 							 double computation_time = std::numeric_limits<double>::max()) = 0;
 
+		/**
+		 * @brief Computes a shortest-path from a source to the first reached vertex of a set
+		 * of targets, e.g. the poses of a goal region. The solvers that don't support it only
+		 * accept a single target
+		 * @param Vertex Source vertex
+		 * @param const std::vector<Vertex>& Target vertexes
+		 * @param double Allowed time for computing a solution (in seconds)
+		 * @return True if it was computed a solution
+		 */
+		virtual bool computeMultiGoal(Vertex source,
+									  const std::vector<Vertex>& targets,
+									  double computation_time = std::numeric_limits<double>::max());
+
+		/**
+		 * @brief Notifies the terrain vertexes whose information changed since the last
+		 * search. The incremental solvers use them for repairing their previous search, and
+		 * the rest of solvers ignore them because they search from scratch
+		 * @param const std::unordered_set<Vertex>& Changed terrain vertexes
+		 */
+		virtual void updateTerrainCells(const std::unordered_set<Vertex>& changed_cells);
+
 		/**
 		 * @brief Gets the shortest-path only for graph searching algorithms
 		 * @param Vertex target Target vertex
 		 * @return The path as a list of vertex
 		 */
-		std::list<Vertex> getShortestPath(Vertex source, Vertex target);
+		virtual std::list<Vertex> getShortestPath(Vertex source, Vertex target);
+
+		/**
+		 * @brief Gets the target reached in the last search, i.e. the end of the shortest-path
+		 * in multi-goal searches
+		 * @return The reached target vertex
+		 */
+		Vertex getReachedTarget();
 
 		/**
 		 * @brief Gets the minimum cost (total cost) for the computed solution
@@ -70,6 +108,12 @@ class SearchTreeSolver
 		 */
 		double getMinimumCost();
 
+		/**
+		 * @brief Gets the number of expanded vertexes of the last search
+		 * @return The number of expansions
+		 */
+		unsigned int getNumberOfExpansions();
+
 		/**
 		 * @brief Gets the name of the solver
 		 * @return The name of the solver
@@ -84,12 +128,24 @@ class SearchTreeSolver
 		/** @brief Adjacency model of the tree */
 		model::AdjacencyModel* adjacency_;
 
-		/** @brief Shortest previous vertex */
-		PreviousVertex policy_;
+		/** @brief Pointer to the TerrainMap object */
+		environment::TerrainMap* terrain_;
+
+		/** @brief Dense costs, parents (shortest previous vertex) and closed set */
+		SearchSpace search_space_;
+
+		/** @brief Ordered openset queue of dense indexes */
+		IndexedHeap<> openset_;
 
 		/** @brief Total cost of the path */
 		double total_cost_;
 
+		/** @brief Target reached in the last search */
+		Vertex reached_target_;
+
+		/** @brief Number of expansions of the last search */
+		unsigned int expansions_;
+
 		/** @brief Initial time of computation */
 		clock_t time_started_;
 
@@ -98,6 +154,9 @@ class SearchTreeSolver
 
 		/** @brief Indicates if it was set an adjacency model */
 		bool is_set_adjacency_model_;
+
+		/** @brief Indicates if the solver owns the adjacency model */
+		bool is_owned_adjacency_model_;
 };
 
 } //@namespace solver
@@ -111,12 +111,25 @@ class cmaesSOFamily : public OptimizationSolver
 		dVec gradientFitnessFunction(const double *x,
 									 const int& n);
 
+		/**
+		 * @brief Wraps the progress function, which records the convergence information
+		 * of each iteration
+		 * @param const CMAParameters& CMA-ES parameters
+		 * @param const libcmaes::CMASolutions& Current CMA-ES solutions
+		 */
+		int progressFunction(const libcmaes::CMAParameters<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,TScaling> >& cmaparams,
+							 const libcmaes::CMASolutions& cmasols);
+
 		/** @brief Fitness function wrapper */
 		libcmaes::FitFunc fitness_;
 
 		/** @brief Gradient of the fitness function */
 		libcmaes::GradFunc grad_fitness_;
 
+		/** @brief Progress function wrapper */
+		libcmaes::ProgressFunc<libcmaes::CMAParameters<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,TScaling> >,
+							   libcmaes::CMASolutions> progress_;
+
 		/** @brief Pointer to the CMA-ES configuration parameters */
 		libcmaes::CMAParameters<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,TScaling> >* cmaes_params_;
 
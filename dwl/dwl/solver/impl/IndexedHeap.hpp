@@ -0,0 +1,217 @@
+#ifndef DWL__SOLVER__INDEXED_HEAP__IMPL_H
+#define DWL__SOLVER__INDEXED_HEAP__IMPL_H
+
+
+namespace dwl
+{
+
+namespace solver
+{
+
+template<unsigned int D, typename Key>
+const unsigned int IndexedHeap<D,Key>::NOT_IN_HEAP;
+
+
+template<unsigned int D, typename Key>
+IndexedHeap<D,Key>::IndexedHeap()
+{
+
+}
+
+
+template<unsigned int D, typename Key>
+IndexedHeap<D,Key>::~IndexedHeap()
+{
+
+}
+
+
+template<unsigned int D, typename Key>
+void IndexedHeap<D,Key>::clear()
+{
+	for (unsigned int i = 0; i < heap_.size(); ++i)
+		position_[heap_[i].index] = NOT_IN_HEAP;
+	heap_.clear();
+}
+
+
+template<unsigned int D, typename Key>
+bool IndexedHeap<D,Key>::empty() const
+{
+	return heap_.empty();
+}
+
+
+template<unsigned int D, typename Key>
+unsigned int IndexedHeap<D,Key>::size() const
+{
+	return heap_.size();
+}
+
+
+template<unsigned int D, typename Key>
+bool IndexedHeap<D,Key>::contains(unsigned int index) const
+{
+	return index < position_.size() && position_[index] != NOT_IN_HEAP;
+}
+
+
+template<unsigned int D, typename Key>
+void IndexedHeap<D,Key>::push(unsigned int index,
+							  const Key& key)
+{
+	if (index >= position_.size())
+		position_.resize(index + 1, NOT_IN_HEAP);
+
+	unsigned int pos = position_[index];
+	if (pos == NOT_IN_HEAP) {
+		// Inserting a new node
+		pos = heap_.size();
+		heap_.push_back(Node(key, index));
+		position_[index] = pos;
+		siftUp(pos);
+	} else {
+		// Updating the key of the node
+		Key old_key = heap_[pos].key;
+		heap_[pos].key = key;
+		if (key < old_key)
+			siftUp(pos);
+		else
+			siftDown(pos);
+	}
+}
+
+
+template<unsigned int D, typename Key>
+unsigned int IndexedHeap<D,Key>::top() const
+{
+	return heap_.front().index;
+}
+
+
+template<unsigned int D, typename Key>
+const Key& IndexedHeap<D,Key>::topKey() const
+{
+	return heap_.front().key;
+}
+
+
+template<unsigned int D, typename Key>
+unsigned int IndexedHeap<D,Key>::pop()
+{
+	unsigned int index = heap_.front().index;
+	remove(index);
+
+	return index;
+}
+
+
+template<unsigned int D, typename Key>
+void IndexedHeap<D,Key>::remove(unsigned int index)
+{
+	if (!contains(index))
+		return;
+
+	// Replacing the node by the last one
+	unsigned int pos = position_[index];
+	position_[index] = NOT_IN_HEAP;
+	Node last = heap_.back();
+	heap_.pop_back();
+	if (pos == heap_.size())
+		return;
+
+	Key old_key = heap_[pos].key;
+	heap_[pos] = last;
+	position_[last.index] = pos;
+	if (last.key < old_key)
+		siftUp(pos);
+	else
+		siftDown(pos);
+}
+
+
+template<unsigned int D, typename Key>
+const Key& IndexedHeap<D,Key>::getKey(unsigned int index) const
+{
+	return heap_[position_[index]].key;
+}
+
+
+template<unsigned int D, typename Key>
+template<typename KeyFunction>
+void IndexedHeap<D,Key>::rebuild(const std::vector<unsigned int>& indexes,
+								 KeyFunction key_function)
+{
+	// Adding the new indexes at the end of the heap
+	for (unsigned int i = 0; i < indexes.size(); ++i) {
+		unsigned int index = indexes[i];
+		if (index >= position_.size())
+			position_.resize(index + 1, NOT_IN_HEAP);
+
+		if (position_[index] == NOT_IN_HEAP) {
+			position_[index] = heap_.size();
+			heap_.push_back(Node(Key(), index));
+		}
+	}
+
+	// Updating the keys and heapifying from the last parent node
+	for (unsigned int pos = 0; pos < heap_.size(); ++pos)
+		heap_[pos].key = key_function(heap_[pos].index);
+	for (unsigned int pos = heap_.size() / D + 1; pos-- > 0;) {
+		if (pos < heap_.size())
+			siftDown(pos);
+	}
+}
+
+
+template<unsigned int D, typename Key>
+void IndexedHeap<D,Key>::siftUp(unsigned int pos)
+{
+	Node node = heap_[pos];
+	while (pos > 0) {
+		unsigned int parent = (pos - 1) / D;
+		if (!(node.key < heap_[parent].key))
+			break;
+
+		heap_[pos] = heap_[parent];
+		position_[heap_[pos].index] = pos;
+		pos = parent;
+	}
+	heap_[pos] = node;
+	position_[node.index] = pos;
+}
+
+
+template<unsigned int D, typename Key>
+void IndexedHeap<D,Key>::siftDown(unsigned int pos)
+{
+	unsigned int size = heap_.size();
+	Node node = heap_[pos];
+	while (true) {
+		// Finding the child with the minimum key
+		unsigned int first_child = D * pos + 1;
+		if (first_child >= size)
+			break;
+
+		unsigned int last_child = first_child + D < size ? first_child + D : size;
+		unsigned int min_child = first_child;
+		for (unsigned int child = first_child + 1; child < last_child; ++child) {
+			if (heap_[child].key < heap_[min_child].key)
+				min_child = child;
+		}
+
+		if (!(heap_[min_child].key < node.key))
+			break;
+
+		heap_[pos] = heap_[min_child];
+		position_[heap_[pos].index] = pos;
+		pos = min_child;
+	}
+	heap_[pos] = node;
+	position_[node.index] = pos;
+}
+
+} //@namespace solver
+} //@namespace dwl
+
+#endif
@@ -278,22 +278,18 @@ bool cmaesSOFamily<TScaling>::init()
 				" constraints.\n" COLOR_RESET);
 	}
 
-	// Getting the bounds of the optimization problem
-	// Eigen interfacing to raw buffers
-	double x_l[state_dim], x_u[state_dim];
-	double g_l[constraint_dim_], g_u[constraint_dim_];
-	Eigen::Map<Eigen::VectorXd> state_lower_bound(x_l, state_dim);
-	Eigen::Map<Eigen::VectorXd> state_upper_bound(x_u, state_dim);
-	Eigen::Map<Eigen::VectorXd> constraint_lower_bound(g_l, constraint_dim_);
-	Eigen::Map<Eigen::VectorXd> constraint_upper_bound(g_u, constraint_dim_);
+	// Getting the bounds of the optimization problem. Note that these buffers are
+	// heap-allocated since large horizons could overflow the stack
+	Eigen::VectorXd x_l(state_dim), x_u(state_dim);
+	Eigen::VectorXd g_l(constraint_dim_), g_u(constraint_dim_);
 
 	// Evaluating the bounds. Note that CMA-ES cannot handle hard constraints
-	model_->evaluateBounds(x_l, state_dim, x_u, state_dim,
-						   g_l, constraint_dim_, g_u, constraint_dim_);
+	model_->evaluateBounds(x_l.data(), state_dim, x_u.data(), state_dim,
+						   g_l.data(), constraint_dim_, g_u.data(), constraint_dim_);
 
 	// Defining the associated bound of the genotype and phenotype
 	libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,
-						TScaling> gp(x_l, x_u, state_dim);
+						TScaling> gp(x_l.data(), x_u.data(), state_dim);
 
 	cmaes_params_ =
 			new libcmaes::CMAParameters<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,
@@ -316,6 +312,10 @@ bool cmaesSOFamily<TScaling>::init()
 	fitness_ = std::bind(&cmaesSOFamily<TScaling>::fitnessFunction,
 						 this, std::placeholders::_1, std::placeholders::_2);
 
+	// Wrapping the progress function
+	progress_ = std::bind(&cmaesSOFamily<TScaling>::progressFunction,
+						  this, std::placeholders::_1, std::placeholders::_2);
+
 	// Wrapping the gradient of the fitness function
 	if (with_gradient_) {
 		grad_fitness_ = std::bind(&cmaesSOFamily<TScaling>::gradientFitnessFunction,
@@ -335,16 +335,16 @@ bool cmaesSOFamily<TScaling>::compute(double allocated_time_secs)
 	cmaes_params_->set_x0(warm_point_);
 
 	// Computing the solution
+	model_->getProfiler().startSolve(name_);
 	libcmaes::CMASolutions cmasols;
 	if (with_gradient_)
 		cmasols = libcmaes::cmaes<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,
 												TScaling>>(fitness_, *cmaes_params_,
-														libcmaes::CMAStrategy<libcmaes::CovarianceUpdate,
-																			  libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,TScaling>>::_defaultPFunc,
-														 grad_fitness_);
+														progress_, grad_fitness_);
 	else
-		cmasols = cmasols = libcmaes::cmaes<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,
-														TScaling>>(fitness_, *cmaes_params_);
+		cmasols = libcmaes::cmaes<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,
+												TScaling>>(fitness_, *cmaes_params_, progress_);
+	model_->getProfiler().stopSolve();
 
 	// Prints the solution in the terminal
 	if (print_) {
@@ -371,9 +371,13 @@ double cmaesSOFamily<TScaling>::fitnessFunction(const double* x,
 
 	// Numerical evaluation of the cost function
 	double obj_value = 0;
-	model_->evaluateCosts(obj_value, x, n);
+	{
+		utils::Profiler::ScopedTimer timer(model_->getProfiler(), "cost");
+		model_->evaluateCosts(obj_value, x, n);
+	}
 
 	if (constraint_dim_ > 0) {
+		utils::Profiler::ScopedTimer timer(model_->getProfiler(), "soft_constraint");
 		obj_value += model_->evaluateAsSoftConstraints(x, n);
 	}
 
@@ -388,11 +392,33 @@ dVec cmaesSOFamily<TScaling>::gradientFitnessFunction(const double *x,
 	dVec gradient(n);
 
 	// Evaluation of the gradient
+	utils::Profiler::ScopedTimer timer(model_->getProfiler(), "gradient");
 	model_->evaluateCostGradient(gradient.data(), n, x, n);
 
 	return gradient;
 }
 
+
+template<typename TScaling>
+int cmaesSOFamily<TScaling>::progressFunction(
+		const libcmaes::CMAParameters<libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,TScaling> >& cmaparams,
+		const libcmaes::CMASolutions& cmasols)
+{
+	// Recording the convergence information of the current iteration
+	utils::Profiler& profiler = model_->getProfiler();
+	if (profiler.isEnabled()) {
+		utils::IterationData data;
+		data.iteration = cmasols.niter();
+		data.cost = cmasols.best_candidate().get_fvalue();
+		data.elapsed_time = profiler.getElapsedTime();
+		profiler.addIteration(data);
+	}
+
+	// Keeping the default libcmaes behavior, i.e. the verbose output
+	return libcmaes::CMAStrategy<libcmaes::CovarianceUpdate,
+								 libcmaes::GenoPheno<libcmaes::pwqBoundStrategy,TScaling> >::_defaultPFunc(cmaparams, cmasols);
+}
+
 } //@namespace solver
 } //@namespace dwl
 
@@ -63,7 +63,10 @@ bool qpOASES::compute(const Eigen::MatrixXd& hessian,
 	// Ensuring the hessian matrix is row-major storage
 	Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> hessian_rowmajor = hessian;
 	
-	// Solving first QP
+	// Solving first QP. Note that qpOASES overwrites the number of working set
+	// recalculations with the performed ones
+	profiler_.startSolve("qpOASES");
+	int num_wsr = num_wsr_;
 	returnValue retval;
 	if (!initialized_solver_) {
 		retval = solver_->init(hessian_rowmajor.data(),
@@ -71,7 +74,7 @@ bool qpOASES::compute(const Eigen::MatrixXd& hessian,
 							   constraint_mat.data(),
 							   lower_bound.data(), upper_bound.data(),
 							   lower_constraint.data(), upper_constraint.data(),
-							   num_wsr_, &cputime);
+							   num_wsr, &cputime);
 		if (retval == SUCCESSFUL_RETURN) {
 			printf("qpOASES problem successfully initialized");
 			initialized_solver_ = true;
@@ -82,7 +85,17 @@ bool qpOASES::compute(const Eigen::MatrixXd& hessian,
 				   	   	   	   	   constraint_mat.data(),
 				   	   	   	   	   lower_bound.data(), upper_bound.data(),
 				   	   	   	   	   lower_constraint.data(), upper_constraint.data(),
-				   	   	   	   	   num_wsr_, &cputime);
+				   	   	   	   	   num_wsr, &cputime);
+	profiler_.stopSolve();
+
+	// Recording the performed working set recalculations as iterations
+	if (profiler_.isEnabled()) {
+		utils::IterationData data;
+		data.iteration = num_wsr;
+		data.cost = solver_->getObjVal();
+		data.elapsed_time = profiler_.getReport().solve_time;
+		profiler_.addIteration(data);
+	}
 
 	if (solver_->isInfeasible())
 		printf("Warning: the quadratic programming is infeasible");
@@ -6,6 +6,7 @@
 
 #include <Eigen/Dense>
 #include <dwl/utils/GraphSearching.h>
+#include <dwl/utils/EnvironmentRepresentation.h>
 #include <dwl/utils/RigidBodyDynamics.h>
 
 
@@ -113,11 +114,13 @@ struct ContactSearchRegion
  */
 struct RobotAndTerrain
 {
+	RobotAndTerrain() : height_map(NULL), resolution(0.) {}
+
 	Eigen::Vector3d body_action;
 	Pose3d pose;
 	Contact potential_contact;
 	std::vector<Contact> current_contacts;
-	std::map<Vertex, double> height_map;
+	const HeightMap* height_map; // read-only reference to the terrain height map
 	double resolution;
 };
 
@@ -3,6 +3,8 @@
 
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <Eigen/Dense>
 #include <dwl/utils/GraphSearching.h>
 
@@ -12,11 +14,13 @@ namespace dwl
 {
 
 /** @brief Defines if there is an obstacle in a certain vertex for
- *  graph-searching algorithms */
-typedef std::map<Vertex,bool> ObstacleMap;
+ *  graph-searching algorithms. It's a hash map for O(1) queries, so its iteration order is
+ *  unspecified, i.e. the callers that depend on the order have to sort or tie-break the
+ *  vertices by id */
+typedef std::unordered_map<Vertex,bool> ObstacleMap;
 
-/** @brief Defines the height map of the environment */
-typedef std::map<Vertex,double> HeightMap;
+/** @brief Defines the height map of the environment. It's a hash map, see ObstacleMap */
+typedef std::unordered_map<Vertex,double> HeightMap;
 
 /** @brief Struct that defines the id (key) of a certain cell */
 struct Key
@@ -47,22 +51,23 @@ struct Cell
 struct TerrainCell
 {
 	TerrainCell() : cost(0.), height(0.),
-			normal(Eigen::Vector3d::UnitZ()) {}
+			normal(Eigen::Vector3d::UnitZ()), curvature(0.) {}
 	TerrainCell(Key key_value,
 				 double cost_value,
 				 double plane,
 				 double height) : key(key_value), cost(cost_value),
-						 height(height) {}
+						 height(height), curvature(0.) {}
 	TerrainCell(Key key_value,
 				 double cost_value,
 				 Eigen::Vector3d _normal,
 				 double plane,
 				 double height) : key(key_value), cost(cost_value),
-						 height(height), normal(_normal) {}
+						 height(height), normal(_normal), curvature(0.) {}
 	Key key;
 	double cost;
 	double height;
 	Eigen::Vector3d normal;
+	double curvature; // surface variation of the fitted plane of the cell
 };
 
 /** @brief Terrain map */
@@ -72,7 +77,9 @@ struct TerrainData
 	double plane_size;
 	double height_size;
 };
-typedef std::map<Vertex, TerrainCell> TerrainDataMap;
+/** @brief Defines the terrain cells mapped using the vertex id, for O(1) queries. Note that
+ * the iteration order is unspecified (see ObstacleMap) */
+typedef std::unordered_map<Vertex, TerrainCell> TerrainDataMap;
 
 
 /**
@@ -85,11 +92,32 @@ struct Terrain
 	Eigen::Vector3d position;
 	Eigen::Vector3d surface_normal;
 	double curvature;
-	std::shared_ptr<std::map<Vertex, double> > height_map;
+	std::shared_ptr<HeightMap> height_map;
 	double min_height;
 	double resolution;
 };
 
+/**
+ * @struct TerrainGrid
+ * @brief Struct to define the terrain information of a rectangular region in contiguous row-major
+ * layers, i.e. the index of a cell is row * width + column. It allows to compute the terrain
+ * features of the whole region at once
+ */
+struct TerrainGrid
+{
+	TerrainGrid() : width(0), height(0), resolution(0.) {}
+	Key origin; // key of the first cell, i.e. the row and column zero
+	unsigned int width; // number of columns, i.e. cells along the x-axis
+	unsigned int height; // number of rows, i.e. cells along the y-axis
+	double resolution;
+	std::vector<double> heights;
+	std::vector<double> normal_x;
+	std::vector<double> normal_y;
+	std::vector<double> normal_z;
+	std::vector<double> curvatures;
+	std::vector<char> valid; // indicates if there is terrain information in the cell
+};
+
 } //@namespace dwl
 
 #endif
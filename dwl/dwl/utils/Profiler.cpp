@@ -0,0 +1,195 @@
+#include <dwl/utils/Profiler.h>
+#include <dwl/utils/Macros.h>
+#include <fstream>
+#include <cstdio>
+
+
+namespace dwl
+{
+
+namespace utils
+{
+
+Profiler::ScopedTimer::ScopedTimer(Profiler& profiler,
+								   const char* name) : profiler_(profiler),
+		name_(name), started_(profiler.tic())
+{
+
+}
+
+
+Profiler::ScopedTimer::~ScopedTimer()
+{
+	if (profiler_.isEnabled())
+		profiler_.addEvaluation(name_, profiler_.toc(started_));
+}
+
+
+Profiler::Profiler() : enabled_(false)
+{
+
+}
+
+
+Profiler::~Profiler()
+{
+
+}
+
+
+void Profiler::enable(bool enable)
+{
+	enabled_ = enable;
+}
+
+
+bool Profiler::isEnabled() const
+{
+	return enabled_;
+}
+
+
+void Profiler::reset()
+{
+	report_ = ProfileReport();
+}
+
+
+void Profiler::startSolve(const std::string& solver)
+{
+	if (!enabled_)
+		return;
+
+	reset();
+	report_.solver = solver;
+	solve_started_ = Clock::now();
+}
+
+
+void Profiler::stopSolve()
+{
+	if (!enabled_)
+		return;
+
+	report_.solve_time = getElapsedTime();
+}
+
+
+Profiler::Clock::time_point Profiler::tic() const
+{
+	if (!enabled_)
+		return Clock::time_point();
+
+	return Clock::now();
+}
+
+
+double Profiler::toc(const Clock::time_point& started) const
+{
+	return std::chrono::duration<double>(Clock::now() - started).count();
+}
+
+
+void Profiler::addEvaluation(const std::string& name,
+							 double duration)
+{
+	update(report_.evaluations[name], duration);
+}
+
+
+void Profiler::addTermEvaluation(const std::string& name,
+								 unsigned int knot,
+								 double duration)
+{
+	update(report_.terms[name], duration);
+
+	std::vector<EvaluationStatistics>& knots = report_.knots[name];
+	if (knots.size() <= knot)
+		knots.resize(knot + 1);
+	update(knots[knot], duration);
+}
+
+
+void Profiler::addIteration(const IterationData& data)
+{
+	report_.iterations.push_back(data);
+}
+
+
+double Profiler::getElapsedTime() const
+{
+	return toc(solve_started_);
+}
+
+
+const ProfileReport& Profiler::getReport() const
+{
+	return report_;
+}
+
+
+bool Profiler::writeReport(const std::string& filename) const
+{
+	std::ofstream file(filename.c_str());
+	if (!file.is_open()) {
+		printf(YELLOW_ "Warning: could not open the %s profiling report\n" COLOR_RESET,
+				filename.c_str());
+		return false;
+	}
+
+	// Writing the report in a yaml format
+	typedef ProfileReport::EvaluationMap::const_iterator EvaluationIterator;
+	typedef ProfileReport::KnotEvaluationMap::const_iterator KnotIterator;
+	file.precision(9);
+	file << "solver: \"" << report_.solver << "\"" << std::endl;
+	file << "solve_time: " << report_.solve_time << std::endl;
+
+	file << "evaluations:" << std::endl;
+	for (EvaluationIterator it = report_.evaluations.begin();
+			it != report_.evaluations.end(); ++it) {
+		file << "  " << it->first << ": {count: " << it->second.count
+			 << ", total_time: " << it->second.total_time
+			 << ", max_time: " << it->second.max_time << "}" << std::endl;
+	}
+
+	file << "terms:" << std::endl;
+	for (EvaluationIterator it = report_.terms.begin();
+			it != report_.terms.end(); ++it) {
+		file << "  \"" << it->first << "\": {count: " << it->second.count
+			 << ", total_time: " << it->second.total_time
+			 << ", max_time: " << it->second.max_time << "}" << std::endl;
+	}
+
+	file << "knots:" << std::endl;
+	for (KnotIterator it = report_.knots.begin();
+			it != report_.knots.end(); ++it) {
+		file << "  \"" << it->first << "\":" << std::endl;
+		for (unsigned int k = 0; k < it->second.size(); ++k) {
+			file << "    - {knot: " << k << ", count: " << it->second[k].count
+				 << ", total_time: " << it->second[k].total_time << "}" << std::endl;
+		}
+	}
+
+	file << "iterations:" << std::endl;
+	for (unsigned int i = 0; i < report_.iterations.size(); ++i) {
+		const IterationData& data = report_.iterations[i];
+		file << "  - {iteration: " << data.iteration << ", cost: " << data.cost
+			 << ", primal_infeasibility: " << data.primal_infeasibility
+			 << ", dual_infeasibility: " << data.dual_infeasibility
+			 << ", elapsed_time: " << data.elapsed_time << "}" << std::endl;
+	}
+
+	return true;
+}
+
+
+void Profiler::update(EvaluationStatistics& stats, double duration)
+{
+	stats.count++;
+	stats.total_time += duration;
+	if (duration > stats.max_time)
+		stats.max_time = duration;
+}
+
+} //@namespace utils
+} //@namespace dwl
@@ -0,0 +1,208 @@
+#ifndef DWL__UTILS__PROFILER__H
+#define DWL__UTILS__PROFILER__H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace dwl
+{
+
+namespace utils
+{
+
+/**
+ * @brief Defines the timing statistics of a certain evaluation, e.g. the cost
+ * function, or a named constraint at a certain knot
+ */
+struct EvaluationStatistics
+{
+	EvaluationStatistics() : count(0), total_time(0.), max_time(0.) {}
+
+	/** @brief Gets the mean time per evaluation in seconds */
+	double getMeanTime() const { return count > 0 ? total_time / count : 0.; }
+
+	unsigned int count;
+	double total_time;
+	double max_time;
+};
+
+/**
+ * @brief Defines the convergence information of a solver iteration. Note that
+ * the infeasibilities are only reported by those solvers that compute them
+ */
+struct IterationData
+{
+	IterationData() : iteration(0), cost(0.), primal_infeasibility(0.),
+			dual_infeasibility(0.), elapsed_time(0.) {}
+
+	int iteration;
+	double cost;
+	double primal_infeasibility;
+	double dual_infeasibility;
+	double elapsed_time;
+};
+
+/**
+ * @brief Defines the profiling report of a solve, i.e. the evaluations per
+ * type (cost, gradient, constraint, jacobian and hessian), per term name
+ * (cost or constraint), per term name and knot, and the convergence data
+ */
+struct ProfileReport
+{
+	typedef std::map<std::string, EvaluationStatistics> EvaluationMap;
+	typedef std::map<std::string, std::vector<EvaluationStatistics> > KnotEvaluationMap;
+
+	ProfileReport() : solve_time(0.) {}
+
+	std::string solver;
+	double solve_time;
+	EvaluationMap evaluations;
+	EvaluationMap terms;
+	KnotEvaluationMap knots;
+	std::vector<IterationData> iterations;
+};
+
+/**
+ * @class Profiler
+ * @brief Collects the number and the wall time of the evaluations done
+ * during a solve, and the per-iteration convergence data. The profiler is
+ * disabled by default, in which case the timers don't read the clock
+ */
+class Profiler
+{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		/**
+		 * @class ScopedTimer
+		 * @brief Times the evaluation of the current scope
+		 */
+		class ScopedTimer
+		{
+			public:
+				/**
+				 * @brief Starts the timer of an evaluation
+				 * @param Profiler& Profiler that records the evaluation
+				 * @param const char* Name of the evaluation
+				 */
+				ScopedTimer(Profiler& profiler, const char* name);
+
+				/** @brief Stops the timer and records the evaluation */
+				~ScopedTimer();
+
+
+			private:
+				Profiler& profiler_;
+				const char* name_;
+				Clock::time_point started_;
+		};
+
+		/** @brief Constructor function */
+		Profiler();
+
+		/** @brief Destructor function */
+		~Profiler();
+
+		/**
+		 * @brief Enables or disables the profiling
+		 * @param bool True for enabling it
+		 */
+		void enable(bool enable = true);
+
+		/** @brief Returns true if the profiling is enabled */
+		bool isEnabled() const;
+
+		/** @brief Resets the report */
+		void reset();
+
+		/**
+		 * @brief Starts the profiling of a solve, which resets the report
+		 * @param const std::string& Name of the solver
+		 */
+		void startSolve(const std::string& solver);
+
+		/** @brief Stops the profiling of a solve, i.e. it records the solve time */
+		void stopSolve();
+
+		/**
+		 * @brief Gets the current time if the profiling is enabled
+		 * @return The current time point
+		 */
+		Clock::time_point tic() const;
+
+		/**
+		 * @brief Gets the elapsed time since a certain time point
+		 * @param const Clock::time_point& Starting time point
+		 * @return The elapsed time in seconds
+		 */
+		double toc(const Clock::time_point& started) const;
+
+		/**
+		 * @brief Records an evaluation
+		 * @param const std::string& Type of evaluation (e.g. cost, constraint, etc)
+		 * @param double Evaluation time in seconds
+		 */
+		void addEvaluation(const std::string& name,
+						   double duration);
+
+		/**
+		 * @brief Records the evaluation of a term (cost or constraint) at a certain knot
+		 * @param const std::string& Name of the cost or constraint
+		 * @param unsigned int Knot index
+		 * @param double Evaluation time in seconds
+		 */
+		void addTermEvaluation(const std::string& name,
+							   unsigned int knot,
+							   double duration);
+
+		/**
+		 * @brief Records the convergence information of an iteration
+		 * @param const IterationData& Iteration data
+		 */
+		void addIteration(const IterationData& data);
+
+		/**
+		 * @brief Gets the elapsed time of the current solve
+		 * @return The elapsed time in seconds
+		 */
+		double getElapsedTime() const;
+
+		/**
+		 * @brief Gets the profiling report
+		 * @return const ProfileReport& The report
+		 */
+		const ProfileReport& getReport() const;
+
+		/**
+		 * @brief Writes the profiling report in a yaml file
+		 * @param const std::string& Filename
+		 * @return True if the file was written
+		 */
+		bool writeReport(const std::string& filename) const;
+
+
+	private:
+		/**
+		 * @brief Updates the statistics given a new evaluation time
+		 * @param EvaluationStatistics& Statistics to update
+		 * @param double Evaluation time in seconds
+		 */
+		void update(EvaluationStatistics& stats, double duration);
+
+		/** @brief Label that indicates if the profiling is enabled */
+		bool enabled_;
+
+		/** @brief Starting time of the current solve */
+		Clock::time_point solve_started_;
+
+		/** @brief Profiling report */
+		ProfileReport report_;
+};
+
+} //@namespace utils
+} //@namespace dwl
+
+#endif
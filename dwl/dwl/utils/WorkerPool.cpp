@@ -0,0 +1,120 @@
+#include <dwl/utils/WorkerPool.h>
+#include <algorithm>
+
+
+namespace dwl
+{
+
+namespace utils
+{
+
+WorkerPool::WorkerPool() : task_(NULL), num_tasks_(0), next_task_(0), active_workers_(0),
+		run_id_(0), is_stopped_(false)
+{
+
+}
+
+
+WorkerPool::~WorkerPool()
+{
+	stop();
+}
+
+
+void WorkerPool::setNumberOfThreads(unsigned int num_threads)
+{
+	if (num_threads == 0)
+		num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	if (num_threads == getNumberOfThreads())
+		return;
+
+	// Starting the workers, the calling thread is the first one
+	stop();
+	is_stopped_ = false;
+	run_id_ = 0;
+	for (unsigned int i = 1; i < num_threads; i++)
+		workers_.push_back(std::thread(&WorkerPool::work, this, i));
+}
+
+
+unsigned int WorkerPool::getNumberOfThreads() const
+{
+	return workers_.size() + 1;
+}
+
+
+void WorkerPool::run(unsigned int num_tasks,
+					 const Task& task)
+{
+	// Evaluating the tasks in order when there aren't workers
+	if (workers_.empty() || num_tasks < 2) {
+		for (unsigned int i = 0; i < num_tasks; i++)
+			task(i, 0);
+		return;
+	}
+
+	// Waking up the workers
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		task_ = &task;
+		num_tasks_ = num_tasks;
+		next_task_ = 0;
+		active_workers_ = workers_.size();
+		run_id_++;
+	}
+	start_condition_.notify_all();
+
+	// Evaluating tasks in the calling thread, and waiting the workers
+	evaluateTasks(0);
+	std::unique_lock<std::mutex> lock(mutex_);
+	done_condition_.wait(lock, [this] { return active_workers_ == 0; });
+	task_ = NULL;
+}
+
+
+void WorkerPool::work(unsigned int thread_id)
+{
+	unsigned long last_run_id = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			start_condition_.wait(lock, [&] { return is_stopped_ || run_id_ != last_run_id; });
+			if (is_stopped_)
+				return;
+
+			last_run_id = run_id_;
+		}
+
+		evaluateTasks(thread_id);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (--active_workers_ == 0)
+			done_condition_.notify_one();
+	}
+}
+
+
+void WorkerPool::evaluateTasks(unsigned int thread_id)
+{
+	unsigned int task_id;
+	while ((task_id = next_task_++) < num_tasks_)
+		(*task_)(task_id, thread_id);
+}
+
+
+void WorkerPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		is_stopped_ = true;
+	}
+	start_condition_.notify_all();
+
+	for (unsigned int i = 0; i < workers_.size(); i++)
+		workers_[i].join();
+	workers_.clear();
+}
+
+} //@namespace utils
+} //@namespace dwl
@@ -0,0 +1,103 @@
+#ifndef DWL__UTILS__WORKER_POOL__H
+#define DWL__UTILS__WORKER_POOL__H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace dwl
+{
+
+namespace utils
+{
+
+/**
+ * @class WorkerPool
+ * @brief Pool of persistent worker threads for evaluating independent tasks, e.g. the actions
+ * of an expansion. The calling thread also evaluates tasks, and it's blocked until all the tasks
+ * are done. With one thread (default) the tasks are evaluated in order by the calling thread, so
+ * the serial results don't depend on the pool
+ */
+class WorkerPool
+{
+	public:
+		/**
+		 * @brief Defines a task function, which receives the task index and the index of the
+		 * thread (zero for the calling thread), e.g. for using a per-thread workspace
+		 */
+		typedef std::function<void(unsigned int, unsigned int)> Task;
+
+		/** @brief Constructor function */
+		WorkerPool();
+
+		/** @brief Destructor function */
+		~WorkerPool();
+
+		/**
+		 * @brief Sets the number of threads that evaluate the tasks, including the calling
+		 * thread. Zero uses the number of hardware threads
+		 * @param unsigned int Number of threads
+		 */
+		void setNumberOfThreads(unsigned int num_threads);
+
+		/** @brief Gets the number of threads that evaluate the tasks */
+		unsigned int getNumberOfThreads() const;
+
+		/**
+		 * @brief Evaluates a number of tasks, and waits until all of them are done
+		 * @param unsigned int Number of tasks
+		 * @param const Task& Task function
+		 */
+		void run(unsigned int num_tasks,
+				 const Task& task);
+
+
+	private:
+		/**
+		 * @brief Loop of a worker thread
+		 * @param unsigned int Index of the thread
+		 */
+		void work(unsigned int thread_id);
+
+		/**
+		 * @brief Evaluates the pending tasks of the current run
+		 * @param unsigned int Index of the thread
+		 */
+		void evaluateTasks(unsigned int thread_id);
+
+		/** @brief Stops and joins the worker threads */
+		void stop();
+
+		/** @brief Worker threads */
+		std::vector<std::thread> workers_;
+
+		/** @brief Mutex and condition variables for starting and finishing a run */
+		std::mutex mutex_;
+		std::condition_variable start_condition_;
+		std::condition_variable done_condition_;
+
+		/** @brief Task function and number of tasks of the current run */
+		const Task* task_;
+		unsigned int num_tasks_;
+
+		/** @brief Next task index to evaluate */
+		std::atomic<unsigned int> next_task_;
+
+		/** @brief Number of workers that haven't finished the current run */
+		unsigned int active_workers_;
+
+		/** @brief Counter of runs, which wakes up the workers */
+		unsigned long run_id_;
+
+		/** @brief Indicates if the workers have to stop */
+		bool is_stopped_;
+};
+
+} //@namespace utils
+} //@namespace dwl
+
+#endif
@@ -0,0 +1,142 @@
+#include <dwl/solver/AnytimeRepairingAStar.h>
+#include <model/TerrainSearchModel.h>
+#include <thread>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+/**
+ * The terrain adjacency with its admissible heuristic, so the inflated searches give
+ * sub-optimal paths. The expansions could be delayed for simulating an expensive adjacency
+ */
+class AdmissibleAdjacency : public dwl::model::UniformCostAdjacency
+{
+	public:
+		AdmissibleAdjacency(double expansion_delay = 0.) : expansion_delay_(expansion_delay)
+		{
+
+		}
+
+		void getSuccessors(std::list<dwl::Edge>& successors,
+						   dwl::Vertex state_vertex)
+		{
+			if (expansion_delay_ > 0.)
+				std::this_thread::sleep_for(std::chrono::duration<double>(expansion_delay_));
+
+			UniformCostAdjacency::getSuccessors(successors, state_vertex);
+		}
+
+		double computeGeometricHeuristic(dwl::Vertex source,
+										 dwl::Vertex target)
+		{
+			return computeAdmissibleHeuristic(source, target);
+		}
+
+	private:
+		double expansion_delay_;
+};
+
+/**
+ * Gets the source and target vertexes of the opposite corners of the terrain
+ */
+void getCorners(dwl::Vertex& source,
+				dwl::Vertex& target,
+				const dwl::environment::TerrainMap& terrain)
+{
+	double margin = (num_cells - 1) * resolution;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., 0., 0.));
+	terrain.getTerrainSpaceModel().stateToVertex(target, Eigen::Vector3d(margin, margin, 0.));
+}
+
+
+BOOST_AUTO_TEST_CASE(anytime_paths) // specify a test case for the improved paths
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+	dwl::Vertex source, target;
+	getCorners(source, target, terrain);
+
+	double optimal_cost = std::numeric_limits<double>::max();
+	BOOST_REQUIRE(dwl::model::computeAStarCost(optimal_cost, terrain,
+											   new dwl::model::UniformCostAdjacency(),
+											   source, target));
+
+	// Note that the solver deletes the adjacency model
+	dwl::solver::AnytimeRepairingAStar solver(3.0, 0.5);
+	solver.setAdjacencyModel(new AdmissibleAdjacency());
+	solver.reset(NULL, &terrain);
+	solver.init();
+
+	std::vector<dwl::solver::AnytimePath> paths;
+	solver.setPathCallback([&](const dwl::solver::AnytimePath& path) {
+		paths.push_back(path);
+	});
+	BOOST_REQUIRE(solver.compute(source, target, std::numeric_limits<double>::max()));
+
+	// Each published path is inside its sub-optimality bound, and improves the cost or the
+	// bound of the previous path
+	BOOST_REQUIRE(!paths.empty());
+	for (unsigned int i = 0; i < paths.size(); ++i) {
+		BOOST_CHECK_EQUAL(paths[i].path.front(), source);
+		BOOST_CHECK_EQUAL(paths[i].path.back(), target);
+		BOOST_CHECK(paths[i].inflation >= 1.);
+		BOOST_CHECK(paths[i].cost <= paths[i].inflation * optimal_cost + epsilon);
+		if (i != 0) {
+			BOOST_CHECK(paths[i].cost <= paths[i - 1].cost);
+			BOOST_CHECK(paths[i].inflation <= paths[i - 1].inflation);
+			BOOST_CHECK(paths[i].time >= paths[i - 1].time);
+		}
+	}
+
+	// Without deadline, the final path is optimal
+	BOOST_CHECK_SMALL(solver.getMinimumCost() - optimal_cost, epsilon);
+	BOOST_CHECK_SMALL(paths.back().cost - optimal_cost, epsilon);
+
+	dwl::solver::AnytimePath best_path;
+	BOOST_CHECK(solver.getBestPath(best_path));
+	BOOST_CHECK_EQUAL(best_path.cost, paths.back().cost);
+	BOOST_CHECK(solver.getShortestPath(source, target) == paths.back().path);
+}
+
+
+BOOST_AUTO_TEST_CASE(deadline) // specify a test case for the computation deadline
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+	dwl::Vertex source, target;
+	getCorners(source, target, terrain);
+
+	// The expansions are delayed, so the deadline only allows the first (inflated) paths
+	dwl::solver::AnytimeRepairingAStar solver(3.0, 0.5);
+	solver.setAdjacencyModel(new AdmissibleAdjacency(0.001));
+	solver.reset(NULL, &terrain);
+	solver.init();
+
+	std::vector<dwl::solver::AnytimePath> paths;
+	solver.setPathCallback([&](const dwl::solver::AnytimePath& path) {
+		paths.push_back(path);
+	});
+
+	double deadline = 0.2;
+	std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+	bool is_path = solver.compute(source, target, deadline);
+	double elapsed_time =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+	// The solver stops at the deadline, i.e. it only finishes the expansion in progress, and
+	// keeps the sub-optimal paths published before it
+	BOOST_CHECK(elapsed_time >= deadline);
+	BOOST_CHECK(elapsed_time < deadline + 0.04);
+	BOOST_CHECK(is_path);
+	BOOST_REQUIRE(!paths.empty());
+	for (unsigned int i = 0; i < paths.size(); ++i)
+		BOOST_CHECK(paths[i].time < deadline);
+	BOOST_CHECK(paths.back().inflation > 1.);
+
+	dwl::solver::AnytimePath best_path;
+	BOOST_CHECK(solver.getBestPath(best_path));
+	BOOST_CHECK_EQUAL(best_path.cost, paths.back().cost);
+}
@@ -0,0 +1,116 @@
+#include <dwl/solver/BidirectionalAStar.h>
+#include <model/TerrainSearchModel.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+/**
+ * Computes the cost of a path from the successors of the adjacency model
+ */
+double computePathCost(dwl::environment::TerrainMap& terrain,
+					   const std::list<dwl::Vertex>& path)
+{
+	dwl::model::UniformCostAdjacency adjacency;
+	adjacency.reset(NULL, &terrain);
+
+	double cost = 0.;
+	std::list<dwl::Vertex>::const_iterator vertex_it = path.begin();
+	for (std::list<dwl::Vertex>::const_iterator next_it = ++path.begin();
+			next_it != path.end(); ++vertex_it, ++next_it) {
+		std::list<dwl::Edge> successors;
+		adjacency.getSuccessors(successors, *vertex_it);
+		double weight = std::numeric_limits<double>::max();
+		for (std::list<dwl::Edge>::const_iterator edge_it = successors.begin();
+				edge_it != successors.end(); ++edge_it) {
+			if (edge_it->target == *next_it)
+				weight = std::min(weight, edge_it->weight);
+		}
+		BOOST_CHECK(weight < std::numeric_limits<double>::max());
+		cost += weight;
+	}
+
+	return cost;
+}
+
+
+BOOST_AUTO_TEST_CASE(astar_costs) // specify a test case for the costs of the bidirectional search
+{
+	// Terrain with a wall of missing cells, so some searches go through its gap
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+
+	dwl::solver::BidirectionalAStar bidirectional_astar;
+	bidirectional_astar.setAdjacencyModel(new dwl::model::UniformCostAdjacency());
+	bidirectional_astar.reset(NULL, &terrain);
+	bidirectional_astar.init();
+
+	// Comparing the cost of several queries with a new A* search, i.e. the solver is reused
+	srand(0);
+	for (unsigned int i = 0; i < 20; ++i) {
+		dwl::Vertex source, target;
+		space_model.stateToVertex(source,
+				Eigen::Vector3d((rand() % num_cells) * resolution,
+								(rand() % num_cells) * resolution, 0.));
+		space_model.stateToVertex(target,
+				Eigen::Vector3d((rand() % num_cells) * resolution,
+								(rand() % num_cells) * resolution, 0.));
+		if (!terrain.isTerrainCell(source) || !terrain.isTerrainCell(target) || source == target)
+			continue;
+
+		double astar_cost = std::numeric_limits<double>::max();
+		BOOST_REQUIRE(dwl::model::computeAStarCost(astar_cost, terrain,
+												   new dwl::model::UniformCostAdjacency(),
+												   source, target));
+		BOOST_REQUIRE(bidirectional_astar.compute(source, target,
+												  std::numeric_limits<double>::max()));
+		BOOST_CHECK_SMALL(bidirectional_astar.getMinimumCost() - astar_cost, epsilon);
+
+		// The joined path goes from the source to the target, and it has the minimum cost
+		std::list<dwl::Vertex> path = bidirectional_astar.getShortestPath(source, target);
+		BOOST_REQUIRE(path.size() > 1);
+		BOOST_CHECK(path.front() == source);
+		BOOST_CHECK(path.back() == target);
+		BOOST_CHECK_SMALL(computePathCost(terrain, path) - astar_cost, epsilon);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(terrain_update) // specify a test case for a search on a changed terrain
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain);
+
+	dwl::solver::BidirectionalAStar bidirectional_astar;
+	bidirectional_astar.setAdjacencyModel(new dwl::model::UniformCostAdjacency());
+	bidirectional_astar.reset(NULL, &terrain);
+	bidirectional_astar.init();
+
+	dwl::Vertex source, target;
+	double margin = (num_cells - 1) * resolution;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., margin, 0.));
+	terrain.getTerrainSpaceModel().stateToVertex(target, Eigen::Vector3d(margin, 0., 0.));
+	BOOST_CHECK(bidirectional_astar.compute(source, target, std::numeric_limits<double>::max()));
+
+	// Increasing the cost of a wall with a gap, so the new path goes around it
+	dwl::TerrainData terrain_delta;
+	terrain_delta.plane_size = resolution;
+	terrain_delta.height_size = resolution;
+	for (unsigned int j = 3; j < num_cells; ++j)
+		terrain_delta.data.push_back(dwl::model::createCell(num_cells / 2, j, 50.));
+	terrain.updateTerrainMap(terrain_delta);
+
+	double astar_cost = std::numeric_limits<double>::max();
+	BOOST_REQUIRE(dwl::model::computeAStarCost(astar_cost, terrain,
+											   new dwl::model::UniformCostAdjacency(),
+											   source, target));
+	BOOST_REQUIRE(bidirectional_astar.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(bidirectional_astar.getMinimumCost() - astar_cost, epsilon);
+
+	std::list<dwl::Vertex> path = bidirectional_astar.getShortestPath(source, target);
+	BOOST_REQUIRE(path.size() > 1);
+	BOOST_CHECK_SMALL(computePathCost(terrain, path) - astar_cost, epsilon);
+}
@@ -0,0 +1,211 @@
+#include <dwl/solver/DStarLite.h>
+#include <dwl/model/LatticeBasedBodyAdjacency.h>
+#include <model/TerrainSearchModel.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+/**
+ * Updates the cost of a band of cells along the y-axis
+ */
+void updateBand(dwl::environment::TerrainMap& terrain,
+				unsigned int column,
+				unsigned int min_row,
+				unsigned int max_row,
+				double cost)
+{
+	dwl::TerrainData terrain_delta;
+	terrain_delta.plane_size = resolution;
+	terrain_delta.height_size = resolution;
+	for (unsigned int j = min_row; j <= max_row; ++j)
+		terrain_delta.data.push_back(dwl::model::createCell(column, j, cost));
+	terrain.updateTerrainMap(terrain_delta);
+}
+
+double computeAStarCost(dwl::environment::TerrainMap& terrain,
+						dwl::Vertex source,
+						dwl::Vertex target)
+{
+	double cost = std::numeric_limits<double>::max();
+	BOOST_CHECK(dwl::model::computeAStarCost(cost, terrain,
+											 new dwl::model::UniformCostAdjacency(),
+											 source, target));
+
+	return cost;
+}
+
+/**
+ * Computes the cost of a path from the successors of the adjacency model
+ */
+double computePathCost(dwl::environment::TerrainMap& terrain,
+					   const std::list<dwl::Vertex>& path)
+{
+	dwl::model::UniformCostAdjacency adjacency;
+	adjacency.reset(NULL, &terrain);
+
+	double cost = 0.;
+	std::list<dwl::Vertex>::const_iterator vertex_it = path.begin();
+	for (std::list<dwl::Vertex>::const_iterator next_it = ++path.begin();
+			next_it != path.end(); ++vertex_it, ++next_it) {
+		std::list<dwl::Edge> successors;
+		adjacency.getSuccessors(successors, *vertex_it);
+		double weight = std::numeric_limits<double>::max();
+		for (std::list<dwl::Edge>::const_iterator edge_it = successors.begin();
+				edge_it != successors.end(); ++edge_it) {
+			if (edge_it->target == *next_it)
+				weight = std::min(weight, edge_it->weight);
+		}
+		BOOST_CHECK(weight < std::numeric_limits<double>::max());
+		cost += weight;
+	}
+
+	return cost;
+}
+
+
+BOOST_AUTO_TEST_CASE(terrain_edits) // specify a test case for the repaired searches
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain);
+
+	dwl::solver::DStarLite dstar;
+	dstar.setAdjacencyModel(new dwl::model::UniformCostAdjacency());
+	dstar.reset(NULL, &terrain);
+	dstar.init();
+
+	dwl::Vertex source, target;
+	double margin = (num_cells - 1) * resolution;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., 0., 0.));
+	terrain.getTerrainSpaceModel().stateToVertex(target, Eigen::Vector3d(margin, margin, 0.));
+
+	// Initial search
+	BOOST_CHECK(dstar.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - computeAStarCost(terrain, source, target),
+					  epsilon);
+
+	// Increasing the cost of a wall with a gap, i.e. the under-consistent repair
+	// The solver gets the changed cells from the dirty region of the terrain
+	updateBand(terrain, num_cells / 2, 0, num_cells - 4, 50.);
+	BOOST_CHECK(dstar.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - computeAStarCost(terrain, source, target),
+					  epsilon);
+
+	// Decreasing the cost of a part of the wall, i.e. the over-consistent repair
+	updateBand(terrain, num_cells / 2, 2, 6, 0.5);
+	BOOST_CHECK(dstar.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - computeAStarCost(terrain, source, target),
+					  epsilon);
+
+	// Moving the source and changing the terrain at the same time
+	dwl::Vertex new_source;
+	terrain.getTerrainSpaceModel().stateToVertex(new_source,
+			Eigen::Vector3d(3 * resolution, 0., 0.));
+	updateBand(terrain, num_cells / 4, 0, num_cells - 1, 10.);
+	BOOST_CHECK(dstar.compute(new_source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - computeAStarCost(terrain, new_source, target),
+					  epsilon);
+
+	// Changing the terrain more times than the kept revisions, so it starts a new search
+	terrain.setDirtyHistorySize(1);
+	updateBand(terrain, num_cells / 2, 0, num_cells - 1, 50.);
+	updateBand(terrain, 3 * num_cells / 4, 1, num_cells - 1, 50.);
+	BOOST_CHECK(dstar.compute(new_source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - computeAStarCost(terrain, new_source, target),
+					  epsilon);
+}
+
+BOOST_AUTO_TEST_CASE(adjacency_heuristic) // specify a test case for the repair with the heuristic
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain);
+
+	// The geometric heuristic of the adjacency model depends on the average cost of the
+	// terrain, and it overestimates after increasing the costs, which would stop the repair
+	// before the source is updated. Therefore the solver uses the admissible heuristic
+	dwl::model::GridBasedBodyAdjacency* adjacency = new dwl::model::GridBasedBodyAdjacency();
+	adjacency->setStanceAdjacency(false);
+	dwl::solver::DStarLite dstar;
+	dstar.setAdjacencyModel(adjacency);
+	dstar.reset(NULL, &terrain);
+	dstar.init();
+
+	dwl::Vertex source, target;
+	double margin = (num_cells - 1) * resolution;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., 0., 0.));
+	terrain.getTerrainSpaceModel().stateToVertex(target, Eigen::Vector3d(margin, margin, 0.));
+	BOOST_CHECK(dstar.compute(source, target, std::numeric_limits<double>::max()));
+
+	// Increasing the cost of a wall with a gap, and moving the source
+	updateBand(terrain, num_cells / 2, 0, num_cells - 4, 50.);
+	terrain.getTerrainSpaceModel().stateToVertex(source,
+			Eigen::Vector3d(2 * resolution, 0., 0.));
+	BOOST_CHECK(dstar.compute(source, target, std::numeric_limits<double>::max()));
+
+	// The repaired path is a path of the updated terrain, and its cost is the optimal one and
+	// the same of a new search
+	std::list<dwl::Vertex> path = dstar.getShortestPath(source, target);
+	BOOST_CHECK(path.size() > 1);
+	BOOST_CHECK(path.front() == source);
+	BOOST_CHECK(path.back() == target);
+	BOOST_CHECK_SMALL(computePathCost(terrain, path) - dstar.getMinimumCost(), epsilon);
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - computeAStarCost(terrain, source, target), epsilon);
+
+	dwl::model::GridBasedBodyAdjacency* new_adjacency = new dwl::model::GridBasedBodyAdjacency();
+	new_adjacency->setStanceAdjacency(false);
+	dwl::solver::DStarLite new_dstar;
+	new_dstar.setAdjacencyModel(new_adjacency);
+	new_dstar.reset(NULL, &terrain);
+	new_dstar.init();
+	BOOST_CHECK(new_dstar.compute(source, target, std::numeric_limits<double>::max()));
+	BOOST_CHECK_SMALL(dstar.getMinimumCost() - new_dstar.getMinimumCost(), epsilon);
+}
+
+BOOST_AUTO_TEST_CASE(admissible_heuristic) // specify a test case for the lower bound of the cost
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain);
+
+	dwl::model::UniformCostAdjacency adjacency;
+	adjacency.reset(NULL, &terrain);
+
+	// The heuristic is informed, and a lower bound of the optimal cost, also after decreasing
+	// the minimum cost of the terrain
+	dwl::Vertex source;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., 0., 0.));
+	for (unsigned int k = 0; k < 2; ++k) {
+		for (unsigned int i = 1; i < num_cells; i += 3) {
+			for (unsigned int j = 0; j < num_cells; j += 4) {
+				dwl::Vertex target;
+				terrain.getTerrainSpaceModel().stateToVertex(target,
+						Eigen::Vector3d(i * resolution, j * resolution, 0.));
+				double heuristic = adjacency.computeAdmissibleHeuristic(source, target);
+				BOOST_CHECK(heuristic > 0.);
+				BOOST_CHECK(heuristic <= computeAStarCost(terrain, source, target) + epsilon);
+			}
+		}
+
+		updateBand(terrain, num_cells / 2, 0, num_cells - 1, 0.1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(directed_adjacency) // specify a test case for the directed successors
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain);
+
+	// The lattice successors are directed, so the default predecessors aren't valid and the
+	// search is rejected
+	dwl::solver::DStarLite dstar;
+	dstar.setAdjacencyModel(new dwl::model::LatticeBasedBodyAdjacency());
+	dstar.reset(NULL, &terrain);
+	dstar.init();
+
+	dwl::Vertex source, target;
+	double margin = (num_cells - 1) * resolution;
+	terrain.getTerrainSpaceModel().stateToVertex(source, Eigen::Vector3d(0., 0., 0.));
+	terrain.getTerrainSpaceModel().stateToVertex(target, Eigen::Vector3d(margin, margin, 0.));
+	BOOST_CHECK(!dstar.compute(source, target, std::numeric_limits<double>::max()));
+}
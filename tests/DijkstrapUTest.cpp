@@ -0,0 +1,57 @@
+#include <dwl/solver/Dijkstrap.h>
+#include <model/TerrainSearchModel.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+BOOST_AUTO_TEST_CASE(cost_field) // specify a test case for the cost-to-go field
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+
+	// Note that the solver deletes the adjacency model
+	dwl::solver::Dijkstrap field_solver;
+	field_solver.setAdjacencyModel(new dwl::model::UniformCostAdjacency());
+	field_solver.reset(NULL, &terrain);
+	field_solver.init();
+
+	dwl::solver::Dijkstrap path_solver;
+	path_solver.setAdjacencyModel(new dwl::model::UniformCostAdjacency());
+	path_solver.reset(NULL, &terrain);
+	path_solver.init();
+
+	dwl::Vertex target;
+	double margin = (num_cells - 1) * resolution;
+	space_model.stateToVertex(target, Eigen::Vector3d(margin, margin, 0.));
+	BOOST_CHECK(field_solver.computeCostField(target));
+
+	// The cost field is the cost-to-go of the target, which differs from its cost-to-come
+	// because the edges cost the arrival cell
+	unsigned int num_asymmetric = 0;
+	for (unsigned int i = 0; i < num_cells; i += 3) {
+		for (unsigned int j = 0; j < num_cells; j += 3) {
+			if (i == num_cells / 2 && j > 3)
+				continue;
+
+			dwl::Vertex source;
+			space_model.stateToVertex(source,
+					Eigen::Vector3d(i * resolution, j * resolution, 0.));
+			if (source == target)
+				continue;
+
+			dwl::Weight field_cost;
+			BOOST_CHECK(field_solver.getCost(field_cost, source));
+			BOOST_CHECK(path_solver.compute(source, target, std::numeric_limits<double>::max()));
+			BOOST_CHECK_SMALL(field_cost - path_solver.getMinimumCost(), epsilon);
+
+			BOOST_CHECK(path_solver.compute(target, source, std::numeric_limits<double>::max()));
+			if (fabs(field_cost - path_solver.getMinimumCost()) > epsilon)
+				num_asymmetric++;
+		}
+	}
+	BOOST_CHECK(num_asymmetric > 0);
+}
@@ -0,0 +1,208 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <model/TerrainSearchModel.h>
+#include <cstdlib>
+
+
+using namespace dwl;
+
+typedef std::map<Vertex,TerrainCell> TerrainSnapshot;
+
+
+/** Gets a copy of the terrain cells */
+TerrainSnapshot getSnapshot(const environment::TerrainMap& terrain)
+{
+	const TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	return TerrainSnapshot(terrain_map.begin(), terrain_map.end());
+}
+
+/** Gets the vertexes of the cells that are different in two snapshots */
+std::set<Vertex> getChangedCells(const TerrainSnapshot& old_snapshot,
+								 const TerrainSnapshot& new_snapshot)
+{
+	std::set<Vertex> cells;
+	for (TerrainSnapshot::const_iterator cell_it = old_snapshot.begin();
+			cell_it != old_snapshot.end(); ++cell_it) {
+		TerrainSnapshot::const_iterator new_it = new_snapshot.find(cell_it->first);
+		if (new_it == new_snapshot.end() || new_it->second.cost != cell_it->second.cost ||
+				new_it->second.key.z != cell_it->second.key.z)
+			cells.insert(cell_it->first);
+	}
+	for (TerrainSnapshot::const_iterator cell_it = new_snapshot.begin();
+			cell_it != new_snapshot.end(); ++cell_it) {
+		if (old_snapshot.find(cell_it->first) == old_snapshot.end())
+			cells.insert(cell_it->first);
+	}
+
+	return cells;
+}
+
+/** Gets a vertex of the terrain from the indexes of the cell */
+Vertex getVertex(const environment::TerrainMap& terrain,
+				 unsigned int i,
+				 unsigned int j)
+{
+	Vertex vertex;
+	terrain.getTerrainSpaceModel().keyToVertex(vertex, model::createCell(i, j, 0.).key, true);
+	return vertex;
+}
+
+
+BOOST_AUTO_TEST_CASE(dirty_region) // specify a test case for the changes since a revision
+{
+	environment::TerrainMap terrain;
+	model::buildTerrain(terrain);
+	const unsigned int history_size = 5;
+	terrain.setDirtyHistorySize(history_size);
+
+	// Changed cells of each revision, which are computed by comparing the snapshots. Note
+	// that setting the terrain map changes all the cells
+	std::map<unsigned long, std::set<Vertex> > changed_cells;
+	TerrainSnapshot snapshot = getSnapshot(terrain);
+	changed_cells[terrain.getRevision()] = getChangedCells(TerrainSnapshot(), snapshot);
+	srand(0);
+	for (unsigned int k = 0; k < 30; ++k) {
+		unsigned long revision = terrain.getRevision();
+
+		// Updating random cells, which include unchanged and removed cells, or adding and
+		// removing single cells
+		if (k % 5 == 3) {
+			terrain.addCellToTerrainMap(model::createCell(rand() % num_cells, rand() % num_cells,
+														  0.5 * (rand() % 8)));
+		} else if (k % 5 == 4) {
+			terrain.removeCellToTerrainMap(getVertex(terrain, rand() % num_cells,
+													 rand() % num_cells));
+		} else {
+			TerrainData terrain_delta;
+			terrain_delta.plane_size = resolution;
+			terrain_delta.height_size = resolution;
+			std::vector<Vertex> removed_cells;
+			for (unsigned int n = 0; n < 6; ++n) {
+				unsigned int i = rand() % num_cells, j = rand() % num_cells;
+				if (rand() % 4 == 0)
+					removed_cells.push_back(getVertex(terrain, i, j));
+				else {
+					TerrainSnapshot::const_iterator cell_it =
+							snapshot.find(getVertex(terrain, i, j));
+					double cost = (cell_it != snapshot.end() && rand() % 3 == 0) ?
+							cell_it->second.cost : 0.5 * (rand() % 8);
+					terrain_delta.data.push_back(model::createCell(i, j, cost));
+				}
+			}
+			terrain.updateTerrainMap(terrain_delta, removed_cells);
+		}
+
+		// The revision only increases if the terrain changed
+		TerrainSnapshot new_snapshot = getSnapshot(terrain);
+		std::set<Vertex> cells = getChangedCells(snapshot, new_snapshot);
+		BOOST_CHECK_EQUAL(terrain.getRevision(), cells.empty() ? revision : revision + 1);
+		if (!cells.empty())
+			changed_cells[terrain.getRevision()] = cells;
+		snapshot = new_snapshot;
+
+		// Comparing the dirty region since every previous revision with the brute-force
+		// union of the changed cells
+		for (unsigned long r = 0; r <= terrain.getRevision(); ++r) {
+			environment::DirtyRegion region;
+			bool is_kept = terrain.getDirtyRegion(region, r);
+			BOOST_CHECK_EQUAL(is_kept, r + history_size >= terrain.getRevision());
+			if (!is_kept)
+				continue;
+
+			std::set<Vertex> expected_cells;
+			for (unsigned long rev = r + 1; rev <= terrain.getRevision(); ++rev)
+				expected_cells.insert(changed_cells[rev].begin(), changed_cells[rev].end());
+			BOOST_CHECK(std::set<Vertex>(region.cells.begin(), region.cells.end()) ==
+					expected_cells);
+
+			Key min_key(std::numeric_limits<unsigned short int>::max(),
+						std::numeric_limits<unsigned short int>::max(), 0), max_key;
+			for (std::set<Vertex>::const_iterator cell_it = expected_cells.begin();
+					cell_it != expected_cells.end(); ++cell_it) {
+				Key key;
+				terrain.getTerrainSpaceModel().vertexToKey(key, *cell_it, true);
+				min_key.x = std::min(min_key.x, key.x);
+				min_key.y = std::min(min_key.y, key.y);
+				max_key.x = std::max(max_key.x, key.x);
+				max_key.y = std::max(max_key.y, key.y);
+			}
+			if (!expected_cells.empty()) {
+				BOOST_CHECK(region.min_key.x == min_key.x && region.min_key.y == min_key.y);
+				BOOST_CHECK(region.max_key.x == max_key.x && region.max_key.y == max_key.y);
+			}
+		}
+
+		// The cost statistics are the ones of the current cells
+		double total_cost = 0., max_cost = 0.;
+		for (TerrainSnapshot::const_iterator cell_it = snapshot.begin();
+				cell_it != snapshot.end(); ++cell_it) {
+			total_cost += cell_it->second.cost;
+			max_cost = std::max(max_cost, cell_it->second.cost);
+		}
+		BOOST_CHECK_SMALL(terrain.getAverageCostOfTerrain() - total_cost / snapshot.size(),
+						  epsilon);
+		Vertex missing_vertex = getVertex(terrain, num_cells + 5, num_cells + 5);
+		BOOST_CHECK_SMALL(terrain.getTerrainCost(missing_vertex) - max_cost, epsilon);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(full_map_update) // specify a test case for the changes of a new terrain map
+{
+	environment::TerrainMap terrain;
+	model::buildTerrain(terrain);
+
+	// Setting the same cells doesn't change any cell
+	TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	TerrainSnapshot snapshot = getSnapshot(terrain);
+	for (TerrainSnapshot::const_iterator cell_it = snapshot.begin();
+			cell_it != snapshot.end(); ++cell_it)
+		terrain_data.data.push_back(cell_it->second);
+	unsigned long revision = terrain.getRevision();
+	terrain.setTerrainMap(terrain_data);
+
+	environment::DirtyRegion region;
+	BOOST_REQUIRE(terrain.getDirtyRegion(region, revision));
+	BOOST_CHECK(region.cells.empty());
+
+	// Changing only the curvature of a cell
+	revision = terrain.getRevision();
+	terrain_data.data[7].curvature = 0.2;
+	terrain.setTerrainMap(terrain_data);
+	BOOST_REQUIRE(terrain.getDirtyRegion(region, revision));
+	Vertex vertex;
+	terrain.getTerrainSpaceModel().keyToVertex(vertex, terrain_data.data[7].key, true);
+	BOOST_CHECK_EQUAL(region.cells.size(), 1);
+	BOOST_CHECK(region.cells.count(vertex) == 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(empty_map_update) // specify a test case for the statistics of an empty map
+{
+	environment::TerrainMap terrain;
+	model::buildTerrain(terrain);
+
+	// Setting an empty terrain map resets the cost statistics
+	TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	terrain.setTerrainMap(terrain_data);
+	BOOST_CHECK(!terrain.isTerrainInformation());
+	BOOST_CHECK_SMALL(terrain.getAverageCostOfTerrain(), epsilon);
+
+	// The incremental update starts from the statistics of the empty terrain
+	terrain_data.data.push_back(model::createCell(3, 4, 1.));
+	terrain.updateTerrainMap(terrain_data);
+	BOOST_CHECK(terrain.isTerrainInformation());
+	BOOST_CHECK_SMALL(terrain.getAverageCostOfTerrain() - 1., epsilon);
+	BOOST_CHECK_SMALL(terrain.getTerrainCost(getVertex(terrain, 10, 10)) - 1., epsilon);
+
+	terrain_data.data.push_back(model::createCell(5, 4, 2.));
+	terrain.updateTerrainMap(terrain_data);
+	BOOST_CHECK_SMALL(terrain.getAverageCostOfTerrain() - 1.5, epsilon);
+	BOOST_CHECK_SMALL(terrain.getTerrainCost(getVertex(terrain, 10, 10)) - 2., epsilon);
+}
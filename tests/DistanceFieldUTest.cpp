@@ -0,0 +1,123 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/DistanceField.h>
+#include <cstdlib>
+
+
+using namespace dwl;
+
+// Tolerance
+const double epsilon = 0.00001;
+
+// Grid of the distance field
+const int origin_x = 100, origin_y = 200;
+const unsigned int width = 40, height = 30, max_distance = 6;
+
+
+/**
+ * Computes the signed distance of a cell by brute force, i.e. the distance between cell centers
+ * to the closest cell of the other type, truncated to the maximum distance
+ */
+double computeDistance(const std::vector<char>& obstacles,
+					   int x,
+					   int y)
+{
+	bool is_obstacle = obstacles[y * width + x] != 0;
+	double distance = max_distance;
+	for (int j = 0; j < (int) height; ++j) {
+		for (int i = 0; i < (int) width; ++i) {
+			if ((obstacles[j * width + i] != 0) != is_obstacle)
+				distance = std::min(distance, sqrt((i - x) * (i - x) + (j - y) * (j - y)));
+		}
+	}
+
+	return is_obstacle ? -distance : distance;
+}
+
+void checkDistances(const environment::DistanceField& field,
+					const std::vector<char>& obstacles)
+{
+	for (int y = 0; y < (int) height; ++y) {
+		for (int x = 0; x < (int) width; ++x) {
+			double expected_distance = computeDistance(obstacles, x, y);
+			double distance = field.getDistance(origin_x + x, origin_y + y);
+			BOOST_CHECK_SMALL(distance - expected_distance, epsilon);
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(incremental_update) // specify a test case for the raised and lowered cells
+{
+	environment::DistanceField field;
+	field.setMaximumDistance(max_distance);
+	field.resize(origin_x, origin_y, width, height);
+	std::vector<char> obstacles(width * height, 0);
+
+	// Without obstacles, all the cells have the maximum distance
+	field.update();
+	checkDistances(field, obstacles);
+
+	// Adding a wall and some blobs, i.e. lowering the free distances
+	for (unsigned int y = 5; y < 25; ++y) {
+		obstacles[y * width + 12] = 1;
+		field.setObstacle(origin_x + 12, origin_y + y);
+	}
+	srand(0);
+	for (unsigned int i = 0; i < 40; ++i) {
+		unsigned int x = rand() % width, y = rand() % height;
+		obstacles[y * width + x] = 1;
+		field.setObstacle(origin_x + x, origin_y + y);
+	}
+	field.update();
+	checkDistances(field, obstacles);
+
+	// Removing a part of the wall and adding more obstacles in the same update, i.e. raising
+	// and lowering cells at once
+	for (unsigned int y = 10; y < 18; ++y) {
+		obstacles[y * width + 12] = 0;
+		field.removeObstacle(origin_x + 12, origin_y + y);
+	}
+	for (unsigned int i = 0; i < 10; ++i) {
+		unsigned int x = rand() % width, y = rand() % height;
+		obstacles[y * width + x] = 1;
+		field.setObstacle(origin_x + x, origin_y + y);
+	}
+	field.update();
+	checkDistances(field, obstacles);
+
+	// Filling a block, i.e. the obstacle side has negative distances, and clearing it again
+	for (unsigned int y = 20; y < 30; ++y) {
+		for (unsigned int x = 25; x < 40; ++x) {
+			obstacles[y * width + x] = 1;
+			field.setObstacle(origin_x + x, origin_y + y);
+		}
+	}
+	field.update();
+	checkDistances(field, obstacles);
+
+	for (unsigned int y = 22; y < 30; ++y) {
+		for (unsigned int x = 28; x < 40; ++x) {
+			obstacles[y * width + x] = 0;
+			field.removeObstacle(origin_x + x, origin_y + y);
+		}
+	}
+	field.update();
+	checkDistances(field, obstacles);
+
+	// Removing all the obstacles
+	for (unsigned int i = 0; i < width * height; ++i) {
+		if (obstacles[i] != 0) {
+			obstacles[i] = 0;
+			field.removeObstacle(origin_x + i % width, origin_y + i / width);
+		}
+	}
+	field.update();
+	checkDistances(field, obstacles);
+
+	// The cells outside the grid have the maximum distance
+	BOOST_CHECK_SMALL(field.getDistance(origin_x - 1, origin_y) - max_distance, epsilon);
+	BOOST_CHECK(!field.setObstacle(origin_x + width, origin_y));
+}
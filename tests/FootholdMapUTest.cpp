@@ -0,0 +1,269 @@
+#include <dwl/environment/FootholdMap.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <set>
+
+
+
+// Tolerance
+const double epsilon = 0.00001;
+
+// Terrain resolutions and number of cells per side
+const double resolution = 0.04;
+const double height_resolution = 0.005;
+const double angular_resolution = M_PI / 8;
+const unsigned int num_cells = 30;
+
+// Parameters of the foothold scores
+const double max_slope = 0.5, max_roughness = 0.02, edge_distance = 0.12, step_height = 0.05;
+const unsigned int half_size = 1;
+const double cost_weight = 1., slope_weight = 0.5, roughness_weight = 2., edge_weight = 1.5;
+
+/** Key offsets of a terrain cell */
+typedef std::pair<int,int> CellKey;
+
+/**
+ * Builds a terrain with a smooth height pattern, a step, holes and slopes bigger than the
+ * maximum one
+ */
+void buildTerrain(dwl::environment::TerrainMap& terrain)
+{
+	dwl::environment::SpaceDiscretization space_model(resolution);
+	space_model.setEnvironmentResolution(height_resolution, false);
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = height_resolution;
+	for (unsigned int i = 0; i < num_cells; ++i) {
+		for (unsigned int j = 0; j < num_cells; ++j) {
+			if ((i * 7 + j * 11) % 17 == 0)
+				continue;
+
+			double height = 0.03 * sin(0.4 * i) * cos(0.3 * j) + (i >= 20 ? 0.1 : 0.);
+			dwl::TerrainCell cell;
+			space_model.coordToKeyChecked(cell.key,
+					Eigen::Vector3d(i * resolution, j * resolution, height));
+			cell.height = height;
+			cell.cost = 1. + 0.5 * sin(i) * cos(j);
+			cell.normal = Eigen::Vector3d(0.6 * sin(i), 0.6 * cos(j), 1.).normalized();
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setStateResolution(resolution, angular_resolution);
+	terrain.setTerrainMap(terrain_data);
+}
+
+/**
+ * Computes the foothold scores from their definition, i.e. the edges are searched over the whole
+ * grid for each cell. The heights are the ones of the height keys
+ */
+std::map<CellKey, dwl::Weight> computeScores(const dwl::environment::TerrainMap& terrain)
+{
+	// Getting the heights of the terrain cells, and the bounding box of their keys
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	const dwl::TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	std::map<CellKey, double> heights;
+	int min_x = std::numeric_limits<int>::max(), min_y = std::numeric_limits<int>::max();
+	int max_x = std::numeric_limits<int>::min(), max_y = std::numeric_limits<int>::min();
+	for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		const dwl::Key& key = cell_it->second.key;
+		space_model.keyToCoord(heights[CellKey(key.x, key.y)], key.z, false);
+		min_x = std::min(min_x, (int) key.x);
+		min_y = std::min(min_y, (int) key.y);
+		max_x = std::max(max_x, (int) key.x);
+		max_y = std::max(max_y, (int) key.y);
+	}
+
+	// Getting the edges, i.e. the missing cells, the border of the grid and the steps
+	std::vector<CellKey> edges;
+	for (int x = min_x; x <= max_x; ++x) {
+		for (int y = min_y; y <= max_y; ++y) {
+			std::map<CellKey, double>::const_iterator height_it = heights.find(CellKey(x, y));
+			bool is_edge = height_it == heights.end() ||
+					x == min_x || y == min_y || x == max_x || y == max_y;
+			CellKey neighbors[4] = {CellKey(x - 1, y), CellKey(x + 1, y),
+									CellKey(x, y - 1), CellKey(x, y + 1)};
+			for (unsigned int i = 0; i < 4 && !is_edge; ++i) {
+				std::map<CellKey, double>::const_iterator neighbor_it =
+						heights.find(neighbors[i]);
+				is_edge = neighbor_it != heights.end() &&
+						fabs(neighbor_it->second - height_it->second) > step_height;
+			}
+			if (is_edge)
+				edges.push_back(CellKey(x, y));
+		}
+	}
+
+	std::map<CellKey, dwl::Weight> scores;
+	double max_distance = ceil(edge_distance / resolution);
+	for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		const dwl::TerrainCell& cell = cell_it->second;
+		CellKey cell_key(cell.key.x, cell.key.y);
+		double slope = acos(std::min(cell.normal(dwl::rbd::Z), 1.));
+		double distance = max_distance;
+		for (unsigned int i = 0; i < edges.size(); ++i)
+			distance = std::min(distance,
+					sqrt(pow(edges[i].first - cell_key.first, 2) +
+						 pow(edges[i].second - cell_key.second, 2)));
+		if (slope > max_slope || distance <= 0.)
+			continue;
+
+		// Computing the standard deviation of the window heights
+		std::vector<double> window_heights;
+		int window_size = half_size;
+		for (int x = cell_key.first - window_size; x <= cell_key.first + window_size; ++x) {
+			for (int y = cell_key.second - window_size; y <= cell_key.second + window_size; ++y) {
+				std::map<CellKey, double>::const_iterator height_it =
+						heights.find(CellKey(x, y));
+				if (height_it != heights.end())
+					window_heights.push_back(height_it->second);
+			}
+		}
+		double mean = 0., variance = 0.;
+		for (unsigned int i = 0; i < window_heights.size(); ++i)
+			mean += window_heights[i] / window_heights.size();
+		for (unsigned int i = 0; i < window_heights.size(); ++i)
+			variance += pow(window_heights[i] - mean, 2) / window_heights.size();
+
+		scores[cell_key] = cost_weight * cell.cost + slope_weight * slope / max_slope +
+				roughness_weight * std::min(sqrt(variance) / max_roughness, 1.) +
+				edge_weight * (1. - distance / max_distance);
+	}
+
+	return scores;
+}
+
+/**
+ * Checks the scores and reachable footholds of the foothold map against the brute-force ones
+ */
+void checkFootholdMap(const dwl::environment::FootholdMap& foothold_map,
+					  const dwl::environment::TerrainMap& terrain,
+					  dwl::robot::Robot& robot)
+{
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	std::map<CellKey, dwl::Weight> scores = computeScores(terrain);
+	const dwl::TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	unsigned int num_footholds = 0;
+	for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		std::map<CellKey, dwl::Weight>::const_iterator score_it =
+				scores.find(CellKey(cell_it->second.key.x, cell_it->second.key.y));
+		dwl::Weight score = foothold_map.getScore(cell_it->first);
+		if (score_it == scores.end())
+			BOOST_CHECK_EQUAL(score, std::numeric_limits<dwl::Weight>::max());
+		else {
+			num_footholds++;
+			BOOST_CHECK_SMALL(score - score_it->second, epsilon);
+		}
+	}
+	BOOST_CHECK(num_footholds > 0 && num_footholds < terrain_map.size());
+
+	// The reachable footholds are the footholds whose center is inside the search area of the
+	// leg, where the body state is discretized into its cell and heading
+	int num_headings = ceil(2 * M_PI / angular_resolution);
+	dwl::SearchAreaMap areas = robot.getFootstepSearchAreas();
+	Eigen::Vector3d body_states[] = {Eigen::Vector3d(0.5, 0.6, 0.),
+									 Eigen::Vector3d(0.7, 0.4, 0.9),
+									 Eigen::Vector3d(0.81, 0.5, -2.)};
+	for (unsigned int k = 0; k < 3; ++k) {
+		dwl::Key body_key;
+		space_model.coordToKey(body_key.x, body_states[k](dwl::rbd::X), true);
+		space_model.coordToKey(body_key.y, body_states[k](dwl::rbd::Y), true);
+		int heading =
+				(int) round(body_states[k](dwl::rbd::Z) / angular_resolution) % num_headings;
+		double yaw = (heading < 0 ? heading + num_headings : heading) * angular_resolution;
+		for (dwl::SearchAreaMap::const_iterator area_it = areas.begin();
+				area_it != areas.end(); ++area_it) {
+			const dwl::SearchArea& area = area_it->second;
+			std::set<dwl::Vertex> expected_footholds;
+			dwl::Weight best_score = std::numeric_limits<dwl::Weight>::max();
+			for (std::map<CellKey, dwl::Weight>::const_iterator score_it = scores.begin();
+					score_it != scores.end(); ++score_it) {
+				int dx = score_it->first.first - body_key.x;
+				int dy = score_it->first.second - body_key.y;
+				double x = dx * resolution * cos(yaw) + dy * resolution * sin(yaw);
+				double y = -dx * resolution * sin(yaw) + dy * resolution * cos(yaw);
+				if (x < area.min_x || x > area.max_x || y < area.min_y || y > area.max_y)
+					continue;
+
+				dwl::Key key;
+				dwl::Vertex vertex;
+				key.x = score_it->first.first;
+				key.y = score_it->first.second;
+				space_model.keyToVertex(vertex, key, true);
+				expected_footholds.insert(vertex);
+				best_score = std::min(best_score, score_it->second);
+			}
+
+			std::vector<dwl::Vertex> footholds;
+			BOOST_REQUIRE(foothold_map.getReachableFootholds(footholds, area_it->first,
+															 body_states[k]));
+			BOOST_CHECK_EQUAL(footholds.size(), expected_footholds.size());
+			BOOST_CHECK(std::set<dwl::Vertex>(footholds.begin(), footholds.end()) ==
+					expected_footholds);
+
+			dwl::Vertex best_foothold;
+			dwl::Weight score;
+			BOOST_CHECK_EQUAL(foothold_map.getBestFoothold(best_foothold, score, area_it->first,
+														   body_states[k]),
+							  !expected_footholds.empty());
+			if (!expected_footholds.empty()) {
+				BOOST_CHECK_SMALL(score - best_score, epsilon);
+				BOOST_CHECK(expected_footholds.count(best_foothold) == 1);
+			}
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(brute_force) // specify a test case for comparing with brute-force footholds
+{
+	dwl::environment::TerrainMap terrain;
+	buildTerrain(terrain);
+	dwl::robot::Robot robot;
+	robot.read(DWL_SOURCE_DIR"/tests/model/robot_config.yaml");
+
+	dwl::environment::FootholdMap foothold_map;
+	foothold_map.setRobot(&robot);
+	foothold_map.setWeights(cost_weight, slope_weight, roughness_weight, edge_weight);
+	foothold_map.setMaximumSlope(max_slope);
+	foothold_map.setMaximumRoughness(max_roughness);
+	foothold_map.setEdgeDistance(edge_distance);
+	foothold_map.setStepHeight(step_height);
+	foothold_map.setWindowSize(half_size);
+	BOOST_REQUIRE(foothold_map.update(terrain));
+	checkFootholdMap(foothold_map, terrain, robot);
+
+	// Updating the terrain with a new step, a removed cell and a cell that fills a hole, which
+	// updates only the dirty region of the foothold map
+	dwl::environment::SpaceDiscretization space_model(resolution);
+	space_model.setEnvironmentResolution(height_resolution, false);
+	dwl::TerrainData terrain_delta;
+	terrain_delta.plane_size = resolution;
+	terrain_delta.height_size = height_resolution;
+	for (unsigned int j = 5; j < 12; ++j) {
+		dwl::TerrainCell cell;
+		space_model.coordToKeyChecked(cell.key,
+				Eigen::Vector3d(12 * resolution, j * resolution, 0.2));
+		space_model.keyToCoord(cell.height, cell.key.z, false);
+		cell.cost = 1.2;
+		cell.normal = Eigen::Vector3d::UnitZ();
+		terrain_delta.data.push_back(cell);
+	}
+	dwl::TerrainCell hole_cell = terrain_delta.data.back();
+	space_model.coordToKeyChecked(hole_cell.key, Eigen::Vector3d(0., 0., 0.));
+	terrain_delta.data.push_back(hole_cell);
+
+	std::vector<dwl::Vertex> removed_cells(1);
+	space_model.coordToVertex(removed_cells[0],
+							  Eigen::Vector2d(15 * resolution, 15 * resolution));
+	unsigned long revision = terrain.getRevision();
+	terrain.updateTerrainMap(terrain_delta, removed_cells);
+	BOOST_REQUIRE(terrain.getRevision() != revision);
+	BOOST_REQUIRE(foothold_map.update(terrain));
+	BOOST_CHECK_EQUAL(foothold_map.getRevision(), terrain.getRevision());
+	checkFootholdMap(foothold_map, terrain, robot);
+}
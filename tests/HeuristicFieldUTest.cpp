@@ -0,0 +1,68 @@
+#include <model/TerrainSearchModel.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+/**
+ * Checks that A* returns the optimal cost with the heuristic field, and that the field is the
+ * exact cost-to-go of the adjacency model
+ */
+void checkField(dwl::environment::TerrainMap& terrain,
+				bool is_stance_adjacency,
+				dwl::robot::Robot* robot)
+{
+	double margin = (num_cells - 1) * resolution;
+	Eigen::Vector3d sources[] = {Eigen::Vector3d(0., 0., 0.),
+								 Eigen::Vector3d(0., margin, 0.),
+								 Eigen::Vector3d(margin / 3, margin / 2, 0.)};
+	Eigen::Vector3d targets[] = {Eigen::Vector3d(margin, margin, 0.),
+								 Eigen::Vector3d(margin, 0., 0.),
+								 Eigen::Vector3d(margin, margin / 2, 0.)};
+	for (unsigned int i = 0; i < 3; ++i) {
+		dwl::Vertex source, target;
+		terrain.getTerrainSpaceModel().stateToVertex(source, sources[i]);
+		terrain.getTerrainSpaceModel().stateToVertex(target, targets[i]);
+
+		double cost, field_cost;
+		dwl::model::HeuristicField field;
+		dwl::model::UniformCostAdjacency* adjacency =
+				new dwl::model::UniformCostAdjacency(is_stance_adjacency);
+		adjacency->setHeuristicField(&field);
+		BOOST_CHECK(dwl::model::computeAStarCost(cost, terrain,
+				new dwl::model::UniformCostAdjacency(is_stance_adjacency), source, target, robot));
+		BOOST_CHECK(dwl::model::computeAStarCost(field_cost, terrain,
+				adjacency, source, target, robot));
+		BOOST_CHECK_SMALL(field_cost - cost, epsilon);
+
+		// The cost-to-go of the field is the cost of the forward search
+		dwl::model::UniformCostAdjacency field_adjacency(is_stance_adjacency);
+		field_adjacency.reset(robot, &terrain);
+		field_adjacency.setHeuristicField(&field);
+		BOOST_CHECK_SMALL(field_adjacency.heuristicCost(source, target) - cost, epsilon);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(terrain_adjacency) // specify a test case for the terrain adjacency
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+
+	checkField(terrain, false, NULL);
+}
+
+
+BOOST_AUTO_TEST_CASE(stance_adjacency) // specify a test case for the default stance adjacency
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+
+	// The body cost of the stance areas is higher than the cost of the arrival cell, and the
+	// stance areas cross the missing cells of the wall
+	dwl::robot::Robot robot;
+	robot.read(DWL_SOURCE_DIR"/tests/model/robot_config.yaml");
+	checkField(terrain, true, &robot);
+}
@@ -0,0 +1,115 @@
+#include <dwl/solver/IndexedHeap.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <cstdlib>
+
+
+
+// Tolerance
+double epsilon = 0.00001;
+
+/** Returns the doubled key of the index, it's used for rebuilding the heap */
+struct DoubledKey
+{
+	DoubledKey(const std::vector<double>& keys) : keys(keys) {}
+	double operator()(unsigned int index) const { return 2 * keys[index]; }
+	const std::vector<double>& keys;
+};
+
+/**
+ * Pops the whole heap, and checks that the keys are sorted and they are the reference ones
+ */
+void checkPopOrder(dwl::solver::IndexedHeap<4,double>& heap,
+				   const std::vector<double>& keys,
+				   double scale)
+{
+	double last_key = -std::numeric_limits<double>::max();
+	while (!heap.empty()) {
+		double key = heap.topKey();
+		unsigned int index = heap.pop();
+		BOOST_CHECK(key >= last_key);
+		BOOST_CHECK_SMALL(key - scale * keys[index], epsilon);
+		BOOST_CHECK(!heap.contains(index));
+		last_key = key;
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(decrease_key) // specify a test case for the key updates
+{
+	dwl::solver::IndexedHeap<4,double> heap;
+	std::vector<double> keys(200);
+	srand(0);
+	for (unsigned int i = 0; i < keys.size(); ++i) {
+		keys[i] = rand() % 1000;
+		heap.push(i, keys[i]);
+	}
+	BOOST_CHECK_EQUAL(heap.size(), keys.size());
+
+	// Decreasing and increasing the keys, there aren't duplicated indexes
+	for (unsigned int i = 0; i < keys.size(); i += 3) {
+		keys[i] = (i % 2 == 0) ? keys[i] - 500 : keys[i] + 500;
+		heap.push(i, keys[i]);
+		BOOST_CHECK_SMALL(heap.getKey(i) - keys[i], epsilon);
+	}
+	BOOST_CHECK_EQUAL(heap.size(), keys.size());
+
+	// Removing some indexes
+	unsigned int num_removed = 0;
+	for (unsigned int i = 1; i < keys.size(); i += 7) {
+		heap.remove(i);
+		BOOST_CHECK(!heap.contains(i));
+		++num_removed;
+	}
+	heap.remove(keys.size() + 10); // it isn't in the heap
+	BOOST_CHECK_EQUAL(heap.size(), keys.size() - num_removed);
+
+	checkPopOrder(heap, keys, 1.);
+}
+
+
+BOOST_AUTO_TEST_CASE(rebuild) // specify a test case for the linear-time rebuild
+{
+	dwl::solver::IndexedHeap<4,double> heap;
+	std::vector<double> keys(100);
+	srand(1);
+	for (unsigned int i = 0; i < keys.size(); ++i)
+		keys[i] = rand() % 1000;
+
+	// Pushing the first half, and adding the rest with the rebuild
+	for (unsigned int i = 0; i < keys.size() / 2; ++i)
+		heap.push(i, keys[i]);
+	std::vector<unsigned int> new_indexes;
+	for (unsigned int i = keys.size() / 4; i < keys.size(); ++i)
+		new_indexes.push_back(i);
+	heap.rebuild(new_indexes, DoubledKey(keys));
+	BOOST_CHECK_EQUAL(heap.size(), keys.size());
+
+	// Decreasing a key after the rebuild
+	keys[keys.size() - 1] = -1.;
+	heap.push(keys.size() - 1, 2 * keys[keys.size() - 1]);
+	BOOST_CHECK_EQUAL(heap.top(), keys.size() - 1);
+
+	checkPopOrder(heap, keys, 2.);
+
+	// Clearing keeps the indexes out of the heap
+	heap.push(3, 1.);
+	heap.clear();
+	BOOST_CHECK(heap.empty());
+	BOOST_CHECK(!heap.contains(3));
+}
+
+
+BOOST_AUTO_TEST_CASE(lexicographic_key) // specify a test case for the pair keys
+{
+	typedef std::pair<double,double> PriorityKey;
+	dwl::solver::IndexedHeap<4,PriorityKey> heap;
+	heap.push(0, PriorityKey(1., 3.));
+	heap.push(1, PriorityKey(1., 2.));
+	heap.push(2, PriorityKey(0.5, 9.));
+	BOOST_CHECK_EQUAL(heap.pop(), 2);
+	BOOST_CHECK_EQUAL(heap.pop(), 1);
+	BOOST_CHECK_EQUAL(heap.pop(), 0);
+}
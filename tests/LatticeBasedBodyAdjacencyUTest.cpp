@@ -0,0 +1,229 @@
+#include <dwl/model/LatticeBasedBodyAdjacency.h>
+#include <model/TerrainSearchModel.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+/**
+ * Reentrant body feature, i.e. its cost only depends on the robot and terrain information
+ */
+class BodyActionFeature : public dwl::environment::Feature
+{
+	public:
+		BodyActionFeature()
+		{
+			name_ = "Body Action";
+		}
+
+		void computeCost(double& cost_value,
+						 const dwl::RobotAndTerrain& info)
+		{
+			cost_value = fabs(info.body_action(2)) + 0.1 * info.pose.position.norm();
+		}
+};
+
+/**
+ * Sets the robot with the body motor primitives
+ */
+void readRobot(dwl::robot::Robot& robot)
+{
+	robot.read(DWL_SOURCE_DIR"/tests/model/robot_config.yaml");
+	robot.getBodyMotorPrimitive().read(DWL_SOURCE_DIR"/tests/model/body_primitives.yaml");
+}
+
+/**
+ * Adds the obstacles of a short wall
+ */
+void addObstacles(dwl::environment::TerrainMap& terrain)
+{
+	dwl::environment::SpaceDiscretization space_model(resolution);
+	std::vector<dwl::Cell> obstacle_map;
+	for (unsigned int j = 0; j < 6; ++j) {
+		dwl::Cell cell;
+		cell.plane_size = resolution;
+		cell.height_size = resolution;
+		space_model.coordToKeyChecked(cell.key,
+				Eigen::Vector3d(0.5 * resolution + 0.56, (j + 0.5) * resolution + 0.2, 0.));
+		obstacle_map.push_back(cell);
+	}
+	terrain.setObstacleMap(obstacle_map);
+}
+
+/**
+ * Gets the state vertexes of some positions with every heading
+ */
+std::vector<dwl::Vertex> getStateVertexes(const dwl::environment::TerrainMap& terrain,
+										  double angular_resolution)
+{
+	double positions[][2] = {{0.3, 0.3}, {0.34, 0.34}, {0.38, 0.5}};
+	std::vector<dwl::Vertex> vertexes;
+	unsigned int num_headings = round(2 * M_PI / angular_resolution);
+	for (unsigned int i = 0; i < 3; ++i) {
+		for (unsigned int k = 0; k < num_headings; ++k) {
+			dwl::Vertex vertex;
+			terrain.getTerrainSpaceModel().stateToVertex(vertex,
+					Eigen::Vector3d(positions[i][0], positions[i][1],
+									(k + 0.5) * angular_resolution));
+			vertexes.push_back(vertex);
+		}
+	}
+
+	return vertexes;
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_actions) // specify a test case for the actions evaluated in parallel
+{
+	dwl::robot::Robot robot;
+	readRobot(robot);
+
+	dwl::environment::TerrainMap terrain;
+	terrain.setStateResolution(resolution, M_PI / 16);
+	dwl::model::buildTerrain(terrain);
+	addObstacles(terrain);
+	std::vector<dwl::Vertex> vertexes = getStateVertexes(terrain, M_PI / 16);
+
+	// Computing the successors with one (reference) and more threads
+	BodyActionFeature feature;
+	feature.setWeight(0.5);
+	std::vector<std::list<dwl::Edge> > expected_successors;
+	unsigned int thread_numbers[] = {1, 2, 4};
+	for (unsigned int t = 0; t < 3; ++t) {
+		dwl::model::LatticeBasedBodyAdjacency adjacency;
+		adjacency.addFeature(&feature);
+		adjacency.reset(&robot, &terrain);
+		adjacency.setNumberOfThreads(thread_numbers[t]);
+
+		for (unsigned int v = 0; v < vertexes.size(); ++v) {
+			std::list<dwl::Edge> successors;
+			adjacency.getSuccessors(successors, vertexes[v]);
+			if (t == 0) {
+				BOOST_CHECK(!successors.empty());
+				expected_successors.push_back(successors);
+				continue;
+			}
+
+			// The successors have the same targets, costs and order than the serial evaluation
+			const std::list<dwl::Edge>& expected = expected_successors[v];
+			BOOST_REQUIRE_EQUAL(successors.size(), expected.size());
+			std::list<dwl::Edge>::const_iterator edge_it = successors.begin();
+			std::list<dwl::Edge>::const_iterator expected_it = expected.begin();
+			for (; edge_it != successors.end(); ++edge_it, ++expected_it) {
+				BOOST_CHECK_EQUAL(edge_it->target, expected_it->target);
+				BOOST_CHECK_EQUAL(edge_it->weight, expected_it->weight);
+			}
+		}
+	}
+
+	// The wall blocks some actions
+	unsigned int num_successors = 0;
+	for (unsigned int v = 0; v < expected_successors.size(); ++v)
+		num_successors += expected_successors[v].size();
+	BOOST_CHECK(num_successors < 6 * vertexes.size());
+}
+
+/**
+ * Computes the successors by generating the actions from the current state, as the adjacency
+ * did before precomputing the primitives per heading. There isn't obstacle information
+ */
+std::list<dwl::Edge> computeSuccessors(dwl::robot::Robot& robot,
+									   dwl::environment::TerrainMap& terrain,
+									   dwl::Vertex state_vertex)
+{
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	Eigen::Vector3d current_state;
+	space_model.vertexToState(current_state, state_vertex);
+	dwl::Pose3d current_pose;
+	current_pose.position = current_state.head(2);
+	current_pose.orientation = current_state(2);
+	std::vector<dwl::Action3d> actions;
+	robot.getBodyMotorPrimitive().generateActions(actions, current_pose);
+
+	std::list<dwl::Edge> successors;
+	for (unsigned int i = 0; i < actions.size(); ++i) {
+		Eigen::Vector3d action_state;
+		action_state << actions[i].pose.position, actions[i].pose.orientation;
+		dwl::Vertex action_vertex;
+		space_model.stateToVertex(action_vertex, action_state);
+
+		// Averaging the different costs of the stance areas, which are rotated by the yaw
+		// of the successor
+		dwl::SearchAreaMap stance_areas = robot.getFootstepSearchAreas(action_state - current_state);
+		double terrain_cost = 0.;
+		double cos_yaw = cos(action_state(2)), sin_yaw = sin(action_state(2));
+		for (dwl::SearchAreaMap::const_iterator area_it = stance_areas.begin();
+				area_it != stance_areas.end(); ++area_it) {
+			const dwl::SearchArea& area = area_it->second;
+			std::set<double> costs;
+			for (double y = area.min_y; y <= area.max_y; y += area.resolution) {
+				for (double x = area.min_x; x <= area.max_x; x += area.resolution) {
+					Eigen::Vector2d point(x * cos_yaw - y * sin_yaw + action_state(0),
+										  x * sin_yaw + y * cos_yaw + action_state(1));
+					dwl::Vertex point_vertex;
+					space_model.coordToVertex(point_vertex, point);
+					const dwl::TerrainCell* cell = terrain.findTerrainCell(point_vertex);
+					if (cell != NULL)
+						costs.insert(cell->cost);
+				}
+			}
+
+			double stance_cost = 0.;
+			unsigned int num_costs = std::min((int) costs.size(), 10);
+			std::set<double>::const_iterator cost_it = costs.begin();
+			for (unsigned int n = 0; n < num_costs; ++n, ++cost_it)
+				stance_cost += *cost_it;
+			if (num_costs == 0)
+				terrain_cost += 1.15 * terrain.getAverageCostOfTerrain();
+			else
+				terrain_cost += stance_cost / num_costs;
+		}
+
+		successors.push_back(dwl::Edge(action_vertex,
+									   terrain_cost / stance_areas.size() + actions[i].cost));
+	}
+
+	return successors;
+}
+
+
+BOOST_AUTO_TEST_CASE(primitive_tables) // specify a test case for the primitives per heading
+{
+	dwl::robot::Robot robot;
+	readRobot(robot);
+
+	double angular_resolution = M_PI / 16;
+	dwl::environment::TerrainMap terrain;
+	terrain.setStateResolution(resolution, angular_resolution);
+	dwl::model::buildTerrain(terrain);
+
+	dwl::model::LatticeBasedBodyAdjacency adjacency;
+	adjacency.reset(&robot, &terrain);
+
+	// Headings of the first and last keys, and around the wrap-around of +-pi. Some successors
+	// are close to the terrain border, so their stance areas have missing cells
+	double yaws[] = {0.5 * angular_resolution, 1.5 * angular_resolution,
+					 M_PI - 0.5 * angular_resolution, -M_PI + 0.5 * angular_resolution,
+					 -0.5 * angular_resolution};
+	double positions[][2] = {{0.3, 0.3}, {0.06, 0.7}};
+	for (unsigned int i = 0; i < 2; ++i) {
+		for (unsigned int k = 0; k < 5; ++k) {
+			dwl::Vertex vertex;
+			terrain.getTerrainSpaceModel().stateToVertex(vertex,
+					Eigen::Vector3d(positions[i][0], positions[i][1], yaws[k]));
+
+			std::list<dwl::Edge> successors;
+			adjacency.getSuccessors(successors, vertex);
+			std::list<dwl::Edge> expected = computeSuccessors(robot, terrain, vertex);
+			BOOST_REQUIRE_EQUAL(successors.size(), expected.size());
+			std::list<dwl::Edge>::const_iterator edge_it = successors.begin();
+			std::list<dwl::Edge>::const_iterator expected_it = expected.begin();
+			for (; edge_it != successors.end(); ++edge_it, ++expected_it) {
+				BOOST_CHECK_EQUAL(edge_it->target, expected_it->target);
+				BOOST_CHECK_CLOSE(edge_it->weight, expected_it->weight, epsilon);
+			}
+		}
+	}
+}
@@ -0,0 +1,117 @@
+#include <dwl/locomotion/MultiResolutionPlanning.h>
+#include <dwl/model/LatticeBasedBodyAdjacency.h>
+#include <model/TerrainSearchModel.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+/**
+ * Creates an A* solver with the terrain adjacency
+ */
+dwl::solver::SearchTreeSolver* createSolver(dwl::model::AdjacencyModel* adjacency)
+{
+	dwl::solver::AStar* solver = new dwl::solver::AStar();
+	solver->setAdjacencyModel(adjacency);
+
+	return solver;
+}
+
+/**
+ * Creates a pose from the (x,y) position
+ */
+dwl::Pose createPose(double x,
+					 double y)
+{
+	dwl::Pose pose;
+	pose.position << x, y, 0.;
+	pose.orientation = Eigen::Quaterniond::Identity();
+
+	return pose;
+}
+
+/**
+ * Gets the block of a terrain vertex
+ */
+dwl::Vertex getBlock(const dwl::locomotion::MultiResolutionPlanning& planner,
+					 const dwl::environment::TerrainMap& terrain,
+					 dwl::Vertex vertex)
+{
+	Eigen::Vector2d coord;
+	dwl::Vertex block_vertex;
+	terrain.getTerrainSpaceModel().vertexToCoord(coord, vertex);
+	planner.getCoarseTerrain().getTerrainSpaceModel().coordToVertex(block_vertex, coord);
+
+	return block_vertex;
+}
+
+
+BOOST_AUTO_TEST_CASE(corridor_cells) // specify a test case for the cells of the corridor
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain, true);
+
+	dwl::locomotion::MultiResolutionPlanning planner;
+	planner.reset(createSolver(new dwl::model::UniformCostAdjacency()));
+	planner.setCoarseSolver(createSolver(new dwl::model::UniformCostAdjacency()));
+	planner.setBlockSize(3);
+	planner.setCorridorWidth(resolution);
+	planner.setComputationTime(std::numeric_limits<double>::max(), true);
+	planner.reset(NULL, &terrain);
+
+	std::vector<dwl::Pose> path;
+	double margin = (num_cells - 1) * resolution;
+	BOOST_REQUIRE(planner.computePath(path, createPose(0., 0.), createPose(margin, margin)));
+	BOOST_CHECK(path.size() > 1);
+
+	// Getting the blocks of the corridor, which are a part of the terrain
+	const dwl::TerrainDataMap& corridor_map = planner.getCorridorTerrain().getTerrainDataMap();
+	std::unordered_set<dwl::Vertex> corridor_blocks;
+	for (dwl::TerrainDataMap::const_iterator cell_it = corridor_map.begin();
+			cell_it != corridor_map.end(); ++cell_it)
+		corridor_blocks.insert(getBlock(planner, terrain, cell_it->first));
+	BOOST_CHECK(corridor_map.size() < terrain.getTerrainDataMap().size());
+
+	// The corridor has the same cells of a brute-force search of the cells of its blocks
+	const dwl::TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	unsigned int num_corridor_cells = 0;
+	for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		if (corridor_blocks.find(getBlock(planner, terrain, cell_it->first)) ==
+				corridor_blocks.end())
+			continue;
+
+		num_corridor_cells++;
+		dwl::TerrainDataMap::const_iterator corridor_it = corridor_map.find(cell_it->first);
+		BOOST_REQUIRE(corridor_it != corridor_map.end());
+		BOOST_CHECK_SMALL(corridor_it->second.cost - cell_it->second.cost, epsilon);
+	}
+	BOOST_CHECK_EQUAL(num_corridor_cells, corridor_map.size());
+
+	// The path is inside the corridor
+	for (unsigned int k = 0; k < path.size(); ++k) {
+		dwl::Vertex vertex;
+		terrain.getTerrainSpaceModel().coordToVertex(vertex,
+				(Eigen::Vector2d) path[k].position.head(2));
+		BOOST_CHECK(corridor_map.find(vertex) != corridor_map.end());
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(lattice_refinement) // specify a test case for the grid-only refinement
+{
+	dwl::environment::TerrainMap terrain;
+	dwl::model::buildTerrain(terrain);
+
+	// The lattice successors could leave the corridor, so the refinement is rejected
+	dwl::locomotion::MultiResolutionPlanning planner;
+	planner.reset(createSolver(new dwl::model::LatticeBasedBodyAdjacency()));
+	planner.setCoarseSolver(createSolver(new dwl::model::UniformCostAdjacency()));
+	planner.reset(NULL, &terrain);
+
+	std::vector<dwl::Pose> path;
+	double margin = (num_cells - 1) * resolution;
+	BOOST_CHECK(!planner.computePath(path, createPose(0., 0.), createPose(margin, margin)));
+}
@@ -0,0 +1,117 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/NormalEstimator.h>
+#include <dwl/environment/TerrainCostPipeline.h>
+#include <dwl/environment/CurvatureFeature.h>
+#include <model/TerrainSearchModel.h>
+
+
+using namespace dwl;
+
+// Center and half size of the curved patch, i.e. a paraboloid bump on a flat terrain
+const int center = 10, patch_size = 4;
+
+// Height resolution, which is finer than the plane one for keeping the curvature of the patch
+const double height_resolution = 0.001;
+
+double getHeight(int i,
+				 int j)
+{
+	int dx = i - center, dy = j - center;
+	if (abs(dx) > patch_size || abs(dy) > patch_size)
+		return 0.;
+
+	return 0.1 - 2. * (dx * dx + dy * dy) * resolution * resolution;
+}
+
+void buildCurvedTerrain(environment::TerrainMap& terrain)
+{
+	TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = height_resolution;
+	environment::SpaceDiscretization space_model(resolution);
+	space_model.setEnvironmentResolution(height_resolution, false);
+	for (unsigned int i = 0; i < num_cells; ++i) {
+		for (unsigned int j = 0; j < num_cells; ++j) {
+			TerrainCell cell = model::createCell(i, j, 1.);
+			space_model.coordToKey(cell.key.z, getHeight(i, j), false);
+			space_model.keyToCoord(cell.height, cell.key.z, false);
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+}
+
+const TerrainCell* getCell(const environment::TerrainMap& terrain,
+						   unsigned int i,
+						   unsigned int j)
+{
+	Vertex vertex;
+	terrain.getTerrainSpaceModel().keyToVertex(vertex, model::createCell(i, j, 0.).key, true);
+	return terrain.findTerrainCell(vertex);
+}
+
+
+BOOST_AUTO_TEST_CASE(curved_patch) // specify a test case for the curvature of a curved patch
+{
+	environment::TerrainMap terrain;
+	buildCurvedTerrain(terrain);
+	Eigen::Vector2d min_corner(0., 0.);
+	Eigen::Vector2d max_corner((num_cells - 1) * resolution, (num_cells - 1) * resolution);
+
+	environment::NormalEstimator estimator;
+	BOOST_REQUIRE(estimator.compute(terrain, min_corner, max_corner));
+
+	// Comparing the normals and curvatures with the brute-force fit of the window points, whose
+	// heights are the ones of the height keys
+	int half_size = 2;
+	for (int j = 0; j < (int) num_cells; ++j) {
+		for (int i = 0; i < (int) num_cells; ++i) {
+			Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+			std::vector<Eigen::Vector3d> points;
+			for (int y = std::max(j - half_size, 0);
+					y <= std::min(j + half_size, (int) num_cells - 1); ++y) {
+				for (int x = std::max(i - half_size, 0);
+						x <= std::min(i + half_size, (int) num_cells - 1); ++x) {
+					double height;
+					terrain.getTerrainSpaceModel().keyToCoord(height, getCell(terrain, x, y)->key.z,
+															  false);
+					points.push_back(Eigen::Vector3d(x * resolution, y * resolution, height));
+					mean += points.back();
+				}
+			}
+			mean /= points.size();
+			Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+			for (unsigned int k = 0; k < points.size(); ++k)
+				covariance += (points[k] - mean) * (points[k] - mean).transpose();
+			covariance /= points.size();
+
+			Eigen::Vector3d normal;
+			double curvature;
+			math::solvePlaneParameters(normal, curvature, covariance);
+			if (normal(rbd::Z) < 0.)
+				normal = -normal;
+
+			const TerrainCell* cell = getCell(terrain, i, j);
+			BOOST_REQUIRE(cell != NULL);
+			BOOST_CHECK_SMALL((cell->normal - normal).norm(), 1e-6);
+			BOOST_CHECK_SMALL(cell->curvature - curvature, 1e-6);
+		}
+	}
+
+	// The curved patch has curvature, and the flat terrain hasn't
+	BOOST_CHECK(getCell(terrain, center, center)->curvature > 1e-4);
+	BOOST_CHECK_SMALL(getCell(terrain, 1, 1)->curvature, 1e-9);
+	BOOST_CHECK_SMALL((getCell(terrain, 1, 1)->normal - Eigen::Vector3d::UnitZ()).norm(), 1e-9);
+
+	// The curvature feature of the pipeline uses the estimated curvatures
+	environment::CurvatureFeature feature;
+	feature.setMaximumCurvature(0.1);
+	environment::TerrainCostPipeline pipeline;
+	pipeline.addFeature(&feature);
+	BOOST_REQUIRE(pipeline.computeCost(terrain, min_corner, max_corner));
+	BOOST_CHECK(getCell(terrain, center, center)->cost > 0.);
+	BOOST_CHECK_SMALL(getCell(terrain, 1, 1)->cost, 1e-6);
+}
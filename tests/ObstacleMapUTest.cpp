@@ -0,0 +1,123 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/ObstacleMap.h>
+
+
+using namespace dwl;
+
+// Resolution of the octomap and the obstacle map
+const double resolution = 0.04;
+
+// Height range of the search area
+const double min_z = -0.2, max_z = 0.2;
+
+
+/**
+ * Builds an octomap of a rough surface with holes. Some columns have an occupied cell below
+ * the surface, and others have an overhang above the height range of the search area
+ */
+void buildOctomap(octomap::OcTree& octomap)
+{
+	for (int i = -40; i < 40; ++i) {
+		for (int j = -40; j < 40; ++j) {
+			if ((i * 7 + j * 3) % 11 == 0)
+				continue;
+
+			double x = (i + 0.5) * resolution, y = (j + 0.5) * resolution;
+			double height = (floor(3. * sin(3. * x) * cos(2. * y)) + 0.5) * resolution;
+			octomap.updateNode(octomap::point3d(x, y, height), true);
+			if ((i + j) % 3 == 0)
+				octomap.updateNode(octomap::point3d(x, y, height - 3 * resolution), true);
+			if (i % 4 == 0)
+				octomap.updateNode(octomap::point3d(x, y, max_z + 4 * resolution), true);
+		}
+	}
+}
+
+/**
+ * Computes the obstacle map by brute force, i.e. it searches the highest occupied cell of each
+ * column of the search area inside its height range
+ */
+std::map<Vertex,Cell> computeObstacleMap(const octomap::OcTree& octomap,
+										 const Eigen::Vector4d& robot_state,
+										 double min_x, double max_x,
+										 double min_y, double max_y)
+{
+	environment::SpaceDiscretization space_discretization(resolution);
+	double cos_yaw = cos(robot_state(3)), sin_yaw = sin(robot_state(3));
+	std::map<Vertex,Cell> obstacle_map;
+	for (double y = min_y + robot_state(1); y < max_y + robot_state(1); y += resolution) {
+		for (double x = min_x + robot_state(0); x < max_x + robot_state(0); x += resolution) {
+			double xc = x - robot_state(0), yc = y - robot_state(1);
+			double xr = xc * cos_yaw - yc * sin_yaw + robot_state(0);
+			double yr = xc * sin_yaw + yc * cos_yaw + robot_state(1);
+
+			// Visiting every cell of the column from the top, including the first cell below
+			// the minimum height
+			octomap::OcTreeKey key;
+			if (!octomap.coordToKeyChecked(xr, yr, max_z + robot_state(2), 16, key))
+				continue;
+
+			for (int key_z = key[2]; key_z >= 0; --key_z) {
+				key[2] = key_z;
+				octomap::OcTreeNode* node = octomap.search(key);
+				if (node != NULL && octomap.isNodeOccupied(node)) {
+					octomap::point3d point = octomap.keyToCoord(key);
+					Cell cell;
+					cell.plane_size = resolution;
+					cell.height_size = resolution;
+					space_discretization.coordToKeyChecked(cell.key,
+							Eigen::Vector3d(point(0), point(1), point(2)));
+					Vertex vertex;
+					space_discretization.keyToVertex(vertex, cell.key, true);
+					obstacle_map[vertex] = cell;
+					break;
+				}
+
+				if (octomap.keyToCoord(key[2]) < min_z + robot_state(2))
+					break;
+			}
+		}
+	}
+
+	return obstacle_map;
+}
+
+
+BOOST_AUTO_TEST_CASE(surface_extraction) // specify a test case for the surface of the octomap
+{
+	octomap::OcTree octomap(resolution);
+	buildOctomap(octomap);
+
+	// Robot states without and with yaw, and evaluating the columns with one and more threads
+	Eigen::Vector4d robot_states[] = {Eigen::Vector4d(0., 0., 0., 0.),
+									  Eigen::Vector4d(0.3, -0.2, 0.05, 0.3)};
+	unsigned int thread_numbers[] = {1, 4};
+	for (unsigned int k = 0; k < 2; ++k) {
+		for (unsigned int t = 0; t < 2; ++t) {
+			// The search area refines the resolution of the obstacle map
+			environment::ObstacleMap obstacle_map;
+			obstacle_map.setResolution(2 * resolution, true);
+			obstacle_map.setResolution(2 * resolution, false);
+			obstacle_map.addSearchArea(-0.6, 0.8, -0.7, 0.5, min_z, max_z, resolution);
+			obstacle_map.setNumberOfThreads(thread_numbers[t]);
+			obstacle_map.compute(&octomap, robot_states[k]);
+
+			std::map<Vertex,Cell> expected_map =
+					computeObstacleMap(octomap, robot_states[k], -0.6, 0.8, -0.7, 0.5);
+			const std::map<Vertex,Cell>& cells = obstacle_map.getObstacleMap();
+			BOOST_CHECK(!expected_map.empty());
+			BOOST_REQUIRE_EQUAL(cells.size(), expected_map.size());
+			std::map<Vertex,Cell>::const_iterator cell_it = cells.begin();
+			std::map<Vertex,Cell>::const_iterator expected_it = expected_map.begin();
+			for (; cell_it != cells.end(); ++cell_it, ++expected_it) {
+				BOOST_CHECK_EQUAL(cell_it->first, expected_it->first);
+				BOOST_CHECK_EQUAL(cell_it->second.key.x, expected_it->second.key.x);
+				BOOST_CHECK_EQUAL(cell_it->second.key.y, expected_it->second.key.y);
+				BOOST_CHECK_EQUAL(cell_it->second.key.z, expected_it->second.key.z);
+			}
+		}
+	}
+}
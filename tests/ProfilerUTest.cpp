@@ -0,0 +1,89 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/utils/Profiler.h>
+#include <thread>
+
+
+using namespace dwl;
+
+// Time of the innermost evaluations
+const double sleep_time = 0.002;
+
+
+/**
+ * Evaluates an outer scope that nests some inner scopes, and records a term evaluation per
+ * inner scope
+ */
+void evaluate(utils::Profiler& profiler,
+			  unsigned int num_inner)
+{
+	utils::Profiler::ScopedTimer timer(profiler, "cost");
+	for (unsigned int k = 0; k < num_inner; ++k) {
+		utils::Profiler::Clock::time_point started = profiler.tic();
+		{
+			utils::Profiler::ScopedTimer inner_timer(profiler, "gradient");
+			std::this_thread::sleep_for(std::chrono::duration<double>(sleep_time));
+		}
+		if (profiler.isEnabled())
+			profiler.addTermEvaluation("friction_cone", k, profiler.toc(started));
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(nested_scopes) // specify a test case for the nested evaluations
+{
+	// The disabled profiler doesn't record the evaluations
+	utils::Profiler profiler;
+	profiler.startSolve("test");
+	evaluate(profiler, 2);
+	profiler.stopSolve();
+	BOOST_CHECK(profiler.getReport().evaluations.empty());
+	BOOST_CHECK(profiler.getReport().terms.empty());
+
+	// Evaluating two outer scopes with three nested scopes each
+	profiler.enable();
+	profiler.startSolve("test");
+	evaluate(profiler, 3);
+	evaluate(profiler, 3);
+	profiler.stopSolve();
+
+	// Each scope counts its calls, and its time includes the one of its nested scopes
+	const utils::ProfileReport& report = profiler.getReport();
+	BOOST_CHECK_EQUAL(report.solver, "test");
+	BOOST_REQUIRE_EQUAL(report.evaluations.size(), 2);
+	const utils::EvaluationStatistics& cost = report.evaluations.find("cost")->second;
+	const utils::EvaluationStatistics& gradient = report.evaluations.find("gradient")->second;
+	BOOST_CHECK_EQUAL(cost.count, 2);
+	BOOST_CHECK_EQUAL(gradient.count, 6);
+	BOOST_CHECK(gradient.total_time >= 6 * sleep_time);
+	BOOST_CHECK(gradient.max_time >= sleep_time);
+	BOOST_CHECK(cost.total_time >= gradient.total_time);
+	BOOST_CHECK(cost.max_time >= 3 * sleep_time);
+	BOOST_CHECK(cost.max_time <= cost.total_time);
+	BOOST_CHECK_CLOSE(cost.getMeanTime(), cost.total_time / 2, 1e-9);
+	BOOST_CHECK(report.solve_time >= cost.total_time);
+
+	// The terms count the calls per knot
+	BOOST_REQUIRE_EQUAL(report.terms.size(), 1);
+	BOOST_CHECK_EQUAL(report.terms.find("friction_cone")->second.count, 6);
+	const std::vector<utils::EvaluationStatistics>& knots =
+			report.knots.find("friction_cone")->second;
+	BOOST_REQUIRE_EQUAL(knots.size(), 3);
+	double knot_time = 0.;
+	for (unsigned int k = 0; k < knots.size(); ++k) {
+		BOOST_CHECK_EQUAL(knots[k].count, 2);
+		knot_time += knots[k].total_time;
+	}
+	BOOST_CHECK_CLOSE(knot_time, report.terms.find("friction_cone")->second.total_time, 1e-9);
+	BOOST_CHECK(knot_time >= gradient.total_time);
+
+	// A new solve resets the report
+	profiler.startSolve("other");
+	evaluate(profiler, 1);
+	BOOST_CHECK_EQUAL(report.solver, "other");
+	BOOST_CHECK_EQUAL(report.evaluations.find("cost")->second.count, 1);
+	BOOST_CHECK_EQUAL(report.evaluations.find("gradient")->second.count, 1);
+	BOOST_CHECK_EQUAL(report.knots.find("friction_cone")->second.size(), 1);
+}
@@ -0,0 +1,210 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/RollingGrid.h>
+#include <model/TerrainSearchModel.h>
+#include <cstdlib>
+
+
+using namespace dwl;
+
+typedef std::map<std::pair<int,int>,TerrainCell> GridCellMap;
+
+
+/** Gets the values of a cell from its keys */
+TerrainCell getGridCell(int x,
+						int y)
+{
+	TerrainCell cell;
+	cell.cost = 0.01 * x + 0.001 * y;
+	cell.normal = Eigen::Vector3d(0.1 * (x % 3), 0.1 * (y % 5), 1.).normalized();
+	return cell;
+}
+
+/** Fills the cells of the window that aren't valid, i.e. the ones that entered it */
+void fillWindow(environment::RollingGrid& grid,
+				const GridCellMap& cells)
+{
+	for (int x = grid.getOriginX(); x < grid.getOriginX() + (int) grid.getWidth(); ++x) {
+		for (int y = grid.getOriginY(); y < grid.getOriginY() + (int) grid.getHeight(); ++y) {
+			unsigned int index;
+			BOOST_REQUIRE(grid.getIndex(index, x, y));
+			GridCellMap::const_iterator cell_it = cells.find(std::make_pair(x, y));
+			if (!grid.isValid(index) && cell_it != cells.end())
+				grid.setCell(index, cell_it->second, 0.5 * cell_it->second.cost);
+		}
+	}
+}
+
+/** Compares every cell of the window with the brute-force lookup of the cells */
+void checkWindow(const environment::RollingGrid& grid,
+				 const GridCellMap& cells)
+{
+	for (int x = grid.getOriginX(); x < grid.getOriginX() + (int) grid.getWidth(); ++x) {
+		for (int y = grid.getOriginY(); y < grid.getOriginY() + (int) grid.getHeight(); ++y) {
+			unsigned int index;
+			BOOST_REQUIRE(grid.getIndex(index, x, y));
+			GridCellMap::const_iterator cell_it = cells.find(std::make_pair(x, y));
+			BOOST_CHECK_EQUAL(grid.isValid(index), cell_it != cells.end());
+			if (cell_it == cells.end() || !grid.isValid(index))
+				continue;
+
+			BOOST_CHECK_SMALL(grid.getCost(index) - cell_it->second.cost, epsilon);
+			BOOST_CHECK_SMALL(grid.getHeight(index) - 0.5 * cell_it->second.cost, epsilon);
+			BOOST_CHECK_SMALL((grid.getNormal(index) - cell_it->second.normal).norm(), epsilon);
+			BOOST_CHECK(grid.getCell(index) == &cell_it->second);
+		}
+	}
+
+	// The keys outside the window haven't index
+	unsigned int index;
+	BOOST_CHECK(!grid.getIndex(index, grid.getOriginX() - 1, grid.getOriginY()));
+	BOOST_CHECK(!grid.getIndex(index, grid.getOriginX(),
+							   grid.getOriginY() + (int) grid.getHeight()));
+}
+
+
+BOOST_AUTO_TEST_CASE(window_motion) // specify a test case for the motion of the ring buffer
+{
+	// Cells of a terrain with some holes
+	srand(0);
+	GridCellMap cells;
+	for (int x = 950; x < 1100; ++x) {
+		for (int y = 1950; y < 2100; ++y) {
+			if (rand() % 7 != 0)
+				cells[std::make_pair(x, y)] = getGridCell(x, y);
+		}
+	}
+
+	environment::RollingGrid grid;
+	grid.resize(13, 9);
+	grid.moveTo(1000, 2000);
+	fillWindow(grid, cells);
+	checkWindow(grid, cells);
+
+	// Moving the window along a random walk, which includes diagonal and big steps. The cells
+	// that stayed in the window keep their values, and the ones that entered it are cleared
+	for (unsigned int i = 0; i < 100; ++i) {
+		int step = rand() % 10 == 0 ? 20 : 4;
+		int origin_x = grid.getOriginX() + rand() % (2 * step + 1) - step;
+		int origin_y = grid.getOriginY() + rand() % (2 * step + 1) - step;
+		origin_x = std::min(std::max(origin_x, 960), 1080);
+		origin_y = std::min(std::max(origin_y, 1960), 2080);
+		int old_origin_x = grid.getOriginX(), old_origin_y = grid.getOriginY();
+		grid.moveTo(origin_x, origin_y);
+
+		for (int x = origin_x; x < origin_x + (int) grid.getWidth(); ++x) {
+			for (int y = origin_y; y < origin_y + (int) grid.getHeight(); ++y) {
+				bool stayed = x >= old_origin_x && x < old_origin_x + (int) grid.getWidth() &&
+						y >= old_origin_y && y < old_origin_y + (int) grid.getHeight();
+				unsigned int index;
+				BOOST_REQUIRE(grid.getIndex(index, x, y));
+				if (!stayed)
+					BOOST_CHECK(!grid.isValid(index));
+			}
+		}
+
+		fillWindow(grid, cells);
+		checkWindow(grid, cells);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(terrain_window) // specify a test case for the window of the terrain map
+{
+	environment::TerrainMap terrain;
+	model::buildTerrain(terrain, true);
+	terrain.setTerrainWindow(0.3);
+	const environment::RollingGrid& grid = terrain.getTerrainWindow();
+	BOOST_REQUIRE(grid.isEnabled());
+	const environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+
+	// Moving the window across the terrain, and beyond it, while the terrain changes
+	for (unsigned int i = 0; i < 30; ++i) {
+		Eigen::Vector2d position(0.05 * i, 0.4 + 0.3 * sin(0.5 * i));
+		terrain.moveTerrainWindow(position);
+
+		TerrainCell cell = model::createCell(i % num_cells, (3 * i) % num_cells, 2. + i);
+		if (i % 4 == 3) {
+			Vertex vertex;
+			space_model.keyToVertex(vertex, cell.key, true);
+			terrain.removeCellToTerrainMap(vertex);
+		} else
+			terrain.addCellToTerrainMap(cell);
+
+		// Comparing the window cells with the cells of the terrain map
+		for (int x = grid.getOriginX(); x < grid.getOriginX() + (int) grid.getWidth(); ++x) {
+			for (int y = grid.getOriginY(); y < grid.getOriginY() + (int) grid.getHeight(); ++y) {
+				Key key;
+				key.x = x;
+				key.y = y;
+				Vertex vertex;
+				space_model.keyToVertex(vertex, key, true);
+				TerrainDataMap::const_iterator cell_it = terrain.getTerrainDataMap().find(vertex);
+				const TerrainCell* terrain_cell = NULL;
+				if (cell_it != terrain.getTerrainDataMap().end())
+					terrain_cell = &cell_it->second;
+
+				// The cells inside the window are found in the window
+				unsigned int index;
+				BOOST_REQUIRE(grid.getIndex(index, x, y));
+				BOOST_CHECK_EQUAL(grid.isValid(index), terrain_cell != NULL);
+				BOOST_CHECK(terrain.findTerrainCell(vertex) == terrain_cell);
+				BOOST_CHECK_EQUAL(terrain.isTerrainCell(vertex), terrain_cell != NULL);
+				if (terrain_cell == NULL || !grid.isValid(index))
+					continue;
+
+				BOOST_CHECK(&terrain.getTerrainData(vertex) == terrain_cell);
+				double height;
+				space_model.keyToCoord(height, terrain_cell->key.z, false);
+				BOOST_CHECK_SMALL(grid.getCost(index) - terrain_cell->cost, epsilon);
+				BOOST_CHECK_SMALL(grid.getHeight(index) - height, epsilon);
+				BOOST_CHECK_SMALL((grid.getNormal(index) - terrain_cell->normal).norm(), epsilon);
+				BOOST_CHECK_SMALL(terrain.getTerrainCost(vertex) - terrain_cell->cost, epsilon);
+			}
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(window_key_range) // specify a test case for the window at the key range
+{
+	// Cells at both borders of the key range (+-1310.72 m)
+	environment::TerrainMap terrain;
+	const environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	TerrainCell cell = model::createCell(0, 0, 1.);
+	cell.key.x = 65535;
+	cell.key.y = 65530;
+	terrain_data.data.push_back(cell);
+	cell.key.x = 2;
+	cell.key.y = 0;
+	terrain_data.data.push_back(cell);
+	terrain.setTerrainMap(terrain_data);
+	terrain.setTerrainWindow(0.4);
+	const environment::RollingGrid& grid = terrain.getTerrainWindow();
+	BOOST_REQUIRE(grid.isEnabled());
+
+	// The window is clamped to the key range, so it contains the cells of the borders
+	Eigen::Vector2d positions[] = {Eigen::Vector2d(1310.7, 1310.5),
+								   Eigen::Vector2d(-1310.7, -1310.72)};
+	Key keys[] = {Key(65535, 65530, 0), Key(2, 0, 0)};
+	for (unsigned int i = 0; i < 2; ++i) {
+		terrain.moveTerrainWindow(positions[i]);
+		BOOST_CHECK(grid.getOriginX() >= 0);
+		BOOST_CHECK(grid.getOriginY() >= 0);
+		BOOST_CHECK(grid.getOriginX() + grid.getWidth() <= 65536);
+		BOOST_CHECK(grid.getOriginY() + grid.getHeight() <= 65536);
+
+		Vertex vertex;
+		space_model.keyToVertex(vertex, keys[i], true);
+		unsigned int index;
+		BOOST_REQUIRE(grid.getIndex(index, keys[i].x, keys[i].y));
+		BOOST_CHECK(grid.isValid(index));
+		BOOST_REQUIRE(terrain.findTerrainCell(vertex) != NULL);
+		BOOST_CHECK_EQUAL(terrain.findTerrainCell(vertex)->key.x, keys[i].x);
+	}
+}
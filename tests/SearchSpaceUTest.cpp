@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/solver/SearchSpace.h>
+
+
+using namespace dwl;
+
+
+BOOST_AUTO_TEST_CASE(capacity) // specify a test case for the dense indexes kept between searches
+{
+	solver::SearchSpace search_space;
+	search_space.setCapacity(100);
+
+	// The dense indexes inside the capacity are kept, but the vertexes are unvisited
+	for (Vertex v = 0; v < 80; ++v)
+		search_space.setCost(search_space.getIndex(1000 + v), v);
+	search_space.reset();
+	BOOST_CHECK_EQUAL(search_space.size(), 80);
+	unsigned int index;
+	BOOST_CHECK(!search_space.find(index, 1000));
+	BOOST_CHECK_EQUAL(search_space.getIndex(1005), 5);
+	BOOST_CHECK_EQUAL(search_space.getCost(5), std::numeric_limits<Weight>::max());
+
+	// A search touches other vertexes, so the dense indexes exceed the capacity, and they are
+	// released when the next search starts
+	for (Vertex v = 0; v < 50; ++v)
+		search_space.getIndex(5000 + v);
+	BOOST_CHECK_EQUAL(search_space.size(), 130);
+	search_space.reset();
+	BOOST_CHECK_EQUAL(search_space.size(), 0);
+	BOOST_CHECK(!search_space.find(index, 5000));
+
+	// The next search starts from the first dense index
+	unsigned int source_idx = search_space.getIndex(5000);
+	unsigned int target_idx = search_space.getIndex(1000);
+	BOOST_CHECK_EQUAL(source_idx, 0);
+	BOOST_CHECK_EQUAL(target_idx, 1);
+	BOOST_CHECK_EQUAL(search_space.getCost(target_idx), std::numeric_limits<Weight>::max());
+	search_space.setCost(source_idx, 0.);
+	search_space.setParent(target_idx, source_idx);
+	search_space.close(source_idx);
+	BOOST_CHECK(search_space.isClosed(source_idx));
+	BOOST_CHECK(!search_space.isClosed(target_idx));
+
+	std::list<Vertex> path;
+	search_space.getPath(path, 5000, 1000);
+	BOOST_REQUIRE_EQUAL(path.size(), 2);
+	BOOST_CHECK_EQUAL(path.front(), 5000);
+	BOOST_CHECK_EQUAL(path.back(), 1000);
+
+	// Without capacity, the dense indexes are kept
+	search_space.setCapacity(0);
+	for (Vertex v = 0; v < 200; ++v)
+		search_space.getIndex(v);
+	search_space.reset();
+	BOOST_CHECK_EQUAL(search_space.size(), 202);
+}
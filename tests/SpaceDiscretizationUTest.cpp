@@ -0,0 +1,179 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/SpaceDiscretization.h>
+#include <cstdlib>
+
+
+using namespace dwl;
+
+const double epsilon = 1e-9;
+
+
+/** Gets a random number inside the [min, max) interval */
+double getRandom(double min,
+				 double max)
+{
+	return min + (max - min) * ((double) rand() / ((double) RAND_MAX + 1.));
+}
+
+/** Computes the key of a coordinate with the floating-point formula */
+unsigned short int getKey(double coordinate,
+						  double resolution)
+{
+	return (unsigned short int) (floor(coordinate / resolution) + 32768);
+}
+
+
+BOOST_AUTO_TEST_CASE(environment_vertex) // specify a test case for the environment vertexes
+{
+	srand(0);
+	environment::SpaceDiscretization space_discretization(0.04);
+	space_discretization.setEnvironmentResolution(0.02, false);
+
+	for (unsigned int i = 0; i < 10000; ++i) {
+		Eigen::Vector3d coord(getRandom(-500., 500.), getRandom(-500., 500.),
+							  getRandom(-200., 200.));
+
+		// The keys are the ones of the floating-point formula
+		Key key;
+		BOOST_REQUIRE(space_discretization.coordToKeyChecked(key, coord));
+		BOOST_CHECK_EQUAL(key.x, getKey(coord(rbd::X), 0.04));
+		BOOST_CHECK_EQUAL(key.y, getKey(coord(rbd::Y), 0.04));
+		BOOST_CHECK_EQUAL(key.z, getKey(coord(rbd::Z), 0.02));
+
+		// The vertexes count the keys with a key count of 2^16
+		Vertex vertex_3d, vertex_2d;
+		Vertex max_key_count = 65536;
+		space_discretization.coordToVertex(vertex_3d, coord);
+		space_discretization.coordToVertex(vertex_2d, (Eigen::Vector2d) coord.head(2));
+		BOOST_CHECK_EQUAL(vertex_3d, key.z + max_key_count * key.y +
+						  max_key_count * max_key_count * key.x);
+		BOOST_CHECK_EQUAL(vertex_2d, key.y + max_key_count * key.x);
+
+		// The vertexes are decoded into the cell centers of the coordinate
+		Eigen::Vector3d center_3d;
+		Eigen::Vector2d center_2d;
+		space_discretization.vertexToCoord(center_3d, vertex_3d);
+		space_discretization.vertexToCoord(center_2d, vertex_2d);
+		BOOST_CHECK_SMALL(center_3d(rbd::X) - (floor(coord(rbd::X) / 0.04) + 0.5) * 0.04, epsilon);
+		BOOST_CHECK_SMALL(center_3d(rbd::Y) - (floor(coord(rbd::Y) / 0.04) + 0.5) * 0.04, epsilon);
+		BOOST_CHECK_SMALL(center_3d(rbd::Z) - (floor(coord(rbd::Z) / 0.02) + 0.5) * 0.02, epsilon);
+		BOOST_CHECK_SMALL((center_2d - center_3d.head(2)).norm(), epsilon);
+
+		// The cell centers are mapped to the same vertexes
+		Vertex center_vertex;
+		space_discretization.coordToVertex(center_vertex, center_3d);
+		BOOST_CHECK_EQUAL(center_vertex, vertex_3d);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(state_vertex) // specify a test case for the state vertexes
+{
+	srand(1);
+	double angular_resolution = M_PI / 36;
+	environment::SpaceDiscretization space_discretization(0.04, 0.08, angular_resolution);
+
+	for (unsigned int i = 0; i < 10000; ++i) {
+		Eigen::Vector3d state(getRandom(-500., 500.), getRandom(-500., 500.),
+							  getRandom(-M_PI, M_PI));
+
+		// The (x,y,yaw) vertex is decoded into the discretized state
+		Vertex vertex;
+		Eigen::Vector3d discrete_state;
+		space_discretization.stateToVertex(vertex, state);
+		space_discretization.vertexToState(discrete_state, vertex);
+		BOOST_CHECK_SMALL(discrete_state(rbd::X) -
+						  (floor(state(rbd::X) / 0.08) + 0.5) * 0.08, epsilon);
+		BOOST_CHECK_SMALL(discrete_state(rbd::Y) -
+						  (floor(state(rbd::Y) / 0.08) + 0.5) * 0.08, epsilon);
+		double yaw = state(rbd::Z) < 0. ? state(rbd::Z) + 2 * M_PI : state(rbd::Z);
+		BOOST_CHECK_SMALL(discrete_state(rbd::Z) -
+						  floor(yaw / angular_resolution) * angular_resolution, epsilon);
+
+		// Neighbouring states have different vertexes
+		Vertex neighbour_vertex;
+		Eigen::Vector3d neighbour_state = discrete_state;
+		neighbour_state(rbd::Y) += 0.08;
+		space_discretization.stateToVertex(neighbour_vertex, neighbour_state);
+		BOOST_CHECK(neighbour_vertex != vertex);
+
+		// The (x,y) vertex is decoded into the discretized position
+		Vertex vertex_2d;
+		Eigen::Vector2d discrete_position;
+		space_discretization.stateToVertex(vertex_2d, (Eigen::Vector2d) state.head(2));
+		space_discretization.vertexToState(discrete_position, vertex_2d);
+		BOOST_CHECK_SMALL((discrete_position - discrete_state.head(2)).norm(), epsilon);
+
+		// The state vertex is mapped to the environment vertex of its position
+		Vertex environment_vertex, expected_vertex;
+		space_discretization.stateVertexToEnvironmentVertex(environment_vertex, vertex, XY_Y);
+		space_discretization.coordToVertex(expected_vertex,
+										   (Eigen::Vector2d) discrete_state.head(2));
+		BOOST_CHECK_EQUAL(environment_vertex, expected_vertex);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(batch_conversion) // specify a test case for the batch conversions
+{
+	srand(2);
+	environment::SpaceDiscretization space_discretization(0.04);
+	space_discretization.setEnvironmentResolution(0.02, false);
+
+	const unsigned int num_coords = 1000;
+	std::vector<double> heights(num_coords);
+	std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d> > coords(num_coords);
+	for (unsigned int i = 0; i < num_coords; ++i) {
+		heights[i] = getRandom(-200., 200.);
+		coords[i] << getRandom(-500., 500.), getRandom(-500., 500.);
+	}
+
+	// Some coordinates are out of the key range (+-1310.72 m)
+	coords[0] << 2000., 0.;
+	coords[1] << 0., -1500.;
+	coords[2] << -3000., 5000.;
+	Key key;
+	BOOST_CHECK(!space_discretization.coordToKeyChecked(key.x, 2000., true));
+	BOOST_CHECK(!space_discretization.coordToKeyChecked(key.y, -1500., true));
+
+	// The batch conversions are the same as the single ones
+	std::vector<unsigned short int> keys(num_coords);
+	std::vector<Vertex> vertices(num_coords);
+	space_discretization.coordToKey(keys.data(), heights.data(), num_coords, false);
+	space_discretization.coordToVertex(vertices.data(), coords.data(), num_coords);
+	for (unsigned int i = 0; i < num_coords; ++i) {
+		unsigned short int key;
+		Vertex vertex;
+		space_discretization.coordToKey(key, heights[i], false);
+		space_discretization.coordToVertex(vertex, coords[i]);
+		BOOST_CHECK_EQUAL(keys[i], key);
+		BOOST_CHECK_EQUAL(keys[i], getKey(heights[i], 0.02));
+		BOOST_CHECK_EQUAL(vertices[i], vertex);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(undefined_state_resolution) // specify a test case for the state resolutions
+{
+	// The state resolutions aren't defined, so the conversions don't change the keys and states
+	environment::SpaceDiscretization space_discretization(0.04);
+	unsigned short int key = 7;
+	space_discretization.stateToKey(key, 1., false);
+	BOOST_CHECK_EQUAL(key, 7);
+	space_discretization.stateToKey(key, 1., true);
+	BOOST_CHECK_EQUAL(key, 7);
+
+	double state = 0.5;
+	space_discretization.keyToState(state, 10, false);
+	BOOST_CHECK_EQUAL(state, 0.5);
+
+	// Defining the angular resolution
+	space_discretization.setStateResolution(0.04, M_PI / 8);
+	space_discretization.stateToKey(key, M_PI / 4 + epsilon, false);
+	BOOST_CHECK_EQUAL(key, 2);
+	space_discretization.keyToState(state, 2, false);
+	BOOST_CHECK_CLOSE(state, M_PI / 4, epsilon);
+}
@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/TerrainCostPipeline.h>
+#include <dwl/environment/CurvatureFeature.h>
+#include <dwl/environment/HeightDeviationFeature.h>
+#include <model/TerrainSearchModel.h>
+
+
+using namespace dwl;
+
+// Curved patch of the terrain, i.e. its cells have curvature
+const unsigned int min_patch = 5, max_patch = 10;
+
+bool isPatchCell(unsigned int i,
+				 unsigned int j)
+{
+	return i >= min_patch && i < max_patch && j >= min_patch && j < max_patch;
+}
+
+void buildCurvedTerrain(environment::TerrainMap& terrain)
+{
+	TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	for (unsigned int i = 0; i < num_cells; ++i) {
+		for (unsigned int j = 0; j < num_cells; ++j) {
+			TerrainCell cell = model::createCell(i, j, 1.);
+			if (isPatchCell(i, j))
+				cell.curvature = 0.02;
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+}
+
+
+BOOST_AUTO_TEST_CASE(curvature_feature) // specify a test case for the curvature of the map path
+{
+	environment::TerrainMap terrain;
+	buildCurvedTerrain(terrain);
+	Eigen::Vector2d min_corner(0., 0.);
+	Eigen::Vector2d max_corner((num_cells - 1) * resolution, (num_cells - 1) * resolution);
+
+	// The terrain grid has the curvatures of the terrain cells
+	TerrainGrid grid;
+	terrain.getTerrainGrid(grid, min_corner, max_corner);
+	BOOST_REQUIRE(grid.width == num_cells && grid.height == num_cells);
+	for (unsigned int j = 0; j < num_cells; ++j) {
+		for (unsigned int i = 0; i < num_cells; ++i) {
+			double curvature = grid.curvatures[j * grid.width + i];
+			BOOST_CHECK(isPatchCell(i, j) ? curvature > 0. : curvature == 0.);
+		}
+	}
+
+	// Computing the curvature cost of the map, and comparing it with the per-cell cost
+	environment::CurvatureFeature feature;
+	environment::TerrainCostPipeline pipeline;
+	pipeline.addFeature(&feature);
+	BOOST_REQUIRE(pipeline.computeCost(terrain, min_corner, max_corner));
+
+	const environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	for (unsigned int j = 0; j < num_cells; ++j) {
+		for (unsigned int i = 0; i < num_cells; ++i) {
+			TerrainCell expected_cell = model::createCell(i, j, 0.);
+			Vertex vertex;
+			space_model.keyToVertex(vertex, expected_cell.key, true);
+			const TerrainCell* cell = terrain.findTerrainCell(vertex);
+			BOOST_REQUIRE(cell != NULL);
+
+			Terrain terrain_info;
+			terrain_info.curvature = cell->curvature;
+			double expected_cost;
+			feature.computeCost(expected_cost, terrain_info);
+			BOOST_CHECK_CLOSE(cell->cost + 1., expected_cost + 1., epsilon);
+			BOOST_CHECK(isPatchCell(i, j) ? cell->cost > 0. : cell->cost == 0.);
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(height_deviation_feature) // specify a test case for the height deviation
+{
+	// Terrain grid with a rough surface and some cells without terrain information
+	TerrainGrid grid;
+	grid.width = 23;
+	grid.height = 17;
+	grid.resolution = resolution;
+	unsigned int num_grid_cells = grid.width * grid.height;
+	grid.heights.resize(num_grid_cells);
+	grid.valid.resize(num_grid_cells);
+	for (unsigned int i = 0; i < num_grid_cells; ++i) {
+		grid.heights[i] = 0.05 * sin(0.7 * i) + 0.02 * cos(1.3 * i);
+		grid.valid[i] = i % 7 != 3;
+	}
+
+	// Evaluating the feature in tiles of a few rows
+	environment::HeightDeviationFeature feature;
+	feature.setWeight(1.);
+	feature.setNeighboringArea(-0.12, 0.08, -0.04, 0.16, resolution);
+	feature.setMaximumDeviation(0.2);
+	environment::TerrainCostPipeline pipeline;
+	pipeline.addFeature(&feature);
+	pipeline.setTileSize(3);
+	std::vector<double> cost_values;
+	pipeline.computeCost(cost_values, grid);
+
+	// Comparing with the brute-force average of the neighboring areas
+	for (int row = 0; row < (int) grid.height; ++row) {
+		for (int col = 0; col < (int) grid.width; ++col) {
+			double height_sum = 0.;
+			unsigned int num_valid = 0;
+			for (int y = row - 1; y <= row + 4; ++y) {
+				for (int x = col - 3; x <= col + 2; ++x) {
+					if (x < 0 || y < 0 || x >= (int) grid.width || y >= (int) grid.height)
+						continue;
+
+					unsigned int index = y * grid.width + x;
+					if (grid.valid[index]) {
+						height_sum += grid.heights[index];
+						num_valid++;
+					}
+				}
+			}
+
+			double expected_cost = 0.;
+			if (num_valid != 0) {
+				double deviation =
+						fabs(grid.heights[row * grid.width + col] - height_sum / num_valid);
+				expected_cost = std::min(10. * deviation / 0.2, 10.);
+			}
+			BOOST_CHECK_CLOSE(cost_values[row * grid.width + col] + 1.,
+							  expected_cost + 1., epsilon);
+		}
+	}
+}
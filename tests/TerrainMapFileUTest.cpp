@@ -0,0 +1,327 @@
+#include <dwl/environment/TerrainMapFile.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <fstream>
+#include <iterator>
+
+
+
+// Tolerance
+double epsilon = 0.00001;
+
+// Snapshot files of the tests
+std::string filename = "terrain_map_utest.bin";
+std::string corrupted_filename = "terrain_map_utest_corrupted.bin";
+
+/**
+ * Builds a terrain with scattered cells and holes, and an obstacle map with other resolution
+ */
+void buildTerrain(dwl::environment::TerrainMap& terrain)
+{
+	dwl::environment::SpaceDiscretization space_model(0.04);
+	space_model.setEnvironmentResolution(0.02, false);
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = 0.04;
+	terrain_data.height_size = 0.02;
+	for (unsigned int i = 0; i < 70; ++i) {
+		for (unsigned int j = 0; j < 45; ++j) {
+			if ((i * 7 + j * 3) % 5 == 0)
+				continue;
+
+			double height = 0.3 * sin(0.2 * i) * cos(0.1 * j);
+			dwl::TerrainCell cell;
+			space_model.coordToKeyChecked(cell.key,
+					Eigen::Vector3d(-1. + i * 0.04, 0.5 + j * 0.04, height));
+			cell.cost = 1. + 0.5 * cos(0.3 * i + j);
+			cell.height = height;
+			cell.normal = Eigen::Vector3d(0.1 * sin(i), 0.1 * cos(j), 1.).normalized();
+			cell.curvature = 0.01 * (i % 4);
+			terrain_data.data.push_back(cell);
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+
+	dwl::environment::SpaceDiscretization obstacle_model(0.08);
+	std::vector<dwl::Cell> obstacles;
+	for (unsigned int i = 0; i < 20; ++i) {
+		dwl::Cell cell;
+		cell.plane_size = 0.08;
+		cell.height_size = 0.08;
+		obstacle_model.coordToKeyChecked(cell.key, Eigen::Vector3d(i * 0.08, 1., 0.));
+		obstacles.push_back(cell);
+	}
+	terrain.setObstacleMap(obstacles);
+}
+
+bool isSameCell(const dwl::TerrainCell& cell1,
+				const dwl::TerrainCell& cell2)
+{
+	return cell1.key.x == cell2.key.x && cell1.key.y == cell2.key.y &&
+			cell1.key.z == cell2.key.z && fabs(cell1.cost - cell2.cost) < epsilon &&
+			fabs(cell1.height - cell2.height) < epsilon &&
+			(cell1.normal - cell2.normal).norm() < epsilon &&
+			fabs(cell1.curvature - cell2.curvature) < epsilon;
+}
+
+/**
+ * Writes a copy of the first bytes of the snapshot, where some bytes are replaced
+ */
+void writeModifiedFile(const std::vector<char>& data,
+					   size_t size,
+					   size_t offset,
+					   const void* value,
+					   size_t value_size)
+{
+	std::vector<char> modified_data(data.begin(), data.begin() + size);
+	if (value_size != 0)
+		memcpy(&modified_data[offset], value, value_size);
+
+	std::ofstream file(corrupted_filename.c_str(), std::ios::binary | std::ios::trunc);
+	file.write(modified_data.data(), modified_data.size());
+}
+
+/**
+ * Checks that the modified copy of the snapshot isn't opened
+ */
+void checkCorruptedFile(const std::vector<char>& data,
+						size_t size,
+						size_t offset,
+						const void* value,
+						size_t value_size)
+{
+	writeModifiedFile(data, size, offset, value, value_size);
+
+	dwl::environment::TerrainMapFile map_file;
+	BOOST_CHECK(!map_file.open(corrupted_filename));
+	BOOST_CHECK(!map_file.isOpen());
+}
+
+BOOST_AUTO_TEST_CASE(round_trip) // specify a test case for writing and reading snapshots
+{
+	dwl::environment::TerrainMap terrain;
+	buildTerrain(terrain);
+
+	dwl::environment::TerrainMapFile map_file;
+	BOOST_CHECK(map_file.write(filename, terrain, 16));
+	BOOST_CHECK(map_file.open(filename));
+	BOOST_CHECK_EQUAL(map_file.getNumberOfTilesX(), 5);
+	BOOST_CHECK_EQUAL(map_file.getNumberOfTilesY(), 3);
+
+	// Loading the whole snapshot
+	dwl::environment::TerrainMap loaded_terrain;
+	BOOST_CHECK(map_file.load(loaded_terrain));
+	const dwl::TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	const dwl::TerrainDataMap& loaded_map = loaded_terrain.getTerrainDataMap();
+	BOOST_CHECK_EQUAL(loaded_map.size(), terrain_map.size());
+	for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		dwl::TerrainDataMap::const_iterator loaded_it = loaded_map.find(cell_it->first);
+		BOOST_CHECK(loaded_it != loaded_map.end() &&
+				isSameCell(loaded_it->second, cell_it->second));
+
+		// Reading the cell from the mapped snapshot
+		dwl::TerrainCell cell;
+		BOOST_CHECK(map_file.getTerrainCell(cell, cell_it->first));
+		BOOST_CHECK(isSameCell(cell, cell_it->second));
+	}
+
+	const dwl::ObstacleMap& obstacle_map = terrain.getObstacleMap();
+	const dwl::ObstacleMap& loaded_obstacles = loaded_terrain.getObstacleMap();
+	BOOST_CHECK_EQUAL(loaded_obstacles.size(), obstacle_map.size());
+	for (dwl::ObstacleMap::const_iterator obs_it = obstacle_map.begin();
+			obs_it != obstacle_map.end(); ++obs_it)
+		BOOST_CHECK(loaded_obstacles.find(obs_it->first) != loaded_obstacles.end());
+	BOOST_CHECK_SMALL(loaded_terrain.getObstacleSpaceModel().getEnvironmentResolution(true) - 0.08,
+					  epsilon);
+
+	// The vertexes outside the snapshot aren't terrain cells
+	dwl::TerrainCell cell;
+	BOOST_CHECK(!map_file.getTerrainCell(cell, 0));
+	map_file.close();
+	BOOST_CHECK(!map_file.isOpen());
+
+	// The tile size is bounded
+	BOOST_CHECK(map_file.write(filename, terrain, 256));
+	BOOST_CHECK(!map_file.write(filename, terrain, 257));
+	BOOST_CHECK(!map_file.write(filename, terrain, 0));
+}
+
+
+BOOST_AUTO_TEST_CASE(region_replace) // specify a test case for replacing the loaded region
+{
+	dwl::environment::TerrainMap terrain;
+	buildTerrain(terrain);
+
+	dwl::environment::TerrainMapFile map_file;
+	BOOST_CHECK(map_file.write(filename, terrain, 16));
+	BOOST_CHECK(map_file.open(filename));
+
+	// Starting from the whole snapshot and a cell that isn't in the snapshot
+	dwl::environment::TerrainMap loaded_terrain;
+	BOOST_CHECK(map_file.load(loaded_terrain));
+	dwl::TerrainCell stale_cell = terrain.getTerrainDataMap().begin()->second;
+	stale_cell.key.x = 10;
+	loaded_terrain.addCellToTerrainMap(stale_cell);
+
+	// Moving the region, i.e. the terrain map only has the cells and obstacles of the region
+	const dwl::environment::SpaceDiscretization& space_model = terrain.getTerrainSpaceModel();
+	const dwl::environment::SpaceDiscretization& obstacle_model = terrain.getObstacleSpaceModel();
+	for (unsigned int k = 0; k < 3; ++k) {
+		Eigen::Vector2d min_corner(-0.9 + 0.35 * k, 0.6 + 0.2 * k);
+		Eigen::Vector2d max_corner(min_corner(0) + 0.8, min_corner(1) + 0.9);
+		BOOST_CHECK(map_file.loadRegion(loaded_terrain, min_corner, max_corner, true));
+
+		unsigned short int min_x, min_y, max_x, max_y;
+		space_model.coordToKey(min_x, min_corner(0), true);
+		space_model.coordToKey(min_y, min_corner(1), true);
+		space_model.coordToKey(max_x, max_corner(0), true);
+		space_model.coordToKey(max_y, max_corner(1), true);
+		const dwl::TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+		const dwl::TerrainDataMap& loaded_map = loaded_terrain.getTerrainDataMap();
+		unsigned int num_cells = 0;
+		for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+				cell_it != terrain_map.end(); ++cell_it) {
+			const dwl::Key& key = cell_it->second.key;
+			if (key.x < min_x || key.x > max_x || key.y < min_y || key.y > max_y)
+				continue;
+
+			dwl::TerrainDataMap::const_iterator loaded_it = loaded_map.find(cell_it->first);
+			BOOST_CHECK(loaded_it != loaded_map.end() &&
+					isSameCell(loaded_it->second, cell_it->second));
+			num_cells++;
+		}
+		BOOST_CHECK(num_cells > 0);
+		BOOST_CHECK_EQUAL(loaded_map.size(), num_cells);
+
+		obstacle_model.coordToKey(min_x, min_corner(0), true);
+		obstacle_model.coordToKey(min_y, min_corner(1), true);
+		obstacle_model.coordToKey(max_x, max_corner(0), true);
+		obstacle_model.coordToKey(max_y, max_corner(1), true);
+		const dwl::ObstacleMap& obstacle_map = terrain.getObstacleMap();
+		const dwl::ObstacleMap& loaded_obstacles = loaded_terrain.getObstacleMap();
+		unsigned int num_obstacles = 0;
+		for (dwl::ObstacleMap::const_iterator obs_it = obstacle_map.begin();
+				obs_it != obstacle_map.end(); ++obs_it) {
+			dwl::Key key;
+			obstacle_model.vertexToKey(key, obs_it->first, true);
+			if (key.x < min_x || key.x > max_x || key.y < min_y || key.y > max_y)
+				continue;
+
+			BOOST_CHECK(loaded_obstacles.find(obs_it->first) != loaded_obstacles.end());
+			num_obstacles++;
+		}
+		BOOST_CHECK_EQUAL(loaded_obstacles.size(), num_obstacles);
+	}
+
+	// Loading a region without replacing keeps the other cells
+	unsigned int num_cells = loaded_terrain.getTerrainDataMap().size();
+	BOOST_CHECK(map_file.loadRegion(loaded_terrain, Eigen::Vector2d(-1., 0.5),
+									Eigen::Vector2d(-0.8, 0.7)));
+	BOOST_CHECK(loaded_terrain.getTerrainDataMap().size() > num_cells);
+}
+
+
+BOOST_AUTO_TEST_CASE(corrupted_files) // specify a test case for rejecting invalid snapshots
+{
+	dwl::environment::TerrainMap terrain;
+	buildTerrain(terrain);
+
+	dwl::environment::TerrainMapFile map_file;
+	BOOST_CHECK(map_file.write(filename, terrain, 16));
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	std::vector<char> data((std::istreambuf_iterator<char>(file)),
+						   std::istreambuf_iterator<char>());
+
+	// The copy without changes is a valid snapshot
+	writeModifiedFile(data, data.size(), 0, NULL, 0);
+	BOOST_CHECK(map_file.open(corrupted_filename));
+	map_file.close();
+
+	// Truncating the header, the table of tiles, the obstacles and the last tile
+	checkCorruptedFile(data, 40, 0, NULL, 0);
+	checkCorruptedFile(data, 120, 0, NULL, 0);
+	checkCorruptedFile(data, 400, 0, NULL, 0);
+	checkCorruptedFile(data, data.size() - 1, 0, NULL, 0);
+
+	// Modifying the header fields. The layout of the header is: magic (0), version (8), byte
+	// order (12), tile size (16), resolutions (24), origin (56), number of tiles (64), number
+	// of cells (72), number of obstacles (80) and obstacles offset (88). The table of tiles
+	// starts at 96, where each tile has an offset and a number of cells
+	uint32_t swapped_byte_order = 0x04030201;
+	checkCorruptedFile(data, data.size(), 12, &swapped_byte_order, sizeof(uint32_t));
+	uint32_t big_value = 0xFFFFFFFF;
+	checkCorruptedFile(data, data.size(), 16, &big_value, sizeof(uint32_t));
+	checkCorruptedFile(data, data.size(), 64, &big_value, sizeof(uint32_t));
+	checkCorruptedFile(data, data.size(), 68, &big_value, sizeof(uint32_t));
+	uint64_t huge_value = 0xFFFFFFFFFFFFFFF0;
+	checkCorruptedFile(data, data.size(), 72, &huge_value, sizeof(uint64_t));
+	checkCorruptedFile(data, data.size(), 80, &huge_value, sizeof(uint64_t));
+	checkCorruptedFile(data, data.size(), 88, &huge_value, sizeof(uint64_t));
+	uint64_t obstacles_offset;
+	memcpy(&obstacles_offset, &data[88], sizeof(uint64_t));
+	uint64_t misaligned_offset = obstacles_offset + 4;
+	checkCorruptedFile(data, data.size(), 88, &misaligned_offset, sizeof(uint64_t));
+
+	// Modifying the origin, where the last tiles exceed the key range and their keys wrap
+	int32_t wrapped_origin = 65535;
+	checkCorruptedFile(data, data.size(), 56, &wrapped_origin, sizeof(int32_t));
+	checkCorruptedFile(data, data.size(), 60, &wrapped_origin, sizeof(int32_t));
+
+	// Modifying the first tile, i.e. an overflowed number of cells, and an offset that is
+	// misaligned, outside the file or overlapping the obstacles
+	checkCorruptedFile(data, data.size(), 104, &huge_value, sizeof(uint64_t));
+	uint64_t tile_offset;
+	memcpy(&tile_offset, &data[96], sizeof(uint64_t));
+	uint64_t tile_offsets[] = {tile_offset + 4, huge_value, obstacles_offset};
+	for (unsigned int i = 0; i < 3; ++i)
+		checkCorruptedFile(data, data.size(), 96, &tile_offsets[i], sizeof(uint64_t));
+}
+
+
+BOOST_AUTO_TEST_CASE(key_range) // specify a test case for the cells at the end of the key range
+{
+	// Building a terrain whose last cells have the maximum keys
+	dwl::environment::SpaceDiscretization space_model(0.04);
+	dwl::TerrainData terrain_data;
+	terrain_data.plane_size = 0.04;
+	terrain_data.height_size = 0.04;
+	for (unsigned int i = 0; i < 20; ++i) {
+		for (unsigned int j = 0; j < 20; ++j) {
+			dwl::TerrainCell cell;
+			cell.key.x = 65535 - i;
+			cell.key.y = 65535 - j;
+			cell.key.z = 32768;
+			cell.cost = 1. + 0.1 * i;
+			space_model.keyToCoord(cell.height, cell.key.z, false);
+			cell.normal = Eigen::Vector3d::UnitZ();
+			terrain_data.data.push_back(cell);
+		}
+	}
+	dwl::environment::TerrainMap terrain;
+	terrain.setTerrainMap(terrain_data);
+
+	// The tiles are shifted inside the key range, so the snapshot is valid
+	dwl::environment::TerrainMapFile map_file;
+	BOOST_CHECK(map_file.write(filename, terrain, 16));
+	BOOST_REQUIRE(map_file.open(filename));
+
+	dwl::environment::TerrainMap loaded_terrain;
+	BOOST_CHECK(map_file.load(loaded_terrain));
+	const dwl::TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	const dwl::TerrainDataMap& loaded_map = loaded_terrain.getTerrainDataMap();
+	BOOST_CHECK_EQUAL(loaded_map.size(), terrain_map.size());
+	for (dwl::TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		dwl::TerrainDataMap::const_iterator loaded_it = loaded_map.find(cell_it->first);
+		BOOST_CHECK(loaded_it != loaded_map.end() &&
+				isSameCell(loaded_it->second, cell_it->second));
+	}
+	map_file.close();
+
+	// The tiles of a tile size that doesn't divide the key range can't cover it
+	terrain_data.data[0].key.x = 0;
+	terrain.setTerrainMap(terrain_data);
+	BOOST_CHECK(!map_file.write(filename, terrain, 3));
+}
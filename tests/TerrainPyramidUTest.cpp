@@ -0,0 +1,166 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/environment/TerrainPyramid.h>
+#include <model/TerrainSearchModel.h>
+#include <cstdlib>
+
+
+using namespace dwl;
+
+/** Values of a cell of the brute-force grid */
+struct GridCell
+{
+	GridCell() : height(0.), cost(0.), is_occupied(false) {}
+	double height;
+	Weight cost;
+	bool is_occupied;
+};
+
+typedef std::map<std::pair<int,int>,GridCell> GridCellMap;
+
+
+/** Compares the region of the pyramid with the brute-force aggregation of the cells */
+void checkRegion(const environment::TerrainPyramid& pyramid,
+				 const GridCellMap& cells,
+				 int min_x, int max_x,
+				 int min_y, int max_y)
+{
+	environment::TerrainRegion expected_region;
+	double sum_height = 0., sum_cost = 0.;
+	for (GridCellMap::const_iterator cell_it = cells.begin(); cell_it != cells.end(); ++cell_it) {
+		int x = cell_it->first.first, y = cell_it->first.second;
+		if (!cell_it->second.is_occupied || x < min_x || x > max_x || y < min_y || y > max_y)
+			continue;
+
+		const GridCell& cell = cell_it->second;
+		expected_region.min_height = std::min(expected_region.min_height, cell.height);
+		expected_region.max_height = std::max(expected_region.max_height, cell.height);
+		expected_region.min_cost = std::min(expected_region.min_cost, cell.cost);
+		expected_region.max_cost = std::max(expected_region.max_cost, cell.cost);
+		sum_height += cell.height;
+		sum_cost += cell.cost;
+		expected_region.num_cells++;
+	}
+
+	environment::TerrainRegion region;
+	bool has_cells = pyramid.getRegion(region, min_x, max_x, min_y, max_y);
+	BOOST_CHECK_EQUAL(has_cells, expected_region.num_cells != 0);
+	BOOST_CHECK_EQUAL(region.num_cells, expected_region.num_cells);
+	if (!has_cells || expected_region.num_cells == 0)
+		return;
+
+	BOOST_CHECK_SMALL(region.min_height - expected_region.min_height, epsilon);
+	BOOST_CHECK_SMALL(region.max_height - expected_region.max_height, epsilon);
+	BOOST_CHECK_SMALL(region.mean_height - sum_height / expected_region.num_cells, epsilon);
+	BOOST_CHECK_SMALL(region.min_cost - expected_region.min_cost, epsilon);
+	BOOST_CHECK_SMALL(region.max_cost - expected_region.max_cost, epsilon);
+	BOOST_CHECK_SMALL(region.mean_cost - sum_cost / expected_region.num_cells, epsilon);
+}
+
+/** Compares random regions, and some unaligned ones, around the cells */
+void checkRegions(const environment::TerrainPyramid& pyramid,
+				  const GridCellMap& cells,
+				  int min_key, int max_key)
+{
+	checkRegion(pyramid, cells, min_key - 3, max_key + 3, min_key - 3, max_key + 3);
+	checkRegion(pyramid, cells, min_key + 1, min_key + 1, min_key + 2, min_key + 2);
+	checkRegion(pyramid, cells, min_key + 3, max_key - 5, min_key + 7, max_key - 1);
+	for (unsigned int i = 0; i < 30; ++i) {
+		int size = max_key - min_key + 1;
+		int min_x = min_key + rand() % size, min_y = min_key + rand() % size;
+		int max_x = min_x + rand() % size, max_y = min_y + rand() % size;
+		checkRegion(pyramid, cells, min_x, max_x, min_y, max_y);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(incremental_update) // specify a test case for the updates of the cells
+{
+	// Cells of an unaligned window of keys, with some missing cells
+	const int min_key = 1001, max_key = 1037;
+	srand(0);
+	GridCellMap cells;
+	environment::TerrainPyramid pyramid;
+	pyramid.setNumberOfLevels(5);
+	for (int x = min_key; x <= max_key; ++x) {
+		for (int y = min_key; y <= max_key; ++y) {
+			if (rand() % 5 == 0)
+				continue;
+
+			GridCell& cell = cells[std::make_pair(x, y)];
+			cell.height = 0.01 * (rand() % 100) - 0.5;
+			cell.cost = 0.1 * (rand() % 50);
+			cell.is_occupied = true;
+			pyramid.insertCell(x, y, cell.height, cell.cost);
+		}
+	}
+	pyramid.build();
+	checkRegions(pyramid, cells, min_key, max_key);
+
+	// Updating, adding and removing cells, i.e. their ancestors are recomputed
+	for (unsigned int i = 0; i < 300; ++i) {
+		int x = min_key + rand() % (max_key - min_key + 1);
+		int y = min_key + rand() % (max_key - min_key + 1);
+		GridCell& cell = cells[std::make_pair(x, y)];
+		if (rand() % 3 == 0) {
+			cell.is_occupied = false;
+			pyramid.removeCell(x, y);
+		} else {
+			cell.height = 0.01 * (rand() % 100) - 0.5;
+			cell.cost = 0.1 * (rand() % 50);
+			cell.is_occupied = true;
+			pyramid.updateCell(x, y, cell.height, cell.cost);
+		}
+	}
+	checkRegions(pyramid, cells, min_key, max_key);
+
+	// Removing all the cells
+	for (GridCellMap::iterator cell_it = cells.begin(); cell_it != cells.end(); ++cell_it) {
+		cell_it->second.is_occupied = false;
+		pyramid.removeCell(cell_it->first.first, cell_it->first.second);
+	}
+	environment::TerrainRegion region;
+	BOOST_CHECK(!pyramid.getRegion(region, min_key, max_key, min_key, max_key));
+}
+
+
+BOOST_AUTO_TEST_CASE(terrain_map_update) // specify a test case for the pyramid of the terrain map
+{
+	environment::TerrainMap terrain;
+	model::buildTerrain(terrain);
+	terrain.setTerrainPyramid(4);
+
+	// Updating the costs and removing some cells of the terrain map
+	TerrainData terrain_delta;
+	terrain_delta.plane_size = resolution;
+	terrain_delta.height_size = resolution;
+	for (unsigned int i = 3; i < 9; ++i)
+		terrain_delta.data.push_back(model::createCell(i, 5, 7.));
+	std::vector<Vertex> removed_cells;
+	for (unsigned int j = 0; j < 4; ++j) {
+		Vertex vertex;
+		terrain.getTerrainSpaceModel().keyToVertex(vertex,
+												   model::createCell(12, j, 0.).key, true);
+		removed_cells.push_back(vertex);
+	}
+	terrain.updateTerrainMap(terrain_delta, removed_cells);
+	terrain.addCellToTerrainMap(model::createCell(15, 15, 9.));
+
+	// Aggregating the cells of the terrain map by brute force
+	GridCellMap cells;
+	int min_key = std::numeric_limits<int>::max(), max_key = 0;
+	const TerrainDataMap& terrain_map = terrain.getTerrainDataMap();
+	for (TerrainDataMap::const_iterator cell_it = terrain_map.begin();
+			cell_it != terrain_map.end(); ++cell_it) {
+		GridCell& cell = cells[std::make_pair(cell_it->second.key.x, cell_it->second.key.y)];
+		terrain.getTerrainSpaceModel().keyToCoord(cell.height, cell_it->second.key.z, false);
+		cell.cost = cell_it->second.cost;
+		cell.is_occupied = true;
+		min_key = std::min(min_key, (int) cell_it->second.key.x);
+		max_key = std::max(max_key, (int) cell_it->second.key.x);
+	}
+	BOOST_REQUIRE_EQUAL(cells.size(), num_cells * num_cells - 4);
+	checkRegions(terrain.getTerrainPyramid(), cells, min_key, max_key);
+}
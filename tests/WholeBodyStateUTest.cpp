@@ -182,3 +182,37 @@ BOOST_AUTO_TEST_CASE(base_joint) // specify a test case for joint states
 	for (unsigned int i = 0; i < old_joint_state.size(); i++)
 		BOOST_CHECK_SMALL((double) (new_joint_state(i) - old_joint_state(i)), epsilon);
 }
+
+
+BOOST_AUTO_TEST_CASE(moved_state) // specify a test case for the moved-from states
+{
+	dwl::WholeBodyState ws(2);
+	ws.setBasePosition(Eigen::Vector3d(0.1, 0.2, 0.3));
+	ws.setBaseVelocity_W(Eigen::Vector3d(1., 2., 3.));
+	ws.setJointPosition(Eigen::Vector2d(0.1, 0.5));
+	ws.setContactPosition_B("lf_foot", Eigen::Vector3d(0.3, 0.2, -0.5));
+
+	// The moved state keeps the values
+	dwl::WholeBodyState moved_ws(std::move(ws));
+	BOOST_CHECK_SMALL((moved_ws.getBasePosition() - Eigen::Vector3d(0.1, 0.2, 0.3)).norm(),
+					  epsilon);
+	BOOST_CHECK_EQUAL(moved_ws.getJointDoF(), 2);
+	BOOST_CHECK_EQUAL(moved_ws.getContactPosition_W("lf_foot").size(), 3);
+
+	// The moved-from state is a zero state without joints and contacts, whose missing
+	// contacts are 3d zero vectors
+	BOOST_CHECK_SMALL(ws.getBasePosition().norm(), epsilon);
+	BOOST_CHECK_SMALL(ws.getBaseVelocity_W().norm(), epsilon);
+	BOOST_CHECK_SMALL(ws.getBaseAcceleration_W().norm(), epsilon);
+	BOOST_CHECK_EQUAL(ws.getJointDoF(), 0);
+	Eigen::VectorXd contact_pos = ws.getContactPosition_W("lf_foot");
+	BOOST_REQUIRE_EQUAL(contact_pos.size(), 3);
+	BOOST_CHECK_SMALL(contact_pos.norm(), epsilon);
+	BOOST_CHECK_EQUAL(ws.getContactVelocity_W("lf_foot").size(), 3);
+
+	// The move assignment swaps the states, so both have 3d null vectors
+	ws = std::move(moved_ws);
+	BOOST_CHECK_SMALL((ws.getBasePosition() - Eigen::Vector3d(0.1, 0.2, 0.3)).norm(), epsilon);
+	BOOST_CHECK_EQUAL(ws.getContactPosition_W("rf_foot").size(), 3);
+	BOOST_CHECK_EQUAL(moved_ws.getContactPosition_W("rf_foot").size(), 3);
+}
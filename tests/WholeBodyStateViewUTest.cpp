@@ -0,0 +1,73 @@
+#include <dwl/ocp/WholeBodyStateView.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+// Tolerance
+double epsilon = 0.00001;
+
+// Decodes the joint positions and efforts of a view, and counts the decodings
+class JointStateDecoder : public dwl::ocp::WholeBodyStateDecoder
+{
+	public:
+		JointStateDecoder() : num_decodings(0) {}
+
+		const dwl::WholeBodyState& decode(const dwl::ocp::WholeBodyStateView& state_view)
+		{
+			state.joint_pos = state_view.getJointPosition();
+			state.joint_eff = state_view.getJointEffort();
+			state.duration = state_view.getDuration();
+			state.time = state_view.getTime();
+			++num_decodings;
+			return state;
+		}
+
+		dwl::WholeBodyState state;
+		unsigned int num_decodings;
+};
+
+BOOST_AUTO_TEST_CASE(decision_view) // specify a test case for the decision state views
+{
+	// Layout of a fixed-base system with 2 joints, i.e. [q, tau]
+	dwl::ocp::WholeBodyStateLayout layout;
+	layout.position = 0;
+	layout.effort = 2;
+	layout.system_dof = 2;
+	layout.joint_dof = 2;
+	double decision[8] = {0.1, 0.2, 3., 4., 0.5, 0.6, 7., 8.};
+
+	// Reading the variables of the second knot in place
+	dwl::ocp::WholeBodyStateView state_view(decision + 4, layout);
+	BOOST_CHECK(!state_view.hasTime() && state_view.hasPosition() && state_view.hasEffort());
+	BOOST_CHECK(state_view.getJointPosition().data() == decision + 4);
+	BOOST_CHECK_SMALL(state_view.getJointEffort()(1) - 8., epsilon);
+
+	// The knot duration is used because time isn't a decision variable
+	state_view.setKnot(0.2, 0.1);
+	BOOST_CHECK_SMALL(state_view.getTime() - 0.2, epsilon);
+	BOOST_CHECK_SMALL(state_view.getDuration() - 0.1, epsilon);
+
+	// The whole-body state is decoded once per view
+	JointStateDecoder decoder;
+	state_view.setDecoder(&decoder);
+	BOOST_CHECK_EQUAL(decoder.num_decodings, 0);
+	const dwl::WholeBodyState& state = state_view.getWholeBodyState();
+	state_view.getWholeBodyState();
+	BOOST_CHECK_EQUAL(decoder.num_decodings, 1);
+	BOOST_CHECK_SMALL(state.joint_pos(0) - 0.5, epsilon);
+	BOOST_CHECK_SMALL(state.joint_eff(0) - 7., epsilon);
+	BOOST_CHECK_SMALL(state.time - 0.2, epsilon);
+
+	// The time is read from the decision state when it's a decision variable
+	dwl::ocp::WholeBodyStateLayout timed_layout = layout;
+	timed_layout.time = 0;
+	timed_layout.position = 1;
+	timed_layout.effort = 3;
+	dwl::ocp::WholeBodyStateView timed_view(decision, timed_layout);
+	timed_view.setKnot(0.3, 0.25);
+	BOOST_CHECK_SMALL(timed_view.getDuration() - 0.1, epsilon);
+	BOOST_CHECK_SMALL(timed_view.getJointPosition()(0) - 0.2, epsilon);
+}
@@ -0,0 +1,143 @@
+#include <dwl/WholeBodyTrajectoryBuffer.h>
+
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+
+
+// Tolerance
+double epsilon = 0.00001;
+
+dwl::WholeBodyState createState(double value)
+{
+	dwl::WholeBodyState ws(2);
+	ws.time = value;
+	ws.duration = 0.1;
+	ws.base_pos = Eigen::VectorXd::Constant(6, value);
+	ws.base_vel = Eigen::VectorXd::Constant(6, 2 * value);
+	ws.joint_pos = Eigen::Vector2d(value, -value);
+	ws.joint_vel = Eigen::Vector2d(2 * value, -2 * value);
+	ws.contact_pos["foot"] = Eigen::Vector3d(value, 0., -value);
+	ws.contact_eff["foot"] = Eigen::VectorXd::Constant(6, 3 * value);
+
+	return ws;
+}
+
+
+BOOST_AUTO_TEST_CASE(round_trip) // specify a test case for the trajectory conversions
+{
+	dwl::WholeBodyTrajectory trajectory;
+	for (unsigned int k = 0; k < 5; k++)
+		trajectory.push_back(createState(k + 1.));
+
+	dwl::WholeBodyTrajectoryBuffer buffer(2, std::vector<std::string>(1, "foot"));
+	buffer.fromWholeBodyTrajectory(trajectory);
+	BOOST_CHECK_EQUAL(buffer.size(), 5);
+
+	dwl::WholeBodyTrajectory new_trajectory;
+	buffer.toWholeBodyTrajectory(new_trajectory);
+	BOOST_CHECK_EQUAL(new_trajectory.size(), 5);
+	for (unsigned int k = 0; k < 5; k++) {
+		const dwl::WholeBodyState& old_state = trajectory[k];
+		const dwl::WholeBodyState& new_state = new_trajectory[k];
+		BOOST_CHECK_SMALL(new_state.time - old_state.time, epsilon);
+		BOOST_CHECK_SMALL(new_state.duration - old_state.duration, epsilon);
+		BOOST_CHECK_SMALL((new_state.base_pos - old_state.base_pos).norm(), epsilon);
+		BOOST_CHECK_SMALL((new_state.base_vel - old_state.base_vel).norm(), epsilon);
+		BOOST_CHECK_SMALL((new_state.joint_pos - old_state.joint_pos).norm(), epsilon);
+		BOOST_CHECK_SMALL((new_state.joint_vel - old_state.joint_vel).norm(), epsilon);
+		BOOST_CHECK_SMALL((double) (new_state.contact_pos.find("foot")->second -
+				old_state.contact_pos.find("foot")->second).norm(), epsilon);
+		BOOST_CHECK_SMALL((double) (new_state.contact_eff.find("foot")->second -
+				old_state.contact_eff.find("foot")->second).norm(), epsilon);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(views) // specify a test case for the per-sample views
+{
+	dwl::WholeBodyTrajectoryBuffer buffer(2, std::vector<std::string>(1, "foot"));
+	buffer.push_back(createState(1.));
+	buffer.push_back(createState(2.));
+
+	BOOST_CHECK_SMALL(buffer.time(1) - 2., epsilon);
+	BOOST_CHECK_SMALL(buffer.joint_pos(1)(1) + 2., epsilon);
+	BOOST_CHECK_SMALL(buffer.contact_pos(1, 0)(2) + 2., epsilon);
+
+	// Writing through the views
+	buffer.base_pos(0).setConstant(5.);
+	dwl::WholeBodyState ws;
+	buffer.getState(ws, 0);
+	BOOST_CHECK_SMALL((double) (ws.base_pos - Eigen::VectorXd::Constant(6, 5.)).norm(), epsilon);
+}
+
+
+BOOST_AUTO_TEST_CASE(clear_and_swap) // specify a test case for the memory reuse
+{
+	dwl::WholeBodyTrajectoryBuffer buffer(2, std::vector<std::string>(1, "foot"));
+	buffer.reserve(10);
+	for (unsigned int k = 0; k < 4; k++)
+		buffer.push_back(createState(k));
+
+	// Clearing keeps the capacity
+	buffer.clear();
+	BOOST_CHECK(buffer.empty());
+	BOOST_CHECK_EQUAL(buffer.capacity(), 10);
+
+	// Moving swaps the storage
+	buffer.push_back(createState(3.));
+	dwl::WholeBodyTrajectoryBuffer other(std::move(buffer));
+	BOOST_CHECK_EQUAL(other.size(), 1);
+	BOOST_CHECK_EQUAL(other.capacity(), 10);
+	BOOST_CHECK_SMALL(other.time(0) - 3., epsilon);
+
+	// Copying keeps the samples of the original buffer
+	dwl::WholeBodyTrajectoryBuffer copy(other);
+	copy.time(0) = 4.;
+	BOOST_CHECK_SMALL(other.time(0) - 3., epsilon);
+	BOOST_CHECK_EQUAL(copy.getJointDoF(), 2);
+	BOOST_CHECK_EQUAL(copy.getContactNames().size(), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(contact_mask) // specify a test case for the undefined contacts
+{
+	std::vector<std::string> contact_names;
+	contact_names.push_back("foot");
+	contact_names.push_back("hand");
+	dwl::WholeBodyTrajectoryBuffer buffer(2, contact_names);
+
+	// The foot is a 3d contact in the first sample, the hand a 6d contact in the second one
+	dwl::WholeBodyState ws = createState(1.);
+	buffer.push_back(ws);
+	ws.contact_pos.clear();
+	ws.contact_eff.clear();
+	ws.contact_pos["hand"] = Eigen::VectorXd::LinSpaced(6, 1., 6.);
+	ws.contact_vel["hand"] = Eigen::VectorXd::Constant(6, 2.);
+	buffer.push_back(ws);
+	BOOST_CHECK_EQUAL(buffer.contact_pos_dim(0, 0), 3);
+	BOOST_CHECK_EQUAL(buffer.contact_pos_dim(0, 1), 0);
+	BOOST_CHECK_EQUAL(buffer.contact_pos_dim(1, 1), 6);
+	BOOST_CHECK_EQUAL(buffer.contact_eff_dim(1, 0), 0);
+
+	// Only the defined contacts are rebuilt, with their dimensions
+	dwl::WholeBodyState first, second;
+	buffer.getState(first, 0);
+	BOOST_CHECK_EQUAL(first.contact_pos.size(), 1);
+	BOOST_CHECK_EQUAL(first.contact_pos["foot"].size(), 3);
+	BOOST_CHECK_EQUAL(first.contact_vel.size(), 0);
+	BOOST_CHECK_EQUAL(first.contact_eff.size(), 1);
+	buffer.getState(second, 1);
+	BOOST_CHECK_EQUAL(second.contact_pos.size(), 1);
+	BOOST_CHECK_SMALL((double) (second.contact_pos["hand"] -
+			Eigen::VectorXd::LinSpaced(6, 1., 6.)).norm(), epsilon);
+	BOOST_CHECK_EQUAL(second.contact_vel["hand"].size(), 6);
+	BOOST_CHECK_EQUAL(second.contact_eff.size(), 0);
+
+	// Reusing a state removes the contacts that the sample doesn't define
+	buffer.getState(first, 1);
+	BOOST_CHECK_EQUAL(first.contact_pos.count("foot"), 0);
+	BOOST_CHECK_EQUAL(first.contact_eff.size(), 0);
+	BOOST_CHECK_EQUAL(first.contact_pos["hand"].size(), 6);
+}
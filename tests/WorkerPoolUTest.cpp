@@ -0,0 +1,98 @@
+#define BOOST_TEST_MODULE DWL_TESTS
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dwl/utils/WorkerPool.h>
+#include <cmath>
+
+
+using namespace dwl;
+
+// Tolerance
+const double epsilon = 0.00001;
+
+/** Computes the value of a task, which is the serial result of the task */
+double computeTaskValue(unsigned int task_id)
+{
+	double value = 0.;
+	for (unsigned int i = 0; i < 100; ++i)
+		value += sin(0.01 * task_id * i);
+
+	return value;
+}
+
+
+BOOST_AUTO_TEST_CASE(parallel_tasks) // specify a test case for the parallel evaluation of tasks
+{
+	const unsigned int num_tasks = 1000;
+	std::vector<double> expected_values(num_tasks);
+	double expected_sum = 0.;
+	for (unsigned int i = 0; i < num_tasks; ++i) {
+		expected_values[i] = computeTaskValue(i);
+		expected_sum += expected_values[i];
+	}
+
+	// Changing the number of threads of the same pool, and running it several times
+	utils::WorkerPool pool;
+	unsigned int thread_numbers[] = {1, 4, 2, 0, 3};
+	for (unsigned int k = 0; k < 5; ++k) {
+		pool.setNumberOfThreads(thread_numbers[k]);
+		unsigned int num_threads = pool.getNumberOfThreads();
+		BOOST_REQUIRE(num_threads > 0);
+		if (thread_numbers[k] != 0)
+			BOOST_CHECK_EQUAL(num_threads, thread_numbers[k]);
+
+		for (unsigned int run = 0; run < 20; ++run) {
+			// Every task is evaluated once, and the per-thread workspaces are accumulated
+			std::vector<double> values(num_tasks, 0.);
+			std::vector<unsigned int> num_evaluations(num_tasks, 0);
+			std::vector<double> thread_sums(num_threads, 0.);
+			std::vector<char> valid_thread(num_tasks, 1);
+			pool.run(num_tasks, [&](unsigned int task_id, unsigned int thread_id) {
+				if (thread_id >= num_threads) {
+					valid_thread[task_id] = 0;
+					return;
+				}
+
+				values[task_id] = computeTaskValue(task_id);
+				num_evaluations[task_id]++;
+				thread_sums[thread_id] += values[task_id];
+			});
+
+			double sum = 0.;
+			for (unsigned int i = 0; i < num_threads; ++i)
+				sum += thread_sums[i];
+			BOOST_CHECK_SMALL(sum - expected_sum, epsilon);
+			for (unsigned int i = 0; i < num_tasks; ++i) {
+				BOOST_CHECK(valid_thread[i] != 0);
+				BOOST_CHECK_EQUAL(num_evaluations[i], 1);
+				BOOST_CHECK_EQUAL(values[i], expected_values[i]);
+			}
+		}
+
+		// A run without tasks returns immediately
+		pool.run(0, [&](unsigned int task_id, unsigned int thread_id) {
+			BOOST_ERROR("a task of an empty run was evaluated");
+		});
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(serial_tasks) // specify a test case for the evaluation with one thread
+{
+	// With one thread the tasks are evaluated in order by the calling thread
+	utils::WorkerPool pool;
+	BOOST_CHECK_EQUAL(pool.getNumberOfThreads(), 1);
+	std::vector<unsigned int> order;
+	std::thread::id caller_id = std::this_thread::get_id();
+	bool is_caller = true;
+	pool.run(50, [&](unsigned int task_id, unsigned int thread_id) {
+		order.push_back(task_id);
+		is_caller = is_caller && thread_id == 0 && std::this_thread::get_id() == caller_id;
+	});
+
+	BOOST_REQUIRE_EQUAL(order.size(), 50);
+	for (unsigned int i = 0; i < order.size(); ++i)
+		BOOST_CHECK_EQUAL(order[i], i);
+	BOOST_CHECK(is_caller);
+}
@@ -0,0 +1,109 @@
+#ifndef DWL__MODEL__TERRAIN_SEARCH_MODEL__H
+#define DWL__MODEL__TERRAIN_SEARCH_MODEL__H
+
+
+#include <dwl/solver/AStar.h>
+#include <dwl/model/GridBasedBodyAdjacency.h>
+#include <dwl/environment/TerrainMap.h>
+
+
+// Tolerance
+const double epsilon = 0.00001;
+
+// Terrain resolution and number of cells per side
+const double resolution = 0.04;
+const unsigned int num_cells = 20;
+
+
+namespace dwl
+{
+
+namespace model
+{
+
+/**
+ * The terrain adjacency with a zero geometric heuristic, so the searches return the optimal
+ * cost (the geometric heuristic of the adjacency models isn't admissible)
+ */
+class UniformCostAdjacency : public GridBasedBodyAdjacency
+{
+	public:
+		UniformCostAdjacency(bool is_stance_adjacency = false)
+		{
+			setStanceAdjacency(is_stance_adjacency);
+		}
+
+		double computeGeometricHeuristic(Vertex source,
+										 Vertex target)
+		{
+			return 0.;
+		}
+};
+
+inline TerrainCell createCell(unsigned int i,
+							  unsigned int j,
+							  double cost)
+{
+	environment::SpaceDiscretization space_model(resolution);
+	Key origin;
+	space_model.coordToKey(origin.x, 0., true);
+	space_model.coordToKey(origin.z, 0., false);
+
+	TerrainCell cell;
+	cell.key.x = origin.x + i;
+	cell.key.y = origin.x + j;
+	cell.key.z = origin.z;
+	cell.cost = cost;
+	cell.height = 0.;
+	cell.normal = Eigen::Vector3d::UnitZ();
+
+	return cell;
+}
+
+/**
+ * Builds a squared terrain with a smooth cost pattern, and optionally a wall of missing cells
+ * with a gap
+ */
+inline void buildTerrain(environment::TerrainMap& terrain,
+						 bool with_wall = false)
+{
+	TerrainData terrain_data;
+	terrain_data.plane_size = resolution;
+	terrain_data.height_size = resolution;
+	for (unsigned int i = 0; i < num_cells; ++i) {
+		for (unsigned int j = 0; j < num_cells; ++j) {
+			if (with_wall && i == num_cells / 2 && j > 3)
+				continue;
+
+			terrain_data.data.push_back(createCell(i, j, 1. + 0.5 * sin(i) * cos(j)));
+		}
+	}
+	terrain.setTerrainMap(terrain_data);
+}
+
+/**
+ * Computes the minimum cost of A* with an adjacency model. Note that the solver deletes the
+ * adjacency model
+ */
+inline bool computeAStarCost(double& cost,
+							 environment::TerrainMap& terrain,
+							 AdjacencyModel* adjacency,
+							 Vertex source,
+							 Vertex target,
+							 robot::Robot* robot = NULL)
+{
+	solver::AStar astar;
+	astar.setAdjacencyModel(adjacency);
+	astar.reset(robot, &terrain);
+	astar.init();
+	if (!astar.compute(source, target, std::numeric_limits<double>::max()))
+		return false;
+
+	cost = astar.getMinimumCost();
+	return true;
+}
+
+} //@namespace model
+} //@namespace dwl
+
+#endif